@@ -113,6 +113,20 @@ public:
                              const Http::HeaderMap& response_headers,
                              const Http::HeaderMap& response_trailers,
                              const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append a formatted access log line to a caller provided buffer. Unlike format(), this does not
+   * allocate a new string per call, so callers that reuse the buffer pay no allocation per line.
+   * @param request_headers supplies the request headers.
+   * @param response_headers supplies the response headers.
+   * @param response_trailers supplies the response trailers.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the complete formatted access log line is appended to.
+   */
+  virtual void formatTo(const Http::HeaderMap& request_headers,
+                        const Http::HeaderMap& response_headers,
+                        const Http::HeaderMap& response_trailers,
+                        const StreamInfo::StreamInfo& stream_info, std::string& output) const PURE;
 };
 
 using FormatterPtr = std::unique_ptr<Formatter>;
@@ -137,6 +151,19 @@ public:
                              const Http::HeaderMap& response_headers,
                              const Http::HeaderMap& response_trailers,
                              const StreamInfo::StreamInfo& stream_info) const PURE;
+  /**
+   * Extract a value from the provided headers/trailers/stream and append it to output. The
+   * appended text is the same as the string returned by format().
+   * @param request_headers supplies the request headers.
+   * @param response_headers supplies the response headers.
+   * @param response_trailers supplies the response trailers.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the extracted value is appended to.
+   */
+  virtual void formatTo(const Http::HeaderMap& request_headers,
+                        const Http::HeaderMap& response_headers,
+                        const Http::HeaderMap& response_trailers,
+                        const StreamInfo::StreamInfo& stream_info, std::string& output) const PURE;
   /**
    * Extract a value from the provided headers/trailers/stream, preserving the value's type.
    * @param request_headers supplies the request headers.
@@ -51,6 +51,34 @@ public:
    */
   virtual SysCallSizeResult recvmsg(int sockfd, struct msghdr* msg, int flags) PURE;
 
+  /**
+   * @see recvmmsg (man 2 recvmmsg)
+   */
+  virtual SysCallIntResult recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                                    int flags, struct timespec* timeout) PURE;
+
+  /**
+   * @see sendmmsg (man 2 sendmmsg)
+   */
+  virtual SysCallIntResult sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                                    int flags) PURE;
+
+  /**
+   * @return true if the platform implements recvmmsg() and sendmmsg().
+   */
+  virtual bool supportsMmsg() const PURE;
+
+  /**
+   * @return true if the kernel can coalesce received UDP datagrams (the UDP_GRO socket option).
+   */
+  virtual bool supportsUdpGro() const PURE;
+
+  /**
+   * @return true if the kernel can segment one large UDP send into several datagrams (the
+   * UDP_SEGMENT control message).
+   */
+  virtual bool supportsUdpGso() const PURE;
+
   /**
    * Release all resources allocated for fd.
    * @return zero on success, -1 returned otherwise.
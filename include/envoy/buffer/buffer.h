@@ -14,6 +14,7 @@
 #include "common/common/byte_order.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Buffer {
@@ -51,6 +52,27 @@ public:
   virtual void done() PURE;
 };
 
+/**
+ * A contiguous block of data whose ownership was transferred out of a buffer. The data stays valid
+ * for the lifetime of the object.
+ */
+class SliceData {
+public:
+  virtual ~SliceData() = default;
+
+  /**
+   * @return the data in the slice.
+   */
+  virtual absl::Span<const uint8_t> getData() const PURE;
+
+  /**
+   * @return the size of the memory kept alive by the slice, which is at least the size of its data.
+   */
+  virtual uint64_t getCapacity() const PURE;
+};
+
+using SliceDataPtr = std::unique_ptr<SliceData>;
+
 /**
  * A basic buffer abstraction.
  */
@@ -123,6 +145,20 @@ public:
    */
   virtual void drain(uint64_t size) PURE;
 
+  /**
+   * Remove the first non-empty slice from the buffer and transfer ownership of its data to the
+   * caller, without copying it. Together with addBufferFragment(), this allows a consumer to
+   * pass parts of the slice on to other buffers without copying them.
+   * @return the first non-empty slice of the buffer. The buffer must not be empty.
+   */
+  virtual SliceDataPtr extractFrontSlice() PURE;
+
+  /**
+   * @return the first non-empty slice of the buffer, or an empty RawSlice if the buffer is empty.
+   *         Unlike getRawSlices(), this does not walk the whole buffer.
+   */
+  virtual RawSlice frontSlice() const PURE;
+
   /**
    * Fetch the raw buffer slices. This routine is optimized for performance.
    * @param out supplies an array of RawSlice objects to fill.
@@ -54,6 +54,7 @@ typedef unsigned int sa_family_t;
 
 #if defined(__linux__)
 #include <linux/netfilter_ipv4.h>
+#include <netinet/udp.h>
 #endif
 
 #define PACKED_STRUCT(definition, ...) definition, ##__VA_ARGS__ __attribute__((packed))
@@ -63,4 +64,27 @@ typedef unsigned int sa_family_t;
 #define IP6T_SO_ORIGINAL_DST 80
 #endif
 
+#ifndef SOL_UDP
+#define SOL_UDP IPPROTO_UDP
+#endif
+
+#ifndef UDP_SEGMENT
+// From linux/udp.h
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef UDP_GRO
+// From linux/udp.h
+#define UDP_GRO 104
+#endif
+
+#if !defined(__linux__)
+// The message vector element of recvmmsg() and sendmmsg(), which only Linux provides. Defined so
+// that the interfaces using it compile elsewhere; Api::OsSysCalls::supportsMmsg() returns false.
+struct mmsghdr {
+  struct msghdr msg_hdr;
+  unsigned int msg_len;
+};
+#endif
+
 #endif
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "envoy/buffer/buffer.h"
 
 namespace Envoy {
@@ -26,5 +28,7 @@ public:
   virtual void compress(Buffer::Instance& buffer, State state) PURE;
 };
 
+using CompressorPtr = std::unique_ptr<Compressor>;
+
 } // namespace Compressor
 } // namespace Envoy
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+#include "envoy/compressor/compressor.h"
+#include "envoy/protobuf/message_validator.h"
+
+#include "common/protobuf/protobuf.h"
+
+namespace Envoy {
+namespace Compressor {
+
+/**
+ * Creates the compressors of a compressor library, set up with the configuration of the library.
+ */
+class CompressorFactory {
+public:
+  virtual ~CompressorFactory() = default;
+
+  /**
+   * @return CompressorPtr a new compressor, ready to compress a single stream.
+   */
+  virtual CompressorPtr createCompressor() PURE;
+};
+
+using CompressorFactorySharedPtr = std::shared_ptr<CompressorFactory>;
+
+/**
+ * Implemented by each compressor library and registered via Registry::registerFactory() or the
+ * convenience class RegisterFactory.
+ */
+class NamedCompressorLibraryConfigFactory {
+public:
+  virtual ~NamedCompressorLibraryConfigFactory() = default;
+
+  /**
+   * Create a particular compressor factory implementation.
+   * @param config supplies the configuration of the library, as returned by
+   *        createEmptyConfigProto() and filled in from the typed config.
+   * @param validation_visitor message validation visitor instance.
+   * @return CompressorFactorySharedPtr the compressor factory.
+   */
+  virtual CompressorFactorySharedPtr
+  createCompressorFactoryFromProto(const Protobuf::Message& config,
+                                   ProtobufMessage::ValidationVisitor& validation_visitor) PURE;
+
+  /**
+   * @return ProtobufTypes::MessagePtr create empty config proto message for v2.
+   */
+  virtual ProtobufTypes::MessagePtr createEmptyConfigProto() PURE;
+
+  /**
+   * @return std::string the identifying name for a particular implementation of a compressor
+   *         library produced by the factory.
+   */
+  virtual std::string name() const PURE;
+
+  /**
+   * @return std::string the identifying category name for objects created by this factory. Used
+   *         for automatic registration with FactoryCategoryRegistry.
+   */
+  static std::string category() { return "compressors"; }
+};
+
+} // namespace Compressor
+} // namespace Envoy
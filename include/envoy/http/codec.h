@@ -340,6 +340,7 @@ public:
   /**
    * Dispatch incoming connection data.
    * @param data supplies the data to dispatch. The codec will drain as many bytes as it processes.
+   *        If dispatch throws, data may have been drained past the point of the error.
    */
   virtual void dispatch(Buffer::Instance& data) PURE;
 
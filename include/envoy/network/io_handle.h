@@ -89,6 +89,11 @@ public:
     std::shared_ptr<const Address::Instance> local_address_;
     // The the source address from transport header.
     std::shared_ptr<const Address::Instance> peer_address_;
+    // The number of bytes received.
+    uint64_t msg_len_{0};
+    // The size of each datagram if the kernel coalesced several datagrams into the received
+    // payload (UDP_GRO), 0 otherwise. Only the last datagram may be shorter.
+    uint64_t gso_size_{0};
   };
 
   /**
@@ -104,6 +109,49 @@ public:
    */
   virtual Api::IoCallUint64Result recvmsg(Buffer::RawSlice* slices, const uint64_t num_slice,
                                           uint32_t self_port, RecvMsgOutput& output) PURE;
+
+  /**
+   * Receive multiple messages with a single system call where the platform supports it, one
+   * message into each of the given slices.
+   * @param slices points to one receiving buffer per message.
+   * @param num_packets indicates the maximum number of messages to receive. |slices| and |outputs|
+   * both contain this many elements.
+   * @param self_port the port this handle is assigned to. @see recvmsg().
+   * @param outputs modified upon each call to return fields requested in them, one per message
+   * received.
+   * @return a Api::IoCallUint64Result with err_ = an Api::IoError instance or
+   * err_ = nullptr and rc_ = the number of messages received for success.
+   */
+  virtual Api::IoCallUint64Result recvmmsg(Buffer::RawSlice* slices, uint64_t num_packets,
+                                           uint32_t self_port, RecvMsgOutput* outputs) PURE;
+
+  /**
+   * A message to be sent by sendmmsg(). @see sendmsg() for the meaning of the fields.
+   */
+  struct SendMsgEntry {
+    const Buffer::RawSlice* slices_;
+    uint64_t num_slice_;
+    const Address::Ip* self_ip_;
+    const Address::Instance* peer_address_;
+  };
+
+  /**
+   * Send multiple messages with as few system calls as the platform allows. Messages are sent in
+   * order. If the send buffer of the socket fills up, the remaining messages are not sent. As with
+   * sendmsg(), empty messages are not sent and count as sent.
+   * @param messages points to the messages to be sent.
+   * @param num_messages indicates the number of messages |messages| contains.
+   * @return a Api::IoCallUint64Result with err_ = an Api::IoError instance if no message could be
+   * sent or err_ = nullptr and rc_ = the number of messages sent.
+   */
+  virtual Api::IoCallUint64Result sendmmsg(const SendMsgEntry* messages,
+                                           uint64_t num_messages) PURE;
+
+  /**
+   * @return true if recvmmsg() and sendmmsg() batch messages into a single system call. If false
+   * they still work, but do one system call per message.
+   */
+  virtual bool supportsMmsg() const PURE;
 };
 
 using IoHandlePtr = std::unique_ptr<IoHandle>;
@@ -196,6 +196,19 @@ struct UdpSendData {
   Buffer::Instance& buffer_;
 };
 
+/**
+ * Options controlling how a UDP listener reads from its socket.
+ */
+struct UdpReadOptions {
+  // The maximum number of datagrams read each time the socket becomes readable. Datagrams left on
+  // the socket are read on the next event loop iteration, so that a busy listener can't starve the
+  // other work of its dispatcher.
+  uint32_t max_packets_per_event_{128};
+  // Whether to enable UDP_GRO on the socket if the kernel supports it. The kernel then coalesces
+  // datagrams from the same peer and returns them with a single read.
+  bool prefer_gro_{false};
+};
+
 /**
  * UDP listener callbacks.
  */
@@ -277,6 +290,19 @@ public:
    * sender.
    */
   virtual Api::IoCallUint64Result send(const UdpSendData& data) PURE;
+
+  /**
+   * Send several datagrams through the underlying udp socket with as few system calls as the
+   * platform allows. Datagrams are sent in order. If the send buffer of the socket FD fills up, the
+   * remaining datagrams are not sent.
+   *
+   * @param data Supplies the datagrams to send.
+   * @param num_packets Supplies the number of datagrams |data| contains.
+   * @return the error code of the underlying send api if no datagram could be sent. Otherwise rc_
+   * is the number of datagrams sent, whose buffers are drained. The remaining can be retried by
+   * the sender.
+   */
+  virtual Api::IoCallUint64Result sendBatch(const UdpSendData* data, uint64_t num_packets) PURE;
 };
 
 using UdpListenerPtr = std::unique_ptr<UdpListener>;
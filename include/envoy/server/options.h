@@ -154,6 +154,11 @@ public:
    */
   virtual std::chrono::milliseconds fileFlushIntervalMsec() const PURE;
 
+  /**
+   * @return bool whether all access log files are flushed by a single shared thread.
+   */
+  virtual bool fileFlushSharedThreadEnabled() const PURE;
+
   /**
    * @return const std::string& the server's cluster.
    */
@@ -120,6 +120,12 @@ public:
    * are candidates for decrypting received tickets.
    */
   virtual const std::vector<SessionTicketKey>& sessionTicketKeys() const PURE;
+
+  /**
+   * @return True if stateful sessions are stored in the session cache shared by all contexts,
+   * false if they are stored in a cache private to the context.
+   */
+  virtual bool shareSessionCache() const PURE;
 };
 
 using ServerContextConfigPtr = std::unique_ptr<ServerContextConfig>;
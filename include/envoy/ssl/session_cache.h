@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Ssl {
+
+/**
+ * A store of TLS sessions shared by all the contexts of a context manager. Sessions stored here
+ * outlive the context that negotiated them, so they can be resumed by any worker and by the
+ * contexts that replace it on a secret update. Implementations must be thread safe.
+ */
+class SessionCache {
+public:
+  virtual ~SessionCache() = default;
+
+  /**
+   * Store a session, replacing any session already stored under the same key.
+   * @param key supplies the key. Callers must make sure that the key covers everything that has
+   *        to match for the session to be resumed safely (peer identity, validation settings...).
+   * @param session supplies the session.
+   */
+  virtual void insert(const std::string& key, bssl::UniquePtr<SSL_SESSION> session) PURE;
+
+  /**
+   * Find a session. Single-use sessions (TLSv1.3 tickets) are removed by the lookup.
+   * @param key supplies the key.
+   * @return a reference to the session, or nullptr if there is no session for the key.
+   */
+  virtual bssl::UniquePtr<SSL_SESSION> lookup(const std::string& key) PURE;
+
+  /**
+   * Remove the session stored under a key, if any.
+   * @param key supplies the key.
+   */
+  virtual void remove(const std::string& key) PURE;
+
+  /**
+   * @return the number of sessions stored.
+   */
+  virtual size_t size() const PURE;
+};
+
+using SessionCacheSharedPtr = std::shared_ptr<SessionCache>;
+
+} // namespace Ssl
+} // namespace Envoy
@@ -8,6 +8,8 @@
 #include "envoy/stats/refcount_ptr.h"
 #include "envoy/stats/stats.h"
 
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace Stats {
 
@@ -140,5 +142,28 @@ public:
 
 using ParentHistogramSharedPtr = RefcountPtr<ParentHistogram>;
 
+/**
+ * Upper bounds of the buckets of a fixed bucket histogram, sorted in increasing order.
+ */
+using ConstSupportedBuckets = const std::vector<double>;
+using ConstSupportedBucketsSharedPtr = std::shared_ptr<ConstSupportedBuckets>;
+
+/**
+ * Per stat name histogram bucket layouts.
+ */
+class HistogramSettings {
+public:
+  virtual ~HistogramSettings() = default;
+
+  /**
+   * @param stat_name supplies the full name of a histogram, before tag extraction.
+   * @return the bucket upper bounds the histogram records into, or nullptr if the histogram
+   *         records into the default log-linear histogram.
+   */
+  virtual ConstSupportedBucketsSharedPtr buckets(absl::string_view stat_name) const PURE;
+};
+
+using HistogramSettingsConstPtr = std::unique_ptr<const HistogramSettings>;
+
 } // namespace Stats
 } // namespace Envoy
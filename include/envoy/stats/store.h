@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "envoy/common/pure.h"
+#include "envoy/stats/histogram.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats_matcher.h"
 #include "envoy/stats/tag_producer.h"
@@ -73,6 +74,13 @@ public:
    */
   virtual void setStatsMatcher(StatsMatcherPtr&& stats_matcher) PURE;
 
+  /**
+   * Attach histogram settings to this StoreRoot, selecting the bucket layout of histograms by
+   * name. The settings apply to histograms created after this call.
+   * @param histogram_settings the HistogramSettings to attach to this StoreRoot.
+   */
+  virtual void setHistogramSettings(HistogramSettingsConstPtr&& histogram_settings) PURE;
+
   /**
    * Initialize the store for threading. This will be called once after all worker threads have
    * been initialized. At this point the store can initialize itself for multi-threaded operation.
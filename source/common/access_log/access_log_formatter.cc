@@ -1,6 +1,9 @@
 #include "common/access_log/access_log_formatter.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <map>
 #include <regex>
 #include <string>
 #include <vector>
@@ -57,6 +60,212 @@ void truncate(std::string& str, absl::optional<uint32_t> max_length) {
   str = str.substr(0, max_length.value());
 }
 
+// Whether c can't be copied as is into a JSON string. Bytes of multi-byte UTF-8 sequences are
+// included, so that appendJsonEscaped() validates the sequences and checks their code points.
+bool needsJsonEscaping(char c) {
+  const auto byte = static_cast<unsigned char>(c);
+  return byte < 0x20 || byte >= 0x7f || c == '"' || c == '\\' || c == '<' || c == '>';
+}
+
+// Whether the protobuf JSON printer escapes the code point cp, which is at least 0x80: the C1
+// controls and the invisible formatting characters.
+bool codePointNeedsJsonEscaping(uint32_t cp) {
+  return cp <= 0x9f || cp == 0xad || (cp >= 0x600 && cp <= 0x603) || cp == 0x6dd ||
+         cp == 0x70f || (cp >= 0x17b4 && cp <= 0x17b5) || (cp >= 0x200b && cp <= 0x200f) ||
+         (cp >= 0x2028 && cp <= 0x202e) || (cp >= 0x2060 && cp <= 0x2064) ||
+         (cp >= 0x206a && cp <= 0x206f) || cp == 0xfeff || (cp >= 0xfff9 && cp <= 0xfffb) ||
+         cp == 0x110bd || (cp >= 0x1d173 && cp <= 0x1d17a) || cp == 0xe0001 ||
+         (cp >= 0xe0020 && cp <= 0xe007f);
+}
+
+// Decodes the UTF-8 sequence at the start of str into cp. Returns the length of the sequence, or 0
+// if str doesn't start with a valid sequence (overlong encodings and surrogates are invalid).
+size_t decodeUtf8(absl::string_view str, uint32_t& cp) {
+  const auto lead = static_cast<unsigned char>(str[0]);
+  size_t length;
+  uint32_t min_cp;
+  if (lead >= 0xc2 && lead <= 0xdf) {
+    length = 2;
+    min_cp = 0x80;
+    cp = lead & 0x1f;
+  } else if (lead >= 0xe0 && lead <= 0xef) {
+    length = 3;
+    min_cp = 0x800;
+    cp = lead & 0x0f;
+  } else if (lead >= 0xf0 && lead <= 0xf4) {
+    length = 4;
+    min_cp = 0x10000;
+    cp = lead & 0x07;
+  } else {
+    return 0;
+  }
+  if (str.size() < length) {
+    return 0;
+  }
+  for (size_t i = 1; i < length; i++) {
+    const auto byte = static_cast<unsigned char>(str[i]);
+    if ((byte & 0xc0) != 0x80) {
+      return 0;
+    }
+    cp = (cp << 6) | (byte & 0x3f);
+  }
+  if (cp < min_cp || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) {
+    return 0;
+  }
+  return length;
+}
+
+void appendJsonUnicodeEscape(uint32_t code_unit, std::string& output) {
+  static const char HexDigits[] = "0123456789abcdef";
+  output.append("\\u");
+  for (int shift = 12; shift >= 0; shift -= 4) {
+    output.push_back(HexDigits[(code_unit >> shift) & 0xf]);
+  }
+}
+
+// Appends str to output as the contents of a JSON string, escaped the way the protobuf JSON
+// printer escapes it: the quote, the backslash, '<', '>', the control characters and the invisible
+// formatting characters. A byte that isn't part of valid UTF-8 is escaped as the code point of the
+// same value, so that the output is always valid UTF-8.
+void appendJsonEscaped(absl::string_view str, std::string& output) {
+  size_t i = 0;
+  while (i < str.size()) {
+    const char c = str[i];
+    if (!needsJsonEscaping(c)) {
+      output.push_back(c);
+      i++;
+      continue;
+    }
+    size_t length = 1;
+    switch (c) {
+    case '"':
+      output.append("\\\"");
+      break;
+    case '\\':
+      output.append("\\\\");
+      break;
+    case '\b':
+      output.append("\\b");
+      break;
+    case '\f':
+      output.append("\\f");
+      break;
+    case '\n':
+      output.append("\\n");
+      break;
+    case '\r':
+      output.append("\\r");
+      break;
+    case '\t':
+      output.append("\\t");
+      break;
+    default: {
+      const auto byte = static_cast<unsigned char>(c);
+      uint32_t cp = 0;
+      const size_t utf8_length = byte >= 0x80 ? decodeUtf8(str.substr(i), cp) : 0;
+      if (utf8_length == 0) {
+        // An ASCII character or a byte that isn't part of valid UTF-8.
+        appendJsonUnicodeEscape(byte, output);
+        break;
+      }
+      length = utf8_length;
+      if (!codePointNeedsJsonEscaping(cp)) {
+        output.append(str.data() + i, length);
+      } else if (cp <= 0xffff) {
+        appendJsonUnicodeEscape(cp, output);
+      } else {
+        // Code points outside of the Basic Multilingual Plane are escaped as surrogate pairs.
+        appendJsonUnicodeEscape(0xd800 + ((cp - 0x10000) >> 10), output);
+        appendJsonUnicodeEscape(0xdc00 + ((cp - 0x10000) & 0x3ff), output);
+      }
+      break;
+    }
+    }
+    i += length;
+  }
+}
+
+// Escapes, in place, everything appended to output from position start onwards. Values rarely need
+// escaping, so the common case is a single scan without copying.
+void escapeJsonInPlace(std::string& output, size_t start) {
+  const auto it = std::find_if(output.begin() + start, output.end(), needsJsonEscaping);
+  if (it == output.end()) {
+    return;
+  }
+
+  const size_t first = it - output.begin();
+  const std::string unescaped = output.substr(first);
+  output.resize(first);
+  appendJsonEscaped(unescaped, output);
+}
+
+void appendJsonNumber(double value, std::string& output) {
+  // Non finite numbers can't be represented in JSON, they are emitted as strings like the protobuf
+  // JSON printer does.
+  if (std::isnan(value)) {
+    output.append("\"NaN\"");
+  } else if (std::isinf(value)) {
+    output.append(value > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+  } else if (std::trunc(value) == value && std::fabs(value) < 9007199254740992.0) {
+    // Integral values which a double represents exactly (up to 2^53) are printed without a
+    // fraction.
+    const fmt::format_int integral(static_cast<int64_t>(value));
+    output.append(integral.data(), integral.size());
+  } else {
+    output.append(fmt::format("{}", value));
+  }
+}
+
+// Appends value to output as JSON. This replaces a trip through ProtobufWkt::Struct and the
+// protobuf JSON printer for the typed JSON formatter.
+void appendJsonValue(const ProtobufWkt::Value& value, std::string& output) {
+  switch (value.kind_case()) {
+  case ProtobufWkt::Value::kNumberValue:
+    appendJsonNumber(value.number_value(), output);
+    break;
+  case ProtobufWkt::Value::kStringValue:
+    output.push_back('"');
+    appendJsonEscaped(value.string_value(), output);
+    output.push_back('"');
+    break;
+  case ProtobufWkt::Value::kBoolValue:
+    output.append(value.bool_value() ? "true" : "false");
+    break;
+  case ProtobufWkt::Value::kStructValue: {
+    output.push_back('{');
+    bool first = true;
+    for (const auto& field : value.struct_value().fields()) {
+      if (!first) {
+        output.push_back(',');
+      }
+      first = false;
+      output.push_back('"');
+      appendJsonEscaped(field.first, output);
+      output.append("\":");
+      appendJsonValue(field.second, output);
+    }
+    output.push_back('}');
+    break;
+  }
+  case ProtobufWkt::Value::kListValue: {
+    output.push_back('[');
+    bool first = true;
+    for (const auto& element : value.list_value().values()) {
+      if (!first) {
+        output.push_back(',');
+      }
+      first = false;
+      appendJsonValue(element, output);
+    }
+    output.push_back(']');
+    break;
+  }
+  default:
+    output.append("null");
+    break;
+  }
+}
+
 // Matches newline pattern in a StartTimeFormatter format string.
 const std::regex& getStartTimeNewlinePattern() {
   CONSTRUCT_ON_FIRST_USE(std::regex, "%[-_0^#]*[1-9]*n");
@@ -94,19 +303,32 @@ std::string FormatterImpl::format(const Http::HeaderMap& request_headers,
                                   const StreamInfo::StreamInfo& stream_info) const {
   std::string log_line;
   log_line.reserve(256);
+  formatTo(request_headers, response_headers, response_trailers, stream_info, log_line);
+  return log_line;
+}
 
+void FormatterImpl::formatTo(const Http::HeaderMap& request_headers,
+                             const Http::HeaderMap& response_headers,
+                             const Http::HeaderMap& response_trailers,
+                             const StreamInfo::StreamInfo& stream_info, std::string& output) const {
   for (const FormatterProviderPtr& provider : providers_) {
-    log_line += provider->format(request_headers, response_headers, response_trailers, stream_info);
+    provider->formatTo(request_headers, response_headers, response_trailers, stream_info, output);
   }
-
-  return log_line;
 }
 
 JsonFormatterImpl::JsonFormatterImpl(std::unordered_map<std::string, std::string>& format_mapping,
                                      bool preserve_types)
     : preserve_types_(preserve_types) {
-  for (const auto& pair : format_mapping) {
-    json_output_format_.emplace(pair.first, AccessLogFormatParser::parse(pair.second));
+  const std::map<std::string, std::string> sorted_format_mapping(format_mapping.begin(),
+                                                                 format_mapping.end());
+  json_output_format_.reserve(sorted_format_mapping.size());
+  for (const auto& pair : sorted_format_mapping) {
+    JsonField field;
+    field.prefix_ = json_output_format_.empty() ? "\"" : ",\"";
+    appendJsonEscaped(pair.first, field.prefix_);
+    field.prefix_.append("\":");
+    field.providers_ = AccessLogFormatParser::parse(pair.second);
+    json_output_format_.push_back(std::move(field));
   }
 }
 
@@ -114,41 +336,41 @@ std::string JsonFormatterImpl::format(const Http::HeaderMap& request_headers,
                                       const Http::HeaderMap& response_headers,
                                       const Http::HeaderMap& response_trailers,
                                       const StreamInfo::StreamInfo& stream_info) const {
-  const auto output_struct =
-      toStruct(request_headers, response_headers, response_trailers, stream_info);
-
-  std::string log_line = MessageUtil::getJsonStringFromMessage(output_struct, false, true);
-  return absl::StrCat(log_line, "\n");
+  std::string log_line;
+  log_line.reserve(256);
+  formatTo(request_headers, response_headers, response_trailers, stream_info, log_line);
+  return log_line;
 }
 
-ProtobufWkt::Struct JsonFormatterImpl::toStruct(const Http::HeaderMap& request_headers,
-                                                const Http::HeaderMap& response_headers,
-                                                const Http::HeaderMap& response_trailers,
-                                                const StreamInfo::StreamInfo& stream_info) const {
-  ProtobufWkt::Struct output;
-  auto* fields = output.mutable_fields();
-  for (const auto& pair : json_output_format_) {
-    const auto& providers = pair.second;
+void JsonFormatterImpl::formatTo(const Http::HeaderMap& request_headers,
+                                 const Http::HeaderMap& response_headers,
+                                 const Http::HeaderMap& response_trailers,
+                                 const StreamInfo::StreamInfo& stream_info,
+                                 std::string& output) const {
+  output.push_back('{');
+  for (const auto& field : json_output_format_) {
+    const auto& providers = field.providers_;
     ASSERT(providers.size() >= 1);
 
-    if (providers.size() == 1) {
-      const auto& provider = providers.front();
-      auto val = preserve_types_ ? provider->formatValue(request_headers, response_headers,
-                                                         response_trailers, stream_info)
-                                 : stringValue(provider->format(request_headers, response_headers,
-                                                                response_trailers, stream_info));
-
-      (*fields)[pair.first] = val;
+    output.append(field.prefix_);
+    if (preserve_types_ && providers.size() == 1) {
+      appendJsonValue(providers.front()->formatValue(request_headers, response_headers,
+                                                     response_trailers, stream_info),
+                      output);
     } else {
-      // Multiple providers forces string output.
-      std::string str;
+      // Multiple providers forces string output. The providers append straight into the output,
+      // which is escaped afterwards only if needed.
+      output.push_back('"');
+      const size_t start = output.size();
       for (const auto& provider : providers) {
-        str += provider->format(request_headers, response_headers, response_trailers, stream_info);
+        provider->formatTo(request_headers, response_headers, response_trailers, stream_info,
+                           output);
       }
-      (*fields)[pair.first] = stringValue(str);
+      escapeJsonInPlace(output, start);
+      output.push_back('"');
     }
   }
-  return output;
+  output.append("}\n");
 }
 
 void AccessLogFormatParser::parseCommandHeader(const std::string& token, const size_t start,
@@ -329,8 +551,8 @@ public:
   StreamInfoStringFieldExtractor(FieldExtractor f) : field_extractor_(f) {}
 
   // StreamInfoFormatter::FieldExtractor
-  std::string extract(const StreamInfo::StreamInfo& stream_info) const override {
-    return field_extractor_(stream_info);
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    output.append(field_extractor_(stream_info));
   }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     return stringValue(field_extractor_(stream_info));
@@ -348,13 +570,14 @@ public:
   StreamInfoOptionalStringFieldExtractor(FieldExtractor f) : field_extractor_(f) {}
 
   // StreamInfoFormatter::FieldExtractor
-  std::string extract(const StreamInfo::StreamInfo& stream_info) const override {
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
     auto str = field_extractor_(stream_info);
     if (!str) {
-      return UnspecifiedValueString;
+      output.append(UnspecifiedValueString);
+      return;
     }
 
-    return str.value();
+    output.append(str.value());
   }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     auto str = field_extractor_(stream_info);
@@ -378,13 +601,15 @@ public:
   StreamInfoDurationFieldExtractor(FieldExtractor f) : field_extractor_(f) {}
 
   // StreamInfoFormatter::FieldExtractor
-  std::string extract(const StreamInfo::StreamInfo& stream_info) const override {
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
     auto millis = extractMillis(stream_info);
     if (!millis) {
-      return UnspecifiedValueString;
+      output.append(UnspecifiedValueString);
+      return;
     }
 
-    return fmt::format_int(millis.value()).str();
+    const fmt::format_int value(millis.value());
+    output.append(value.data(), value.size());
   }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     auto millis = extractMillis(stream_info);
@@ -415,8 +640,9 @@ public:
   StreamInfoUInt64FieldExtractor(FieldExtractor f) : field_extractor_(f) {}
 
   // StreamInfoFormatter::FieldExtractor
-  std::string extract(const StreamInfo::StreamInfo& stream_info) const override {
-    return fmt::format_int(field_extractor_(stream_info)).str();
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const fmt::format_int value(field_extractor_(stream_info));
+    output.append(value.data(), value.size());
   }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     return numberValue(field_extractor_(stream_info));
@@ -444,13 +670,18 @@ public:
       : field_extractor_(f), include_port_(include_port) {}
 
   // StreamInfoFormatter::FieldExtractor
-  std::string extract(const StreamInfo::StreamInfo& stream_info) const override {
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
     Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
     if (!address) {
-      return UnspecifiedValueString;
+      output.append(UnspecifiedValueString);
+      return;
     }
 
-    return toString(*address);
+    if (include_port_) {
+      output.append(address->asString());
+    } else {
+      output.append(StreamInfo::Utility::formatDownstreamAddressNoPort(*address));
+    }
   }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
@@ -481,17 +712,14 @@ public:
 
   StreamInfoSslConnectionInfoFieldExtractor(FieldExtractor f) : field_extractor_(f) {}
 
-  std::string extract(const StreamInfo::StreamInfo& stream_info) const override {
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
     if (stream_info.downstreamSslConnection() == nullptr) {
-      return UnspecifiedValueString;
+      output.append(UnspecifiedValueString);
+      return;
     }
 
     const auto value = field_extractor_(*stream_info.downstreamSslConnection());
-    if (value.empty()) {
-      return UnspecifiedValueString;
-    }
-
-    return value;
+    output.append(value.empty() ? UnspecifiedValueString : value);
   }
 
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
@@ -721,7 +949,16 @@ StreamInfoFormatter::StreamInfoFormatter(const std::string& field_name) {
 std::string StreamInfoFormatter::format(const Http::HeaderMap&, const Http::HeaderMap&,
                                         const Http::HeaderMap&,
                                         const StreamInfo::StreamInfo& stream_info) const {
-  return field_extractor_->extract(stream_info);
+  std::string value;
+  field_extractor_->extractTo(stream_info, value);
+  return value;
+}
+
+void StreamInfoFormatter::formatTo(const Http::HeaderMap&, const Http::HeaderMap&,
+                                   const Http::HeaderMap&,
+                                   const StreamInfo::StreamInfo& stream_info,
+                                   std::string& output) const {
+  field_extractor_->extractTo(stream_info, output);
 }
 
 ProtobufWkt::Value
@@ -739,6 +976,12 @@ std::string PlainStringFormatter::format(const Http::HeaderMap&, const Http::Hea
   return str_.string_value();
 }
 
+void PlainStringFormatter::formatTo(const Http::HeaderMap&, const Http::HeaderMap&,
+                                    const Http::HeaderMap&, const StreamInfo::StreamInfo&,
+                                    std::string& output) const {
+  output.append(str_.string_value());
+}
+
 ProtobufWkt::Value PlainStringFormatter::formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                                      const Http::HeaderMap&,
                                                      const StreamInfo::StreamInfo&) const {
@@ -771,6 +1014,20 @@ std::string HeaderFormatter::format(const Http::HeaderMap& headers) const {
   return val;
 }
 
+void HeaderFormatter::formatTo(const Http::HeaderMap& headers, std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    output.append(UnspecifiedValueString);
+    return;
+  }
+
+  absl::string_view val = header->value().getStringView();
+  if (max_length_) {
+    val = val.substr(0, max_length_.value());
+  }
+  output.append(val.data(), val.size());
+}
+
 ProtobufWkt::Value HeaderFormatter::formatValue(const Http::HeaderMap& headers) const {
   const Http::HeaderEntry* header = findHeader(headers);
   if (!header) {
@@ -794,6 +1051,13 @@ std::string ResponseHeaderFormatter::format(const Http::HeaderMap&,
   return HeaderFormatter::format(response_headers);
 }
 
+void ResponseHeaderFormatter::formatTo(const Http::HeaderMap&,
+                                       const Http::HeaderMap& response_headers,
+                                       const Http::HeaderMap&, const StreamInfo::StreamInfo&,
+                                       std::string& output) const {
+  HeaderFormatter::formatTo(response_headers, output);
+}
+
 ProtobufWkt::Value ResponseHeaderFormatter::formatValue(const Http::HeaderMap&,
                                                         const Http::HeaderMap& response_headers,
                                                         const Http::HeaderMap&,
@@ -812,6 +1076,12 @@ std::string RequestHeaderFormatter::format(const Http::HeaderMap& request_header
   return HeaderFormatter::format(request_headers);
 }
 
+void RequestHeaderFormatter::formatTo(const Http::HeaderMap& request_headers,
+                                      const Http::HeaderMap&, const Http::HeaderMap&,
+                                      const StreamInfo::StreamInfo&, std::string& output) const {
+  HeaderFormatter::formatTo(request_headers, output);
+}
+
 ProtobufWkt::Value RequestHeaderFormatter::formatValue(const Http::HeaderMap& request_headers,
                                                        const Http::HeaderMap&,
                                                        const Http::HeaderMap&,
@@ -830,6 +1100,12 @@ std::string ResponseTrailerFormatter::format(const Http::HeaderMap&, const Http:
   return HeaderFormatter::format(response_trailers);
 }
 
+void ResponseTrailerFormatter::formatTo(const Http::HeaderMap&, const Http::HeaderMap&,
+                                        const Http::HeaderMap& response_trailers,
+                                        const StreamInfo::StreamInfo&, std::string& output) const {
+  HeaderFormatter::formatTo(response_trailers, output);
+}
+
 ProtobufWkt::Value ResponseTrailerFormatter::formatValue(const Http::HeaderMap&,
                                                          const Http::HeaderMap&,
                                                          const Http::HeaderMap& response_trailers,
@@ -887,6 +1163,13 @@ std::string DynamicMetadataFormatter::format(const Http::HeaderMap&, const Http:
   return MetadataFormatter::formatMetadata(stream_info.dynamicMetadata());
 }
 
+void DynamicMetadataFormatter::formatTo(const Http::HeaderMap&, const Http::HeaderMap&,
+                                        const Http::HeaderMap&,
+                                        const StreamInfo::StreamInfo& stream_info,
+                                        std::string& output) const {
+  output.append(MetadataFormatter::formatMetadata(stream_info.dynamicMetadata()));
+}
+
 ProtobufWkt::Value
 DynamicMetadataFormatter::formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                       const Http::HeaderMap&,
@@ -929,6 +1212,14 @@ std::string FilterStateFormatter::format(const Http::HeaderMap&, const Http::Hea
   return value;
 }
 
+void FilterStateFormatter::formatTo(const Http::HeaderMap& request_headers,
+                                    const Http::HeaderMap& response_headers,
+                                    const Http::HeaderMap& response_trailers,
+                                    const StreamInfo::StreamInfo& stream_info,
+                                    std::string& output) const {
+  output.append(format(request_headers, response_headers, response_trailers, stream_info));
+}
+
 ProtobufWkt::Value
 FilterStateFormatter::formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                   const Http::HeaderMap&,
@@ -959,6 +1250,16 @@ std::string StartTimeFormatter::format(const Http::HeaderMap&, const Http::Heade
   }
 }
 
+void StartTimeFormatter::formatTo(const Http::HeaderMap&, const Http::HeaderMap&,
+                                  const Http::HeaderMap&, const StreamInfo::StreamInfo& stream_info,
+                                  std::string& output) const {
+  if (date_formatter_.formatString().empty()) {
+    AccessLogDateTimeFormatter::appendTime(stream_info.startTime(), output);
+  } else {
+    date_formatter_.appendTime(stream_info.startTime(), output);
+  }
+}
+
 ProtobufWkt::Value StartTimeFormatter::formatValue(
     const Http::HeaderMap& request_headers, const Http::HeaderMap& response_headers,
     const Http::HeaderMap& response_trailers, const StreamInfo::StreamInfo& stream_info) const {
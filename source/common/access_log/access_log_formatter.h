@@ -93,6 +93,9 @@ public:
                      const Http::HeaderMap& response_headers,
                      const Http::HeaderMap& response_trailers,
                      const StreamInfo::StreamInfo& stream_info) const override;
+  void formatTo(const Http::HeaderMap& request_headers, const Http::HeaderMap& response_headers,
+                const Http::HeaderMap& response_trailers, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
 
 private:
   std::vector<FormatterProviderPtr> providers_;
@@ -108,15 +111,22 @@ public:
                      const Http::HeaderMap& response_headers,
                      const Http::HeaderMap& response_trailers,
                      const StreamInfo::StreamInfo& stream_info) const override;
+  void formatTo(const Http::HeaderMap& request_headers, const Http::HeaderMap& response_headers,
+                const Http::HeaderMap& response_trailers, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
 
 private:
-  const bool preserve_types_;
-  std::map<const std::string, const std::vector<FormatterProviderPtr>> json_output_format_;
+  // A single key of the JSON object, compiled at construction time.
+  struct JsonField {
+    // The escaped key with its quotes, the ':' separator and the leading ',' for every field but
+    // the first, e.g. ,"key":
+    std::string prefix_;
+    std::vector<FormatterProviderPtr> providers_;
+  };
 
-  ProtobufWkt::Struct toStruct(const Http::HeaderMap& request_headers,
-                               const Http::HeaderMap& response_headers,
-                               const Http::HeaderMap& response_trailers,
-                               const StreamInfo::StreamInfo& stream_info) const;
+  const bool preserve_types_;
+  // Sorted by key, so that the key order of the output is stable.
+  std::vector<JsonField> json_output_format_;
 };
 
 /**
@@ -130,6 +140,8 @@ public:
   // FormatterProvider
   std::string format(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
                      const StreamInfo::StreamInfo&) const override;
+  void formatTo(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
+                const StreamInfo::StreamInfo&, std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                  const Http::HeaderMap&,
                                  const StreamInfo::StreamInfo&) const override;
@@ -148,6 +160,7 @@ public:
 
 protected:
   std::string format(const Http::HeaderMap& headers) const;
+  void formatTo(const Http::HeaderMap& headers, std::string& output) const;
   ProtobufWkt::Value formatValue(const Http::HeaderMap& headers) const;
 
 private:
@@ -169,6 +182,9 @@ public:
   // FormatterProvider
   std::string format(const Http::HeaderMap& request_headers, const Http::HeaderMap&,
                      const Http::HeaderMap&, const StreamInfo::StreamInfo&) const override;
+  void formatTo(const Http::HeaderMap& request_headers, const Http::HeaderMap&,
+                const Http::HeaderMap&, const StreamInfo::StreamInfo&,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                  const Http::HeaderMap&,
                                  const StreamInfo::StreamInfo&) const override;
@@ -185,6 +201,9 @@ public:
   // FormatterProvider
   std::string format(const Http::HeaderMap&, const Http::HeaderMap& response_headers,
                      const Http::HeaderMap&, const StreamInfo::StreamInfo&) const override;
+  void formatTo(const Http::HeaderMap&, const Http::HeaderMap& response_headers,
+                const Http::HeaderMap&, const StreamInfo::StreamInfo&,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                  const Http::HeaderMap&,
                                  const StreamInfo::StreamInfo&) const override;
@@ -202,6 +221,9 @@ public:
   std::string format(const Http::HeaderMap&, const Http::HeaderMap&,
                      const Http::HeaderMap& response_trailers,
                      const StreamInfo::StreamInfo&) const override;
+  void formatTo(const Http::HeaderMap&, const Http::HeaderMap&,
+                const Http::HeaderMap& response_trailers, const StreamInfo::StreamInfo&,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                  const Http::HeaderMap&,
                                  const StreamInfo::StreamInfo&) const override;
@@ -217,6 +239,8 @@ public:
   // FormatterProvider
   std::string format(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
                      const StreamInfo::StreamInfo&) const override;
+  void formatTo(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
+                const StreamInfo::StreamInfo&, std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                  const Http::HeaderMap&,
                                  const StreamInfo::StreamInfo&) const override;
@@ -225,7 +249,7 @@ public:
   public:
     virtual ~FieldExtractor() = default;
 
-    virtual std::string extract(const StreamInfo::StreamInfo&) const PURE;
+    virtual void extractTo(const StreamInfo::StreamInfo&, std::string& output) const PURE;
     virtual ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo&) const PURE;
   };
   using FieldExtractorPtr = std::unique_ptr<FieldExtractor>;
@@ -263,6 +287,8 @@ public:
   // FormatterProvider
   std::string format(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
                      const StreamInfo::StreamInfo&) const override;
+  void formatTo(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
+                const StreamInfo::StreamInfo&, std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                  const Http::HeaderMap&,
                                  const StreamInfo::StreamInfo&) const override;
@@ -278,6 +304,8 @@ public:
   // FormatterProvider
   std::string format(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
                      const StreamInfo::StreamInfo&) const override;
+  void formatTo(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
+                const StreamInfo::StreamInfo&, std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                  const Http::HeaderMap&,
                                  const StreamInfo::StreamInfo&) const override;
@@ -299,6 +327,8 @@ public:
   // FormatterProvider
   std::string format(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
                      const StreamInfo::StreamInfo&) const override;
+  void formatTo(const Http::HeaderMap&, const Http::HeaderMap&, const Http::HeaderMap&,
+                const StreamInfo::StreamInfo&, std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::HeaderMap&, const Http::HeaderMap&,
                                  const Http::HeaderMap&,
                                  const StreamInfo::StreamInfo&) const override;
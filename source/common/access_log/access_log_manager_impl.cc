@@ -1,12 +1,16 @@
 #include "common/access_log/access_log_manager_impl.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "common/common/assert.h"
 #include "common/common/fmt.h"
 #include "common/common/lock_guard.h"
 #include "common/common/stack_array.h"
 
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace AccessLog {
 
@@ -21,6 +25,16 @@ AccessLogFileSharedPtr AccessLogManagerImpl::createAccessLog(const std::string&
     return access_logs_[file_name];
   }
 
+  if (shared_flush_thread_) {
+    if (flusher_ == nullptr) {
+      flusher_ = std::make_shared<AccessLogFlusher>(api_.threadFactory(),
+                                                    file_flush_interval_msec_, file_stats_);
+    }
+    access_logs_[file_name] = std::make_shared<SharedFlushAccessLogFileImpl>(
+        api_.fileSystem().createFile(file_name), lock_, file_stats_, flusher_);
+    return access_logs_[file_name];
+  }
+
   access_logs_[file_name] = std::make_shared<AccessLogFileImpl>(
       api_.fileSystem().createFile(file_name), dispatcher_, lock_, file_stats_,
       file_flush_interval_msec_, api_.threadFactory());
@@ -200,5 +214,241 @@ void AccessLogFileImpl::createFlushStructures() {
   flush_timer_->enableTimer(flush_interval_msec_);
 }
 
+AccessLogRing::AccessLogRing(uint64_t capacity)
+    : mask_(capacity - 1), slots_(new Slot[capacity]) {
+  ASSERT(capacity > 0 && (capacity & mask_) == 0);
+  for (uint64_t i = 0; i < capacity; i++) {
+    slots_[i].sequence_.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool AccessLogRing::push(absl::string_view data) {
+  uint64_t position = write_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Slot& slot = slots_[position & mask_];
+    const uint64_t sequence = slot.sequence_.load(std::memory_order_acquire);
+    const int64_t lag = static_cast<int64_t>(sequence - position);
+    if (lag == 0) {
+      // The slot is free for this position. Claim it, or retry from the position another writer
+      // moved write_position_ to.
+      if (write_position_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+        slot.data_.assign(data.data(), data.size());
+        slot.sequence_.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (lag < 0) {
+      // The slot still holds the line written one lap ago: the ring is full.
+      return false;
+    } else {
+      position = write_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+uint64_t AccessLogRing::peek(absl::string_view* lines, uint64_t max_lines) {
+  const uint64_t position = read_position_.load(std::memory_order_relaxed);
+  uint64_t num_lines = 0;
+  // Stop at the first slot that isn't complete yet, so lines are always read in order.
+  for (; num_lines < max_lines && num_lines <= mask_; num_lines++) {
+    const Slot& slot = slots_[(position + num_lines) & mask_];
+    if (slot.sequence_.load(std::memory_order_acquire) != position + num_lines + 1) {
+      break;
+    }
+    lines[num_lines] = slot.data_;
+  }
+  return num_lines;
+}
+
+void AccessLogRing::pop(uint64_t num_lines) {
+  const uint64_t position = read_position_.load(std::memory_order_relaxed);
+  for (uint64_t i = 0; i < num_lines; i++) {
+    // Hand the slot to the writer one lap ahead.
+    slots_[(position + i) & mask_].sequence_.store(position + i + mask_ + 1,
+                                                   std::memory_order_release);
+  }
+  read_position_.store(position + num_lines, std::memory_order_relaxed);
+}
+
+uint64_t AccessLogRing::size() const {
+  const uint64_t read_position = read_position_.load(std::memory_order_relaxed);
+  const uint64_t write_position = write_position_.load(std::memory_order_relaxed);
+  return write_position > read_position ? write_position - read_position : 0;
+}
+
+AccessLogFlusher::AccessLogFlusher(Thread::ThreadFactory& thread_factory,
+                                   std::chrono::milliseconds flush_interval_msec,
+                                   AccessLogFileStats& stats)
+    : flush_interval_msec_(flush_interval_msec), stats_(stats),
+      flush_thread_(thread_factory.createThread([this]() -> void { flushThreadFunc(); })) {}
+
+AccessLogFlusher::~AccessLogFlusher() {
+  {
+    Thread::LockGuard lock(lock_);
+    ASSERT(files_.empty());
+    exit_ = true;
+    flush_event_.notifyOne();
+  }
+  flush_thread_->join();
+}
+
+void AccessLogFlusher::registerFile(SharedFlushAccessLogFileImpl& file) {
+  Thread::LockGuard lock(lock_);
+  files_.push_back(&file);
+}
+
+void AccessLogFlusher::unregisterFile(SharedFlushAccessLogFileImpl& file) {
+  Thread::LockGuard lock(lock_);
+  files_.remove(&file);
+  // Waits for the flush thread to finish with the file if it is draining it.
+  while (flushing_ == &file) {
+    flushed_event_.wait(lock_);
+  }
+}
+
+void AccessLogFlusher::wakeup() {
+  if (!wakeup_pending_.exchange(true)) {
+    flush_event_.notifyOne();
+  }
+}
+
+void AccessLogFlusher::flushThreadFunc() {
+  std::vector<SharedFlushAccessLogFileImpl*> files;
+  while (true) {
+    {
+      Thread::LockGuard lock(lock_);
+      if (!exit_ && !wakeup_pending_.load()) {
+        if (flush_event_.waitFor(lock_, flush_interval_msec_) ==
+            Thread::CondVar::WaitStatus::Timeout) {
+          stats_.flushed_by_timer_.inc();
+        }
+      }
+      if (exit_) {
+        return;
+      }
+      wakeup_pending_ = false;
+      files.assign(files_.begin(), files_.end());
+    }
+
+    // Files are drained without holding lock_, so that a slow disk doesn't hold up the main thread
+    // registering and unregistering files. Only unregistering the file being drained waits.
+    for (SharedFlushAccessLogFileImpl* file : files) {
+      {
+        Thread::LockGuard lock(lock_);
+        if (std::find(files_.begin(), files_.end(), file) == files_.end()) {
+          // Unregistered since the pass started.
+          continue;
+        }
+        flushing_ = file;
+      }
+      file->drain();
+      {
+        Thread::LockGuard lock(lock_);
+        flushing_ = nullptr;
+        flushed_event_.notifyAll();
+      }
+    }
+  }
+}
+
+SharedFlushAccessLogFileImpl::SharedFlushAccessLogFileImpl(Filesystem::FilePtr&& file,
+                                                           Thread::BasicLockable& lock,
+                                                           AccessLogFileStats& stats,
+                                                           AccessLogFlusherSharedPtr flusher)
+    : file_(std::move(file)), file_lock_(lock), ring_(RING_CAPACITY), stats_(stats),
+      flusher_(std::move(flusher)) {
+  open();
+  flusher_->registerFile(*this);
+}
+
+SharedFlushAccessLogFileImpl::~SharedFlushAccessLogFileImpl() {
+  flusher_->unregisterFile(*this);
+  drain();
+
+  if (file_->isOpen()) {
+    const Api::IoCallBoolResult result = file_->close();
+    ASSERT(result.rc_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                   result.err_->getErrorDetails()));
+  }
+}
+
+void SharedFlushAccessLogFileImpl::open() {
+  const Api::IoCallBoolResult result = file_->open(AccessLogFileImpl::defaultFlags());
+  if (!result.rc_) {
+    throw EnvoyException(
+        fmt::format("unable to open file '{}': {}", file_->path(), result.err_->getErrorDetails()));
+  }
+}
+
+void SharedFlushAccessLogFileImpl::write(absl::string_view data) {
+  stats_.write_buffered_.inc();
+  if (!ring_.push(data)) {
+    stats_.write_dropped_.inc();
+    return;
+  }
+  stats_.write_total_buffered_.add(data.size());
+
+  const uint64_t buffered_bytes = buffered_bytes_.fetch_add(data.size()) + data.size();
+  if (ring_.size() > ring_.capacity() / 2) {
+    // The flush thread isn't keeping up, most likely because the disk is slow.
+    stats_.write_backpressure_.inc();
+    flusher_->wakeup();
+  } else if (buffered_bytes > MIN_FLUSH_SIZE) {
+    flusher_->wakeup();
+  }
+}
+
+void SharedFlushAccessLogFileImpl::reopen() { reopen_file_ = true; }
+
+void SharedFlushAccessLogFileImpl::flush() { flusher_->wakeup(); }
+
+void SharedFlushAccessLogFileImpl::drain() {
+  Thread::LockGuard drain_lock(drain_lock_);
+
+  if (reopen_file_ && file_->isOpen()) {
+    reopen_file_ = false;
+    const Api::IoCallBoolResult result = file_->close();
+    ASSERT(result.rc_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                   result.err_->getErrorDetails()));
+    try {
+      open();
+    } catch (const EnvoyException&) {
+      stats_.reopen_failed_.inc();
+    }
+  }
+
+  // Bound a single drain to one ring's worth of lines, so that a busy file can't keep the flush
+  // thread from the other files.
+  STACK_ARRAY(lines, absl::string_view, MAX_LINES_PER_WRITE);
+  for (uint64_t drained = 0; drained < ring_.capacity();) {
+    const uint64_t num_lines = ring_.peek(lines.begin(), MAX_LINES_PER_WRITE);
+    if (num_lines == 0) {
+      break;
+    }
+
+    uint64_t num_bytes = 0;
+    for (uint64_t i = 0; i < num_lines; i++) {
+      num_bytes += lines[i].size();
+    }
+
+    // If the file failed to reopen the lines are discarded, as with AccessLogFileImpl.
+    if (file_->isOpen()) {
+      Thread::LockGuard lock(file_lock_);
+      const Api::IoCallSizeResult result = file_->writev(lines.begin(), num_lines);
+      if (result.ok() && result.rc_ == static_cast<ssize_t>(num_bytes)) {
+        stats_.write_completed_.inc();
+      } else {
+        // Probably disk full.
+        stats_.write_failed_.inc();
+      }
+    }
+
+    ring_.pop(num_lines);
+    buffered_bytes_ -= num_bytes;
+    stats_.write_total_buffered_.sub(num_bytes);
+    drained += num_lines;
+  }
+}
+
 } // namespace AccessLog
 } // namespace Envoy
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -18,8 +21,10 @@ namespace Envoy {
 #define ACCESS_LOG_FILE_STATS(COUNTER, GAUGE)                                                      \
   COUNTER(flushed_by_timer)                                                                        \
   COUNTER(reopen_failed)                                                                           \
+  COUNTER(write_backpressure)                                                                      \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -29,15 +34,24 @@ struct AccessLogFileStats {
 
 namespace AccessLog {
 
+class AccessLogFlusher;
+class SharedFlushAccessLogFileImpl;
+using AccessLogFlusherSharedPtr = std::shared_ptr<AccessLogFlusher>;
+
 class AccessLogManagerImpl : public AccessLogManager {
 public:
+  /**
+   * @param shared_flush_thread if true, all files are flushed by a single thread and workers
+   *        stage log lines in lock-free rings. See SharedFlushAccessLogFileImpl.
+   */
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
                        Event::Dispatcher& dispatcher, Thread::BasicLockable& lock,
-                       Stats::Store& stats_store)
+                       Stats::Store& stats_store, bool shared_flush_thread = false)
       : file_flush_interval_msec_(file_flush_interval_msec), api_(api), dispatcher_(dispatcher),
         lock_(lock), file_stats_{
                          ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
-                                               POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
+                                               POOL_GAUGE_PREFIX(stats_store, "filesystem."))},
+        shared_flush_thread_(shared_flush_thread) {}
 
   // AccessLog::AccessLogManager
   void reopen() override;
@@ -49,6 +63,10 @@ private:
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
   AccessLogFileStats file_stats_;
+  const bool shared_flush_thread_;
+  // Created with the first file when shared_flush_thread_ is set. Files keep it alive, since they
+  // may outlive the manager.
+  AccessLogFlusherSharedPtr flusher_;
   std::unordered_map<std::string, AccessLogFileSharedPtr> access_logs_;
 };
 
@@ -78,15 +96,15 @@ public:
   void reopen() override;
   void flush() override;
 
+  // return default flags set which used by open
+  static Filesystem::FlagSet defaultFlags();
+
 private:
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
   void open();
   void createFlushStructures();
 
-  // return default flags set which used by open
-  static Filesystem::FlagSet defaultFlags();
-
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
 
@@ -133,5 +151,146 @@ private:
   AccessLogFileStats& stats_;
 };
 
+/**
+ * A bounded ring of log lines with any number of writers and a single reader. It follows the
+ * per-slot sequence number scheme of Dmitry Vyukov's bounded MPMC queue, so writers never take a
+ * lock and never wait: push() fails when the ring is full. Slots keep the capacity of their
+ * strings, so a steady stream of similarly sized lines doesn't allocate.
+ */
+class AccessLogRing {
+public:
+  /**
+   * @param capacity the number of lines the ring holds. Must be a power of two.
+   */
+  explicit AccessLogRing(uint64_t capacity);
+
+  /**
+   * Copy a line into the ring. May be called from any thread.
+   * @return false if the ring is full and the line was dropped.
+   */
+  bool push(absl::string_view data);
+
+  /**
+   * Get views of the lines at the head of the ring without removing them. Only the reader may
+   * call this.
+   * @param lines receives up to max_lines views, valid until the next pop().
+   * @return the number of views stored in lines.
+   */
+  uint64_t peek(absl::string_view* lines, uint64_t max_lines);
+
+  /**
+   * Remove lines returned by the last peek() from the head of the ring. Only the reader may call
+   * this.
+   */
+  void pop(uint64_t num_lines);
+
+  /**
+   * @return an approximation of the number of lines in the ring.
+   */
+  uint64_t size() const;
+
+  uint64_t capacity() const { return mask_ + 1; }
+
+private:
+  struct Slot {
+    // Equals the write position the slot is free for, or that position + 1 once it holds a line.
+    std::atomic<uint64_t> sequence_;
+    std::string data_;
+  };
+
+  const uint64_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> write_position_{};
+  std::atomic<uint64_t> read_position_{};
+};
+
+/**
+ * Flushes every SharedFlushAccessLogFileImpl of a process from one thread. The thread wakes up
+ * when a file has enough data buffered, and otherwise every flush interval.
+ */
+class AccessLogFlusher {
+public:
+  AccessLogFlusher(Thread::ThreadFactory& thread_factory,
+                   std::chrono::milliseconds flush_interval_msec, AccessLogFileStats& stats);
+  ~AccessLogFlusher();
+
+  void registerFile(SharedFlushAccessLogFileImpl& file);
+
+  /**
+   * Stop flushing a file. Once this returns the flush thread no longer uses the file.
+   */
+  void unregisterFile(SharedFlushAccessLogFileImpl& file);
+
+  /**
+   * Ask the flush thread to run a pass now. Never blocks, so it is safe on worker threads.
+   */
+  void wakeup();
+
+private:
+  void flushThreadFunc();
+
+  const std::chrono::milliseconds flush_interval_msec_;
+  AccessLogFileStats& stats_;
+  Thread::MutexBasicLockable lock_;
+  Thread::CondVar flush_event_;
+  std::list<SharedFlushAccessLogFileImpl*> files_ ABSL_GUARDED_BY(lock_);
+  // The file the flush thread is draining, if any. unregisterFile() waits on flushed_event_ for
+  // it to be done with the file.
+  SharedFlushAccessLogFileImpl* flushing_ ABSL_GUARDED_BY(lock_){};
+  Thread::CondVar flushed_event_;
+  bool exit_ ABSL_GUARDED_BY(lock_){};
+  // Set by wakeup(). Workers don't take lock_, so a wakeup that races with the flush thread going
+  // to sleep can be missed; the flush interval bounds the delay in that case.
+  std::atomic<bool> wakeup_pending_{};
+  Thread::ThreadPtr flush_thread_;
+};
+
+/**
+ * An access log file for the shared flush thread mode. Writers copy lines into a lock-free ring
+ * and never touch the disk or contend on a mutex. The AccessLogFlusher drains the ring, handing
+ * many lines to the kernel with a single writev(). If the disk stalls and the ring fills up, new
+ * lines are dropped and counted rather than blocking workers.
+ */
+class SharedFlushAccessLogFileImpl : public AccessLogFile {
+public:
+  SharedFlushAccessLogFileImpl(Filesystem::FilePtr&& file, Thread::BasicLockable& lock,
+                               AccessLogFileStats& stats, AccessLogFlusherSharedPtr flusher);
+  ~SharedFlushAccessLogFileImpl() override;
+
+  // AccessLog::AccessLogFile
+  void write(absl::string_view data) override;
+  void reopen() override;
+  // Wakes the flush thread up rather than writing on the calling thread.
+  void flush() override;
+
+  /**
+   * Write the buffered lines to disk, reopening the file first if needed. Called by the flush
+   * thread, and once more when the file is destroyed.
+   */
+  void drain();
+
+private:
+  void open();
+
+  // Lines buffered per file. At most this many lines are dropped when a disk stalls.
+  static constexpr uint64_t RING_CAPACITY = 1024 * 16;
+  // Lines handed to a single writev(), which is limited to IOV_MAX (1024 on Linux) buffers.
+  static constexpr uint64_t MAX_LINES_PER_WRITE = 1024;
+  // Minimum buffered size before the flush thread is woken up early.
+  static constexpr uint64_t MIN_FLUSH_SIZE = 1024 * 64;
+
+  Filesystem::FilePtr file_;
+  // Serializes disk writes with other processes writing the same file during hot restart. See
+  // AccessLogFileImpl::file_lock_.
+  Thread::BasicLockable& file_lock_;
+  // Makes drain() single reader; writers never take it.
+  Thread::MutexBasicLockable drain_lock_;
+  AccessLogRing ring_;
+  std::atomic<uint64_t> buffered_bytes_{};
+  std::atomic<bool> reopen_file_{};
+  AccessLogFileStats& stats_;
+  const AccessLogFlusherSharedPtr flusher_;
+};
+
 } // namespace AccessLog
 } // namespace Envoy
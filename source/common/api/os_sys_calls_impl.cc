@@ -50,6 +50,82 @@ SysCallSizeResult OsSysCallsImpl::recvmsg(int sockfd, struct msghdr* msg, int fl
   return {rc, errno};
 }
 
+SysCallIntResult OsSysCallsImpl::recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                                          int flags, struct timespec* timeout) {
+#if defined(__linux__)
+  const int rc = ::recvmmsg(sockfd, msgvec, vlen, flags, timeout);
+  return {rc, errno};
+#else
+  static_cast<void>(sockfd);
+  static_cast<void>(msgvec);
+  static_cast<void>(vlen);
+  static_cast<void>(flags);
+  static_cast<void>(timeout);
+  return {-1, ENOSYS};
+#endif
+}
+
+SysCallIntResult OsSysCallsImpl::sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                                          int flags) {
+#if defined(__linux__)
+  const int rc = ::sendmmsg(sockfd, msgvec, vlen, flags);
+  return {rc, errno};
+#else
+  static_cast<void>(sockfd);
+  static_cast<void>(msgvec);
+  static_cast<void>(vlen);
+  static_cast<void>(flags);
+  return {-1, ENOSYS};
+#endif
+}
+
+bool OsSysCallsImpl::supportsMmsg() const {
+#if defined(__linux__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if defined(__linux__)
+namespace {
+
+// Probes a UDP socket option on a throwaway socket, since support depends on the running kernel
+// rather than on the headers Envoy was built with.
+bool udpSocketOptionSupported(int optname, bool set) {
+  const int fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (fd < 0) {
+    return false;
+  }
+  int value = set ? 1 : 0;
+  socklen_t length = sizeof(value);
+  const int rc = set ? ::setsockopt(fd, SOL_UDP, optname, &value, length)
+                     : ::getsockopt(fd, SOL_UDP, optname, &value, &length);
+  ::close(fd);
+  return rc == 0;
+}
+
+} // namespace
+#endif
+
+bool OsSysCallsImpl::supportsUdpGro() const {
+#if defined(__linux__)
+  static const bool is_supported = udpSocketOptionSupported(UDP_GRO, true);
+  return is_supported;
+#else
+  return false;
+#endif
+}
+
+bool OsSysCallsImpl::supportsUdpGso() const {
+#if defined(__linux__)
+  static const bool is_supported = udpSocketOptionSupported(UDP_SEGMENT, false);
+  return is_supported;
+#else
+  return false;
+#endif
+}
+
 SysCallIntResult OsSysCallsImpl::ftruncate(int fd, off_t length) {
   const int rc = ::ftruncate(fd, length);
   return {rc, errno};
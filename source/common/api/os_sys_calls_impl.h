@@ -19,6 +19,13 @@ public:
   SysCallSizeResult readv(int fd, const iovec* iovec, int num_iovec) override;
   SysCallSizeResult recv(int socket, void* buffer, size_t length, int flags) override;
   SysCallSizeResult recvmsg(int sockfd, struct msghdr* msg, int flags) override;
+  SysCallIntResult recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags,
+                            struct timespec* timeout) override;
+  SysCallIntResult sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                            int flags) override;
+  bool supportsMmsg() const override;
+  bool supportsUdpGro() const override;
+  bool supportsUdpGso() const override;
   SysCallIntResult close(int fd) override;
   SysCallIntResult ftruncate(int fd, off_t length) override;
   SysCallPtrResult mmap(void* addr, size_t length, int prot, int flags, int fd,
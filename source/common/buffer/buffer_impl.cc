@@ -150,6 +150,27 @@ void OwnedImpl::drain(uint64_t size) {
   }
 }
 
+SliceDataPtr OwnedImpl::extractFrontSlice() {
+  RELEASE_ASSERT(length_ > 0, "Extract called on empty buffer");
+  // Skip the empty slices at the front, so that the extracted slice has data.
+  while (slices_.front()->dataSize() == 0) {
+    slices_.pop_front();
+  }
+  SliceDataPtr slice = std::move(slices_.front());
+  slices_.pop_front();
+  length_ -= slice->getData().size();
+  return slice;
+}
+
+RawSlice OwnedImpl::frontSlice() const {
+  for (const auto& slice : slices_) {
+    if (slice->dataSize() > 0) {
+      return {slice->data(), static_cast<size_t>(slice->dataSize())};
+    }
+  }
+  return {};
+}
+
 uint64_t OwnedImpl::getRawSlices(RawSlice* out, uint64_t out_size) const {
   uint64_t num_slices = 0;
   for (const auto& slice : slices_) {
@@ -8,6 +8,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/network/io_handle.h"
 
+#include "common/buffer/slice_pool.h"
 #include "common/common/assert.h"
 #include "common/common/non_copyable.h"
 #include "common/common/utility.h"
@@ -31,11 +32,15 @@ namespace Buffer {
  *                   |
  *                   data()
  */
-class Slice {
+class Slice : public SliceData {
 public:
   using Reservation = RawSlice;
 
-  virtual ~Slice() = default;
+  ~Slice() override = default;
+
+  // SliceData
+  absl::Span<const uint8_t> getData() const override { return {data(), dataSize()}; }
+  uint64_t getCapacity() const override { return capacity_; }
 
   /**
    * @return a pointer to the start of the usable content.
@@ -196,6 +201,10 @@ using SlicePtr = std::unique_ptr<Slice>;
 // OwnedSlice can not be derived from as it has variable sized array as member.
 class OwnedSlice final : public Slice, public InlineStorage {
 public:
+  // Storage for OwnedSlices comes from the thread-local SlicePool. These hide the
+  // InlineStorage operators, which go directly to the heap.
+  static void operator delete(void* address) { SlicePool::deallocate(address); }
+
   /**
    * Create an empty OwnedSlice.
    * @param capacity number of bytes of space the slice should have.
@@ -222,17 +231,24 @@ public:
   }
 
 private:
+  static void* operator new(size_t object_size, size_t data_size_bytes) {
+    return SlicePool::allocate(object_size + data_size_bytes);
+  }
+
   OwnedSlice(uint64_t size) : Slice(0, 0, size) { base_ = storage_; }
 
   /**
-   * Compute a slice size big enough to hold a specified amount of data.
+   * Compute a slice size big enough to hold a specified amount of data. The result is chosen so
+   * that the slice, together with the SlicePool block header, fills a whole number of pages and
+   * therefore maps onto one of the pool's size classes.
    * @param data_size the minimum amount of data the slice must be able to store, in bytes.
    * @return a recommended slice size, in bytes.
    */
   static uint64_t sliceSize(uint64_t data_size) {
-    static constexpr uint64_t PageSize = 4096;
-    const uint64_t num_pages = (sizeof(OwnedSlice) + data_size + PageSize - 1) / PageSize;
-    return num_pages * PageSize - sizeof(OwnedSlice);
+    static constexpr uint64_t PageSize = SlicePool::PageSize;
+    static constexpr uint64_t Overhead = sizeof(OwnedSlice) + SlicePool::HeaderSize;
+    const uint64_t num_pages = (Overhead + data_size + PageSize - 1) / PageSize;
+    return num_pages * PageSize - Overhead;
   }
 
   uint8_t storage_[];
@@ -493,6 +509,8 @@ public:
   void commit(RawSlice* iovecs, uint64_t num_iovecs) override;
   void copyOut(size_t start, uint64_t size, void* data) const override;
   void drain(uint64_t size) override;
+  SliceDataPtr extractFrontSlice() override;
+  RawSlice frontSlice() const override;
   uint64_t getRawSlices(RawSlice* out, uint64_t out_size) const override;
   uint64_t length() const override;
   void* linearize(uint32_t size) override;
@@ -0,0 +1,210 @@
+#include "common/buffer/slice_pool.h"
+
+#include <list>
+#include <new>
+#include <vector>
+
+#include "common/common/assert.h"
+#include "common/common/lock_guard.h"
+#include "common/common/macros.h"
+#include "common/common/thread.h"
+
+namespace Envoy {
+namespace Buffer {
+
+namespace {
+
+// Size class stored in the header of blocks that did not come from a poolable size.
+constexpr uint64_t UnpooledSizeClass = 0;
+
+struct BlockHeader {
+  // Number of pages in the block including the header, or UnpooledSizeClass.
+  uint64_t num_pages_;
+};
+static_assert(sizeof(BlockHeader) <= SlicePool::HeaderSize, "BlockHeader too large");
+
+class ThreadCache;
+
+/**
+ * Tracks the live thread caches so that stats() can sum over them, and accumulates the counters
+ * of threads that have already exited.
+ */
+struct CacheRegistry {
+  Thread::MutexBasicLockable mutex_;
+  std::list<ThreadCache*> caches_ ABSL_GUARDED_BY(mutex_);
+  uint64_t retired_hits_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t retired_misses_ ABSL_GUARDED_BY(mutex_){};
+};
+
+CacheRegistry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(CacheRegistry); }
+
+/**
+ * Per-thread freelists. The counters are atomics only so that stats() can read them from another
+ * thread; they are written exclusively by the owning thread, so relaxed load/store pairs are used
+ * instead of read-modify-write operations.
+ */
+class ThreadCache {
+public:
+  ThreadCache() {
+    CacheRegistry& reg = registry();
+    Thread::LockGuard lock(reg.mutex_);
+    reg.caches_.push_back(this);
+  }
+
+  ~ThreadCache() {
+    releaseAll();
+    CacheRegistry& reg = registry();
+    Thread::LockGuard lock(reg.mutex_);
+    reg.caches_.remove(this);
+    reg.retired_hits_ += hits_.load(std::memory_order_relaxed);
+    reg.retired_misses_ += misses_.load(std::memory_order_relaxed);
+  }
+
+  void* pop(uint64_t num_pages) {
+    std::vector<void*>& freelist = freelists_[num_pages - 1];
+    if (freelist.empty()) {
+      bump(misses_);
+      return nullptr;
+    }
+    void* block = freelist.back();
+    freelist.pop_back();
+    subtractCachedBytes(num_pages * SlicePool::PageSize);
+    bump(hits_);
+    return block;
+  }
+
+  bool push(void* block, uint64_t num_pages) {
+    const uint64_t block_size = num_pages * SlicePool::PageSize;
+    const uint64_t max_bytes = SlicePool::maxCachedBytesPerThread();
+    const uint64_t cached = cached_bytes_.load(std::memory_order_relaxed);
+    if (cached > max_bytes) {
+      // The limit was lowered since these blocks were cached.
+      trim(max_bytes);
+    }
+    if (cached_bytes_.load(std::memory_order_relaxed) + block_size > max_bytes) {
+      return false;
+    }
+    freelists_[num_pages - 1].push_back(block);
+    cached_bytes_.store(cached_bytes_.load(std::memory_order_relaxed) + block_size,
+                        std::memory_order_relaxed);
+    return true;
+  }
+
+  void releaseAll() { trim(0); }
+
+  uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+  uint64_t cachedBytes() const { return cached_bytes_.load(std::memory_order_relaxed); }
+
+private:
+  static void bump(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  void subtractCachedBytes(uint64_t size) {
+    cached_bytes_.store(cached_bytes_.load(std::memory_order_relaxed) - size,
+                        std::memory_order_relaxed);
+  }
+
+  // Free cached blocks, largest size class first, until at most max_bytes remain.
+  void trim(uint64_t max_bytes) {
+    for (uint64_t i = SlicePool::MaxPooledPages; i > 0; i--) {
+      std::vector<void*>& freelist = freelists_[i - 1];
+      while (!freelist.empty() && cached_bytes_.load(std::memory_order_relaxed) > max_bytes) {
+        ::operator delete(freelist.back());
+        freelist.pop_back();
+        subtractCachedBytes(i * SlicePool::PageSize);
+      }
+    }
+  }
+
+  std::vector<void*> freelists_[SlicePool::MaxPooledPages];
+  std::atomic<uint64_t> hits_{};
+  std::atomic<uint64_t> misses_{};
+  std::atomic<uint64_t> cached_bytes_{};
+};
+
+// Set to false once the calling thread's cache has been destroyed, so that buffers destroyed later
+// in thread teardown fall back to the heap rather than touching a dead thread_local. This must be
+// trivially destructible for that check to be valid.
+thread_local bool thread_cache_alive = true;
+
+struct ThreadCacheHolder {
+  ~ThreadCacheHolder() { thread_cache_alive = false; }
+  ThreadCache cache_;
+};
+
+ThreadCache* threadCache() {
+  if (!thread_cache_alive) {
+    return nullptr;
+  }
+  static thread_local ThreadCacheHolder holder;
+  return &holder.cache_;
+}
+
+} // namespace
+
+std::atomic<uint64_t> SlicePool::max_cached_bytes_per_thread_{DefaultMaxCachedBytesPerThread};
+
+void* SlicePool::allocate(uint64_t size) {
+  const uint64_t total_size = size + HeaderSize;
+  uint64_t num_pages = UnpooledSizeClass;
+  void* block = nullptr;
+  if (total_size % PageSize == 0 && total_size / PageSize <= MaxPooledPages) {
+    num_pages = total_size / PageSize;
+    ThreadCache* cache = threadCache();
+    if (cache != nullptr) {
+      block = cache->pop(num_pages);
+    }
+  }
+  if (block == nullptr) {
+    block = ::operator new(total_size);
+  }
+  static_cast<BlockHeader*>(block)->num_pages_ = num_pages;
+  return static_cast<uint8_t*>(block) + HeaderSize;
+}
+
+void SlicePool::deallocate(void* data) {
+  void* block = static_cast<uint8_t*>(data) - HeaderSize;
+  const uint64_t num_pages = static_cast<BlockHeader*>(block)->num_pages_;
+  ASSERT(num_pages <= MaxPooledPages);
+  if (num_pages != UnpooledSizeClass) {
+    ThreadCache* cache = threadCache();
+    if (cache != nullptr && cache->push(block, num_pages)) {
+      return;
+    }
+  }
+  ::operator delete(block);
+}
+
+void SlicePool::setMaxCachedBytesPerThread(uint64_t max_bytes) {
+  max_cached_bytes_per_thread_.store(max_bytes, std::memory_order_relaxed);
+}
+
+uint64_t SlicePool::maxCachedBytesPerThread() {
+  return max_cached_bytes_per_thread_.load(std::memory_order_relaxed);
+}
+
+void SlicePool::releaseThreadCache() {
+  ThreadCache* cache = threadCache();
+  if (cache != nullptr) {
+    cache->releaseAll();
+  }
+}
+
+SlicePoolStats SlicePool::stats() {
+  SlicePoolStats stats;
+  CacheRegistry& reg = registry();
+  Thread::LockGuard lock(reg.mutex_);
+  stats.hits_ = reg.retired_hits_;
+  stats.misses_ = reg.retired_misses_;
+  for (const ThreadCache* cache : reg.caches_) {
+    stats.hits_ += cache->hits();
+    stats.misses_ += cache->misses();
+    stats.cached_bytes_ += cache->cachedBytes();
+  }
+  return stats;
+}
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Aggregate statistics for the slice pool, summed across all threads.
+ */
+struct SlicePoolStats {
+  // Number of allocations that were satisfied from a thread-local freelist.
+  uint64_t hits_{};
+  // Number of allocations that had to go to the general purpose heap.
+  uint64_t misses_{};
+  // Number of bytes currently held in thread-local freelists.
+  uint64_t cached_bytes_{};
+};
+
+/**
+ * Thread-local, size-classed pool for OwnedSlice storage.
+ *
+ * Every allocation is rounded by OwnedSlice to a whole number of pages, so the pool keeps one
+ * freelist per page count up to MaxPooledPages. Freed blocks go to the freelist of the thread
+ * that frees them, which for buffers is almost always the worker that allocated them. Each
+ * thread holds at most maxCachedBytesPerThread() bytes; anything beyond that, and any allocation
+ * larger than MaxPooledPages, goes straight to the general purpose heap.
+ */
+class SlicePool {
+public:
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint64_t MaxPooledPages = 16;
+  // Size of the bookkeeping header that precedes every block handed out by allocate().
+  static constexpr uint64_t HeaderSize = alignof(std::max_align_t);
+  static constexpr uint64_t DefaultMaxCachedBytesPerThread = 2 * 1024 * 1024;
+
+  /**
+   * Allocate a block of memory.
+   * @param size the number of bytes needed. For the block to be poolable, size + HeaderSize
+   *        must be a multiple of PageSize.
+   * @return a pointer to at least size bytes, aligned to alignof(std::max_align_t).
+   */
+  static void* allocate(uint64_t size);
+
+  /**
+   * Release a block obtained from allocate() on any thread.
+   * @param block the pointer returned by allocate().
+   */
+  static void deallocate(void* block);
+
+  /**
+   * Set the upper bound on the bytes each thread keeps in its freelists. Setting 0 disables
+   * pooling: subsequent frees go directly to the heap. Threads trim their freelists to the new
+   * limit on their next deallocation.
+   */
+  static void setMaxCachedBytesPerThread(uint64_t max_bytes);
+  static uint64_t maxCachedBytesPerThread();
+
+  /**
+   * Return every block in the calling thread's freelists to the heap.
+   */
+  static void releaseThreadCache();
+
+  /**
+   * @return SlicePoolStats the pool statistics, summed over all live and exited threads.
+   */
+  static SlicePoolStats stats();
+
+private:
+  static std::atomic<uint64_t> max_cached_bytes_per_thread_;
+};
+
+} // namespace Buffer
+} // namespace Envoy
@@ -10,6 +10,11 @@ void WatermarkBuffer::add(const void* data, uint64_t size) {
   checkHighWatermark();
 }
 
+void WatermarkBuffer::addBufferFragment(BufferFragment& fragment) {
+  OwnedImpl::addBufferFragment(fragment);
+  checkHighWatermark();
+}
+
 void WatermarkBuffer::add(absl::string_view data) {
   OwnedImpl::add(data);
   checkHighWatermark();
@@ -40,6 +45,12 @@ void WatermarkBuffer::drain(uint64_t size) {
   checkLowWatermark();
 }
 
+SliceDataPtr WatermarkBuffer::extractFrontSlice() {
+  SliceDataPtr slice = OwnedImpl::extractFrontSlice();
+  checkLowWatermark();
+  return slice;
+}
+
 void WatermarkBuffer::move(Instance& rhs) {
   OwnedImpl::move(rhs);
   checkHighWatermark();
@@ -22,12 +22,14 @@ public:
   // Override all functions from Instance which can result in changing the size
   // of the underlying buffer.
   void add(const void* data, uint64_t size) override;
+  void addBufferFragment(BufferFragment& fragment) override;
   void add(absl::string_view data) override;
   void add(const Instance& data) override;
   void prepend(absl::string_view data) override;
   void prepend(Instance& data) override;
   void commit(RawSlice* iovecs, uint64_t num_iovecs) override;
   void drain(uint64_t size) override;
+  SliceDataPtr extractFrontSlice() override;
   void move(Instance& rhs) override;
   void move(Instance& rhs, uint64_t length) override;
   Api::IoCallUint64Result read(Network::IoHandle& io_handle, uint64_t max_length) override;
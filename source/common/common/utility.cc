@@ -1,5 +1,6 @@
 #include "common/common/utility.h"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
@@ -38,6 +39,12 @@ using SpecifierConstants = ConstSingleton<SpecifierConstantValues>;
 } // namespace
 
 std::string DateFormatter::fromTime(const SystemTime& time) const {
+  std::string formatted_str;
+  appendTime(time, formatted_str);
+  return formatted_str;
+}
+
+void DateFormatter::appendTime(const SystemTime& time, std::string& output) const {
   struct CachedTime {
     // The string length of a number of seconds since the Epoch. E.g. for "1528270093", the length
     // is 10.
@@ -69,7 +76,7 @@ std::string DateFormatter::fromTime(const SystemTime& time) const {
   const std::chrono::seconds epoch_time_seconds =
       std::chrono::duration_cast<std::chrono::seconds>(epoch_time_ns);
 
-  const auto& item = cached_time.formatted.find(raw_format_string_);
+  auto item = cached_time.formatted.find(raw_format_string_);
   if (item == cached_time.formatted.end() ||
       item->second.epoch_time_seconds != epoch_time_seconds) {
     // Remove all the expired cached items.
@@ -92,37 +99,44 @@ std::string DateFormatter::fromTime(const SystemTime& time) const {
 
     // Stamp the formatted string using the current epoch time in seconds, and then cache it in.
     formatted.epoch_time_seconds = epoch_time_seconds;
-    cached_time.formatted.emplace(std::make_pair(raw_format_string_, formatted));
+    item = cached_time.formatted.emplace(raw_format_string_, std::move(formatted)).first;
   }
 
-  const auto& formatted = cached_time.formatted.at(raw_format_string_);
+  const auto& formatted = item->second;
   ASSERT(specifiers_.size() == formatted.specifier_offsets.size());
 
-  // Copy the current cached formatted format string, then replace its subseconds part (when it has
-  // non-zero width) by correcting its position using prepared subseconds offsets.
-  std::string formatted_str = formatted.str;
-  std::string nanoseconds = fmt::format_int(epoch_time_ns.count()).str();
-  // Special case handling for beginning of time, we should never need to do this outside of
-  // tests or a time machine.
-  if (nanoseconds.size() < 10) {
-    nanoseconds = std::string(10 - nanoseconds.size(), '0') + nanoseconds;
+  // Append the current cached formatted format string, then replace its subseconds part (when it
+  // has non-zero width) in place by correcting its position using prepared subseconds offsets.
+  const size_t start = output.size();
+  output.append(formatted.str);
+
+  // The nanosecond digits following the seconds digits. Special case handling for beginning of
+  // time, where the nanosecond count has fewer digits than a second and must be zero padded; we
+  // should never need to do this outside of tests or a time machine.
+  const fmt::format_int nanoseconds(epoch_time_ns.count());
+  absl::string_view subseconds(nanoseconds.data(), nanoseconds.size());
+  char padded[10];
+  if (subseconds.size() < sizeof(padded)) {
+    const size_t padding = sizeof(padded) - subseconds.size();
+    std::fill(padded, padded + padding, '0');
+    std::copy(subseconds.begin(), subseconds.end(), padded + padding);
+    subseconds = absl::string_view(padded, sizeof(padded));
   }
+  subseconds.remove_prefix(cached_time.seconds_length);
 
   for (size_t i = 0; i < specifiers_.size(); ++i) {
-    const auto& specifier = specifiers_.at(i);
+    const auto& specifier = specifiers_[i];
 
     // When specifier.width_ is zero, skip the replacement. This is the last segment or it has no
     // specifier.
     if (specifier.width_ > 0 && !specifier.second_) {
-      ASSERT(specifier.position_ + formatted.specifier_offsets.at(i) < formatted_str.size());
-      formatted_str.replace(specifier.position_ + formatted.specifier_offsets.at(i),
-                            specifier.width_,
-                            nanoseconds.substr(cached_time.seconds_length, specifier.width_));
+      const size_t position = start + specifier.position_ + formatted.specifier_offsets[i];
+      ASSERT(position + specifier.width_ <= output.size());
+      output.replace(position, specifier.width_, subseconds.data(), specifier.width_);
     }
   }
 
-  ASSERT(formatted_str.size() == formatted.str.size());
-  return formatted_str;
+  ASSERT(output.size() == start + formatted.str.size());
 }
 
 void DateFormatter::parse(const std::string& format_string) {
@@ -405,6 +419,12 @@ std::string StringUtil::escape(const std::string& source) {
 }
 
 std::string AccessLogDateTimeFormatter::fromTime(const SystemTime& system_time) {
+  std::string formatted_time;
+  appendTime(system_time, formatted_time);
+  return formatted_time;
+}
+
+void AccessLogDateTimeFormatter::appendTime(const SystemTime& system_time, std::string& output) {
   static const std::string DefaultDateFormat = "%Y-%m-%dT%H:%M:%E3SZ";
 
   struct CachedTime {
@@ -436,7 +456,7 @@ std::string AccessLogDateTimeFormatter::fromTime(const SystemTime& system_time)
     cached_time.formatted_time[offset++] = ('0' + msec);
   }
 
-  return cached_time.formatted_time;
+  output.append(cached_time.formatted_time);
 }
 
 const std::string& StringUtil::nonEmptyStringOrDefault(const std::string& s,
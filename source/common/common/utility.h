@@ -32,6 +32,14 @@ public:
    */
   std::string fromTime(const SystemTime& time) const;
 
+  /**
+   * Append the GMT/UTC time based on the input time to output. The formatted string is cached per
+   * second and per thread, so within the same second only the subsecond digits are rewritten.
+   * @param time supplies the time to format.
+   * @param output supplies the buffer the formatted time is appended to.
+   */
+  void appendTime(const SystemTime& time, std::string& output) const;
+
   /**
    * @param time_source time keeping source.
    * @return std::string representing the GMT/UTC time of a TimeSource based on the format string.
@@ -91,6 +99,12 @@ private:
 class AccessLogDateTimeFormatter {
 public:
   static std::string fromTime(const SystemTime& time);
+
+  /**
+   * Append the access log representation of time to output, without building an intermediate
+   * string.
+   */
+  static void appendTime(const SystemTime& time, std::string& output);
 };
 
 /**
@@ -143,10 +143,13 @@ Network::ListenerPtr DispatcherImpl::createListener(Network::SocketSharedPtr&& s
   return std::make_unique<Network::ListenerImpl>(*this, std::move(socket), cb, bind_to_port);
 }
 
-Network::UdpListenerPtr DispatcherImpl::createUdpListener(Network::SocketSharedPtr&& socket,
-                                                          Network::UdpListenerCallbacks& cb) {
+Network::UdpListenerPtr
+DispatcherImpl::createUdpListener(Network::SocketSharedPtr&& socket,
+                                  Network::UdpListenerCallbacks& cb,
+                                  const Network::UdpReadOptions& read_options) {
   ASSERT(isThreadSafe());
-  return std::make_unique<Network::UdpListenerImpl>(*this, std::move(socket), cb, timeSource());
+  return std::make_unique<Network::UdpListenerImpl>(*this, std::move(socket), cb, timeSource(),
+                                                    read_options);
 }
 
 TimerPtr DispatcherImpl::createTimer(TimerCb cb) { return createTimerInternal(cb); }
@@ -61,7 +61,8 @@ public:
   Network::ListenerPtr createListener(Network::SocketSharedPtr&& socket,
                                       Network::ListenerCallbacks& cb, bool bind_to_port) override;
   Network::UdpListenerPtr createUdpListener(Network::SocketSharedPtr&& socket,
-                                            Network::UdpListenerCallbacks& cb) override;
+                                            Network::UdpListenerCallbacks& cb,
+                                            const Network::UdpReadOptions& read_options) override;
   TimerPtr createTimer(TimerCb cb) override;
   void deferredDelete(DeferredDeletablePtr&& to_delete) override;
   void exit() override;
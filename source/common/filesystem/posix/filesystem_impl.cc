@@ -1,6 +1,7 @@
 #include <dirent.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <cstdlib>
@@ -14,6 +15,7 @@
 #include "common/common/assert.h"
 #include "common/common/fmt.h"
 #include "common/common/logger.h"
+#include "common/common/stack_array.h"
 #include "common/filesystem/filesystem_impl.h"
 
 #include "absl/strings/match.h"
@@ -37,6 +39,15 @@ ssize_t FileImplPosix::writeFile(absl::string_view buffer) {
   return ::write(fd_, buffer.data(), buffer.size());
 }
 
+ssize_t FileImplPosix::writevFile(const absl::string_view* buffers, uint64_t num_buffers) {
+  STACK_ARRAY(iov, iovec, num_buffers);
+  for (uint64_t i = 0; i < num_buffers; i++) {
+    iov[i].iov_base = const_cast<char*>(buffers[i].data());
+    iov[i].iov_len = buffers[i].size();
+  }
+  return ::writev(fd_, iov.begin(), static_cast<int>(num_buffers));
+}
+
 FileImplPosix::FlagsAndMode FileImplPosix::translateFlag(FlagSet in) {
   int out = 0;
   mode_t mode = 0;
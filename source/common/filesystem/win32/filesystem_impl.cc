@@ -32,6 +32,22 @@ ssize_t FileImplWin32::writeFile(absl::string_view buffer) {
   return ::_write(fd_, buffer.data(), buffer.size());
 }
 
+ssize_t FileImplWin32::writevFile(const absl::string_view* buffers, uint64_t num_buffers) {
+  // There is no gather write for CRT file descriptors, so the buffers are written one by one.
+  ssize_t total = 0;
+  for (uint64_t i = 0; i < num_buffers; i++) {
+    const ssize_t rc = ::_write(fd_, buffers[i].data(), buffers[i].size());
+    if (rc == -1) {
+      return total > 0 ? total : -1;
+    }
+    total += rc;
+    if (static_cast<size_t>(rc) != buffers[i].size()) {
+      break;
+    }
+  }
+  return total;
+}
+
 FileImplWin32::FlagsAndMode FileImplWin32::translateFlag(FlagSet in) {
   int out = 0;
   int pmode = 0;
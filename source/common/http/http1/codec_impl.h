@@ -1,7 +1,5 @@
 #pragma once
 
-#include <http_parser.h>
-
 #include <array>
 #include <cstdint>
 #include <list>
@@ -19,6 +17,7 @@
 #include "common/http/codes.h"
 #include "common/http/header_map_impl.h"
 #include "common/http/http1/header_formatter.h"
+#include "common/http/http1/parser.h"
 
 namespace Envoy {
 namespace Http {
@@ -141,10 +140,12 @@ private:
 
 /**
  * Base class for HTTP/1.1 client and server connections.
- * Handles the callbacks of http_parser with its own base routine and then
+ * Handles the callbacks of the HTTP/1 parser with its own base routine and then
  * virtual dispatches to its subclasses.
  */
-class ConnectionImpl : public virtual Connection, protected Logger::Loggable<Logger::Id::http> {
+class ConnectionImpl : public virtual Connection,
+                       private ParserCallbacks,
+                       protected Logger::Loggable<Logger::Id::http> {
 public:
   /**
    * @return Network::Connection& the backing network connection.
@@ -200,7 +201,7 @@ public:
   bool enableTrailers() const { return enable_trailers_; }
 
 protected:
-  ConnectionImpl(Network::Connection& connection, Stats::Scope& stats, http_parser_type type,
+  ConnectionImpl(Network::Connection& connection, Stats::Scope& stats, MessageType type,
                  uint32_t max_headers_kb, const uint32_t max_headers_count,
                  HeaderKeyFormatterPtr&& header_key_formatter, bool enable_trailers);
 
@@ -208,7 +209,7 @@ protected:
 
   Network::Connection& connection_;
   CodecStats stats_;
-  http_parser parser_;
+  ParserPtr parser_;
   HeaderMapPtr deferred_end_stream_headers_;
   Http::Code error_code_{Http::Code::BadRequest};
   const HeaderKeyFormatterPtr header_key_formatter_;
@@ -234,54 +235,28 @@ private:
    */
   size_t dispatchSlice(const char* slice, size_t len);
 
-  /**
-   * Called when a request/response is beginning. A base routine happens first then a virtual
-   * dispatch is invoked.
-   */
-  void onMessageBeginBase();
-  virtual void onMessageBegin() PURE;
-
-  /**
-   * Called when URL data is received.
-   * @param data supplies the start address.
-   * @param length supplies the length.
-   */
-  virtual void onUrl(const char* data, size_t length) PURE;
-
-  /**
-   * Called when header field data is received.
-   * @param data supplies the start address.
-   * @param length supplies the length.
-   */
-  void onHeaderField(const char* data, size_t length);
+  // Http1::ParserCallbacks
+  void onMessageBeginBase() override;
+  void onHeaderField(const char* data, size_t length) override;
+  void onHeaderValue(const char* data, size_t length) override;
+  int onHeadersCompleteBase() override;
+  void onMessageCompleteBase() override;
 
   /**
-   * Called when header value data is received.
-   * @param data supplies the start address.
-   * @param length supplies the length.
+   * Called from onMessageBeginBase() once the base routine is done.
    */
-  void onHeaderValue(const char* data, size_t length);
+  virtual void onMessageBegin() PURE;
 
   /**
-   * Called when headers are complete. A base routine happens first then a virtual dispatch is
-   * invoked. Note that this only applies to headers and NOT trailers. End of
-   * trailers are signaled via onMessageCompleteBase().
+   * Called from onHeadersCompleteBase() once the base routine is done. Note that this only applies
+   * to headers and NOT trailers. End of trailers are signaled via onMessageComplete().
    * @return 0 if no error, 1 if there should be no body.
    */
-  int onHeadersCompleteBase();
   virtual int onHeadersComplete(HeaderMapImplPtr&& headers) PURE;
 
   /**
-   * Called when body data is received.
-   * @param data supplies the start address.
-   * @param length supplies the length.
-   */
-  virtual void onBody(const char* data, size_t length) PURE;
-
-  /**
-   * Called when the request/response is complete.
+   * Called from onMessageCompleteBase() once the base routine is done.
    */
-  void onMessageCompleteBase();
   virtual void onMessageComplete(HeaderMapImplPtr&& trailers) PURE;
 
   /**
@@ -306,7 +281,6 @@ private:
    */
   virtual void onBelowLowWatermark() PURE;
 
-  static http_parser_settings settings_;
   static const ToLowerTable& toLowerTable();
 
   HeaderMapImplPtr current_header_map_;
@@ -350,11 +324,11 @@ private:
    * Manipulate the request's first line, parsing the url and converting to a relative path if
    * necessary. Compute Host / :authority headers based on 7230#5.7 and 7230#6
    *
-   * @param is_connect true if the request has the CONNECT method
    * @param headers the request's headers
+   * @param method the request's method
    * @throws CodecProtocolException on an invalid url in the request line
    */
-  void handlePath(HeaderMapImpl& headers, unsigned int method);
+  void handlePath(HeaderMapImpl& headers, absl::string_view method);
 
   // ConnectionImpl
   void onEncodeComplete() override;
@@ -0,0 +1,1354 @@
+#include "common/http/http1/fast_parser_impl.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "common/common/assert.h"
+#include "common/common/macros.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+constexpr uint64_t NoContentLength = std::numeric_limits<uint64_t>::max();
+// http_parser is built with -DHTTP_MAX_HEADER_SIZE=0x2000000, see bazel/external/http-parser.BUILD.
+constexpr uint64_t MaxHeaderSize = 0x2000000;
+
+constexpr char CR = '\r';
+constexpr char LF = '\n';
+
+constexpr const char* MethodNames[] = {
+    "DELETE",   "GET",       "HEAD",        "POST",     "PUT",       "CONNECT", "OPTIONS",
+    "TRACE",    "COPY",      "LOCK",        "MKCOL",    "MOVE",      "PROPFIND", "PROPPATCH",
+    "SEARCH",   "UNLOCK",    "BIND",        "REBIND",   "UNBIND",    "ACL",     "REPORT",
+    "MKACTIVITY", "CHECKOUT", "MERGE",      "M-SEARCH", "NOTIFY",    "SUBSCRIBE", "UNSUBSCRIBE",
+    "PATCH",    "PURGE",     "MKCALENDAR",  "LINK",     "UNLINK",    "SOURCE"};
+
+constexpr absl::string_view ConnectionToken = "connection";
+constexpr absl::string_view ProxyConnectionToken = "proxy-connection";
+constexpr absl::string_view ContentLengthToken = "content-length";
+constexpr absl::string_view TransferEncodingToken = "transfer-encoding";
+constexpr absl::string_view UpgradeToken = "upgrade";
+constexpr absl::string_view ChunkedToken = "chunked";
+constexpr absl::string_view KeepAliveToken = "keep-alive";
+constexpr absl::string_view CloseToken = "close";
+
+bool isNum(uint8_t c) { return c >= '0' && c <= '9'; }
+bool isAlpha(uint8_t c) { return (c | 0x20) >= 'a' && (c | 0x20) <= 'z'; }
+uint8_t lower(uint8_t c) { return c | 0x20; }
+// Header values may not contain control characters other than HTAB, nor DEL.
+bool isHeaderChar(uint8_t c) { return c == CR || c == LF || c == '\t' || (c > 31 && c != 127); }
+
+/**
+ * Byte classes of http_parser without HTTP_PARSER_STRICT.
+ */
+struct CharTables {
+  CharTables() {
+    for (int i = 0; i < 256; i++) {
+      const uint8_t c = i;
+      const bool alnum = isAlpha(c) || isNum(c);
+      const bool mark = c == '-' || c == '_' || c == '.' || c == '!' || c == '~' || c == '*' ||
+                        c == '\'' || c == '(' || c == ')';
+      // Spaces are allowed in header names.
+      const bool token = alnum || c == ' ' || c == '!' || c == '#' || c == '$' || c == '%' ||
+                         c == '&' || c == '\'' || c == '*' || c == '+' || c == '-' || c == '.' ||
+                         c == '^' || c == '_' || c == '`' || c == '|' || c == '~';
+      token_[i] = token ? (isAlpha(c) ? lower(c) : c) : 0;
+      // HTAB and FF are allowed in URLs.
+      url_[i] = c == '\t' || c == '\f' || (c > ' ' && c != '#' && c != '?' && c != 127);
+      userinfo_[i] = alnum || mark || c == '%' || c == ';' || c == ':' || c == '&' || c == '=' ||
+                     c == '+' || c == '$' || c == ',';
+      unhex_[i] = isNum(c) ? c - '0'
+                           : (lower(c) >= 'a' && lower(c) <= 'f' ? lower(c) - 'a' + 10 : -1);
+    }
+  }
+
+  // The lower cased byte if it is allowed in header names, 0 otherwise.
+  std::array<uint8_t, 256> token_;
+  std::array<bool, 256> url_;
+  std::array<bool, 256> userinfo_;
+  std::array<int8_t, 256> unhex_;
+};
+
+const CharTables& charTables() { CONSTRUCT_ON_FIRST_USE(CharTables); }
+
+/**
+ * @return the first byte in [begin, end) that ends a run of header value bytes: CR, LF, or a byte
+ *         that is not allowed in header values. end if there is none.
+ */
+const char* findHeaderValueEnd(const char* begin, const char* end) {
+  const char* p = begin;
+#if defined(__SSE2__)
+  const __m128i max_control = _mm_set1_epi8(0x1f);
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i del = _mm_set1_epi8(0x7f);
+  for (; end - p >= 16; p += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    // There is no unsigned byte compare, but v <= 0x1f exactly when min(v, 0x1f) == v.
+    const __m128i control = _mm_andnot_si128(_mm_cmpeq_epi8(v, tab),
+                                             _mm_cmpeq_epi8(_mm_min_epu8(v, max_control), v));
+    const int mask = _mm_movemask_epi8(_mm_or_si128(control, _mm_cmpeq_epi8(v, del)));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; p != end; ++p) {
+    const uint8_t c = *p;
+    if ((c < ' ' && c != '\t') || c == 127) {
+      return p;
+    }
+  }
+  return end;
+}
+
+/**
+ * @return the first byte in [begin, end) that may change the state of a URL path, query string or
+ *         fragment: a space or control character, DEL, '#' or '?'. end if there is none.
+ */
+const char* findUrlDelimiter(const char* begin, const char* end) {
+  const char* p = begin;
+#if defined(__SSE2__)
+  const __m128i max_space = _mm_set1_epi8(' ');
+  const __m128i del = _mm_set1_epi8(0x7f);
+  const __m128i hash = _mm_set1_epi8('#');
+  const __m128i question = _mm_set1_epi8('?');
+  for (; end - p >= 16; p += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(v, max_space), v);
+    const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, del),
+                                         _mm_or_si128(_mm_cmpeq_epi8(v, hash),
+                                                      _mm_cmpeq_epi8(v, question)));
+    const int mask = _mm_movemask_epi8(_mm_or_si128(control, special));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; p != end; ++p) {
+    const uint8_t c = *p;
+    if (c <= ' ' || c == 127 || c == '#' || c == '?') {
+      return p;
+    }
+  }
+  return end;
+}
+
+} // namespace
+
+FastHttpParserImpl::FastHttpParserImpl(MessageType type, ParserCallbacks& callbacks)
+    : callbacks_(callbacks), type_(type), state_(startState()) {}
+
+ParserStatus FastHttpParserImpl::getStatus() const {
+  if (error_ != Error::Ok) {
+    return ParserStatus::Error;
+  }
+  return paused_ ? ParserStatus::Paused : ParserStatus::Ok;
+}
+
+absl::string_view FastHttpParserImpl::errorName() const {
+  switch (error_) {
+  case Error::Ok:
+    return paused_ ? "HPE_PAUSED" : "HPE_OK";
+  case Error::CbHeadersComplete:
+    return "HPE_CB_headers_complete";
+  case Error::InvalidEofState:
+    return "HPE_INVALID_EOF_STATE";
+  case Error::HeaderOverflow:
+    return "HPE_HEADER_OVERFLOW";
+  case Error::InvalidVersion:
+    return "HPE_INVALID_VERSION";
+  case Error::InvalidStatus:
+    return "HPE_INVALID_STATUS";
+  case Error::InvalidMethod:
+    return "HPE_INVALID_METHOD";
+  case Error::InvalidUrl:
+    return "HPE_INVALID_URL";
+  case Error::InvalidConstant:
+    return "HPE_INVALID_CONSTANT";
+  case Error::LfExpected:
+    return "HPE_LF_EXPECTED";
+  case Error::InvalidHeaderToken:
+    return "HPE_INVALID_HEADER_TOKEN";
+  case Error::InvalidContentLength:
+    return "HPE_INVALID_CONTENT_LENGTH";
+  case Error::UnexpectedContentLength:
+    return "HPE_UNEXPECTED_CONTENT_LENGTH";
+  case Error::InvalidChunkSize:
+    return "HPE_INVALID_CHUNK_SIZE";
+  }
+  NOT_REACHED_GCOVR_EXCL_LINE;
+}
+
+absl::optional<uint64_t> FastHttpParserImpl::contentLength() const {
+  if (content_length_ == NoContentLength) {
+    return absl::nullopt;
+  }
+  return content_length_;
+}
+
+absl::string_view FastHttpParserImpl::methodName() const {
+  return MethodNames[static_cast<uint8_t>(method_)];
+}
+
+bool FastHttpParserImpl::messageNeedsEof() const {
+  if (type_ == MessageType::Request) {
+    return false;
+  }
+  if (status_code_ / 100 == 1 || status_code_ == 204 || status_code_ == 304 ||
+      (flags_ & Flags::SkipBody)) {
+    return false;
+  }
+  return !(flags_ & Flags::Chunked) && content_length_ == NoContentLength;
+}
+
+bool FastHttpParserImpl::emitData(void (ParserCallbacks::*callback)(const char*, size_t),
+                                  const char*& mark, const char* at) {
+  if (mark != nullptr) {
+    (callbacks_.*callback)(mark, at - mark);
+    mark = nullptr;
+  }
+  return !paused_;
+}
+
+bool FastHttpParserImpl::countHeaderBytes(uint64_t count) {
+  header_bytes_ += count;
+  return header_bytes_ <= MaxHeaderSize;
+}
+
+bool FastHttpParserImpl::skipTo(const char*& p, const char* at, const char* end) {
+  const char* last = at == end ? end - 1 : at;
+  const uint64_t count = last - p;
+  p = last;
+  return countHeaderBytes(count);
+}
+
+void FastHttpParserImpl::finishHeaderValue() {
+  switch (header_state_) {
+  case HeaderState::ConnectionKeepAlive:
+    flags_ |= Flags::ConnectionKeepAlive;
+    break;
+  case HeaderState::ConnectionClose:
+    flags_ |= Flags::ConnectionClose;
+    break;
+  case HeaderState::TransferEncodingChunked:
+    flags_ |= Flags::Chunked;
+    break;
+  case HeaderState::ConnectionUpgrade:
+    flags_ |= Flags::ConnectionUpgrade;
+    break;
+  default:
+    break;
+  }
+}
+
+size_t FastHttpParserImpl::onEof() {
+  switch (state_) {
+  case State::BodyIdentityEof:
+    callbacks_.onMessageCompleteBase();
+    return 0;
+  case State::StartReq:
+  case State::StartRes:
+    return 0;
+  default:
+    error_ = Error::InvalidEofState;
+    return 1;
+  }
+}
+
+FastHttpParserImpl::State FastHttpParserImpl::parseUrlChar(State s, uint8_t c) {
+  const CharTables& tables = charTables();
+  if (c == ' ' || c == CR || c == LF) {
+    return State::Dead;
+  }
+  switch (s) {
+  case State::ReqSpacesBeforeUrl:
+    // Proxied requests are followed by the scheme of an absolute URI. All methods except CONNECT
+    // are followed by '/' or '*'.
+    if (c == '/' || c == '*') {
+      return State::ReqPath;
+    }
+    if (isAlpha(c)) {
+      return State::ReqSchema;
+    }
+    break;
+  case State::ReqSchema:
+    if (isAlpha(c)) {
+      return s;
+    }
+    if (c == ':') {
+      return State::ReqSchemaSlash;
+    }
+    break;
+  case State::ReqSchemaSlash:
+    if (c == '/') {
+      return State::ReqSchemaSlashSlash;
+    }
+    break;
+  case State::ReqSchemaSlashSlash:
+    if (c == '/') {
+      return State::ReqServerStart;
+    }
+    break;
+  case State::ReqServerWithAt:
+    if (c == '@') {
+      return State::Dead;
+    }
+    FALLTHRU;
+  case State::ReqServerStart:
+  case State::ReqServer:
+    if (c == '/') {
+      return State::ReqPath;
+    }
+    if (c == '?') {
+      return State::ReqQueryStringStart;
+    }
+    if (c == '@') {
+      return State::ReqServerWithAt;
+    }
+    if (tables.userinfo_[c] || c == '[' || c == ']') {
+      return State::ReqServer;
+    }
+    break;
+  case State::ReqPath:
+    if (tables.url_[c]) {
+      return s;
+    }
+    if (c == '?') {
+      return State::ReqQueryStringStart;
+    }
+    if (c == '#') {
+      return State::ReqFragmentStart;
+    }
+    break;
+  case State::ReqQueryStringStart:
+  case State::ReqQueryString:
+    if (tables.url_[c] || c == '?') {
+      return State::ReqQueryString;
+    }
+    if (c == '#') {
+      return State::ReqFragmentStart;
+    }
+    break;
+  case State::ReqFragmentStart:
+    if (tables.url_[c] || c == '?') {
+      return State::ReqFragment;
+    }
+    if (c == '#') {
+      return s;
+    }
+    break;
+  case State::ReqFragment:
+    if (tables.url_[c] || c == '?' || c == '#') {
+      return s;
+    }
+    break;
+  default:
+    break;
+  }
+  return State::Dead;
+}
+
+bool FastHttpParserImpl::nextMethod(Method& method, uint8_t index, uint8_t c) {
+  struct Transition {
+    Method from;
+    uint8_t index;
+    char c;
+    Method to;
+  };
+  static constexpr Transition transitions[] = {
+      {Method::Post, 1, 'U', Method::Put},
+      {Method::Post, 1, 'A', Method::Patch},
+      {Method::Post, 1, 'R', Method::Propfind},
+      {Method::Put, 2, 'R', Method::Purge},
+      {Method::Connect, 1, 'H', Method::Checkout},
+      {Method::Connect, 2, 'P', Method::Copy},
+      {Method::Mkcol, 1, 'O', Method::Move},
+      {Method::Mkcol, 1, 'E', Method::Merge},
+      {Method::Mkcol, 1, '-', Method::Msearch},
+      {Method::Mkcol, 2, 'A', Method::Mkactivity},
+      {Method::Mkcol, 3, 'A', Method::Mkcalendar},
+      {Method::Subscribe, 1, 'E', Method::Search},
+      {Method::Subscribe, 1, 'O', Method::Source},
+      {Method::Report, 2, 'B', Method::Rebind},
+      {Method::Propfind, 4, 'P', Method::Proppatch},
+      {Method::Lock, 1, 'I', Method::Link},
+      {Method::Unlock, 2, 'S', Method::Unsubscribe},
+      {Method::Unlock, 2, 'B', Method::Unbind},
+      {Method::Unlock, 3, 'I', Method::Unlink},
+  };
+  for (const Transition& transition : transitions) {
+    if (transition.from == method && transition.index == index && transition.c == c) {
+      method = transition.to;
+      return true;
+    }
+  }
+  return false;
+}
+
+FastHttpParserImpl::HeaderState FastHttpParserImpl::matchToken(absl::string_view token,
+                                                              uint8_t index, uint8_t c,
+                                                              HeaderState matching,
+                                                              HeaderState mismatch,
+                                                              HeaderState done) {
+  if (index >= token.size() || c != static_cast<uint8_t>(token[index])) {
+    return mismatch;
+  }
+  return index == token.size() - 1 ? done : matching;
+}
+
+size_t FastHttpParserImpl::execute(const char* data, size_t length) {
+  if (error_ != Error::Ok || paused_) {
+    return 0;
+  }
+  if (length == 0) {
+    return onEof();
+  }
+
+  const CharTables& tables = charTables();
+  const char* const end = data + length;
+  const char* p = data;
+  // Start of the URL, header name, header value or body that is handed out next. At most one is
+  // set at a time. Spans that were cut off by the end of the previous input go on here.
+  const char* url_mark = nullptr;
+  const char* header_field_mark = nullptr;
+  const char* header_value_mark = nullptr;
+  const char* body_mark = nullptr;
+  switch (state_) {
+  case State::HeaderField:
+    header_field_mark = data;
+    break;
+  case State::HeaderValue:
+    header_value_mark = data;
+    break;
+  case State::ReqSchema:
+  case State::ReqSchemaSlash:
+  case State::ReqSchemaSlashSlash:
+  case State::ReqServerStart:
+  case State::ReqServer:
+  case State::ReqServerWithAt:
+  case State::ReqPath:
+  case State::ReqQueryStringStart:
+  case State::ReqQueryString:
+  case State::ReqFragmentStart:
+  case State::ReqFragment:
+    url_mark = data;
+    break;
+  default:
+    break;
+  }
+
+  const auto fail = [this, &p, data](Error error) -> size_t {
+    error_ = error;
+    return p - data;
+  };
+
+  // Each byte is counted once, when it is first looked at. A state that is done with the byte
+  // breaks out of the switch, a state that hands it to the next state continues the inner loop.
+  for (; p != end; ++p) {
+    if (parsingHeader() && !countHeaderBytes(1)) {
+      return fail(Error::HeaderOverflow);
+    }
+    bool reexecute;
+    do {
+      reexecute = false;
+      const uint8_t c = *p;
+      switch (state_) {
+      case State::StartReq: {
+        if (c == CR || c == LF) {
+          break;
+        }
+        flags_ = 0;
+        content_length_ = NoContentLength;
+        method_ = Method::Delete;
+        index_ = 1;
+        switch (c) {
+        case 'A':
+          method_ = Method::Acl;
+          break;
+        case 'B':
+          method_ = Method::Bind;
+          break;
+        case 'C':
+          method_ = Method::Connect;
+          break;
+        case 'D':
+          method_ = Method::Delete;
+          break;
+        case 'G':
+          method_ = Method::Get;
+          break;
+        case 'H':
+          method_ = Method::Head;
+          break;
+        case 'L':
+          method_ = Method::Lock;
+          break;
+        case 'M':
+          method_ = Method::Mkcol;
+          break;
+        case 'N':
+          method_ = Method::Notify;
+          break;
+        case 'O':
+          method_ = Method::Options;
+          break;
+        case 'P':
+          method_ = Method::Post;
+          break;
+        case 'R':
+          method_ = Method::Report;
+          break;
+        case 'S':
+          method_ = Method::Subscribe;
+          break;
+        case 'T':
+          method_ = Method::Trace;
+          break;
+        case 'U':
+          method_ = Method::Unlock;
+          break;
+        default:
+          return fail(Error::InvalidMethod);
+        }
+        state_ = State::ReqMethod;
+        callbacks_.onMessageBeginBase();
+        if (paused_) {
+          return p - data + 1;
+        }
+        break;
+      }
+
+      case State::ReqMethod: {
+        if (c == '\0') {
+          return fail(Error::InvalidMethod);
+        }
+        const char* matcher = MethodNames[static_cast<uint8_t>(method_)];
+        if (c == ' ' && matcher[index_] == '\0') {
+          state_ = State::ReqSpacesBeforeUrl;
+        } else if (c == static_cast<uint8_t>(matcher[index_])) {
+          // Still on the same method.
+        } else if ((c >= 'A' && c <= 'Z') || c == '-') {
+          if (!nextMethod(method_, index_, c)) {
+            return fail(Error::InvalidMethod);
+          }
+        } else {
+          return fail(Error::InvalidMethod);
+        }
+        ++index_;
+        break;
+      }
+
+      case State::ReqSpacesBeforeUrl:
+        if (c == ' ') {
+          break;
+        }
+        url_mark = p;
+        if (method_ == Method::Connect) {
+          state_ = State::ReqServerStart;
+        }
+        state_ = parseUrlChar(state_, c);
+        if (state_ == State::Dead) {
+          return fail(Error::InvalidUrl);
+        }
+        break;
+
+      case State::ReqSchema:
+      case State::ReqSchemaSlash:
+      case State::ReqSchemaSlashSlash:
+      case State::ReqServerStart:
+        // No whitespace allowed here.
+        if (c == ' ' || c == CR || c == LF) {
+          return fail(Error::InvalidUrl);
+        }
+        state_ = parseUrlChar(state_, c);
+        if (state_ == State::Dead) {
+          return fail(Error::InvalidUrl);
+        }
+        break;
+
+      case State::ReqServer:
+      case State::ReqServerWithAt:
+      case State::ReqPath:
+      case State::ReqQueryStringStart:
+      case State::ReqQueryString:
+      case State::ReqFragmentStart:
+      case State::ReqFragment:
+        if (c == ' ') {
+          state_ = State::ReqHttpStart;
+          if (!emitData(&ParserCallbacks::onUrl, url_mark, p)) {
+            return p - data + 1;
+          }
+          break;
+        }
+        if (c == CR || c == LF) {
+          // HTTP/0.9 request line.
+          http_major_ = 0;
+          http_minor_ = 9;
+          state_ = c == CR ? State::ReqLineAlmostDone : State::HeaderFieldStart;
+          if (!emitData(&ParserCallbacks::onUrl, url_mark, p)) {
+            return p - data + 1;
+          }
+          break;
+        }
+        state_ = parseUrlChar(state_, c);
+        if (state_ == State::Dead) {
+          return fail(Error::InvalidUrl);
+        }
+        if (state_ == State::ReqPath || state_ == State::ReqQueryString ||
+            state_ == State::ReqFragment) {
+          // None of the bytes up to the next delimiter change the state.
+          const char* delimiter = findUrlDelimiter(p + 1, end);
+          if (!skipTo(p, delimiter, end)) {
+            return fail(Error::HeaderOverflow);
+          }
+          if (delimiter != end) {
+            reexecute = true;
+            continue;
+          }
+        }
+        break;
+
+      case State::ReqHttpStart:
+        if (c == ' ') {
+          break;
+        }
+        if (c == 'H') {
+          state_ = State::ReqHttpH;
+          break;
+        }
+        if (c == 'I' && method_ == Method::Source) {
+          state_ = State::ReqHttpI;
+          break;
+        }
+        return fail(Error::InvalidConstant);
+
+      // The rest of the protocol name is not checked.
+      case State::ReqHttpH:
+        state_ = State::ReqHttpHT;
+        break;
+      case State::ReqHttpHT:
+        state_ = State::ReqHttpHTT;
+        break;
+      case State::ReqHttpHTT:
+        state_ = State::ReqHttpHTTP;
+        break;
+      case State::ReqHttpI:
+        state_ = State::ReqHttpIC;
+        break;
+      case State::ReqHttpIC:
+        // ICE/x.y is taken as HTTP/x.y.
+        state_ = State::ReqHttpHTTP;
+        break;
+      case State::ReqHttpHTTP:
+        state_ = State::ReqHttpMajor;
+        break;
+
+      case State::ReqHttpMajor:
+      case State::ResHttpMajor:
+        if (!isNum(c)) {
+          return fail(Error::InvalidVersion);
+        }
+        http_major_ = c - '0';
+        state_ = state_ == State::ReqHttpMajor ? State::ReqHttpDot : State::ResHttpDot;
+        break;
+
+      case State::ReqHttpDot:
+      case State::ResHttpDot:
+        if (c != '.') {
+          return fail(Error::InvalidVersion);
+        }
+        state_ = state_ == State::ReqHttpDot ? State::ReqHttpMinor : State::ResHttpMinor;
+        break;
+
+      case State::ReqHttpMinor:
+      case State::ResHttpMinor:
+        if (!isNum(c)) {
+          return fail(Error::InvalidVersion);
+        }
+        http_minor_ = c - '0';
+        state_ = state_ == State::ReqHttpMinor ? State::ReqHttpEnd : State::ResHttpEnd;
+        break;
+
+      case State::ReqHttpEnd:
+        if (c == CR) {
+          state_ = State::ReqLineAlmostDone;
+          break;
+        }
+        if (c == LF) {
+          state_ = State::HeaderFieldStart;
+          break;
+        }
+        return fail(Error::InvalidVersion);
+
+      case State::ReqLineAlmostDone:
+        if (c != LF) {
+          return fail(Error::LfExpected);
+        }
+        state_ = State::HeaderFieldStart;
+        break;
+
+      case State::StartRes:
+        if (c == CR || c == LF) {
+          break;
+        }
+        flags_ = 0;
+        content_length_ = NoContentLength;
+        if (c != 'H') {
+          return fail(Error::InvalidConstant);
+        }
+        state_ = State::ResH;
+        callbacks_.onMessageBeginBase();
+        if (paused_) {
+          return p - data + 1;
+        }
+        break;
+
+      // The rest of the protocol name is not checked.
+      case State::ResH:
+        state_ = State::ResHT;
+        break;
+      case State::ResHT:
+        state_ = State::ResHTT;
+        break;
+      case State::ResHTT:
+        state_ = State::ResHTTP;
+        break;
+      case State::ResHTTP:
+        state_ = State::ResHttpMajor;
+        break;
+
+      case State::ResHttpEnd:
+        if (c != ' ') {
+          return fail(Error::InvalidVersion);
+        }
+        state_ = State::ResFirstStatusCode;
+        break;
+
+      case State::ResFirstStatusCode:
+        if (!isNum(c)) {
+          if (c == ' ') {
+            break;
+          }
+          return fail(Error::InvalidStatus);
+        }
+        status_code_ = c - '0';
+        state_ = State::ResStatusCode;
+        break;
+
+      case State::ResStatusCode:
+        if (!isNum(c)) {
+          if (c == ' ') {
+            state_ = State::ResStatusStart;
+            break;
+          }
+          if (c == CR || c == LF) {
+            state_ = State::ResStatusStart;
+            reexecute = true;
+            continue;
+          }
+          return fail(Error::InvalidStatus);
+        }
+        status_code_ = status_code_ * 10 + (c - '0');
+        if (status_code_ > 999) {
+          return fail(Error::InvalidStatus);
+        }
+        break;
+
+      case State::ResStatusStart:
+        state_ = State::ResStatus;
+        index_ = 0;
+        if (c == CR || c == LF) {
+          reexecute = true;
+          continue;
+        }
+        break;
+
+      case State::ResStatus: {
+        // The reason phrase is not handed out, skip to its end.
+        const char* q = p;
+        while (q != end && *q != CR && *q != LF) {
+          ++q;
+        }
+        if (!skipTo(p, q, end)) {
+          return fail(Error::HeaderOverflow);
+        }
+        if (q != end) {
+          state_ = *q == CR ? State::ResLineAlmostDone : State::HeaderFieldStart;
+        }
+        break;
+      }
+
+      case State::ResLineAlmostDone:
+        state_ = State::HeaderFieldStart;
+        break;
+
+      case State::HeaderFieldStart: {
+        if (c == CR) {
+          state_ = State::HeadersAlmostDone;
+          break;
+        }
+        if (c == LF) {
+          // A bare LF ends the header section as well.
+          state_ = State::HeadersAlmostDone;
+          reexecute = true;
+          continue;
+        }
+        const uint8_t token = tables.token_[c];
+        if (token == 0) {
+          return fail(Error::InvalidHeaderToken);
+        }
+        header_field_mark = p;
+        index_ = 0;
+        state_ = State::HeaderField;
+        switch (token) {
+        case 'c':
+          header_state_ = HeaderState::C;
+          break;
+        case 'p':
+          header_state_ = HeaderState::MatchingProxyConnection;
+          break;
+        case 't':
+          header_state_ = HeaderState::MatchingTransferEncoding;
+          break;
+        case 'u':
+          header_state_ = HeaderState::MatchingUpgrade;
+          break;
+        default:
+          header_state_ = HeaderState::General;
+          break;
+        }
+        break;
+      }
+
+      case State::HeaderField: {
+        const char* q = p;
+        // Only the names of the few headers the parser acts on are matched byte by byte.
+        for (; q != end && header_state_ != HeaderState::General; ++q) {
+          const uint8_t token = tables.token_[static_cast<uint8_t>(*q)];
+          if (token == 0) {
+            break;
+          }
+          ++index_;
+          switch (header_state_) {
+          case HeaderState::C:
+            header_state_ = token == 'o' ? HeaderState::CO : HeaderState::General;
+            break;
+          case HeaderState::CO:
+            header_state_ = token == 'n' ? HeaderState::CON : HeaderState::General;
+            break;
+          case HeaderState::CON:
+            header_state_ = token == 'n'   ? HeaderState::MatchingConnection
+                            : token == 't' ? HeaderState::MatchingContentLength
+                                           : HeaderState::General;
+            break;
+          case HeaderState::MatchingConnection:
+            header_state_ =
+                matchToken(ConnectionToken, index_, token, HeaderState::MatchingConnection,
+                           HeaderState::General, HeaderState::Connection);
+            break;
+          case HeaderState::MatchingProxyConnection:
+            header_state_ =
+                matchToken(ProxyConnectionToken, index_, token,
+                           HeaderState::MatchingProxyConnection, HeaderState::General,
+                           HeaderState::Connection);
+            break;
+          case HeaderState::MatchingContentLength:
+            header_state_ =
+                matchToken(ContentLengthToken, index_, token, HeaderState::MatchingContentLength,
+                           HeaderState::General, HeaderState::ContentLength);
+            break;
+          case HeaderState::MatchingTransferEncoding:
+            header_state_ =
+                matchToken(TransferEncodingToken, index_, token,
+                           HeaderState::MatchingTransferEncoding, HeaderState::General,
+                           HeaderState::TransferEncoding);
+            break;
+          case HeaderState::MatchingUpgrade:
+            header_state_ =
+                matchToken(UpgradeToken, index_, token, HeaderState::MatchingUpgrade,
+                           HeaderState::General, HeaderState::Upgrade);
+            break;
+          case HeaderState::Connection:
+          case HeaderState::ContentLength:
+          case HeaderState::TransferEncoding:
+          case HeaderState::Upgrade:
+            // Trailing spaces are allowed after the matched name.
+            if (*q != ' ') {
+              header_state_ = HeaderState::General;
+            }
+            break;
+          default:
+            NOT_REACHED_GCOVR_EXCL_LINE;
+          }
+        }
+        while (q != end && tables.token_[static_cast<uint8_t>(*q)] != 0) {
+          ++q;
+        }
+        if (!skipTo(p, q, end)) {
+          return fail(Error::HeaderOverflow);
+        }
+        if (q == end) {
+          break;
+        }
+        if (*p != ':') {
+          return fail(Error::InvalidHeaderToken);
+        }
+        state_ = State::HeaderValueDiscardWs;
+        if (!emitData(&ParserCallbacks::onHeaderField, header_field_mark, p)) {
+          return p - data + 1;
+        }
+        break;
+      }
+
+      case State::HeaderValueDiscardWs:
+        if (c == ' ' || c == '\t') {
+          break;
+        }
+        if (c == CR) {
+          state_ = State::HeaderValueDiscardWsAlmostDone;
+          break;
+        }
+        if (c == LF) {
+          state_ = State::HeaderValueDiscardLws;
+          break;
+        }
+        FALLTHRU;
+
+      case State::HeaderValueStart:
+        // Note that the first byte of a value is not validated.
+        header_value_mark = p;
+        state_ = State::HeaderValue;
+        index_ = 0;
+        switch (header_state_) {
+        case HeaderState::Upgrade:
+          flags_ |= Flags::Upgrade;
+          header_state_ = HeaderState::General;
+          break;
+        case HeaderState::TransferEncoding:
+          header_state_ = lower(c) == 'c' ? HeaderState::MatchingTransferEncodingChunked
+                                          : HeaderState::General;
+          break;
+        case HeaderState::ContentLength:
+          if (!isNum(c)) {
+            return fail(Error::InvalidContentLength);
+          }
+          if (flags_ & Flags::ContentLength) {
+            return fail(Error::UnexpectedContentLength);
+          }
+          flags_ |= Flags::ContentLength;
+          content_length_ = c - '0';
+          header_state_ = HeaderState::ContentLengthNum;
+          break;
+        case HeaderState::ContentLengthWs:
+          // A folded content-length value.
+          break;
+        case HeaderState::Connection:
+          switch (lower(c)) {
+          case 'k':
+            header_state_ = HeaderState::MatchingConnectionKeepAlive;
+            break;
+          case 'c':
+            header_state_ = HeaderState::MatchingConnectionClose;
+            break;
+          case 'u':
+            header_state_ = HeaderState::MatchingConnectionUpgrade;
+            break;
+          default:
+            header_state_ = HeaderState::MatchingConnectionToken;
+            break;
+          }
+          break;
+        case HeaderState::MatchingConnectionTokenStart:
+          // A folded connection value.
+          break;
+        default:
+          header_state_ = HeaderState::General;
+          break;
+        }
+        break;
+
+      case State::HeaderValue: {
+        const char* q = p;
+        for (; q != end; ++q) {
+          const uint8_t v = *q;
+          if (v == CR || v == LF) {
+            break;
+          }
+          if (!isHeaderChar(v)) {
+            p = q;
+            return fail(Error::InvalidHeaderToken);
+          }
+          if (header_state_ == HeaderState::General) {
+            q = findHeaderValueEnd(q, end);
+            if (q == end) {
+              break;
+            }
+            // Let the loop look at the byte that ended the run.
+            --q;
+            continue;
+          }
+          const uint8_t l = lower(v);
+          switch (header_state_) {
+          case HeaderState::ContentLength:
+            if (v == ' ') {
+              break;
+            }
+            header_state_ = HeaderState::ContentLengthNum;
+            FALLTHRU;
+          case HeaderState::ContentLengthNum:
+            if (v == ' ') {
+              header_state_ = HeaderState::ContentLengthWs;
+              break;
+            }
+            if (!isNum(v) || (NoContentLength - 10) / 10 < content_length_) {
+              p = q;
+              return fail(Error::InvalidContentLength);
+            }
+            content_length_ = content_length_ * 10 + (v - '0');
+            break;
+          case HeaderState::ContentLengthWs:
+            if (v != ' ') {
+              p = q;
+              return fail(Error::InvalidContentLength);
+            }
+            break;
+          case HeaderState::MatchingTransferEncodingChunked:
+            header_state_ =
+                matchToken(ChunkedToken, ++index_, l, HeaderState::MatchingTransferEncodingChunked,
+                           HeaderState::General, HeaderState::TransferEncodingChunked);
+            break;
+          case HeaderState::MatchingConnectionTokenStart:
+            if (l == 'k') {
+              header_state_ = HeaderState::MatchingConnectionKeepAlive;
+            } else if (l == 'c') {
+              header_state_ = HeaderState::MatchingConnectionClose;
+            } else if (l == 'u') {
+              header_state_ = HeaderState::MatchingConnectionUpgrade;
+            } else if (l != ' ' && tables.token_[l] != 0) {
+              header_state_ = HeaderState::MatchingConnectionToken;
+            } else if (l == ' ' || l == '\t') {
+              // Skip whitespace between tokens.
+            } else {
+              header_state_ = HeaderState::General;
+            }
+            break;
+          case HeaderState::MatchingConnectionKeepAlive:
+            header_state_ =
+                matchToken(KeepAliveToken, ++index_, l, HeaderState::MatchingConnectionKeepAlive,
+                           HeaderState::MatchingConnectionToken, HeaderState::ConnectionKeepAlive);
+            break;
+          case HeaderState::MatchingConnectionClose:
+            header_state_ =
+                matchToken(CloseToken, ++index_, l, HeaderState::MatchingConnectionClose,
+                           HeaderState::MatchingConnectionToken, HeaderState::ConnectionClose);
+            break;
+          case HeaderState::MatchingConnectionUpgrade:
+            header_state_ =
+                matchToken(UpgradeToken, ++index_, l, HeaderState::MatchingConnectionUpgrade,
+                           HeaderState::MatchingConnectionToken, HeaderState::ConnectionUpgrade);
+            break;
+          case HeaderState::MatchingConnectionToken:
+            if (v == ',') {
+              header_state_ = HeaderState::MatchingConnectionTokenStart;
+              index_ = 0;
+            }
+            break;
+          case HeaderState::TransferEncodingChunked:
+            if (v != ' ') {
+              header_state_ = HeaderState::General;
+            }
+            break;
+          case HeaderState::ConnectionKeepAlive:
+          case HeaderState::ConnectionClose:
+          case HeaderState::ConnectionUpgrade:
+            if (v == ',') {
+              finishHeaderValue();
+              header_state_ = HeaderState::MatchingConnectionTokenStart;
+              index_ = 0;
+            } else if (v != ' ') {
+              header_state_ = HeaderState::MatchingConnectionToken;
+            }
+            break;
+          default:
+            header_state_ = HeaderState::General;
+            break;
+          }
+        }
+        if (!skipTo(p, q, end)) {
+          return fail(Error::HeaderOverflow);
+        }
+        if (q == end) {
+          break;
+        }
+        state_ = State::HeaderAlmostDone;
+        if (*p == CR) {
+          if (!emitData(&ParserCallbacks::onHeaderValue, header_value_mark, p)) {
+            return p - data + 1;
+          }
+          break;
+        }
+        // The LF is looked at again as the end of the header line.
+        if (!emitData(&ParserCallbacks::onHeaderValue, header_value_mark, p)) {
+          return p - data;
+        }
+        reexecute = true;
+        continue;
+      }
+
+      case State::HeaderAlmostDone:
+        if (c != LF) {
+          return fail(Error::LfExpected);
+        }
+        state_ = State::HeaderValueLws;
+        break;
+
+      case State::HeaderValueLws:
+        if (c == ' ' || c == '\t') {
+          // Obsolete line folding, the value goes on.
+          if (header_state_ == HeaderState::ContentLengthNum) {
+            header_state_ = HeaderState::ContentLengthWs;
+          }
+          state_ = State::HeaderValueStart;
+          reexecute = true;
+          continue;
+        }
+        finishHeaderValue();
+        state_ = State::HeaderFieldStart;
+        reexecute = true;
+        continue;
+
+      case State::HeaderValueDiscardWsAlmostDone:
+        state_ = State::HeaderValueDiscardLws;
+        break;
+
+      case State::HeaderValueDiscardLws:
+        if (c == ' ' || c == '\t') {
+          state_ = State::HeaderValueDiscardWs;
+          break;
+        }
+        if (header_state_ == HeaderState::ContentLength) {
+          // Empty content-length values are not allowed.
+          return fail(Error::InvalidContentLength);
+        }
+        finishHeaderValue();
+        // The value is empty.
+        header_value_mark = p;
+        state_ = State::HeaderFieldStart;
+        if (!emitData(&ParserCallbacks::onHeaderValue, header_value_mark, p)) {
+          return p - data;
+        }
+        reexecute = true;
+        continue;
+
+      case State::HeadersAlmostDone: {
+        if (flags_ & Flags::Trailing) {
+          // End of a chunked message.
+          state_ = State::MessageDone;
+          reexecute = true;
+          continue;
+        }
+        // Chunked encoding and a content-length header can't be used together.
+        if ((flags_ & Flags::Chunked) && (flags_ & Flags::ContentLength)) {
+          return fail(Error::UnexpectedContentLength);
+        }
+        state_ = State::HeadersDone;
+        if ((flags_ & Flags::Upgrade) && (flags_ & Flags::ConnectionUpgrade)) {
+          // For responses, Upgrade and Connection: upgrade only mean an upgrade with a 101.
+          upgrade_ = type_ == MessageType::Request || status_code_ == 101;
+        } else {
+          upgrade_ = method_ == Method::Connect;
+        }
+        switch (callbacks_.onHeadersCompleteBase()) {
+        case 0:
+          break;
+        case 2:
+          upgrade_ = true;
+          FALLTHRU;
+        case 1:
+          flags_ |= Flags::SkipBody;
+          break;
+        default:
+          error_ = Error::CbHeadersComplete;
+          return p - data;
+        }
+        if (paused_) {
+          return p - data;
+        }
+        reexecute = true;
+        continue;
+      }
+
+      case State::HeadersDone: {
+        header_bytes_ = 0;
+        const bool has_body = (flags_ & Flags::Chunked) ||
+                              (content_length_ > 0 && content_length_ != NoContentLength);
+        if (upgrade_ &&
+            (method_ == Method::Connect || (flags_ & Flags::SkipBody) || !has_body)) {
+          // The rest of the input is in a different protocol.
+          state_ = startState();
+          callbacks_.onMessageCompleteBase();
+          return p - data + 1;
+        }
+        if (flags_ & Flags::SkipBody) {
+          state_ = startState();
+        } else if (flags_ & Flags::Chunked) {
+          state_ = State::ChunkSizeStart;
+          break;
+        } else if (content_length_ == 0) {
+          state_ = startState();
+        } else if (content_length_ != NoContentLength) {
+          state_ = State::BodyIdentity;
+          break;
+        } else if (!messageNeedsEof()) {
+          // No content-length means no body.
+          state_ = startState();
+        } else {
+          // The body ends with the connection.
+          state_ = State::BodyIdentityEof;
+          break;
+        }
+        callbacks_.onMessageCompleteBase();
+        if (paused_) {
+          return p - data + 1;
+        }
+        break;
+      }
+
+      case State::ChunkSizeStart: {
+        const int8_t value = tables.unhex_[c];
+        if (value < 0) {
+          return fail(Error::InvalidChunkSize);
+        }
+        content_length_ = value;
+        state_ = State::ChunkSize;
+        break;
+      }
+
+      case State::ChunkSize: {
+        if (c == CR) {
+          state_ = State::ChunkSizeAlmostDone;
+          break;
+        }
+        const int8_t value = tables.unhex_[c];
+        if (value < 0) {
+          if (c == ';' || c == ' ') {
+            state_ = State::ChunkParameters;
+            break;
+          }
+          return fail(Error::InvalidChunkSize);
+        }
+        if ((NoContentLength - 16) / 16 < content_length_) {
+          return fail(Error::InvalidContentLength);
+        }
+        content_length_ = content_length_ * 16 + value;
+        break;
+      }
+
+      case State::ChunkParameters: {
+        // Chunk extensions are ignored.
+        const char* cr = static_cast<const char*>(memchr(p, CR, end - p));
+        if (cr == nullptr) {
+          p = end - 1;
+          break;
+        }
+        p = cr;
+        state_ = State::ChunkSizeAlmostDone;
+        break;
+      }
+
+      case State::ChunkSizeAlmostDone:
+        header_bytes_ = 0;
+        if (content_length_ == 0) {
+          // The last chunk, trailers follow.
+          flags_ |= Flags::Trailing;
+          state_ = State::HeaderFieldStart;
+        } else {
+          state_ = State::ChunkData;
+        }
+        break;
+
+      case State::ChunkData: {
+        const uint64_t to_read = std::min<uint64_t>(content_length_, end - p);
+        if (body_mark == nullptr) {
+          body_mark = p;
+        }
+        content_length_ -= to_read;
+        p += to_read - 1;
+        if (content_length_ == 0) {
+          state_ = State::ChunkDataAlmostDone;
+        }
+        break;
+      }
+
+      case State::ChunkDataAlmostDone:
+        state_ = State::ChunkDataDone;
+        if (!emitData(&ParserCallbacks::onBody, body_mark, p)) {
+          return p - data + 1;
+        }
+        break;
+
+      case State::ChunkDataDone:
+        header_bytes_ = 0;
+        state_ = State::ChunkSizeStart;
+        break;
+
+      case State::BodyIdentity: {
+        const uint64_t to_read = std::min<uint64_t>(content_length_, end - p);
+        if (body_mark == nullptr) {
+          body_mark = p;
+        }
+        content_length_ -= to_read;
+        p += to_read - 1;
+        if (content_length_ == 0) {
+          // Hand out the body including the byte at p, then look at p again to complete the
+          // message.
+          state_ = State::MessageDone;
+          if (!emitData(&ParserCallbacks::onBody, body_mark, p + 1)) {
+            return p - data;
+          }
+          reexecute = true;
+          continue;
+        }
+        break;
+      }
+
+      case State::BodyIdentityEof:
+        if (body_mark == nullptr) {
+          body_mark = p;
+        }
+        p = end - 1;
+        break;
+
+      case State::MessageDone:
+        state_ = startState();
+        callbacks_.onMessageCompleteBase();
+        if (paused_ || upgrade_) {
+          // After an upgrade the rest of the input is in a different protocol.
+          return p - data + 1;
+        }
+        break;
+
+      case State::Dead:
+        NOT_REACHED_GCOVR_EXCL_LINE;
+      }
+    } while (reexecute);
+  }
+
+  // Hand out what is left of the span that goes on in the next input. At most one is marked.
+  emitData(&ParserCallbacks::onHeaderField, header_field_mark, end);
+  emitData(&ParserCallbacks::onHeaderValue, header_value_mark, end);
+  emitData(&ParserCallbacks::onUrl, url_mark, end);
+  emitData(&ParserCallbacks::onBody, body_mark, end);
+  return length;
+}
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/http/http1/parser.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+/**
+ * HTTP/1 parser that accepts the same messages as http_parser, as Envoy builds it (without
+ * HTTP_PARSER_STRICT), and fails with the same errors. Unlike http_parser it does not step its
+ * state machine for every byte of URLs, header names, header values and bodies: it scans each run
+ * for the byte that ends it, 16 bytes at a time where SSE2 is available, and validates the run
+ * along the way. URLs, header names, header values and bodies are handed to the callbacks as spans
+ * of the input, split only where the input is.
+ */
+class FastHttpParserImpl : public Parser {
+public:
+  FastHttpParserImpl(MessageType type, ParserCallbacks& callbacks);
+
+  // Http1::Parser
+  size_t execute(const char* data, size_t length) override;
+  void resume() override { paused_ = false; }
+  void pause() override { paused_ = true; }
+  ParserStatus getStatus() const override;
+  absl::string_view errorName() const override;
+  uint16_t statusCode() const override { return status_code_; }
+  int httpMajor() const override { return http_major_; }
+  int httpMinor() const override { return http_minor_; }
+  absl::optional<uint64_t> contentLength() const override;
+  bool isChunked() const override { return flags_ & Flags::Chunked; }
+  absl::string_view methodName() const override;
+
+private:
+  // The states below mirror those of http_parser, so that both parsers can be checked against
+  // each other state by state.
+  enum class State : uint8_t {
+    StartReq,
+    ReqMethod,
+    ReqSpacesBeforeUrl,
+    ReqSchema,
+    ReqSchemaSlash,
+    ReqSchemaSlashSlash,
+    ReqServerStart,
+    ReqServer,
+    ReqServerWithAt,
+    ReqPath,
+    ReqQueryStringStart,
+    ReqQueryString,
+    ReqFragmentStart,
+    ReqFragment,
+    ReqHttpStart,
+    ReqHttpH,
+    ReqHttpHT,
+    ReqHttpHTT,
+    ReqHttpI,
+    ReqHttpIC,
+    ReqHttpHTTP,
+    ReqHttpMajor,
+    ReqHttpDot,
+    ReqHttpMinor,
+    ReqHttpEnd,
+    ReqLineAlmostDone,
+
+    StartRes,
+    ResH,
+    ResHT,
+    ResHTT,
+    ResHTTP,
+    ResHttpMajor,
+    ResHttpDot,
+    ResHttpMinor,
+    ResHttpEnd,
+    ResFirstStatusCode,
+    ResStatusCode,
+    ResStatusStart,
+    ResStatus,
+    ResLineAlmostDone,
+
+    HeaderFieldStart,
+    HeaderField,
+    HeaderValueDiscardWs,
+    HeaderValueDiscardWsAlmostDone,
+    HeaderValueDiscardLws,
+    HeaderValueStart,
+    HeaderValue,
+    HeaderValueLws,
+    HeaderAlmostDone,
+    HeadersAlmostDone,
+    // All states up to here parse the start line or a header section.
+    HeadersDone,
+
+    ChunkSizeStart,
+    ChunkSize,
+    ChunkParameters,
+    ChunkSizeAlmostDone,
+    ChunkData,
+    ChunkDataAlmostDone,
+    ChunkDataDone,
+    BodyIdentity,
+    BodyIdentityEof,
+    MessageDone,
+
+    // Only returned by URL parsing to reject a byte, never entered.
+    Dead,
+  };
+
+  // What is known about the header being parsed, from its name and as much of its value as has
+  // been seen.
+  enum class HeaderState : uint8_t {
+    General,
+    C,
+    CO,
+    CON,
+    MatchingConnection,
+    MatchingProxyConnection,
+    MatchingContentLength,
+    MatchingTransferEncoding,
+    MatchingUpgrade,
+    Connection,
+    ContentLength,
+    ContentLengthNum,
+    ContentLengthWs,
+    TransferEncoding,
+    Upgrade,
+    MatchingTransferEncodingChunked,
+    MatchingConnectionTokenStart,
+    MatchingConnectionKeepAlive,
+    MatchingConnectionClose,
+    MatchingConnectionUpgrade,
+    MatchingConnectionToken,
+    TransferEncodingChunked,
+    ConnectionKeepAlive,
+    ConnectionClose,
+    ConnectionUpgrade,
+  };
+
+  // In http_parser's order, which is also the order of its http_method enum.
+  enum class Method : uint8_t {
+    Delete,
+    Get,
+    Head,
+    Post,
+    Put,
+    Connect,
+    Options,
+    Trace,
+    Copy,
+    Lock,
+    Mkcol,
+    Move,
+    Propfind,
+    Proppatch,
+    Search,
+    Unlock,
+    Bind,
+    Rebind,
+    Unbind,
+    Acl,
+    Report,
+    Mkactivity,
+    Checkout,
+    Merge,
+    Msearch,
+    Notify,
+    Subscribe,
+    Unsubscribe,
+    Patch,
+    Purge,
+    Mkcalendar,
+    Link,
+    Unlink,
+    Source,
+  };
+
+  // Named after the http_parser errors they stand for.
+  enum class Error : uint8_t {
+    Ok,
+    CbHeadersComplete,
+    InvalidEofState,
+    HeaderOverflow,
+    InvalidVersion,
+    InvalidStatus,
+    InvalidMethod,
+    InvalidUrl,
+    InvalidConstant,
+    LfExpected,
+    InvalidHeaderToken,
+    InvalidContentLength,
+    UnexpectedContentLength,
+    InvalidChunkSize,
+  };
+
+  struct Flags {
+    static constexpr uint8_t Chunked = 1 << 0;
+    static constexpr uint8_t ConnectionKeepAlive = 1 << 1;
+    static constexpr uint8_t ConnectionClose = 1 << 2;
+    static constexpr uint8_t ConnectionUpgrade = 1 << 3;
+    static constexpr uint8_t Trailing = 1 << 4;
+    static constexpr uint8_t Upgrade = 1 << 5;
+    static constexpr uint8_t SkipBody = 1 << 6;
+    static constexpr uint8_t ContentLength = 1 << 7;
+  };
+
+  bool parsingHeader() const { return state_ <= State::HeadersDone; }
+  State startState() const {
+    return type_ == MessageType::Request ? State::StartReq : State::StartRes;
+  }
+  bool messageNeedsEof() const;
+  // Hands the span from mark to at to the callback, if a span is marked, and clears the mark.
+  // Returns false if the callback paused the parser.
+  bool emitData(void (ParserCallbacks::*callback)(const char*, size_t), const char*& mark,
+                const char* at);
+  // Counts bytes of the start line and header sections. Returns false once there are too many.
+  bool countHeaderBytes(uint64_t count);
+  // Moves p to at, the byte that ends a run that needs no more work, or to the last byte of the
+  // input if the run goes on to its end. Counts the skipped bytes like countHeaderBytes().
+  bool skipTo(const char*& p, const char* at, const char* end);
+  // Applies the header state reached at the end of a header value to the message flags.
+  void finishHeaderValue();
+  size_t onEof();
+
+  // The state after byte c of a request target in state s, or State::Dead if c is not allowed.
+  static State parseUrlChar(State s, uint8_t c);
+  // Switches method to the one that byte c at index of its name tells apart from the other
+  // methods starting with the same letter. Returns false if there is none.
+  static bool nextMethod(Method& method, uint8_t index, uint8_t c);
+  // The header state after byte c, the lower cased byte at index of a name or value being matched
+  // against token: matching while the match goes on, done once all of token matched and mismatch
+  // if c does not match.
+  static HeaderState matchToken(absl::string_view token, uint8_t index, uint8_t c,
+                                HeaderState matching, HeaderState mismatch, HeaderState done);
+
+  ParserCallbacks& callbacks_;
+  const MessageType type_;
+  State state_;
+  HeaderState header_state_{HeaderState::General};
+  Error error_{Error::Ok};
+  bool paused_{false};
+  bool upgrade_{false};
+  Method method_{Method::Delete};
+  uint8_t flags_{0};
+  // Position in the method name or header token being matched.
+  uint8_t index_{0};
+  uint8_t http_major_{0};
+  uint8_t http_minor_{0};
+  uint16_t status_code_{0};
+  uint64_t header_bytes_{0};
+  uint64_t content_length_{0};
+};
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,75 @@
+#include "common/http/http1/legacy_parser_impl.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+ParserCallbacks& callbacks(http_parser* parser) {
+  return *static_cast<ParserCallbacks*>(parser->data);
+}
+
+} // namespace
+
+http_parser_settings LegacyHttpParserImpl::settings_{
+    [](http_parser* parser) -> int {
+      callbacks(parser).onMessageBeginBase();
+      return 0;
+    },
+    [](http_parser* parser, const char* at, size_t length) -> int {
+      callbacks(parser).onUrl(at, length);
+      return 0;
+    },
+    nullptr, // on_status
+    [](http_parser* parser, const char* at, size_t length) -> int {
+      callbacks(parser).onHeaderField(at, length);
+      return 0;
+    },
+    [](http_parser* parser, const char* at, size_t length) -> int {
+      callbacks(parser).onHeaderValue(at, length);
+      return 0;
+    },
+    [](http_parser* parser) -> int { return callbacks(parser).onHeadersCompleteBase(); },
+    [](http_parser* parser, const char* at, size_t length) -> int {
+      callbacks(parser).onBody(at, length);
+      return 0;
+    },
+    [](http_parser* parser) -> int {
+      callbacks(parser).onMessageCompleteBase();
+      return 0;
+    },
+    nullptr, // on_chunk_header
+    nullptr  // on_chunk_complete
+};
+
+LegacyHttpParserImpl::LegacyHttpParserImpl(MessageType type, ParserCallbacks& callbacks) {
+  http_parser_init(&parser_, type == MessageType::Request ? HTTP_REQUEST : HTTP_RESPONSE);
+  parser_.data = &callbacks;
+}
+
+size_t LegacyHttpParserImpl::execute(const char* data, size_t length) {
+  return http_parser_execute(&parser_, &settings_, data, length);
+}
+
+ParserStatus LegacyHttpParserImpl::getStatus() const {
+  switch (HTTP_PARSER_ERRNO(&parser_)) {
+  case HPE_OK:
+    return ParserStatus::Ok;
+  case HPE_PAUSED:
+    return ParserStatus::Paused;
+  default:
+    return ParserStatus::Error;
+  }
+}
+
+absl::optional<uint64_t> LegacyHttpParserImpl::contentLength() const {
+  // http_parser uses ULLONG_MAX to mean that no content-length header was present.
+  if (parser_.content_length == ULLONG_MAX) {
+    return absl::nullopt;
+  }
+  return parser_.content_length;
+}
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
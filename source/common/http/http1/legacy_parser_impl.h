@@ -0,0 +1,43 @@
+#pragma once
+
+#include <http_parser.h>
+
+#include "common/http/http1/parser.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+/**
+ * Parser backed by the nodejs http_parser library.
+ */
+class LegacyHttpParserImpl : public Parser {
+public:
+  LegacyHttpParserImpl(MessageType type, ParserCallbacks& callbacks);
+
+  // Http1::Parser
+  size_t execute(const char* data, size_t length) override;
+  void resume() override { http_parser_pause(&parser_, 0); }
+  void pause() override { http_parser_pause(&parser_, 1); }
+  ParserStatus getStatus() const override;
+  absl::string_view errorName() const override {
+    return http_errno_name(HTTP_PARSER_ERRNO(&parser_));
+  }
+  uint16_t statusCode() const override { return parser_.status_code; }
+  int httpMajor() const override { return parser_.http_major; }
+  int httpMinor() const override { return parser_.http_minor; }
+  absl::optional<uint64_t> contentLength() const override;
+  bool isChunked() const override { return parser_.flags & F_CHUNKED; }
+  absl::string_view methodName() const override {
+    return http_method_str(static_cast<http_method>(parser_.method));
+  }
+
+private:
+  static http_parser_settings settings_;
+
+  http_parser parser_;
+};
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
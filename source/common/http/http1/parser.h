@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/pure.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+/**
+ * Callbacks raised by a Parser as it consumes an HTTP/1 message. Data pointers refer directly
+ * into the buffer passed to Parser::execute() and are only valid for the duration of the
+ * callback; a single field, value, URL or body may be delivered across several calls when it
+ * spans buffer slices.
+ */
+class ParserCallbacks {
+public:
+  virtual ~ParserCallbacks() = default;
+
+  /**
+   * Called when a request/response is beginning.
+   */
+  virtual void onMessageBeginBase() PURE;
+
+  /**
+   * Called when URL data is received.
+   * @param data supplies the start address.
+   * @param length supplies the length.
+   */
+  virtual void onUrl(const char* data, size_t length) PURE;
+
+  /**
+   * Called when header field data is received.
+   * @param data supplies the start address.
+   * @param length supplies the length.
+   */
+  virtual void onHeaderField(const char* data, size_t length) PURE;
+
+  /**
+   * Called when header value data is received.
+   * @param data supplies the start address.
+   * @param length supplies the length.
+   */
+  virtual void onHeaderValue(const char* data, size_t length) PURE;
+
+  /**
+   * Called when headers are complete. Note that this only applies to headers and NOT trailers.
+   * End of trailers are signaled via onMessageCompleteBase().
+   * @return 0 if no error, 1 if there should be no body, 2 if there should be no body and no
+   *         further messages on the connection.
+   */
+  virtual int onHeadersCompleteBase() PURE;
+
+  /**
+   * Called when body data is received.
+   * @param data supplies the start address.
+   * @param length supplies the length.
+   */
+  virtual void onBody(const char* data, size_t length) PURE;
+
+  /**
+   * Called when the request/response is complete.
+   */
+  virtual void onMessageCompleteBase() PURE;
+};
+
+enum class MessageType { Request, Response };
+
+enum class ParserStatus {
+  // The parser consumed the input without error.
+  Ok,
+  // A callback paused the parser; execute() returned early and resume() must be called before
+  // more input is accepted.
+  Paused,
+  // The input is not a valid HTTP/1 message.
+  Error,
+};
+
+/**
+ * An HTTP/1 message parser. Implementations must agree exactly on which inputs they accept and
+ * on where they stop, since the codec's error handling and pipelining depend on it.
+ */
+class Parser {
+public:
+  virtual ~Parser() = default;
+
+  /**
+   * Parse a span of input, raising callbacks as message elements are recognized.
+   * @param data supplies the start address, or nullptr to signal end of input.
+   * @param length supplies the length.
+   * @return the number of bytes consumed. This is less than length if the parser was paused or
+   *         hit an error.
+   */
+  virtual size_t execute(const char* data, size_t length) PURE;
+
+  /**
+   * Resume a paused parser.
+   */
+  virtual void resume() PURE;
+
+  /**
+   * Pause the parser. May be called from within callbacks, in which case execute() returns after
+   * the current callback.
+   */
+  virtual void pause() PURE;
+
+  /**
+   * @return the parser status after the last call to execute().
+   */
+  virtual ParserStatus getStatus() const PURE;
+
+  /**
+   * @return a short name for the current error, suitable for error messages.
+   */
+  virtual absl::string_view errorName() const PURE;
+
+  /**
+   * @return the status code of the response being parsed.
+   */
+  virtual uint16_t statusCode() const PURE;
+
+  /**
+   * @return the major and minor HTTP version of the message being parsed.
+   */
+  virtual int httpMajor() const PURE;
+  virtual int httpMinor() const PURE;
+
+  /**
+   * @return the remaining content length of the message being parsed, or absl::nullopt if the
+   *         message has no content-length header.
+   */
+  virtual absl::optional<uint64_t> contentLength() const PURE;
+
+  /**
+   * @return whether the message being parsed uses chunked transfer encoding.
+   */
+  virtual bool isChunked() const PURE;
+
+  /**
+   * @return the method of the request being parsed, as an upper case token such as "GET".
+   */
+  virtual absl::string_view methodName() const PURE;
+};
+
+using ParserPtr = std::unique_ptr<Parser>;
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
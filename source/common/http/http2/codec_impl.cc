@@ -14,7 +14,6 @@
 #include "common/common/cleanup.h"
 #include "common/common/enum_to_int.h"
 #include "common/common/fmt.h"
-#include "common/common/stack_array.h"
 #include "common/common/utility.h"
 #include "common/http/codes.h"
 #include "common/http/exception.h"
@@ -367,6 +366,34 @@ bool checkRuntimeOverride(bool config_value, const char* override_key) {
   return Runtime::runtimeFeatureEnabled(override_key) ? true : config_value;
 }
 
+// DATA payloads smaller than this are copied into the stream's receive buffer. Referencing them
+// costs as much as copying them.
+constexpr size_t MinZeroCopyDataSize = 4096;
+
+// A referenced DATA payload keeps its whole read slice alive, but the stream's receive buffer and
+// its watermarks only account for the payload. Payloads are only referenced if the slice is at
+// most this many times their size, so that a stream never pins more than twice the memory that its
+// flow control limits allow.
+constexpr uint64_t MaxZeroCopySliceToDataRatio = 2;
+
+// A part of a read slice added to a stream's receive buffer without copying. The fragment keeps the
+// slice alive until the buffer releases the fragment, and deletes itself then.
+class RecvDataFragment : public Buffer::BufferFragment {
+public:
+  RecvDataFragment(std::shared_ptr<const Buffer::SliceData> slice, const uint8_t* data, size_t size)
+      : slice_(std::move(slice)), data_(data), size_(size) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return data_; }
+  size_t size() const override { return size_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const Buffer::SliceData> slice_;
+  const uint8_t* const data_;
+  const size_t size_;
+};
+
 } // namespace
 
 ConnectionImpl::ConnectionImpl(Network::Connection& connection, Stats::Scope& stats,
@@ -403,26 +430,30 @@ ConnectionImpl::~ConnectionImpl() { nghttp2_session_del(session_); }
 
 void ConnectionImpl::dispatch(Buffer::Instance& data) {
   ENVOY_CONN_LOG(trace, "dispatching {} bytes", connection_, data.length());
-  uint64_t num_slices = data.getRawSlices(nullptr, 0);
-  STACK_ARRAY(slices, Buffer::RawSlice, num_slices);
-  data.getRawSlices(slices.begin(), num_slices);
-  for (const Buffer::RawSlice& slice : slices) {
+  uint64_t dispatched_bytes = 0;
+  // Take ownership of each slice while nghttp2 parses it, so that onData() can pass DATA payloads,
+  // which nghttp2 hands back as pointers into its input, on to the streams without copying them.
+  // A slice is drained from data before it is parsed, so if parsing it throws, its bytes are gone
+  // from data along with those of the slices before it. The caller closes the connection then.
+  while (data.length() > 0) {
+    current_recv_slice_ = data.extractFrontSlice();
+    const absl::Span<const uint8_t> slice = current_recv_slice_->getData();
     dispatching_ = true;
-    ssize_t rc =
-        nghttp2_session_mem_recv(session_, static_cast<const uint8_t*>(slice.mem_), slice.len_);
+    ssize_t rc = nghttp2_session_mem_recv(session_, slice.data(), slice.size());
     if (rc == NGHTTP2_ERR_FLOODED || flood_detected_) {
       throw FrameFloodException(
           "Flooding was detected in this HTTP/2 session, and it must be closed");
     }
-    if (rc != static_cast<ssize_t>(slice.len_)) {
+    if (rc != static_cast<ssize_t>(slice.size())) {
       throw CodecProtocolException(fmt::format("{}", nghttp2_strerror(rc)));
     }
 
     dispatching_ = false;
+    dispatched_bytes += slice.size();
   }
+  current_recv_slice_.reset();
 
-  ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, data.length());
-  data.drain(data.length());
+  ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, dispatched_bytes);
 
   // Decoding incoming frames can generate outbound frames so flush pending.
   sendPendingFrames();
@@ -436,7 +467,15 @@ int ConnectionImpl::onData(int32_t stream_id, const uint8_t* data, size_t len) {
   StreamImpl* stream = getStream(stream_id);
   // If this results in buffering too much data, the watermark buffer will call
   // pendingRecvBufferHighWatermark, resulting in ++read_disable_count_
-  stream->pending_recv_data_.add(data, len);
+  if (len >= MinZeroCopyDataSize && current_recv_slice_ != nullptr &&
+      current_recv_slice_->getCapacity() <= len * MaxZeroCopySliceToDataRatio &&
+      data >= current_recv_slice_->getData().begin() &&
+      data + len <= current_recv_slice_->getData().end()) {
+    stream->pending_recv_data_.addBufferFragment(
+        *new RecvDataFragment(current_recv_slice_, data, len));
+  } else {
+    stream->pending_recv_data_.add(data, len);
+  }
   // Update the window to the peer unless some consumer of this stream's data has hit a flow control
   // limit and disabled reads on this stream
   if (!stream->buffers_overrun()) {
@@ -384,6 +384,9 @@ private:
   void releaseOutboundFrame(const Buffer::OwnedBufferFragmentImpl* fragment);
   void releaseOutboundControlFrame(const Buffer::OwnedBufferFragmentImpl* fragment);
 
+  // The slice nghttp2 is parsing in dispatch(). Large DATA payloads are added to the streams'
+  // receive buffers as fragments of this slice, which share its ownership.
+  std::shared_ptr<const Buffer::SliceData> current_recv_slice_;
   bool dispatching_ : 1;
   bool raised_goaway_ : 1;
   bool pending_deferred_reset_ : 1;
@@ -1,5 +1,6 @@
 #include "common/network/io_socket_handle_impl.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <iostream>
 
@@ -73,52 +74,35 @@ Api::IoCallUint64Result IoSocketHandleImpl::writev(const Buffer::RawSlice* slice
   return sysCallResultToIoCallResult(result);
 }
 
-Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slices,
-                                                    uint64_t num_slice, int flags,
-                                                    const Address::Ip* self_ip,
-                                                    const Address::Instance& peer_address) {
-  const auto* address_base = dynamic_cast<const Address::InstanceBase*>(&peer_address);
-  sockaddr* sock_addr = const_cast<sockaddr*>(address_base->sockAddr());
+namespace {
 
-  STACK_ARRAY(iov, iovec, num_slice);
-  uint64_t num_slices_to_write = 0;
-  for (uint64_t i = 0; i < num_slice; i++) {
-    if (slices[i].mem_ != nullptr && slices[i].len_ != 0) {
-      iov[num_slices_to_write].iov_base = slices[i].mem_;
-      iov[num_slices_to_write].iov_len = slices[i].len_;
-      num_slices_to_write++;
-    }
-  }
-  if (num_slices_to_write == 0) {
-    return Api::ioCallUint64ResultNoError();
-  }
+// The largest UDP payload over IPv4, which bounds the payload of a GSO send.
+constexpr uint64_t MaxUdpGsoPayload = 65507;
+// Linux rejects GSO sends with more than UDP_MAX_SEGMENTS segments.
+constexpr uint64_t MaxUdpGsoSegments = 64;
 
-  struct msghdr message;
-  message.msg_name = reinterpret_cast<void*>(sock_addr);
-  message.msg_namelen = address_base->sockAddrLen();
-  message.msg_iov = iov.begin();
-  message.msg_iovlen = num_slices_to_write;
-  message.msg_flags = 0;
-  auto& os_syscalls = Api::OsSysCallsSingleton::get();
-  if (self_ip == nullptr) {
-    message.msg_control = nullptr;
-    message.msg_controllen = 0;
-    const Api::SysCallSizeResult result = os_syscalls.sendmsg(fd_, &message, flags);
-    return sysCallResultToIoCallResult(result);
-  } else {
-    const size_t space_v6 = CMSG_SPACE(sizeof(in6_pktinfo));
-    // FreeBSD only needs in_addr size, but allocates more to unify code in two platforms.
-    const size_t space_v4 = CMSG_SPACE(sizeof(in_pktinfo));
-    const size_t cmsg_space = (space_v4 < space_v6) ? space_v6 : space_v4;
-    // kSpaceForIp should be big enough to hold both IPv4 and IPv6 packet info.
-    STACK_ARRAY(cbuf, char, cmsg_space);
-    memset(cbuf.begin(), 0, cmsg_space);
+// The control message space needed for the source address of a datagram and its GSO segment size.
+size_t sendCmsgSpace() {
+  const size_t space_v6 = CMSG_SPACE(sizeof(in6_pktinfo));
+  // FreeBSD only needs in_addr size, but allocates more to unify code in two platforms.
+  const size_t space_v4 = CMSG_SPACE(sizeof(in_pktinfo));
+  return std::max(space_v4, space_v6) + CMSG_SPACE(sizeof(uint16_t));
+}
 
-    message.msg_control = cbuf.begin();
-    message.msg_controllen = cmsg_space * sizeof(char);
-    cmsghdr* const cmsg = CMSG_FIRSTHDR(&message);
-    RELEASE_ASSERT(cmsg != nullptr, fmt::format("cbuf with size {} is not enough, cmsghdr size {}",
-                                                sizeof(cbuf), sizeof(cmsghdr)));
+// Fills the control messages of |message| into |cbuf|, which must be sendCmsgSpace() bytes long:
+// the source address to send from unless |self_ip| is nullptr, and the GSO segment size unless
+// |gso_size| is 0.
+void buildSendControlMessages(msghdr& message, char* cbuf, const Address::Ip* self_ip,
+                              uint16_t gso_size) {
+  const size_t cmsg_space = sendCmsgSpace();
+  memset(cbuf, 0, cmsg_space);
+  message.msg_control = cbuf;
+  message.msg_controllen = cmsg_space;
+  size_t cmsg_used = 0;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  RELEASE_ASSERT(cmsg != nullptr, fmt::format("cbuf with size {} is not enough, cmsghdr size {}",
+                                              cmsg_space, sizeof(cmsghdr)));
+  if (self_ip != nullptr) {
     if (self_ip->version() == Address::IpVersion::v4) {
       cmsg->cmsg_level = IPPROTO_IP;
 #ifndef IP_SENDSRCADDR
@@ -127,10 +111,12 @@ Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slic
       auto pktinfo = reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg));
       pktinfo->ipi_ifindex = 0;
       pktinfo->ipi_spec_dst.s_addr = self_ip->ipv4()->address();
+      cmsg_used += CMSG_SPACE(sizeof(in_pktinfo));
 #else
       cmsg->cmsg_type = IP_SENDSRCADDR;
       cmsg->cmsg_len = CMSG_LEN(sizeof(in_addr));
       *(reinterpret_cast<struct in_addr*>(CMSG_DATA(cmsg))).s_addr = self_ip->ipv4()->address();
+      cmsg_used += CMSG_SPACE(sizeof(in_addr));
 #endif
     } else if (self_ip->version() == Address::IpVersion::v6) {
       cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
@@ -139,10 +125,203 @@ Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slic
       auto pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
       pktinfo->ipi6_ifindex = 0;
       *(reinterpret_cast<absl::uint128*>(pktinfo->ipi6_addr.s6_addr)) = self_ip->ipv6()->address();
+      cmsg_used += CMSG_SPACE(sizeof(in6_pktinfo));
     }
-    const Api::SysCallSizeResult result = os_syscalls.sendmsg(fd_, &message, flags);
-    return sysCallResultToIoCallResult(result);
+    cmsg = CMSG_NXTHDR(&message, cmsg);
+  }
+  if (gso_size != 0) {
+    ASSERT(cmsg != nullptr);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    *reinterpret_cast<uint16_t*>(CMSG_DATA(cmsg)) = gso_size;
+    cmsg_used += CMSG_SPACE(sizeof(uint16_t));
+  }
+  if (cmsg_used == 0) {
+    message.msg_control = nullptr;
   }
+  message.msg_controllen = cmsg_used;
+}
+
+// Copies the non-empty slices into |iov|, which must have room for all of them, and returns the
+// number of iovecs used.
+uint64_t slicesToIovecs(const Buffer::RawSlice* slices, uint64_t num_slice, iovec* iov) {
+  uint64_t num_iov = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    if (slices[i].mem_ != nullptr && slices[i].len_ != 0) {
+      iov[num_iov].iov_base = slices[i].mem_;
+      iov[num_iov].iov_len = slices[i].len_;
+      num_iov++;
+    }
+  }
+  return num_iov;
+}
+
+uint64_t messageLength(const IoHandle::SendMsgEntry& message) {
+  uint64_t length = 0;
+  for (uint64_t i = 0; i < message.num_slice_; i++) {
+    length += message.slices_[i].len_;
+  }
+  return length;
+}
+
+bool sameSourceIp(const Address::Ip* a, const Address::Ip* b) {
+  return a == b || (a != nullptr && b != nullptr && a->addressAsString() == b->addressAsString());
+}
+
+// Returns the segment size to send |messages| with as a single GSO datagram, or 0 if they don't
+// qualify. The kernel splits a GSO datagram into equally sized datagrams to a single destination,
+// so all messages need the same addresses and length, except for a shorter last message.
+uint64_t gsoSegmentSize(const IoHandle::SendMsgEntry* messages, uint64_t num_messages) {
+  if (num_messages < 2 || num_messages > MaxUdpGsoSegments) {
+    return 0;
+  }
+  const uint64_t segment_size = messageLength(messages[0]);
+  uint64_t total_size = 0;
+  for (uint64_t i = 0; i < num_messages; i++) {
+    const uint64_t length = i == 0 ? segment_size : messageLength(messages[i]);
+    if (length == 0 || length > segment_size || (length < segment_size && i + 1 < num_messages)) {
+      return 0;
+    }
+    if (i != 0 && (*messages[i].peer_address_ != *messages[0].peer_address_ ||
+                   !sameSourceIp(messages[i].self_ip_, messages[0].self_ip_))) {
+      return 0;
+    }
+    total_size += length;
+  }
+  return total_size <= MaxUdpGsoPayload ? segment_size : 0;
+}
+
+} // namespace
+
+Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slices,
+                                                    uint64_t num_slice, int flags,
+                                                    const Address::Ip* self_ip,
+                                                    const Address::Instance& peer_address) {
+  const auto* address_base = dynamic_cast<const Address::InstanceBase*>(&peer_address);
+  sockaddr* sock_addr = const_cast<sockaddr*>(address_base->sockAddr());
+
+  STACK_ARRAY(iov, iovec, num_slice);
+  const uint64_t num_slices_to_write = slicesToIovecs(slices, num_slice, iov.begin());
+  if (num_slices_to_write == 0) {
+    return Api::ioCallUint64ResultNoError();
+  }
+
+  struct msghdr message;
+  message.msg_name = reinterpret_cast<void*>(sock_addr);
+  message.msg_namelen = address_base->sockAddrLen();
+  message.msg_iov = iov.begin();
+  message.msg_iovlen = num_slices_to_write;
+  message.msg_flags = 0;
+  STACK_ARRAY(cbuf, char, sendCmsgSpace());
+  buildSendControlMessages(message, cbuf.begin(), self_ip, 0);
+  auto& os_syscalls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallSizeResult result = os_syscalls.sendmsg(fd_, &message, flags);
+  return sysCallResultToIoCallResult(result);
+}
+
+Api::IoCallUint64Result IoSocketHandleImpl::sendmmsg(const SendMsgEntry* messages,
+                                                     uint64_t num_messages) {
+  if (num_messages == 0) {
+    return Api::ioCallUint64ResultNoError();
+  }
+  auto& os_syscalls = Api::OsSysCallsSingleton::get();
+
+  uint64_t total_slices = 0;
+  for (uint64_t i = 0; i < num_messages; i++) {
+    total_slices += messages[i].num_slice_;
+  }
+  STACK_ARRAY(iov, iovec, total_slices);
+  const size_t cmsg_space = sendCmsgSpace();
+
+  const uint64_t gso_size = gsoSegmentSize(messages, num_messages);
+  if (gso_size != 0 && os_syscalls.supportsUdpGso()) {
+    // Send all messages as one datagram, which the kernel or the NIC splits into gso_size chunks.
+    uint64_t num_iov = 0;
+    for (uint64_t i = 0; i < num_messages; i++) {
+      num_iov += slicesToIovecs(messages[i].slices_, messages[i].num_slice_, &iov[num_iov]);
+    }
+    const auto* address_base =
+        dynamic_cast<const Address::InstanceBase*>(messages[0].peer_address_);
+    msghdr message;
+    message.msg_name = const_cast<sockaddr*>(address_base->sockAddr());
+    message.msg_namelen = address_base->sockAddrLen();
+    message.msg_iov = iov.begin();
+    message.msg_iovlen = num_iov;
+    message.msg_flags = 0;
+    STACK_ARRAY(cbuf, char, cmsg_space);
+    buildSendControlMessages(message, cbuf.begin(), messages[0].self_ip_, gso_size);
+    const Api::SysCallSizeResult result = os_syscalls.sendmsg(fd_, &message, 0);
+    if (result.rc_ >= 0) {
+      return Api::IoCallUint64Result(num_messages,
+                                     Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+    }
+    if (result.errno_ != EIO) {
+      return sysCallResultToIoCallResult(result);
+    }
+    // EIO means the egress device can't checksum the segments. Send the messages one by one.
+    ENVOY_LOG(debug, "GSO send failed with EIO, falling back to sending datagrams separately");
+  }
+
+  if (!os_syscalls.supportsMmsg()) {
+    uint64_t num_sent = 0;
+    for (; num_sent < num_messages; num_sent++) {
+      const SendMsgEntry& message = messages[num_sent];
+      Api::IoCallUint64Result result = sendmsg(message.slices_, message.num_slice_, 0,
+                                               message.self_ip_, *message.peer_address_);
+      if (!result.ok()) {
+        if (num_sent == 0) {
+          return result;
+        }
+        break;
+      }
+    }
+    return Api::IoCallUint64Result(num_sent,
+                                   Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+  }
+
+  STACK_ARRAY(hdrs, mmsghdr, num_messages);
+  STACK_ARRAY(cbuf, char, cmsg_space * num_messages);
+  // Like sendmsg(), empty messages are skipped rather than sent as empty datagrams. For each header
+  // this keeps the index of the message it was built from.
+  STACK_ARRAY(message_index, uint64_t, num_messages);
+  uint64_t num_hdrs = 0;
+  uint64_t num_iov = 0;
+  for (uint64_t i = 0; i < num_messages; i++) {
+    const uint64_t num_message_iov =
+        slicesToIovecs(messages[i].slices_, messages[i].num_slice_, &iov[num_iov]);
+    if (num_message_iov == 0) {
+      continue;
+    }
+    const auto* address_base =
+        dynamic_cast<const Address::InstanceBase*>(messages[i].peer_address_);
+    msghdr& message = hdrs[num_hdrs].msg_hdr;
+    message.msg_name = const_cast<sockaddr*>(address_base->sockAddr());
+    message.msg_namelen = address_base->sockAddrLen();
+    message.msg_iov = &iov[num_iov];
+    message.msg_iovlen = num_message_iov;
+    message.msg_flags = 0;
+    buildSendControlMessages(message, &cbuf[cmsg_space * num_hdrs], messages[i].self_ip_, 0);
+    hdrs[num_hdrs].msg_len = 0;
+    message_index[num_hdrs] = i;
+    num_hdrs++;
+    num_iov += num_message_iov;
+  }
+  if (num_hdrs == 0) {
+    return Api::IoCallUint64Result(num_messages,
+                                   Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+  }
+  const Api::SysCallIntResult result =
+      os_syscalls.sendmmsg(fd_, hdrs.begin(), static_cast<unsigned int>(num_hdrs), 0);
+  if (result.rc_ < 0) {
+    return sysCallResultToIoCallResult(Api::SysCallSizeResult{result.rc_, result.errno_});
+  }
+  // Report the messages consumed, including the empty ones skipped before the first unsent header.
+  const uint64_t num_sent = static_cast<uint64_t>(result.rc_) < num_hdrs
+                                ? message_index[result.rc_]
+                                : num_messages;
+  return Api::IoCallUint64Result(num_sent,
+                                 Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
 }
 
 Api::IoCallUint64Result
@@ -209,27 +388,35 @@ absl::optional<uint32_t> maybeGetPacketsDroppedFromHeader(
   return absl::nullopt;
 }
 
+namespace {
+
+absl::optional<uint64_t> maybeGetUdpGroSizeFromHeader(const struct cmsghdr& cmsg) {
+  if (cmsg.cmsg_level == SOL_UDP && cmsg.cmsg_type == UDP_GRO) {
+    return *reinterpret_cast<const int*>(CMSG_DATA(&cmsg));
+  }
+  return absl::nullopt;
+}
+
+// The minimum cmsg buffer size to filled in destination address, packets dropped and GRO segment
+// size when receiving a packet. It is possible for a received packet to contain both IPv4 and
+// IPv6 addresses.
+size_t recvCmsgSpace() {
+  return CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(struct in_pktinfo)) +
+         CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int));
+}
+
+} // namespace
+
 Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
                                                     const uint64_t num_slice, uint32_t self_port,
                                                     RecvMsgOutput& output) {
 
-  // The minimum cmsg buffer size to filled in destination address and packets dropped when
-  // receiving a packet. It is possible for a received packet to contain both IPv4 and IPv6
-  // addresses.
-  const size_t cmsg_space = CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(struct in_pktinfo)) +
-                            CMSG_SPACE(sizeof(struct in6_pktinfo));
+  const size_t cmsg_space = recvCmsgSpace();
   STACK_ARRAY(cbuf, char, cmsg_space);
   memset(cbuf.begin(), 0, cmsg_space);
 
   STACK_ARRAY(iov, iovec, num_slice);
-  uint64_t num_slices_for_read = 0;
-  for (uint64_t i = 0; i < num_slice; i++) {
-    if (slices[i].mem_ != nullptr && slices[i].len_ != 0) {
-      iov[num_slices_for_read].iov_base = slices[i].mem_;
-      iov[num_slices_for_read].iov_len = slices[i].len_;
-      ++num_slices_for_read;
-    }
-  }
+  const uint64_t num_slices_for_read = slicesToIovecs(slices, num_slice, iov.begin());
 
   sockaddr_storage peer_addr;
   msghdr hdr;
@@ -249,6 +436,65 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
     return sysCallResultToIoCallResult(result);
   }
 
+  output.msg_len_ = result.rc_;
+  processRecvMsgHeader(hdr, peer_addr, self_port, output);
+  return sysCallResultToIoCallResult(result);
+}
+
+Api::IoCallUint64Result IoSocketHandleImpl::recvmmsg(Buffer::RawSlice* slices,
+                                                     uint64_t num_packets, uint32_t self_port,
+                                                     RecvMsgOutput* outputs) {
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  if (!os_sys_calls.supportsMmsg()) {
+    Api::IoCallUint64Result result = recvmsg(slices, 1, self_port, outputs[0]);
+    if (!result.ok()) {
+      return result;
+    }
+    return Api::IoCallUint64Result(1, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+  }
+
+  const size_t cmsg_space = recvCmsgSpace();
+  STACK_ARRAY(cbuf, char, cmsg_space * num_packets);
+  memset(cbuf.begin(), 0, cmsg_space * num_packets);
+  STACK_ARRAY(iov, iovec, num_packets);
+  STACK_ARRAY(peer_addrs, sockaddr_storage, num_packets);
+  STACK_ARRAY(hdrs, mmsghdr, num_packets);
+  for (uint64_t i = 0; i < num_packets; i++) {
+    iov[i].iov_base = slices[i].mem_;
+    iov[i].iov_len = slices[i].len_;
+
+    msghdr& hdr = hdrs[i].msg_hdr;
+    hdr.msg_name = &peer_addrs[i];
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &iov[i];
+    hdr.msg_iovlen = 1;
+    hdr.msg_flags = 0;
+    auto cmsg = reinterpret_cast<struct cmsghdr*>(&cbuf[cmsg_space * i]);
+    cmsg->cmsg_len = cmsg_space;
+    hdr.msg_control = cmsg;
+    hdr.msg_controllen = cmsg_space;
+    hdrs[i].msg_len = 0;
+  }
+
+  const Api::SysCallIntResult result =
+      os_sys_calls.recvmmsg(fd_, hdrs.begin(), static_cast<unsigned int>(num_packets), 0, nullptr);
+  if (result.rc_ <= 0) {
+    return sysCallResultToIoCallResult(Api::SysCallSizeResult{result.rc_, result.errno_});
+  }
+
+  for (int i = 0; i < result.rc_; i++) {
+    outputs[i].msg_len_ = hdrs[i].msg_len;
+    processRecvMsgHeader(hdrs[i].msg_hdr, peer_addrs[i], self_port, outputs[i]);
+  }
+  return sysCallResultToIoCallResult(Api::SysCallSizeResult{result.rc_, result.errno_});
+}
+
+bool IoSocketHandleImpl::supportsMmsg() const {
+  return Api::OsSysCallsSingleton::get().supportsMmsg();
+}
+
+void IoSocketHandleImpl::processRecvMsgHeader(const msghdr& hdr, const sockaddr_storage& peer_addr,
+                                              uint32_t self_port, RecvMsgOutput& output) {
   RELEASE_ASSERT((hdr.msg_flags & MSG_CTRUNC) == 0,
                  fmt::format("Incorrectly set control message length: {}", hdr.msg_controllen));
   RELEASE_ASSERT(hdr.msg_namelen > 0,
@@ -268,10 +514,11 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
     PANIC(fmt::format("Invalid remote address for fd: {}, error: {}", fd_, e.what()));
   }
 
-  // Get overflow, local and peer addresses from control message.
+  // Get overflow, GRO segment size, local and peer addresses from control message.
   if (hdr.msg_controllen > 0) {
     struct cmsghdr* cmsg;
-    for (cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+    for (cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&hdr), cmsg)) {
       if (output.local_address_ == nullptr) {
         try {
           Address::InstanceConstSharedPtr addr = maybeGetDstAddressFromHeader(*cmsg, self_port);
@@ -284,6 +531,11 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
           PANIC(fmt::format("Invalid destination address for fd: {}, error: {}", fd_, e.what()));
         }
       }
+      absl::optional<uint64_t> maybe_gso_size = maybeGetUdpGroSizeFromHeader(*cmsg);
+      if (maybe_gso_size) {
+        output.gso_size_ = *maybe_gso_size;
+        continue;
+      }
       if (output.dropped_packets_ != nullptr) {
         absl::optional<uint32_t> maybe_dropped = maybeGetPacketsDroppedFromHeader(*cmsg);
         if (maybe_dropped) {
@@ -292,7 +544,6 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
       }
     }
   }
-  return sysCallResultToIoCallResult(result);
 }
 
 } // namespace Network
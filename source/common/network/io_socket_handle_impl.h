@@ -39,10 +39,21 @@ public:
   Api::IoCallUint64Result recvmsg(Buffer::RawSlice* slices, const uint64_t num_slice,
                                   uint32_t self_port, RecvMsgOutput& output) override;
 
+  Api::IoCallUint64Result recvmmsg(Buffer::RawSlice* slices, uint64_t num_packets,
+                                   uint32_t self_port, RecvMsgOutput* outputs) override;
+
+  Api::IoCallUint64Result sendmmsg(const SendMsgEntry* messages, uint64_t num_messages) override;
+
+  bool supportsMmsg() const override;
+
 private:
   // Converts a SysCallSizeResult to IoCallUint64Result.
   Api::IoCallUint64Result sysCallResultToIoCallResult(const Api::SysCallSizeResult& result);
 
+  // Fills the addresses, packets dropped and GRO segment size of a received message into output.
+  void processRecvMsgHeader(const msghdr& hdr, const sockaddr_storage& peer_addr,
+                            uint32_t self_port, RecvMsgOutput& output);
+
   int fd_;
 };
 
@@ -1,5 +1,12 @@
 #include "common/network/raw_buffer_socket.h"
 
+#include <sys/ioctl.h>
+
+#include <algorithm>
+
+#include "envoy/api/os_sys_calls.h"
+
+#include "common/api/os_sys_calls_impl.h"
 #include "common/common/assert.h"
 #include "common/common/empty_string.h"
 #include "common/http/headers.h"
@@ -7,6 +14,48 @@
 namespace Envoy {
 namespace Network {
 
+AdaptiveReadSizeConfig::AdaptiveReadSizeConfig(uint64_t min_read_size, uint64_t max_read_size,
+                                               bool use_pending_bytes, Stats::Scope& scope)
+    : min_read_size_(min_read_size), max_read_size_(max_read_size),
+      use_pending_bytes_(use_pending_bytes),
+      stats_({ALL_RAW_BUFFER_SOCKET_STATS(POOL_COUNTER_PREFIX(scope, "raw_buffer."))}) {
+  ASSERT(min_read_size_ > 0 && min_read_size_ <= max_read_size_);
+}
+
+ReadSizeController::ReadSizeController(const AdaptiveReadSizeConfig& config)
+    : config_(config), read_size_(clamp(InitialReadSize)) {}
+
+uint64_t ReadSizeController::clamp(uint64_t read_size) const {
+  return std::min(std::max(read_size, config_.min_read_size_), config_.max_read_size_);
+}
+
+void ReadSizeController::onPendingBytes(uint64_t pending_bytes) {
+  const uint64_t read_size = clamp(pending_bytes);
+  if (read_size > read_size_) {
+    read_size_ = read_size;
+    config_.stats_.read_size_from_pending_bytes_.inc();
+  }
+}
+
+void ReadSizeController::onRead(uint64_t bytes_read) {
+  if (bytes_read >= read_size_) {
+    if (read_size_ < config_.max_read_size_) {
+      read_size_ = std::min(read_size_ * 2, config_.max_read_size_);
+      config_.stats_.read_size_increased_.inc();
+    }
+  } else if (bytes_read <= read_size_ / 4 && read_size_ > config_.min_read_size_) {
+    read_size_ = std::max(read_size_ / 2, config_.min_read_size_);
+    config_.stats_.read_size_decreased_.inc();
+  }
+}
+
+RawBufferSocket::RawBufferSocket(AdaptiveReadSizeConfigSharedPtr read_size_config)
+    : read_size_config_(std::move(read_size_config)) {
+  if (read_size_config_ != nullptr) {
+    read_size_controller_.emplace(*read_size_config_);
+  }
+}
+
 void RawBufferSocket::setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) {
   ASSERT(!callbacks_);
   callbacks_ = &callbacks;
@@ -16,9 +65,13 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
   PostIoAction action = PostIoAction::KeepOpen;
   uint64_t bytes_read = 0;
   bool end_stream = false;
+  if (read_size_controller_.has_value() && read_size_config_->use_pending_bytes_) {
+    read_size_controller_->onPendingBytes(pendingBytes());
+  }
   do {
-    // 16K read is arbitrary. TODO(mattklein123) PERF: Tune the read size.
-    Api::IoCallUint64Result result = buffer.read(callbacks_->ioHandle(), 16384);
+    const uint64_t read_size =
+        read_size_controller_.has_value() ? read_size_controller_->readSize() : FixedReadSize;
+    Api::IoCallUint64Result result = buffer.read(callbacks_->ioHandle(), read_size);
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "read returns: {}", callbacks_->connection(), result.rc_);
@@ -28,6 +81,9 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
         break;
       }
       bytes_read += result.rc_;
+      if (read_size_controller_.has_value()) {
+        read_size_controller_->onRead(result.rc_);
+      }
       if (callbacks_->shouldDrainReadBuffer()) {
         callbacks_->setReadBufferReady();
         break;
@@ -46,6 +102,17 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
   return {action, bytes_read, end_stream};
 }
 
+uint64_t RawBufferSocket::pendingBytes() {
+  int pending_bytes = 0;
+  const Api::SysCallIntResult result = Api::OsSysCallsSingleton::get().ioctl(
+      callbacks_->ioHandle().fd(), FIONREAD, &pending_bytes);
+  if (result.rc_ < 0 || pending_bytes < 0) {
+    // Not fatal: the read itself will surface any socket error.
+    return 0;
+  }
+  return pending_bytes;
+}
+
 IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   PostIoAction action;
   uint64_t bytes_written = 0;
@@ -88,7 +155,7 @@ void RawBufferSocket::onConnected() { callbacks_->raiseEvent(ConnectionEvent::Co
 
 TransportSocketPtr
 RawBufferSocketFactory::createTransportSocket(TransportSocketOptionsSharedPtr) const {
-  return std::make_unique<RawBufferSocket>();
+  return std::make_unique<RawBufferSocket>(read_size_config_);
 }
 
 bool RawBufferSocketFactory::implementsSecureTransport() const { return false; }
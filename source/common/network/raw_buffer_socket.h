@@ -1,16 +1,93 @@
 #pragma once
 
+#include <memory>
+
 #include "envoy/buffer/buffer.h"
 #include "envoy/network/connection.h"
 #include "envoy/network/transport_socket.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "common/common/logger.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Network {
 
+/**
+ * All raw buffer socket stats. @see stats_macros.h
+ */
+#define ALL_RAW_BUFFER_SOCKET_STATS(COUNTER)                                                       \
+  COUNTER(read_size_decreased)                                                                     \
+  COUNTER(read_size_increased)                                                                     \
+  COUNTER(read_size_from_pending_bytes)
+
+/**
+ * Struct definition for all raw buffer socket stats. @see stats_macros.h
+ */
+struct RawBufferSocketStats {
+  ALL_RAW_BUFFER_SOCKET_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Adaptive read sizing parameters, shared by all the sockets created by one factory.
+ */
+struct AdaptiveReadSizeConfig {
+  AdaptiveReadSizeConfig(uint64_t min_read_size, uint64_t max_read_size, bool use_pending_bytes,
+                         Stats::Scope& scope);
+
+  static constexpr uint64_t DefaultMinReadSize = 4096;
+  static constexpr uint64_t DefaultMaxReadSize = 256 * 1024;
+
+  const uint64_t min_read_size_;
+  const uint64_t max_read_size_;
+  const bool use_pending_bytes_;
+  RawBufferSocketStats stats_;
+};
+
+using AdaptiveReadSizeConfigSharedPtr = std::shared_ptr<const AdaptiveReadSizeConfig>;
+
+/**
+ * Tracks the read size of a single connection. The size doubles every time a read fills the
+ * whole size, and halves every time a read returns no more than a quarter of it, staying within
+ * the configured bounds.
+ */
+class ReadSizeController {
+public:
+  static constexpr uint64_t InitialReadSize = 16384;
+
+  ReadSizeController(const AdaptiveReadSizeConfig& config);
+
+  /**
+   * @return the number of bytes to ask for in the next read.
+   */
+  uint64_t readSize() const { return read_size_; }
+
+  /**
+   * Size the next read to cover the bytes known to be pending on the socket.
+   * @param pending_bytes number of bytes reported as readable by the kernel.
+   */
+  void onPendingBytes(uint64_t pending_bytes);
+
+  /**
+   * Adjust the read size based on the outcome of a read of readSize() bytes.
+   * @param bytes_read number of bytes the read returned.
+   */
+  void onRead(uint64_t bytes_read);
+
+private:
+  uint64_t clamp(uint64_t read_size) const;
+
+  const AdaptiveReadSizeConfig& config_;
+  uint64_t read_size_;
+};
+
 class RawBufferSocket : public TransportSocket, protected Logger::Loggable<Logger::Id::connection> {
 public:
+  RawBufferSocket() = default;
+  RawBufferSocket(AdaptiveReadSizeConfigSharedPtr read_size_config);
+
   // Network::TransportSocket
   void setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) override;
   std::string protocol() const override;
@@ -23,15 +100,29 @@ public:
   Ssl::ConnectionInfoConstSharedPtr ssl() const override { return nullptr; }
 
 private:
+  // Read size used when adaptive read sizing is not configured.
+  static constexpr uint64_t FixedReadSize = 16384;
+
+  uint64_t pendingBytes();
+
   TransportSocketCallbacks* callbacks_{};
   bool shutdown_{};
+  const AdaptiveReadSizeConfigSharedPtr read_size_config_;
+  absl::optional<ReadSizeController> read_size_controller_;
 };
 
 class RawBufferSocketFactory : public TransportSocketFactory {
 public:
+  RawBufferSocketFactory() = default;
+  RawBufferSocketFactory(AdaptiveReadSizeConfigSharedPtr read_size_config)
+      : read_size_config_(std::move(read_size_config)) {}
+
   // Network::TransportSocketFactory
   TransportSocketPtr createTransportSocket(TransportSocketOptionsSharedPtr options) const override;
   bool implementsSecureTransport() const override;
+
+private:
+  const AdaptiveReadSizeConfigSharedPtr read_size_config_;
 };
 
 } // namespace Network
@@ -28,8 +28,10 @@ namespace Envoy {
 namespace Network {
 
 UdpListenerImpl::UdpListenerImpl(Event::DispatcherImpl& dispatcher, SocketSharedPtr socket,
-                                 UdpListenerCallbacks& cb, TimeSource& time_source)
-    : BaseListenerImpl(dispatcher, std::move(socket)), cb_(cb), time_source_(time_source) {
+                                 UdpListenerCallbacks& cb, TimeSource& time_source,
+                                 const UdpReadOptions& read_options)
+    : BaseListenerImpl(dispatcher, std::move(socket)), cb_(cb), time_source_(time_source),
+      max_packets_per_event_(read_options.max_packets_per_event_) {
   file_event_ = dispatcher_.createFileEvent(
       socket_->ioHandle().fd(), [this](uint32_t events) -> void { onSocketEvent(events); },
       Event::FileTriggerType::Edge, Event::FileReadyType::Read | Event::FileReadyType::Write);
@@ -41,6 +43,18 @@ UdpListenerImpl::UdpListenerImpl(Event::DispatcherImpl& dispatcher, SocketShared
     throw CreateListenerException(fmt::format("cannot set post-bound socket option on socket: {}",
                                               socket_->localAddress()->asString()));
   }
+
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  if (read_options.prefer_gro_ && os_sys_calls.supportsUdpGro()) {
+    const int enable = 1;
+    gro_enabled_ = os_sys_calls
+                       .setsockopt(socket_->ioHandle().fd(), SOL_UDP, UDP_GRO, &enable,
+                                   sizeof(enable))
+                       .rc_ == 0;
+    if (!gro_enabled_) {
+      ENVOY_UDP_LOG(warn, "failed to enable UDP_GRO, reading datagrams one by one");
+    }
+  }
 }
 
 UdpListenerImpl::~UdpListenerImpl() {
@@ -69,9 +83,16 @@ void UdpListenerImpl::onSocketEvent(short flags) {
 
 void UdpListenerImpl::handleReadCallback() {
   ENVOY_UDP_LOG(trace, "handleReadCallback");
-  const Api::IoErrorPtr result = Utility::readPacketsFromSocket(
-      socket_->ioHandle(), *socket_->localAddress(), *this, time_source_, packets_dropped_);
-  // TODO(mattklein123): Handle no error when we limit the number of packets read.
+  const Api::IoErrorPtr result =
+      Utility::readPacketsFromSocket(socket_->ioHandle(), *socket_->localAddress(), *this,
+                                     time_source_, packets_dropped_, max_packets_per_event_,
+                                     gro_enabled_, recv_buffers_);
+  if (result == nullptr) {
+    // The packet budget of this event is used up. The socket is edge triggered, so schedule the
+    // remaining packets to be read on the next event loop iteration.
+    file_event_->activate(Event::FileReadyType::Read);
+    return;
+  }
   if (result->getErrorCode() != Api::IoError::IoErrorCode::Again) {
     // TODO(mattklein123): When rate limited logging is implemented log this at error level
     // on a periodic basis.
@@ -115,5 +136,10 @@ Api::IoCallUint64Result UdpListenerImpl::send(const UdpSendData& send_data) {
   return send_result;
 }
 
+Api::IoCallUint64Result UdpListenerImpl::sendBatch(const UdpSendData* data, uint64_t num_packets) {
+  ENVOY_UDP_LOG(trace, "sendBatch {}", num_packets);
+  return Utility::writePacketsToSocket(socket_->ioHandle(), data, num_packets);
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -23,7 +23,8 @@ class UdpListenerImpl : public BaseListenerImpl,
                         protected Logger::Loggable<Logger::Id::udp> {
 public:
   UdpListenerImpl(Event::DispatcherImpl& dispatcher, SocketSharedPtr socket,
-                  UdpListenerCallbacks& cb, TimeSource& time_source);
+                  UdpListenerCallbacks& cb, TimeSource& time_source,
+                  const UdpReadOptions& read_options = UdpReadOptions());
 
   ~UdpListenerImpl() override;
 
@@ -35,6 +36,7 @@ public:
   Event::Dispatcher& dispatcher() override;
   const Address::InstanceConstSharedPtr& localAddress() const override;
   Api::IoCallUint64Result send(const UdpSendData& data) override;
+  Api::IoCallUint64Result sendBatch(const UdpSendData* data, uint64_t num_packets) override;
 
   void processPacket(Address::InstanceConstSharedPtr local_address,
                      Address::InstanceConstSharedPtr peer_address, Buffer::InstancePtr buffer,
@@ -56,6 +58,11 @@ private:
   void onSocketEvent(short flags);
 
   TimeSource& time_source_;
+  const uint32_t max_packets_per_event_;
+  // Whether UDP_GRO is enabled on the socket.
+  bool gro_enabled_{false};
+  // Kept across events so that buffers not filled by a read are not allocated again.
+  UdpRecvBuffers recv_buffers_;
   Event::FileEventPtr file_event_;
 };
 
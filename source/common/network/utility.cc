@@ -1,5 +1,6 @@
 #include "common/network/utility.h"
 
+#include <array>
 #include <cstdint>
 #include <list>
 #include <sstream>
@@ -525,6 +526,163 @@ Api::IoCallUint64Result Utility::writeToSocket(IoHandle& handle, Buffer::RawSlic
   return send_result;
 }
 
+Api::IoCallUint64Result Utility::writePacketsToSocket(IoHandle& handle, const UdpSendData* data,
+                                                      uint64_t num_packets) {
+  uint64_t num_slices = 0;
+  for (uint64_t i = 0; i < num_packets; i++) {
+    num_slices += data[i].buffer_.getRawSlices(nullptr, 0);
+  }
+  STACK_ARRAY(slices, Buffer::RawSlice, num_slices);
+  STACK_ARRAY(messages, IoHandle::SendMsgEntry, num_packets);
+  uint64_t slice_index = 0;
+  for (uint64_t i = 0; i < num_packets; i++) {
+    const uint64_t packet_slices = data[i].buffer_.getRawSlices(&slices[slice_index],
+                                                                num_slices - slice_index);
+    messages[i] = {&slices[slice_index], packet_slices, data[i].local_ip_, &data[i].peer_address_};
+    slice_index += packet_slices;
+  }
+
+  Api::IoCallUint64Result send_result(
+      /*rc=*/0, /*err=*/Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+  do {
+    send_result = handle.sendmmsg(messages.begin(), num_packets);
+  } while (!send_result.ok() &&
+           // Send again if interrupted.
+           send_result.err_->getErrorCode() == Api::IoError::IoErrorCode::Interrupt);
+
+  if (send_result.ok()) {
+    ENVOY_LOG_MISC(trace, "sendmmsg packets {}", send_result.rc_);
+    for (uint64_t i = 0; i < send_result.rc_; i++) {
+      data[i].buffer_.drain(data[i].buffer_.length());
+    }
+  } else {
+    ENVOY_LOG_MISC(debug, "sendmmsg failed with error code {}: {}",
+                   static_cast<int>(send_result.err_->getErrorCode()),
+                   send_result.err_->getErrorDetails());
+  }
+  return send_result;
+}
+
+namespace {
+
+// With UDP_GRO the kernel coalesces up to 64KiB of packets into a single read.
+constexpr uint64_t MAX_UDP_GRO_READ_SIZE = 64 * 1024;
+
+void passPayloadToProcessor(IoHandle& handle, const Address::Instance& local_address,
+                            IoHandle::RecvMsgOutput& output, Buffer::InstancePtr buffer,
+                            UdpPacketProcessor& udp_packet_processor, MonotonicTime receive_time) {
+  RELEASE_ASSERT(output.peer_address_ != nullptr,
+                 fmt::format("Unable to get remote address for fd: {}, local address: {} ",
+                             handle.fd(), local_address.asString()));
+
+  // Unix domain sockets are not supported
+  RELEASE_ASSERT(output.peer_address_->type() == Address::Type::Ip,
+                 fmt::format("Unsupported remote address: {} local address: {}, receive size: "
+                             "{}",
+                             output.peer_address_->asString(), local_address.asString(),
+                             output.msg_len_));
+  udp_packet_processor.processPacket(std::move(output.local_address_),
+                                     std::move(output.peer_address_), std::move(buffer),
+                                     receive_time);
+}
+
+// Reads one payload with recvmsg() and passes its packets to udp_packet_processor. Returns the
+// number of packets passed on as rc_.
+Api::IoCallUint64Result readPayloadFromSocket(IoHandle& handle,
+                                              const Address::Instance& local_address,
+                                              UdpPacketProcessor& udp_packet_processor,
+                                              MonotonicTime receive_time, bool use_gro,
+                                              uint32_t* packets_dropped) {
+  Buffer::InstancePtr buffer = std::make_unique<Buffer::OwnedImpl>();
+  Buffer::RawSlice slice;
+  const uint64_t num_slices = buffer->reserve(
+      use_gro ? MAX_UDP_GRO_READ_SIZE : udp_packet_processor.maxPacketSize(), &slice, 1);
+  ASSERT(num_slices == 1);
+
+  IoHandle::RecvMsgOutput output(packets_dropped);
+  Api::IoCallUint64Result result =
+      handle.recvmsg(&slice, num_slices, local_address.ip()->port(), output);
+
+  if (!result.ok()) {
+    return result;
+  }
+
+  // Adjust used memory length.
+  slice.len_ = std::min(slice.len_, static_cast<size_t>(result.rc_));
+  buffer->commit(&slice, 1);
+
+  ENVOY_LOG_MISC(trace, "recvmsg bytes {}", result.rc_);
+  if (result.rc_ == 0) {
+    // TODO(conqerAtapple): Is zero length packet interesting? If so add stats
+    // for it. Otherwise remove the warning log below.
+    ENVOY_LOG_MISC(trace, "received 0-length packet");
+  }
+
+  if (output.gso_size_ == 0 || buffer->length() <= output.gso_size_) {
+    passPayloadToProcessor(handle, local_address, output, std::move(buffer), udp_packet_processor,
+                           receive_time);
+    return Api::IoCallUint64Result(1, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+  }
+
+  // The kernel coalesced several packets of gso_size_ bytes, only the last one may be shorter.
+  uint64_t num_packets = 0;
+  while (buffer->length() > 0) {
+    Buffer::InstancePtr packet = std::make_unique<Buffer::OwnedImpl>();
+    packet->move(*buffer, std::min(output.gso_size_, buffer->length()));
+    IoHandle::RecvMsgOutput packet_output(output);
+    passPayloadToProcessor(handle, local_address, packet_output, std::move(packet),
+                           udp_packet_processor, receive_time);
+    num_packets++;
+  }
+  return Api::IoCallUint64Result(num_packets,
+                                 Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+}
+
+// Reads up to num_packets packets with recvmmsg() into |recv_buffers|. Buffers that are passed on
+// are replaced, the others keep their reservation for the next call. Returns the number of packets
+// read as rc_.
+Api::IoCallUint64Result readPacketBatchFromSocket(IoHandle& handle,
+                                                  const Address::Instance& local_address,
+                                                  UdpPacketProcessor& udp_packet_processor,
+                                                  MonotonicTime receive_time, uint64_t num_packets,
+                                                  UdpRecvBuffers& recv_buffers,
+                                                  uint32_t* packets_dropped) {
+  ASSERT(num_packets <= UdpRecvBuffers::NUM_PACKETS_PER_MMSG_CALL);
+  auto& ring = recv_buffers.buffers_;
+  const uint64_t max_packet_size = udp_packet_processor.maxPacketSize();
+  STACK_ARRAY(slices, Buffer::RawSlice, num_packets);
+  for (uint64_t i = 0; i < num_packets; i++) {
+    if (ring[i] == nullptr) {
+      ring[i] = std::make_unique<Buffer::OwnedImpl>();
+    }
+    const uint64_t num_slices = ring[i]->reserve(max_packet_size, &slices[i], 1);
+    ASSERT(num_slices == 1);
+  }
+
+  auto& outputs = recv_buffers.outputs_;
+  outputs.assign(num_packets, IoHandle::RecvMsgOutput(packets_dropped));
+  Api::IoCallUint64Result result =
+      handle.recvmmsg(slices.begin(), num_packets, local_address.ip()->port(), outputs.data());
+  if (!result.ok()) {
+    return result;
+  }
+
+  ENVOY_LOG_MISC(trace, "recvmmsg packets {}", result.rc_);
+  for (uint64_t i = 0; i < result.rc_; i++) {
+    // Adjust used memory length.
+    slices[i].len_ = std::min(slices[i].len_, static_cast<size_t>(outputs[i].msg_len_));
+    ring[i]->commit(&slices[i], 1);
+    if (outputs[i].msg_len_ == 0) {
+      ENVOY_LOG_MISC(trace, "received 0-length packet");
+    }
+    passPayloadToProcessor(handle, local_address, outputs[i], std::move(ring[i]),
+                           udp_packet_processor, receive_time);
+  }
+  return result;
+}
+
+} // namespace
+
 Api::IoCallUint64Result Utility::readFromSocket(IoHandle& handle,
                                                 const Address::Instance& local_address,
                                                 UdpPacketProcessor& udp_packet_processor,
@@ -549,19 +707,8 @@ Api::IoCallUint64Result Utility::readFromSocket(IoHandle& handle,
 
   ENVOY_LOG_MISC(trace, "recvmsg bytes {}", result.rc_);
 
-  RELEASE_ASSERT(output.peer_address_ != nullptr,
-                 fmt::format("Unable to get remote address for fd: {}, local address: {} ",
-                             handle.fd(), local_address.asString()));
-
-  // Unix domain sockets are not supported
-  RELEASE_ASSERT(output.peer_address_->type() == Address::Type::Ip,
-                 fmt::format("Unsupported remote address: {} local address: {}, receive size: "
-                             "{}",
-                             output.peer_address_->asString(), local_address.asString(),
-                             result.rc_));
-  udp_packet_processor.processPacket(std::move(output.local_address_),
-                                     std::move(output.peer_address_), std::move(buffer),
-                                     receive_time);
+  passPayloadToProcessor(handle, local_address, output, std::move(buffer), udp_packet_processor,
+                         receive_time);
   return result;
 }
 
@@ -569,22 +716,41 @@ Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
                                                const Address::Instance& local_address,
                                                UdpPacketProcessor& udp_packet_processor,
                                                TimeSource& time_source, uint32_t& packets_dropped) {
-  do {
+  UdpRecvBuffers recv_buffers;
+  Api::IoErrorPtr result = readPacketsFromSocket(handle, local_address, udp_packet_processor,
+                                                 time_source, packets_dropped,
+                                                 std::numeric_limits<uint64_t>::max(), false,
+                                                 recv_buffers);
+  ASSERT(result != nullptr);
+  return result;
+}
+
+Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
+                                               const Address::Instance& local_address,
+                                               UdpPacketProcessor& udp_packet_processor,
+                                               TimeSource& time_source, uint32_t& packets_dropped,
+                                               uint64_t max_packets, bool use_gro,
+                                               UdpRecvBuffers& recv_buffers) {
+  // Coalesced reads already return many packets per system call, so only batch plain reads.
+  const bool use_mmsg = !use_gro && handle.supportsMmsg();
+  uint64_t packets_read = 0;
+  while (packets_read < max_packets) {
     const uint32_t old_packets_dropped = packets_dropped;
     const MonotonicTime receive_time = time_source.monotonicTime();
-    Api::IoCallUint64Result result = Utility::readFromSocket(
-        handle, local_address, udp_packet_processor, receive_time, &packets_dropped);
+    Api::IoCallUint64Result result =
+        use_mmsg ? readPacketBatchFromSocket(
+                       handle, local_address, udp_packet_processor, receive_time,
+                       std::min(UdpRecvBuffers::NUM_PACKETS_PER_MMSG_CALL,
+                                max_packets - packets_read),
+                       recv_buffers, &packets_dropped)
+                 : readPayloadFromSocket(handle, local_address, udp_packet_processor,
+                                         receive_time, use_gro, &packets_dropped);
 
     if (!result.ok()) {
       // No more to read or encountered a system error.
       return std::move(result.err_);
     }
-
-    if (result.rc_ == 0) {
-      // TODO(conqerAtapple): Is zero length packet interesting? If so add stats
-      // for it. Otherwise remove the warning log below.
-      ENVOY_LOG_MISC(trace, "received 0-length packet");
-    }
+    packets_read += result.rc_;
 
     if (packets_dropped != old_packets_dropped) {
       // The kernel tracks SO_RXQ_OVFL as a uint32 which can overflow to a smaller
@@ -599,7 +765,8 @@ Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
       ENVOY_LOG_MISC(
           debug, "Kernel dropped {} more packets. Consider increase receive buffer size.", delta);
     }
-  } while (true);
+  }
+  return Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError);
 }
 
 } // namespace Network
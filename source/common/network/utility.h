@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <list>
 #include <string>
+#include <vector>
 
 #include "envoy/api/v2/core/address.pb.h"
 #include "envoy/common/platform.h"
@@ -59,6 +61,18 @@ public:
 
 static const uint64_t MAX_UDP_PACKET_SIZE = 1500;
 
+/**
+ * Receive buffers kept across reads of a UDP socket with recvmmsg(). Buffers reserved for a read
+ * but not filled by it are reused by the next read instead of being allocated again.
+ */
+struct UdpRecvBuffers {
+  // The number of packets received by each recvmmsg() call.
+  static constexpr uint64_t NUM_PACKETS_PER_MMSG_CALL = 16;
+
+  std::array<Buffer::InstancePtr, NUM_PACKETS_PER_MMSG_CALL> buffers_;
+  std::vector<IoHandle::RecvMsgOutput> outputs_;
+};
+
 /**
  * Common network utility routines.
  */
@@ -304,6 +318,17 @@ public:
                                                const Address::Ip* local_ip,
                                                const Address::Instance& peer_address);
 
+  /**
+   * Send several packets via given UDP socket with as few system calls as the platform allows.
+   * @param handle is the UDP socket used to send.
+   * @param data points to the packets to send. The buffers of the packets sent are drained.
+   * @param num_packets is the number of packets |data| contains.
+   * @return a Api::IoCallUint64Result with err_ = an Api::IoError instance if no packet could be
+   * sent or err_ = nullptr and rc_ = the number of packets sent.
+   */
+  static Api::IoCallUint64Result writePacketsToSocket(IoHandle& handle, const UdpSendData* data,
+                                                      uint64_t num_packets);
+
   /**
    * Read a packet from a given UDP socket and pass the packet to given UdpPacketProcessor.
    * @param handle is the UDP socket to read from.
@@ -328,11 +353,8 @@ public:
    * @param udp_packet_processor is the callback to receive the packets.
    * @param time_source is the time source used to generate the time stamp of the received packets.
    * @param packets_dropped is the output parameter for number of packets dropped in kernel.
+   * @return the error that ended reading, which is EAGAIN once all available packets are read.
    *
-   * TODO(mattklein123): Allow the number of packets read to be limited for fairness. Currently
-   *                     this function will always return an error, even if EAGAIN. In the future
-   *                     we can return no error if we limited the number of packets read and have
-   *                     to fake another read event.
    * TODO(mattklein123): Can we potentially share this with the TCP stack somehow? Similar code
    *                     exists there.
    */
@@ -341,6 +363,30 @@ public:
                                                UdpPacketProcessor& udp_packet_processor,
                                                TimeSource& time_source, uint32_t& packets_dropped);
 
+  /**
+   * Read up to max_packets packets from a given UDP socket and pass them to a given
+   * UdpPacketProcessor. Packets are received in batches where the platform supports it.
+   * @param handle is the UDP socket to read from.
+   * @param local_address is the socket's local address used to populate port.
+   * @param udp_packet_processor is the callback to receive the packets.
+   * @param time_source is the time source used to generate the time stamp of the received packets.
+   * @param packets_dropped is the output parameter for number of packets dropped in kernel.
+   * @param max_packets is the number of packets after which reading stops. A coalesced read may
+   * overshoot it.
+   * @param use_gro must be true if UDP_GRO is enabled on the socket, in which case the kernel may
+   * return several coalesced packets per read. They are split before being passed on.
+   * @param recv_buffers holds the buffers of batched reads. Passing the same instance to every call
+   * for a socket saves reallocating the buffers a read did not fill.
+   * @return the error that ended reading, or nullptr if max_packets packets were read. In the
+   * latter case more packets may be available on the socket.
+   */
+  static Api::IoErrorPtr readPacketsFromSocket(IoHandle& handle,
+                                               const Address::Instance& local_address,
+                                               UdpPacketProcessor& udp_packet_processor,
+                                               TimeSource& time_source, uint32_t& packets_dropped,
+                                               uint64_t max_packets, bool use_gro,
+                                               UdpRecvBuffers& recv_buffers);
+
 private:
   static void throwWithMalformedIp(const std::string& ip_address);
 
@@ -1,7 +1,9 @@
 #include "common/protobuf/utility.h"
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
+#include <type_traits>
 
 #include "envoy/protobuf/message_validator.h"
 #include "envoy/type/percent.pb.h"
@@ -25,6 +27,182 @@ absl::string_view filenameFromPath(absl::string_view full_path) {
   return full_path.substr(index + 1, full_path.size());
 }
 
+// Appends a canonical binary encoding of messages to a string, for MessageUtil::hash(). Unlike the
+// wire format, the encoding expands the google.protobuf.Any fields and doesn't depend on the order
+// of the map entries. Each message ends with the invalid field number 0, so that the fields of
+// nested messages can't be mistaken for the fields of their parent.
+class CanonicalEncoder {
+public:
+  explicit CanonicalEncoder(std::string& out) : out_(out) {}
+
+  void appendMessage(const Protobuf::Message& message) {
+    if (message.GetDescriptor() == ProtobufWkt::Any::descriptor() && appendAny(message)) {
+      return;
+    }
+
+    const Protobuf::Reflection* reflection = message.GetReflection();
+    std::vector<const Protobuf::FieldDescriptor*> fields;
+    // The fields that are set, ordered by field number.
+    reflection->ListFields(message, &fields);
+    for (const Protobuf::FieldDescriptor* field : fields) {
+      appendValue<int32_t>(field->number());
+      if (field->is_map()) {
+        appendMap(message, *reflection, *field);
+      } else if (field->is_repeated()) {
+        const int size = reflection->FieldSize(message, field);
+        appendValue<int32_t>(size);
+        for (int i = 0; i < size; ++i) {
+          appendField(message, *reflection, *field, i);
+        }
+      } else {
+        appendField(message, *reflection, *field, -1);
+      }
+    }
+    appendUnknownFields(reflection->GetUnknownFields(message));
+    appendValue<int32_t>(0);
+  }
+
+private:
+  template <class T> void appendValue(T value) {
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic values are appended as is");
+    out_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void appendString(absl::string_view value) {
+    appendValue<uint64_t>(value.size());
+    out_.append(value.data(), value.size());
+  }
+
+  // Appends the type URL and the unpacked message. Returns false if the type is unknown or the
+  // value can't be parsed, in which case the Any is appended as a regular message.
+  bool appendAny(const Protobuf::Message& any) {
+    const Protobuf::Reflection* reflection = any.GetReflection();
+    const Protobuf::Descriptor* descriptor = any.GetDescriptor();
+    std::string type_url_scratch;
+    const std::string& type_url = reflection->GetStringReference(
+        any, descriptor->FindFieldByNumber(1), &type_url_scratch);
+    const Protobuf::Descriptor* type =
+        Protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(
+            std::string(TypeUtil::typeUrlToDescriptorFullName(type_url)));
+    if (type == nullptr) {
+      return false;
+    }
+
+    ProtobufTypes::MessagePtr message(
+        Protobuf::MessageFactory::generated_factory()->GetPrototype(type)->New());
+    std::string value_scratch;
+    const std::string& value =
+        reflection->GetStringReference(any, descriptor->FindFieldByNumber(2), &value_scratch);
+    if (!message->ParseFromString(value)) {
+      return false;
+    }
+
+    appendString(type_url);
+    appendMessage(*message);
+    return true;
+  }
+
+  // Map entries are encoded on their own and appended as a sorted list of their hashes.
+  void appendMap(const Protobuf::Message& message, const Protobuf::Reflection& reflection,
+                 const Protobuf::FieldDescriptor& field) {
+    const int size = reflection.FieldSize(message, &field);
+    std::vector<uint64_t> entry_hashes;
+    entry_hashes.reserve(size);
+    std::string entry;
+    CanonicalEncoder entry_encoder(entry);
+    for (int i = 0; i < size; ++i) {
+      entry.clear();
+      entry_encoder.appendMessage(reflection.GetRepeatedMessage(message, &field, i));
+      entry_hashes.push_back(HashUtil::xxHash64(entry));
+    }
+    std::sort(entry_hashes.begin(), entry_hashes.end());
+
+    appendValue<int32_t>(size);
+    for (const uint64_t entry_hash : entry_hashes) {
+      appendValue(entry_hash);
+    }
+  }
+
+  // Appends a singular field if index is negative, or an element of a repeated field.
+  void appendField(const Protobuf::Message& message, const Protobuf::Reflection& reflection,
+                   const Protobuf::FieldDescriptor& field, int index) {
+    const bool repeated = index >= 0;
+    switch (field.cpp_type()) {
+    case Protobuf::FieldDescriptor::CPPTYPE_INT32:
+      appendValue(repeated ? reflection.GetRepeatedInt32(message, &field, index)
+                           : reflection.GetInt32(message, &field));
+      break;
+    case Protobuf::FieldDescriptor::CPPTYPE_INT64:
+      appendValue(repeated ? reflection.GetRepeatedInt64(message, &field, index)
+                           : reflection.GetInt64(message, &field));
+      break;
+    case Protobuf::FieldDescriptor::CPPTYPE_UINT32:
+      appendValue(repeated ? reflection.GetRepeatedUInt32(message, &field, index)
+                           : reflection.GetUInt32(message, &field));
+      break;
+    case Protobuf::FieldDescriptor::CPPTYPE_UINT64:
+      appendValue(repeated ? reflection.GetRepeatedUInt64(message, &field, index)
+                           : reflection.GetUInt64(message, &field));
+      break;
+    case Protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+      appendValue(repeated ? reflection.GetRepeatedDouble(message, &field, index)
+                           : reflection.GetDouble(message, &field));
+      break;
+    case Protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+      appendValue(repeated ? reflection.GetRepeatedFloat(message, &field, index)
+                           : reflection.GetFloat(message, &field));
+      break;
+    case Protobuf::FieldDescriptor::CPPTYPE_BOOL:
+      appendValue(repeated ? reflection.GetRepeatedBool(message, &field, index)
+                           : reflection.GetBool(message, &field));
+      break;
+    case Protobuf::FieldDescriptor::CPPTYPE_ENUM:
+      appendValue(repeated ? reflection.GetRepeatedEnumValue(message, &field, index)
+                           : reflection.GetEnumValue(message, &field));
+      break;
+    case Protobuf::FieldDescriptor::CPPTYPE_STRING: {
+      std::string scratch;
+      appendString(repeated
+                       ? reflection.GetRepeatedStringReference(message, &field, index, &scratch)
+                       : reflection.GetStringReference(message, &field, &scratch));
+      break;
+    }
+    case Protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+      appendMessage(repeated ? reflection.GetRepeatedMessage(message, &field, index)
+                             : reflection.GetMessage(message, &field));
+      break;
+    }
+  }
+
+  void appendUnknownFields(const Protobuf::UnknownFieldSet& unknown_fields) {
+    for (int i = 0; i < unknown_fields.field_count(); ++i) {
+      const Protobuf::UnknownField& field = unknown_fields.field(i);
+      appendValue<int32_t>(field.number());
+      appendValue<int32_t>(field.type());
+      switch (field.type()) {
+      case Protobuf::UnknownField::TYPE_VARINT:
+        appendValue(field.varint());
+        break;
+      case Protobuf::UnknownField::TYPE_FIXED32:
+        appendValue(field.fixed32());
+        break;
+      case Protobuf::UnknownField::TYPE_FIXED64:
+        appendValue(field.fixed64());
+        break;
+      case Protobuf::UnknownField::TYPE_LENGTH_DELIMITED:
+        appendString(field.length_delimited());
+        break;
+      case Protobuf::UnknownField::TYPE_GROUP:
+        appendUnknownFields(field.group());
+        appendValue<int32_t>(0);
+        break;
+      }
+    }
+  }
+
+  std::string& out_;
+};
+
 void blockFormat(YAML::Node node) {
   node.SetStyle(YAML::EmitterStyle::Block);
 
@@ -159,17 +337,9 @@ ProtoValidationException::ProtoValidationException(const std::string& validation
 }
 
 size_t MessageUtil::hash(const Protobuf::Message& message) {
-  std::string text_format;
-
-  {
-    Protobuf::TextFormat::Printer printer;
-    printer.SetExpandAny(true);
-    printer.SetUseFieldNumber(true);
-    printer.SetSingleLineMode(true);
-    printer.PrintToString(message, &text_format);
-  }
-
-  return HashUtil::xxHash64(text_format);
+  std::string encoded;
+  CanonicalEncoder(encoded).appendMessage(message);
+  return HashUtil::xxHash64(encoded);
 }
 
 void MessageUtil::loadFromJson(const std::string& json, Protobuf::Message& message,
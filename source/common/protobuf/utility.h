@@ -206,9 +206,9 @@ public:
   using FileExtensions = ConstSingleton<FileExtensionValues>;
 
   /**
-   * A hash function uses Protobuf::TextFormat to force deterministic serialization recursively
-   * including known types in google.protobuf.Any. See
-   * https://github.com/protocolbuffers/protobuf/issues/5731 for the context.
+   * A hash function walking the message fields to hash a deterministic binary encoding of the
+   * message recursively, including known types in google.protobuf.Any and independent of the order
+   * of map entries. See https://github.com/protocolbuffers/protobuf/issues/5731 for the context.
    * Using this function is discouraged, see discussion in
    * https://github.com/envoyproxy/envoy/issues/8301.
    */
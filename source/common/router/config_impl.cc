@@ -946,6 +946,26 @@ VirtualHostImpl::VirtualHostImpl(const envoy::api::v2::route::VirtualHost& virtu
     }
   }
 
+  if (global_route_config.buildRouteIndex()) {
+    auto route_index = std::make_unique<PathRouteIndex>();
+    for (int i = 0; i < virtual_host.routes().size(); i++) {
+      const auto& match = virtual_host.routes(i).match();
+      const bool case_sensitive = PROTOBUF_GET_WRAPPED_OR_DEFAULT(match, case_sensitive, true);
+      switch (match.path_specifier_case()) {
+      case envoy::api::v2::route::RouteMatch::kPrefix:
+        route_index->addPrefix(match.prefix(), case_sensitive, i);
+        break;
+      case envoy::api::v2::route::RouteMatch::kPath:
+        route_index->addPath(match.path(), case_sensitive, i);
+        break;
+      default:
+        route_index->addUnindexed(i);
+        break;
+      }
+    }
+    route_index_ = std::move(route_index);
+  }
+
   for (const auto& virtual_cluster : virtual_host.virtual_clusters()) {
     virtual_clusters_.push_back(VirtualClusterEntry(virtual_cluster, stat_name_pool_));
   }
@@ -1062,6 +1082,26 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const Http::HeaderMap&
     return SSL_REDIRECT_ROUTE;
   }
 
+  // With a route index only the routes whose path specifier matches the path are evaluated. They
+  // are returned in configuration order, so the first one that fully matches is the same route the
+  // linear scan below would find.
+  if (route_index_ != nullptr) {
+    // All routes require a path header, see RouteEntryImplBase::matchRoute().
+    if (headers.Path() == nullptr) {
+      return nullptr;
+    }
+    PathRouteIndex::Candidates candidates;
+    route_index_->candidates(headers.Path()->value().getStringView(), candidates);
+    for (const uint32_t candidate : candidates) {
+      RouteConstSharedPtr route_entry =
+          routes_[candidate]->matches(headers, stream_info, random_value);
+      if (nullptr != route_entry) {
+        return route_entry;
+      }
+    }
+    return nullptr;
+  }
+
   // Check for a route that matches the request.
   for (const RouteEntryImplBaseConstSharedPtr& route : routes_) {
     RouteConstSharedPtr route_entry = route->matches(headers, stream_info, random_value);
@@ -1148,7 +1188,8 @@ ConfigImpl::ConfigImpl(const envoy::api::v2::RouteConfiguration& config,
                        bool validate_clusters_default)
     : name_(config.name()), symbol_table_(factory_context.scope().symbolTable()),
       uses_vhds_(config.has_vhds()),
-      most_specific_header_mutations_wins_(config.most_specific_header_mutations_wins()) {
+      most_specific_header_mutations_wins_(config.most_specific_header_mutations_wins()),
+      build_route_index_(config.build_route_index()) {
   route_matcher_ = std::make_unique<RouteMatcher>(
       config, *this, factory_context, validator,
       PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
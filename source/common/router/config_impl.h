@@ -26,6 +26,7 @@
 #include "common/router/header_formatter.h"
 #include "common/router/header_parser.h"
 #include "common/router/metadatamatchcriteria_impl.h"
+#include "common/router/path_route_index.h"
 #include "common/router/router_ratelimit.h"
 #include "common/router/tls_context_match_criteria_impl.h"
 #include "common/stats/symbol_table_impl.h"
@@ -211,6 +212,8 @@ private:
   Stats::StatNamePool stat_name_pool_;
   const Stats::StatName stat_name_;
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  // Only built if the route configuration asks for it, see ConfigImpl::buildRouteIndex().
+  std::unique_ptr<const PathRouteIndex> route_index_;
   std::vector<VirtualClusterEntry> virtual_clusters_;
   SslRequirements ssl_requirements_;
   const RateLimitPolicyImpl rate_limit_policy_;
@@ -828,6 +831,7 @@ public:
 
   const HeaderParser& requestHeaderParser() const { return *request_headers_parser_; };
   const HeaderParser& responseHeaderParser() const { return *response_headers_parser_; };
+  bool buildRouteIndex() const { return build_route_index_; }
 
   // Router::Config
   RouteConstSharedPtr route(const Http::HeaderMap& headers,
@@ -857,6 +861,7 @@ private:
   Stats::SymbolTable& symbol_table_;
   const bool uses_vhds_;
   const bool most_specific_header_mutations_wins_;
+  const bool build_route_index_;
 };
 
 /**
@@ -0,0 +1,126 @@
+#include "common/router/path_route_index.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Router {
+
+namespace {
+
+// Finds the child whose label starts with c, or the position where it would be inserted.
+template <class Children> auto findChild(Children& children, char c) {
+  return std::lower_bound(children.begin(), children.end(), static_cast<unsigned char>(c),
+                          [](const auto& child, unsigned char value) {
+                            return static_cast<unsigned char>(child->label_[0]) < value;
+                          });
+}
+
+void appendRoutes(const std::vector<uint32_t>& routes, PathRouteIndex::Candidates& out) {
+  out.insert(out.end(), routes.begin(), routes.end());
+}
+
+} // namespace
+
+PathRouteIndex::PathRouteIndex() = default;
+
+PathRouteIndex::~PathRouteIndex() = default;
+
+void PathRouteIndex::addPrefix(absl::string_view prefix, bool case_sensitive, uint32_t route) {
+  if (case_sensitive) {
+    insert(prefixes_, prefix, route);
+  } else {
+    has_ignore_case_ = true;
+    insert(prefixes_ignore_case_, absl::AsciiStrToLower(prefix), route);
+  }
+}
+
+void PathRouteIndex::addPath(absl::string_view path, bool case_sensitive, uint32_t route) {
+  if (case_sensitive) {
+    paths_[std::string(path)].push_back(route);
+  } else {
+    has_ignore_case_ = true;
+    paths_ignore_case_[absl::AsciiStrToLower(path)].push_back(route);
+  }
+}
+
+void PathRouteIndex::addUnindexed(uint32_t route) { unindexed_.push_back(route); }
+
+void PathRouteIndex::candidates(absl::string_view path, Candidates& candidates) const {
+  candidates.clear();
+  collect(prefixes_, path, candidates);
+
+  const absl::string_view path_only = path.substr(0, path.find('?'));
+  auto it = paths_.find(path_only);
+  if (it != paths_.end()) {
+    appendRoutes(it->second, candidates);
+  }
+
+  if (has_ignore_case_) {
+    const std::string lower_path = absl::AsciiStrToLower(path);
+    collect(prefixes_ignore_case_, lower_path, candidates);
+    it = paths_ignore_case_.find(absl::string_view(lower_path).substr(0, path_only.size()));
+    if (it != paths_ignore_case_.end()) {
+      appendRoutes(it->second, candidates);
+    }
+  }
+
+  appendRoutes(unindexed_, candidates);
+
+  // Each source yields its routes in order, but the sources interleave.
+  std::sort(candidates.begin(), candidates.end());
+}
+
+void PathRouteIndex::insert(Node& root, absl::string_view prefix, uint32_t route) {
+  Node* node = &root;
+  while (!prefix.empty()) {
+    auto child = findChild(node->children_, prefix[0]);
+    if (child == node->children_.end() || (*child)->label_[0] != prefix[0]) {
+      auto leaf = std::make_unique<Node>();
+      leaf->label_ = std::string(prefix);
+      leaf->routes_.push_back(route);
+      node->children_.insert(child, std::move(leaf));
+      return;
+    }
+
+    const std::string& label = (*child)->label_;
+    size_t common = 1;
+    while (common < label.size() && common < prefix.size() && label[common] == prefix[common]) {
+      common++;
+    }
+    if (common < label.size()) {
+      // The new prefix ends or diverges inside the child's label, so split the label.
+      auto split = std::make_unique<Node>();
+      split->label_ = label.substr(0, common);
+      (*child)->label_ = label.substr(common);
+      split->children_.push_back(std::move(*child));
+      *child = std::move(split);
+    }
+    node = child->get();
+    prefix.remove_prefix(common);
+  }
+
+  ASSERT(node->routes_.empty() || node->routes_.back() < route);
+  node->routes_.push_back(route);
+}
+
+void PathRouteIndex::collect(const Node& root, absl::string_view path, Candidates& out) {
+  const Node* node = &root;
+  appendRoutes(node->routes_, out);
+  while (!path.empty()) {
+    auto child = findChild(node->children_, path[0]);
+    if (child == node->children_.end() || !absl::StartsWith(path, (*child)->label_)) {
+      return;
+    }
+    node = child->get();
+    appendRoutes(node->routes_, out);
+    path.remove_prefix(node->label_.size());
+  }
+}
+
+} // namespace Router
+} // namespace Envoy
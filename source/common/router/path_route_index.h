@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index over the path specifiers of a virtual host's routes. Routes are identified by their
+ * position in the virtual host's route list. For a request path the index returns, in ascending
+ * order, every route whose path specifier may match it: prefix routes whose prefix the path starts
+ * with, path routes equal to the path without its query string, and all routes added with
+ * addUnindexed(). Routes that are not returned cannot match the path, so evaluating the candidates
+ * in order selects the same route as a linear scan over all routes.
+ */
+class PathRouteIndex {
+public:
+  // Requests rarely have more than a handful of candidate routes, so avoid allocating for them.
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  PathRouteIndex();
+  ~PathRouteIndex();
+
+  /**
+   * Add a route that matches paths beginning with prefix.
+   * @param prefix supplies the route's prefix.
+   * @param case_sensitive supplies whether the prefix is compared case sensitively.
+   * @param route supplies the route's position in the route list. Routes must be added in order.
+   */
+  void addPrefix(absl::string_view prefix, bool case_sensitive, uint32_t route);
+
+  /**
+   * Add a route that matches requests whose path, without query string, equals path.
+   * @param path supplies the route's path.
+   * @param case_sensitive supplies whether the path is compared case sensitively.
+   * @param route supplies the route's position in the route list. Routes must be added in order.
+   */
+  void addPath(absl::string_view path, bool case_sensitive, uint32_t route);
+
+  /**
+   * Add a route that has to be evaluated for every request, such as a regex route.
+   * @param route supplies the route's position in the route list. Routes must be added in order.
+   */
+  void addUnindexed(uint32_t route);
+
+  /**
+   * Find the routes that may match a path.
+   * @param path supplies the request's :path header value, including any query string.
+   * @param candidates receives the positions of the candidate routes in ascending order. It is
+   *        cleared first.
+   */
+  void candidates(absl::string_view path, Candidates& candidates) const;
+
+private:
+  struct Node;
+  using NodePtr = std::unique_ptr<Node>;
+
+  /**
+   * A radix tree over prefixes. Each node's label is the part of the prefix following its parent;
+   * a node carries the routes whose prefix ends exactly there.
+   */
+  struct Node {
+    std::string label_;
+    std::vector<uint32_t> routes_;
+    // Children have labels with distinct first characters and are kept sorted by them.
+    std::vector<NodePtr> children_;
+  };
+
+  static void insert(Node& root, absl::string_view prefix, uint32_t route);
+  static void collect(const Node& root, absl::string_view path, Candidates& out);
+
+  Node prefixes_;
+  // Holds lower cased prefixes of case insensitive prefix routes.
+  Node prefixes_ignore_case_;
+  absl::flat_hash_map<std::string, std::vector<uint32_t>> paths_;
+  // Keyed by the lower cased path of case insensitive path routes.
+  absl::flat_hash_map<std::string, std::vector<uint32_t>> paths_ignore_case_;
+  std::vector<uint32_t> unindexed_;
+  bool has_ignore_case_{};
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -45,6 +45,8 @@ constexpr const char* runtime_features[] = {
 constexpr const char* disabled_runtime_features[] = {
     // Sentinel and test flag.
     "envoy.reloadable_features.test_feature_false",
+    // Replaces http_parser with FastHttpParserImpl until it has seen more production traffic.
+    "envoy.reloadable_features.http1_fast_parser",
     // Should be removed as part of https://github.com/envoyproxy/envoy/issues/8993
     "envoy.reloadable_features.http2_protocol_options.stream_error_on_invalid_http_messaging",
 };
@@ -1,8 +1,11 @@
 #include "common/stats/histogram_impl.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <string>
 
+#include "common/common/macros.h"
 #include "common/common/utility.h"
 
 #include "absl/strings/str_join.h"
@@ -10,8 +13,88 @@
 namespace Envoy {
 namespace Stats {
 
+FixedBucketHistogram::FixedBucketHistogram(ConstSupportedBucketsSharedPtr buckets)
+    : buckets_(std::move(buckets)), counts_(buckets_->size() + 1, 0),
+      min_value_(std::numeric_limits<uint64_t>::max()), max_value_(0) {
+  ASSERT(std::is_sorted(buckets_->begin(), buckets_->end()));
+}
+
+void FixedBucketHistogram::recordValue(uint64_t value) {
+  const auto bucket =
+      std::lower_bound(buckets_->begin(), buckets_->end(), static_cast<double>(value));
+  ++counts_[bucket - buckets_->begin()];
+  ++sample_count_;
+  sample_sum_ += value;
+  min_value_ = std::min(min_value_, value);
+  max_value_ = std::max(max_value_, value);
+}
+
+void FixedBucketHistogram::merge(const FixedBucketHistogram& other) {
+  ASSERT(*other.buckets_ == *buckets_);
+  // A plain loop over the two contiguous arrays, which the compiler turns into vector adds.
+  const size_t size = counts_.size();
+  uint64_t* counts = counts_.data();
+  const uint64_t* other_counts = other.counts_.data();
+  for (size_t i = 0; i < size; ++i) {
+    counts[i] += other_counts[i];
+  }
+  sample_count_ += other.sample_count_;
+  sample_sum_ += other.sample_sum_;
+  min_value_ = std::min(min_value_, other.min_value_);
+  max_value_ = std::max(max_value_, other.max_value_);
+}
+
+void FixedBucketHistogram::clear() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  sample_count_ = 0;
+  sample_sum_ = 0;
+  min_value_ = std::numeric_limits<uint64_t>::max();
+  max_value_ = 0;
+}
+
+std::vector<uint64_t> FixedBucketHistogram::cumulativeCounts() const {
+  std::vector<uint64_t> cumulative_counts;
+  cumulative_counts.reserve(buckets_->size());
+  uint64_t count = 0;
+  for (size_t i = 0; i < buckets_->size(); ++i) {
+    count += counts_[i];
+    cumulative_counts.push_back(count);
+  }
+  return cumulative_counts;
+}
+
+double FixedBucketHistogram::quantile(double q) const {
+  if (sample_count_ == 0) {
+    return std::nan("");
+  }
+
+  const double rank = q * sample_count_;
+  uint64_t count_below = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    if (counts_[i] == 0) {
+      continue;
+    }
+    if (count_below + counts_[i] >= rank) {
+      // The samples of a bucket are assumed to be spread evenly between its bounds, narrowed down
+      // by the recorded extremes so that the first and last buckets do not stretch the quantiles.
+      const double lower_bound = i == 0 ? 0 : (*buckets_)[i - 1];
+      const double upper_bound = i < buckets_->size() ? (*buckets_)[i] : max_value_;
+      const double lower = std::max(lower_bound, static_cast<double>(min_value_));
+      const double upper = std::min(upper_bound, static_cast<double>(max_value_));
+      return lower + (upper - lower) * (rank - count_below) / counts_[i];
+    }
+    count_below += counts_[i];
+  }
+  return max_value_;
+}
+
+HistogramStatisticsImpl::HistogramStatisticsImpl()
+    : supported_buckets_(defaultSupportedBuckets()),
+      computed_quantiles_(supportedQuantiles().size(), 0.0) {}
+
 HistogramStatisticsImpl::HistogramStatisticsImpl(const histogram_t* histogram_ptr)
-    : computed_quantiles_(supportedQuantiles().size(), 0.0) {
+    : supported_buckets_(defaultSupportedBuckets()),
+      computed_quantiles_(supportedQuantiles().size(), 0.0) {
   hist_approx_quantile(histogram_ptr, supportedQuantiles().data(), supportedQuantiles().size(),
                        computed_quantiles_.data());
 
@@ -31,11 +114,20 @@ const std::vector<double>& HistogramStatisticsImpl::supportedQuantiles() const {
   return supported_quantiles;
 }
 
+HistogramStatisticsImpl::HistogramStatisticsImpl(const FixedBucketHistogram& histogram)
+    : computed_quantiles_(supportedQuantiles().size(), 0.0) {
+  refresh(histogram);
+}
+
+const ConstSupportedBucketsSharedPtr& HistogramStatisticsImpl::defaultSupportedBuckets() {
+  CONSTRUCT_ON_FIRST_USE(ConstSupportedBucketsSharedPtr,
+                         std::make_shared<ConstSupportedBuckets>(std::vector<double>{
+                             0.5, 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000,
+                             60000, 300000, 600000, 1800000, 3600000}));
+}
+
 const std::vector<double>& HistogramStatisticsImpl::supportedBuckets() const {
-  static const std::vector<double> supported_buckets = {
-      0.5,  1,    5,     10,    25,    50,     100,    250,     500,    1000,
-      2500, 5000, 10000, 30000, 60000, 300000, 600000, 1800000, 3600000};
-  return supported_buckets;
+  return *supported_buckets_;
 }
 
 std::string HistogramStatisticsImpl::quantileSummary() const {
@@ -70,7 +162,7 @@ void HistogramStatisticsImpl::refresh(const histogram_t* new_histogram_ptr) {
   sample_count_ = hist_sample_count(new_histogram_ptr);
   sample_sum_ = hist_approx_sum(new_histogram_ptr);
 
-  ASSERT(supportedBuckets().size() == computed_buckets_.size());
+  supported_buckets_ = defaultSupportedBuckets();
   computed_buckets_.clear();
   const std::vector<double>& supported_buckets = supportedBuckets();
   computed_buckets_.reserve(supported_buckets.size());
@@ -79,5 +171,38 @@ void HistogramStatisticsImpl::refresh(const histogram_t* new_histogram_ptr) {
   }
 }
 
+void HistogramStatisticsImpl::refresh(const FixedBucketHistogram& new_histogram) {
+  supported_buckets_ = new_histogram.supportedBuckets();
+  const std::vector<double>& supported_quantiles = supportedQuantiles();
+  ASSERT(supported_quantiles.size() == computed_quantiles_.size());
+  for (size_t i = 0; i < supported_quantiles.size(); ++i) {
+    computed_quantiles_[i] = new_histogram.quantile(supported_quantiles[i]);
+  }
+
+  sample_count_ = new_histogram.sampleCount();
+  sample_sum_ = new_histogram.sampleSum();
+  computed_buckets_ = new_histogram.cumulativeCounts();
+}
+
+HistogramSettingsImpl::HistogramSettingsImpl(
+    const envoy::config::metrics::v2::StatsConfig& config) {
+  configs_.reserve(config.histogram_bucket_settings_size());
+  for (const auto& setting : config.histogram_bucket_settings()) {
+    std::vector<double> buckets{setting.buckets().begin(), setting.buckets().end()};
+    std::sort(buckets.begin(), buckets.end());
+    configs_.emplace_back(Matchers::StringMatcherImpl(setting.match()),
+                          std::make_shared<ConstSupportedBuckets>(std::move(buckets)));
+  }
+}
+
+ConstSupportedBucketsSharedPtr HistogramSettingsImpl::buckets(absl::string_view stat_name) const {
+  for (const auto& config : configs_) {
+    if (config.first.match(stat_name)) {
+      return config.second;
+    }
+  }
+  return nullptr;
+}
+
 } // namespace Stats
 } // namespace Envoy
@@ -2,11 +2,15 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "envoy/config/metrics/v2/stats.pb.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
 #include "envoy/stats/store.h"
 
+#include "common/common/matchers.h"
 #include "common/common/non_copyable.h"
 #include "common/stats/metric_impl.h"
 
@@ -16,19 +20,71 @@ namespace Envoy {
 namespace Stats {
 
 /**
- * Implementation of HistogramStatistics for circllhist.
+ * A histogram with fixed bucket upper bounds. Each bucket counts the values greater than the
+ * previous bound and less than or equal to its own bound, and an overflow bucket counts the values
+ * greater than the largest bound. Recording is a binary search over the bounds and an increment,
+ * and merging histograms with the same bounds is an element-wise add of the bucket counts, which
+ * is much cheaper than merging log-linear histograms.
+ */
+class FixedBucketHistogram {
+public:
+  explicit FixedBucketHistogram(ConstSupportedBucketsSharedPtr buckets);
+
+  void recordValue(uint64_t value);
+
+  /**
+   * Adds the samples of other, which must have the same bucket bounds, to this histogram.
+   */
+  void merge(const FixedBucketHistogram& other);
+  void clear();
+
+  const ConstSupportedBucketsSharedPtr& supportedBuckets() const { return buckets_; }
+  uint64_t sampleCount() const { return sample_count_; }
+  double sampleSum() const { return sample_sum_; }
+
+  /**
+   * @return the number of samples less than or equal to the upper bound of each bucket.
+   */
+  std::vector<uint64_t> cumulativeCounts() const;
+
+  /**
+   * @return the value at quantile q, interpolated linearly within the bucket the quantile falls
+   *         into, or NaN if there are no samples.
+   */
+  double quantile(double q) const;
+
+private:
+  ConstSupportedBucketsSharedPtr buckets_;
+  // One count per bucket in buckets_, followed by the overflow bucket.
+  std::vector<uint64_t> counts_;
+  uint64_t sample_count_{};
+  double sample_sum_{};
+  // The smallest and largest recorded values, which bound the interpolation of quantiles.
+  uint64_t min_value_;
+  uint64_t max_value_;
+};
+
+/**
+ * Implementation of HistogramStatistics for circllhist and FixedBucketHistogram.
  */
 class HistogramStatisticsImpl : public HistogramStatistics, NonCopyable {
 public:
-  HistogramStatisticsImpl() : computed_quantiles_(supportedQuantiles().size(), 0.0) {}
+  HistogramStatisticsImpl();
   /**
    * HistogramStatisticsImpl object is constructed using the passed in histogram.
    * @param histogram_ptr pointer to the histogram for which stats will be calculated. This pointer
    * will not be retained.
    */
   HistogramStatisticsImpl(const histogram_t* histogram_ptr);
+  HistogramStatisticsImpl(const FixedBucketHistogram& histogram);
 
   void refresh(const histogram_t* new_histogram_ptr);
+  void refresh(const FixedBucketHistogram& new_histogram);
+
+  /**
+   * @return the buckets of the statistics of log-linear histograms.
+   */
+  static const ConstSupportedBucketsSharedPtr& defaultSupportedBuckets();
 
   // HistogramStatistics
   std::string quantileSummary() const override;
@@ -41,12 +97,28 @@ public:
   double sampleSum() const override { return sample_sum_; }
 
 private:
+  ConstSupportedBucketsSharedPtr supported_buckets_;
   std::vector<double> computed_quantiles_;
   std::vector<uint64_t> computed_buckets_;
   uint64_t sample_count_;
   double sample_sum_;
 };
 
+/**
+ * HistogramSettings built from the histogram_bucket_settings of the bootstrap stats config. The
+ * first setting whose matcher matches a histogram name selects its buckets.
+ */
+class HistogramSettingsImpl : public HistogramSettings {
+public:
+  explicit HistogramSettingsImpl(const envoy::config::metrics::v2::StatsConfig& config);
+
+  // HistogramSettings
+  ConstSupportedBucketsSharedPtr buckets(absl::string_view stat_name) const override;
+
+private:
+  std::vector<std::pair<Matchers::StringMatcherImpl, ConstSupportedBucketsSharedPtr>> configs_;
+};
+
 class HistogramImplHelper : public MetricImpl<Histogram> {
 public:
   HistogramImplHelper(StatName name, const std::string& tag_extracted_name,
@@ -1,5 +1,6 @@
 #include "common/stats/tag_extractor_impl.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -23,12 +24,11 @@ bool regexStartsWithDot(absl::string_view regex) {
 
 } // namespace
 
-TagExtractorImpl::TagExtractorImpl(const std::string& name, const std::string& regex,
-                                   const std::string& substr)
-    : name_(name), prefix_(std::string(extractRegexPrefix(regex))), substr_(substr),
-      regex_(Regex::Utility::parseStdRegex(regex)) {}
+TagExtractorImplBase::TagExtractorImplBase(const std::string& name, const std::string& regex,
+                                           const std::string& substr)
+    : name_(name), prefix_(std::string(extractRegexPrefix(regex))), substr_(substr) {}
 
-std::string TagExtractorImpl::extractRegexPrefix(absl::string_view regex) {
+std::string TagExtractorImplBase::extractRegexPrefix(absl::string_view regex) {
   std::string prefix;
   if (absl::StartsWith(regex, "^")) {
     for (absl::string_view::size_type i = 1; i < regex.size(); ++i) {
@@ -47,6 +47,26 @@ std::string TagExtractorImpl::extractRegexPrefix(absl::string_view regex) {
   return prefix;
 }
 
+bool TagExtractorImplBase::substrMismatch(absl::string_view stat_name) const {
+  return !substr_.empty() && stat_name.find(substr_) == absl::string_view::npos;
+}
+
+void TagExtractorImplBase::addTag(absl::string_view value, size_t remove_start,
+                                  size_t remove_end, std::vector<Tag>& tags,
+                                  IntervalSet<size_t>& remove_characters) const {
+  tags.emplace_back();
+  Tag& tag = tags.back();
+  tag.name_ = name_;
+  tag.value_ = std::string(value);
+
+  // Determines which characters to remove from stat_name to elide remove_subexpr.
+  remove_characters.insert(remove_start, remove_end);
+}
+
+TagExtractorImpl::TagExtractorImpl(const std::string& name, const std::string& regex,
+                                   const std::string& substr)
+    : TagExtractorImplBase(name, regex, substr), regex_(Regex::Utility::parseStdRegex(regex)) {}
+
 TagExtractorPtr TagExtractorImpl::createTagExtractor(const std::string& name,
                                                      const std::string& regex,
                                                      const std::string& substr) {
@@ -62,10 +82,6 @@ TagExtractorPtr TagExtractorImpl::createTagExtractor(const std::string& name,
   return TagExtractorPtr{new TagExtractorImpl(name, regex, substr)};
 }
 
-bool TagExtractorImpl::substrMismatch(absl::string_view stat_name) const {
-  return !substr_.empty() && stat_name.find(substr_) == absl::string_view::npos;
-}
-
 bool TagExtractorImpl::extractTag(absl::string_view stat_name, std::vector<Tag>& tags,
                                   IntervalSet<size_t>& remove_characters) const {
   PERF_OPERATION(perf);
@@ -89,15 +105,8 @@ bool TagExtractorImpl::extractTag(absl::string_view stat_name, std::vector<Tag>&
     // second submatch, then the value_subexpr is the same as the remove_subexpr.
     const auto& value_subexpr = match.size() > 2 ? match[2] : remove_subexpr;
 
-    tags.emplace_back();
-    Tag& tag = tags.back();
-    tag.name_ = name_;
-    tag.value_ = value_subexpr.str();
-
-    // Determines which characters to remove from stat_name to elide remove_subexpr.
-    std::string::size_type start = remove_subexpr.first - stat_name.begin();
-    std::string::size_type end = remove_subexpr.second - stat_name.begin();
-    remove_characters.insert(start, end);
+    addTag(value_subexpr.str(), remove_subexpr.first - stat_name.begin(),
+           remove_subexpr.second - stat_name.begin(), tags, remove_characters);
     PERF_RECORD(perf, "re-match", name_);
     return true;
   }
@@ -105,5 +114,44 @@ bool TagExtractorImpl::extractTag(absl::string_view stat_name, std::vector<Tag>&
   return false;
 }
 
+TagExtractorRe2Impl::TagExtractorRe2Impl(const std::string& name, const std::string& regex,
+                                         const std::string& substr)
+    : TagExtractorImplBase(name, regex, substr), regex_(regex, re2::RE2::Quiet) {
+  if (!regex_.ok()) {
+    throw EnvoyException(fmt::format("Invalid regex '{}': {}", regex, regex_.error()));
+  }
+}
+
+bool TagExtractorRe2Impl::extractTag(absl::string_view stat_name, std::vector<Tag>& tags,
+                                     IntervalSet<size_t>& remove_characters) const {
+  PERF_OPERATION(perf);
+
+  if (substrMismatch(stat_name)) {
+    PERF_RECORD(perf, "re2-skip-substr", name_);
+    return false;
+  }
+
+  // Same subexpression semantics as TagExtractorImpl: the first one is removed from the name and
+  // the second one, if any, is the tag value.
+  const int num_submatches = std::min(regex_.NumberOfCapturingGroups(), 2) + 1;
+  re2::StringPiece match[3];
+  const re2::StringPiece text(stat_name.data(), stat_name.size());
+  if (num_submatches > 1 &&
+      regex_.Match(text, 0, text.size(), re2::RE2::UNANCHORED, match, num_submatches) &&
+      match[1].data() != nullptr) {
+    const re2::StringPiece& remove_subexpr = match[1];
+    const re2::StringPiece& value_subexpr =
+        num_submatches > 2 && match[2].data() != nullptr ? match[2] : remove_subexpr;
+
+    const size_t start = remove_subexpr.data() - stat_name.data();
+    addTag(absl::string_view(value_subexpr.data(), value_subexpr.size()), start,
+           start + remove_subexpr.size(), tags, remove_characters);
+    PERF_RECORD(perf, "re2-match", name_);
+    return true;
+  }
+  PERF_RECORD(perf, "re2-miss", name_);
+  return false;
+}
+
 } // namespace Stats
 } // namespace Envoy
@@ -7,29 +7,20 @@
 #include "envoy/stats/tag_extractor.h"
 
 #include "absl/strings/string_view.h"
+#include "re2/re2.h"
 
 namespace Envoy {
 namespace Stats {
 
-class TagExtractorImpl : public TagExtractor {
+/**
+ * Common base of the tag extractors, holding the tag name and the prefix and substring used to
+ * skip the regex for stat names that can't match.
+ */
+class TagExtractorImplBase : public TagExtractor {
 public:
-  /**
-   * Creates a tag extractor from the regex provided. name and regex must be non-empty.
-   * @param name name for tag extractor.
-   * @param regex regex expression.
-   * @param substr a substring that -- if provided -- must be present in a stat name
-   *               in order to match the regex. This is an optional performance tweak
-   *               to avoid large numbers of failed regex lookups.
-   * @return TagExtractorPtr newly constructed TagExtractor.
-   */
-  static TagExtractorPtr createTagExtractor(const std::string& name, const std::string& regex,
-                                            const std::string& substr = "");
-
-  TagExtractorImpl(const std::string& name, const std::string& regex,
-                   const std::string& substr = "");
+  TagExtractorImplBase(const std::string& name, const std::string& regex,
+                       const std::string& substr = "");
   std::string name() const override { return name_; }
-  bool extractTag(absl::string_view tag_extracted_name, std::vector<Tag>& tags,
-                  IntervalSet<size_t>& remove_characters) const override;
   absl::string_view prefixToken() const override { return prefix_; }
 
   /**
@@ -39,6 +30,18 @@ public:
    */
   bool substrMismatch(absl::string_view stat_name) const;
 
+protected:
+  /**
+   * Adds the tag found in a stat name.
+   * @param value the tag value.
+   * @param remove_start index of the first character of the stat name to remove.
+   * @param remove_end index following the last character of the stat name to remove.
+   */
+  void addTag(absl::string_view value, size_t remove_start, size_t remove_end,
+              std::vector<Tag>& tags, IntervalSet<size_t>& remove_characters) const;
+
+  const std::string name_;
+
 private:
   /**
    * Examines a regex string, looking for the pattern: ^alphanumerics_with_underscores\.
@@ -47,11 +50,58 @@ private:
    * @return std::string the prefix, or "" if no prefix found.
    */
   static std::string extractRegexPrefix(absl::string_view regex);
-  const std::string name_;
+
   const std::string prefix_;
   const std::string substr_;
+};
+
+/**
+ * Tag extractor using a std::regex, for the regexes specified in the configuration.
+ */
+class TagExtractorImpl : public TagExtractorImplBase {
+public:
+  /**
+   * Creates a tag extractor from the regex provided. name and regex must be non-empty.
+   * @param name name for tag extractor.
+   * @param regex regex expression.
+   * @param substr a substring that -- if provided -- must be present in a stat name
+   *               in order to match the regex. This is an optional performance tweak
+   *               to avoid large numbers of failed regex lookups.
+   * @return TagExtractorPtr newly constructed TagExtractor.
+   */
+  static TagExtractorPtr createTagExtractor(const std::string& name, const std::string& regex,
+                                            const std::string& substr = "");
+
+  TagExtractorImpl(const std::string& name, const std::string& regex,
+                   const std::string& substr = "");
+  bool extractTag(absl::string_view tag_extracted_name, std::vector<Tag>& tags,
+                  IntervalSet<size_t>& remove_characters) const override;
+
+private:
   const std::regex regex_;
 };
 
+/**
+ * Tag extractor using RE2, for the default regexes. These are written without lookarounds, so
+ * that TagProducerImpl can also compile them into a single RE2::Set.
+ */
+class TagExtractorRe2Impl : public TagExtractorImplBase {
+public:
+  /**
+   * @throw EnvoyException if RE2 can't compile the regex.
+   */
+  TagExtractorRe2Impl(const std::string& name, const std::string& regex,
+                      const std::string& substr = "");
+  bool extractTag(absl::string_view tag_extracted_name, std::vector<Tag>& tags,
+                  IntervalSet<size_t>& remove_characters) const override;
+
+  const re2::RE2& regex() const { return regex_; }
+
+private:
+  const re2::RE2 regex_;
+};
+
+using TagExtractorRe2ImplPtr = std::unique_ptr<const TagExtractorRe2Impl>;
+
 } // namespace Stats
 } // namespace Envoy
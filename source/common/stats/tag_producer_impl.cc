@@ -1,17 +1,20 @@
 #include "common/stats/tag_producer_impl.h"
 
+#include <algorithm>
 #include <string>
 
 #include "envoy/common/exception.h"
 #include "envoy/config/metrics/v2/stats.pb.h"
 
+#include "common/common/assert.h"
 #include "common/common/utility.h"
 #include "common/stats/tag_extractor_impl.h"
 
 namespace Envoy {
 namespace Stats {
 
-TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v2::StatsConfig& config) {
+TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v2::StatsConfig& config)
+    : re2_set_(std::make_unique<re2::RE2::Set>(re2::RE2::Quiet, re2::RE2::UNANCHORED)) {
   // To check name conflict.
   reserveResources(config);
   std::unordered_set<std::string> names = addDefaultExtractors(config);
@@ -40,14 +43,18 @@ TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v2::StatsConfig&
       default_tags_.emplace_back(Stats::Tag{name, tag_specifier.fixed_value()});
     }
   }
+
+  if (!re2_tag_extractors_.empty()) {
+    const bool compiled = re2_set_->Compile();
+    RELEASE_ASSERT(compiled, "failed to compile the default tag extractor regexes");
+  }
 }
 
 int TagProducerImpl::addExtractorsMatching(absl::string_view name) {
   int num_found = 0;
   for (const auto& desc : Config::TagNames::get().descriptorVec()) {
     if (desc.name_ == name) {
-      addExtractor(
-          Stats::TagExtractorImpl::createTagExtractor(desc.name_, desc.regex_, desc.substr_));
+      addRe2Extractor(desc.name_, desc.regex_, desc.substr_);
       ++num_found;
     }
   }
@@ -63,11 +70,29 @@ void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
   }
 }
 
-void TagProducerImpl::forEachExtractorMatching(
-    absl::string_view stat_name, std::function<void(const TagExtractorPtr&)> f) const {
-  IntervalSetImpl<size_t> remove_characters;
+void TagProducerImpl::addRe2Extractor(const std::string& name, const std::string& regex,
+                                      const std::string& substr) {
+  auto extractor = std::make_unique<const TagExtractorRe2Impl>(name, regex, substr);
+  const int index = re2_set_->Add(extractor->regex().pattern(), nullptr);
+  RELEASE_ASSERT(index == static_cast<int>(re2_tag_extractors_.size()),
+                 fmt::format("failed to add tag extractor regex '{}'", regex));
+  re2_tag_extractors_.emplace_back(std::move(extractor));
+}
+
+void TagProducerImpl::forEachExtractorMatching(absl::string_view stat_name,
+                                               std::function<void(const TagExtractor&)> f) const {
+  if (!re2_tag_extractors_.empty()) {
+    std::vector<int> matches;
+    if (re2_set_->Match(re2::StringPiece(stat_name.data(), stat_name.size()), &matches)) {
+      // Keep the tags in the order of the extractors.
+      std::sort(matches.begin(), matches.end());
+      for (const int index : matches) {
+        f(*re2_tag_extractors_[index]);
+      }
+    }
+  }
   for (const TagExtractorPtr& tag_extractor : tag_extractors_without_prefix_) {
-    f(tag_extractor);
+    f(*tag_extractor);
   }
   const absl::string_view::size_type dot = stat_name.find('.');
   if (dot != std::string::npos) {
@@ -75,7 +100,7 @@ void TagProducerImpl::forEachExtractorMatching(
     const auto iter = tag_extractor_prefix_map_.find(token);
     if (iter != tag_extractor_prefix_map_.end()) {
       for (const TagExtractorPtr& tag_extractor : iter->second) {
-        f(tag_extractor);
+        f(*tag_extractor);
       }
     }
   }
@@ -86,8 +111,8 @@ std::string TagProducerImpl::produceTags(absl::string_view metric_name,
   tags.insert(tags.end(), default_tags_.begin(), default_tags_.end());
   IntervalSetImpl<size_t> remove_characters;
   forEachExtractorMatching(
-      metric_name, [&remove_characters, &tags, &metric_name](const TagExtractorPtr& tag_extractor) {
-        tag_extractor->extractTag(metric_name, tags, remove_characters);
+      metric_name, [&remove_characters, &tags, &metric_name](const TagExtractor& tag_extractor) {
+        tag_extractor.extractTag(metric_name, tags, remove_characters);
       });
   return StringUtil::removeCharacters(metric_name, remove_characters);
 }
@@ -102,8 +127,7 @@ TagProducerImpl::addDefaultExtractors(const envoy::config::metrics::v2::StatsCon
   if (!config.has_use_all_default_tags() || config.use_all_default_tags().value()) {
     for (const auto& desc : Config::TagNames::get().descriptorVec()) {
       names.emplace(desc.name_);
-      addExtractor(
-          Stats::TagExtractorImpl::createTagExtractor(desc.name_, desc.regex_, desc.substr_));
+      addRe2Extractor(desc.name_, desc.regex_, desc.substr_);
     }
   }
   return names;
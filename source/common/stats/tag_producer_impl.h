@@ -16,16 +16,19 @@
 #include "common/common/utility.h"
 #include "common/config/well_known_names.h"
 #include "common/protobuf/protobuf.h"
+#include "common/stats/tag_extractor_impl.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
+#include "re2/set.h"
 
 namespace Envoy {
 namespace Stats {
 
 /**
  * Organizes a collection of TagExtractors so that stat-names can be processed without
- * iterating through all extractors.
+ * iterating through all extractors. The default extractors are compiled into a single RE2::Set,
+ * which finds all the default tags matching a stat name in one pass over the name.
  */
 class TagProducerImpl : public TagProducer {
 public:
@@ -50,6 +53,15 @@ private:
    */
   void addExtractor(TagExtractorPtr extractor);
 
+  /**
+   * Adds a default TagExtractor, whose regex is also added to the RE2::Set.
+   * @param name the tag name.
+   * @param regex the RE2 regex.
+   * @param substr the substring that must be present in matching stat names, if any.
+   */
+  void addRe2Extractor(const std::string& name, const std::string& regex,
+                       const std::string& substr);
+
   /**
    * Adds all default extractors matching the specified tag name. In this model,
    * more than one TagExtractor can be used to generate a given tag. The default
@@ -81,18 +93,24 @@ private:
    * callback f for each one. This is broken out this way to reduce code redundancy
    * during testing, where we want to verify that extraction is order-independent.
    * The possibly-matching-extractors list is computed by:
-   *   1. Finding the first '.' separated token in stat_name.
-   *   2. Collecting the TagExtractors whose regexes have that same prefix "^prefix\\."
-   *   3. Collecting also the TagExtractors whose regexes don't start with any prefix.
+   *   1. Matching stat_name against the RE2::Set of the default extractors.
+   *   2. Finding the first '.' separated token in stat_name.
+   *   3. Collecting the TagExtractors whose regexes have that same prefix "^prefix\\."
+   *   4. Collecting also the TagExtractors whose regexes don't start with any prefix.
    * In the future, we may also do substring searches in some cases.
    * See DefaultTagRegexTester::produceTagsReverse in test/common/stats/stats_impl_test.cc.
    *
    * @param stat_name const std::string& the stat name.
-   * @param f std::function<void(const TagExtractorPtr&)> function to call for each extractor.
+   * @param f std::function<void(const TagExtractor&)> function to call for each extractor.
    */
   void forEachExtractorMatching(absl::string_view stat_name,
-                                std::function<void(const TagExtractorPtr&)> f) const;
+                                std::function<void(const TagExtractor&)> f) const;
+
+  // The default extractors, indexed like their regexes in re2_set_.
+  std::vector<TagExtractorRe2ImplPtr> re2_tag_extractors_;
+  std::unique_ptr<re2::RE2::Set> re2_set_;
 
+  // The extractors configured with a regex, which may use std::regex only syntax.
   std::vector<TagExtractorPtr> tag_extractors_without_prefix_;
 
   // Maps a prefix word extracted out of a regex to a vector of TagExtractors. Note that
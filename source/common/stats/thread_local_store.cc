@@ -502,8 +502,13 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::histogramFromStatName(StatName name,
   } else {
     TagExtraction extraction(parent_, final_stat_name);
 
-    RefcountPtr<ParentHistogramImpl> stat(new ParentHistogramImpl(
-        final_stat_name, unit, parent_, *this, extraction.tagExtractedName(), extraction.tags()));
+    ConstSupportedBucketsSharedPtr buckets;
+    if (parent_.histogram_settings_ != nullptr) {
+      buckets = parent_.histogram_settings_->buckets(symbolTable().toString(final_stat_name));
+    }
+    RefcountPtr<ParentHistogramImpl> stat(
+        new ParentHistogramImpl(final_stat_name, unit, std::move(buckets), parent_, *this,
+                                extraction.tagExtractedName(), extraction.tags()));
     central_ref = &central_cache_.histograms_[stat->statName()];
     *central_ref = stat;
   }
@@ -552,8 +557,8 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::tlsHistogram(StatName name,
   std::vector<Tag> tags;
   std::string tag_extracted_name =
       parent_.tagProducer().produceTags(symbolTable().toString(name), tags);
-  TlsHistogramSharedPtr hist_tls_ptr(
-      new ThreadLocalHistogramImpl(name, parent.unit(), tag_extracted_name, tags, symbolTable()));
+  TlsHistogramSharedPtr hist_tls_ptr(new ThreadLocalHistogramImpl(
+      name, parent.unit(), parent.buckets(), tag_extracted_name, tags, symbolTable()));
 
   parent.addTlsHistogram(hist_tls_ptr);
 
@@ -564,46 +569,79 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::tlsHistogram(StatName name,
 }
 
 ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name, Histogram::Unit unit,
+                                                   ConstSupportedBucketsSharedPtr buckets,
                                                    const std::string& tag_extracted_name,
                                                    const std::vector<Tag>& tags,
                                                    SymbolTable& symbol_table)
     : HistogramImplHelper(name, tag_extracted_name, tags, symbol_table), unit_(unit),
       current_active_(0), used_(false), created_thread_id_(std::this_thread::get_id()),
       symbol_table_(symbol_table) {
-  histograms_[0] = hist_alloc();
-  histograms_[1] = hist_alloc();
+  if (buckets != nullptr) {
+    fixed_histograms_[0] = std::make_unique<FixedBucketHistogram>(buckets);
+    fixed_histograms_[1] = std::make_unique<FixedBucketHistogram>(buckets);
+  } else {
+    histograms_[0] = hist_alloc();
+    histograms_[1] = hist_alloc();
+  }
 }
 
 ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
   MetricImpl::clear(symbolTable());
-  hist_free(histograms_[0]);
-  hist_free(histograms_[1]);
+  if (histograms_[0] != nullptr) {
+    hist_free(histograms_[0]);
+    hist_free(histograms_[1]);
+  }
 }
 
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
-  hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  if (fixed_histograms_[current_active_] != nullptr) {
+    fixed_histograms_[current_active_]->recordValue(value);
+  } else {
+    hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  }
   used_ = true;
 }
 
 void ThreadLocalHistogramImpl::merge(histogram_t* target) {
+  ASSERT(histograms_[0] != nullptr);
   histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
   hist_accumulate(target, other_histogram, 1);
   hist_clear(*other_histogram);
 }
 
-ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit, Store& parent,
+void ThreadLocalHistogramImpl::merge(FixedBucketHistogram& target) {
+  ASSERT(fixed_histograms_[0] != nullptr);
+  FixedBucketHistogram& other_histogram = *fixed_histograms_[otherHistogramIndex()];
+  target.merge(other_histogram);
+  other_histogram.clear();
+}
+
+ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
+                                         ConstSupportedBucketsSharedPtr buckets, Store& parent,
                                          TlsScope& tls_scope, absl::string_view tag_extracted_name,
                                          const std::vector<Tag>& tags)
     : MetricImpl(name, tag_extracted_name, tags, parent.symbolTable()), unit_(unit),
-      parent_(parent), tls_scope_(tls_scope), interval_histogram_(hist_alloc()),
-      cumulative_histogram_(hist_alloc()), interval_statistics_(interval_histogram_),
-      cumulative_statistics_(cumulative_histogram_), merged_(false) {}
+      buckets_(std::move(buckets)), parent_(parent), tls_scope_(tls_scope), merged_(false) {
+  if (buckets_ != nullptr) {
+    fixed_interval_histogram_ = std::make_unique<FixedBucketHistogram>(buckets_);
+    fixed_cumulative_histogram_ = std::make_unique<FixedBucketHistogram>(buckets_);
+    interval_statistics_.refresh(*fixed_interval_histogram_);
+    cumulative_statistics_.refresh(*fixed_cumulative_histogram_);
+  } else {
+    interval_histogram_ = hist_alloc();
+    cumulative_histogram_ = hist_alloc();
+    interval_statistics_.refresh(interval_histogram_);
+    cumulative_statistics_.refresh(cumulative_histogram_);
+  }
+}
 
 ParentHistogramImpl::~ParentHistogramImpl() {
   MetricImpl::clear(symbolTable());
-  hist_free(interval_histogram_);
-  hist_free(cumulative_histogram_);
+  if (interval_histogram_ != nullptr) {
+    hist_free(interval_histogram_);
+    hist_free(cumulative_histogram_);
+  }
 }
 
 Histogram::Unit ParentHistogramImpl::unit() const { return unit_; }
@@ -622,6 +660,21 @@ bool ParentHistogramImpl::used() const {
 void ParentHistogramImpl::merge() {
   Thread::ReleasableLockGuard lock(merge_lock_);
   if (merged_ || usedLockHeld()) {
+    if (buckets_ != nullptr) {
+      fixed_interval_histogram_->clear();
+      // Merging fixed bucket histograms is a few vector adds per TLS histogram, so it is done
+      // with the lock held.
+      for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
+        tls_histogram->merge(*fixed_interval_histogram_);
+      }
+      lock.release();
+      fixed_cumulative_histogram_->merge(*fixed_interval_histogram_);
+      cumulative_statistics_.refresh(*fixed_cumulative_histogram_);
+      interval_statistics_.refresh(*fixed_interval_histogram_);
+      merged_ = true;
+      return;
+    }
+
     hist_clear(interval_histogram_);
     // Here we could copy all the pointers to TLS histograms in the tls_histogram_ list,
     // then release the lock before we do the actual merge. However it is not a big deal
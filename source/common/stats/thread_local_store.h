@@ -30,12 +30,18 @@ namespace Stats {
  */
 class ThreadLocalHistogramImpl : public HistogramImplHelper {
 public:
+  /**
+   * @param buckets supplies the bucket bounds to record into, or nullptr to record into a
+   *        log-linear histogram.
+   */
   ThreadLocalHistogramImpl(StatName name, Histogram::Unit unit,
+                           ConstSupportedBucketsSharedPtr buckets,
                            const std::string& tag_extracted_name, const std::vector<Tag>& tags,
                            SymbolTable& symbol_table);
   ~ThreadLocalHistogramImpl() override;
 
   void merge(histogram_t* target);
+  void merge(FixedBucketHistogram& target);
 
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
@@ -63,7 +69,10 @@ private:
   Histogram::Unit unit_;
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_;
-  histogram_t* histograms_[2];
+  // Exactly one of histograms_ and fixed_histograms_ is populated, depending on whether the
+  // histogram has configured buckets.
+  histogram_t* histograms_[2]{};
+  std::unique_ptr<FixedBucketHistogram> fixed_histograms_[2];
   std::atomic<bool> used_;
   std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -78,11 +87,17 @@ class TlsScope;
  */
 class ParentHistogramImpl : public MetricImpl<ParentHistogram> {
 public:
-  ParentHistogramImpl(StatName name, Histogram::Unit unit, Store& parent, TlsScope& tls_scope,
-                      absl::string_view tag_extracted_name, const std::vector<Tag>& tags);
+  /**
+   * @param buckets supplies the bucket bounds to record into, or nullptr to record into a
+   *        log-linear histogram.
+   */
+  ParentHistogramImpl(StatName name, Histogram::Unit unit, ConstSupportedBucketsSharedPtr buckets,
+                      Store& parent, TlsScope& tls_scope, absl::string_view tag_extracted_name,
+                      const std::vector<Tag>& tags);
   ~ParentHistogramImpl() override;
 
   void addTlsHistogram(const TlsHistogramSharedPtr& hist_ptr);
+  const ConstSupportedBucketsSharedPtr& buckets() const { return buckets_; }
 
   // Stats::Histogram
   Histogram::Unit unit() const override;
@@ -116,10 +131,15 @@ private:
   bool usedLockHeld() const EXCLUSIVE_LOCKS_REQUIRED(merge_lock_);
 
   Histogram::Unit unit_;
+  const ConstSupportedBucketsSharedPtr buckets_;
   Store& parent_;
   TlsScope& tls_scope_;
-  histogram_t* interval_histogram_;
-  histogram_t* cumulative_histogram_;
+  // Log-linear histograms, used when buckets_ is nullptr.
+  histogram_t* interval_histogram_{};
+  histogram_t* cumulative_histogram_{};
+  // Fixed bucket histograms, used when buckets_ is set.
+  std::unique_ptr<FixedBucketHistogram> fixed_interval_histogram_;
+  std::unique_ptr<FixedBucketHistogram> fixed_cumulative_histogram_;
   HistogramStatisticsImpl interval_statistics_;
   HistogramStatisticsImpl cumulative_statistics_;
   mutable Thread::MutexBasicLockable merge_lock_;
@@ -223,6 +243,9 @@ public:
     tag_producer_ = std::move(tag_producer);
   }
   void setStatsMatcher(StatsMatcherPtr&& stats_matcher) override;
+  void setHistogramSettings(HistogramSettingsConstPtr&& histogram_settings) override {
+    histogram_settings_ = std::move(histogram_settings);
+  }
   void initializeThreading(Event::Dispatcher& main_thread_dispatcher,
                            ThreadLocal::Instance& tls) override;
   void shutdownThreading() override;
@@ -369,6 +392,7 @@ private:
   std::list<std::reference_wrapper<Sink>> timer_sinks_;
   TagProducerPtr tag_producer_;
   StatsMatcherPtr stats_matcher_;
+  HistogramSettingsConstPtr histogram_settings_;
   std::atomic<bool> threading_ever_initialized_{};
   std::atomic<bool> shutting_down_{};
   std::atomic<bool> merge_in_progress_{};
@@ -187,26 +187,31 @@ void EdsClusterImpl::reloadHealthyHostsHelper(const HostSharedPtr& host) {
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
+    HostVectorConstSharedPtr hosts = host_set->hostsPtr();
+    HostsPerLocalityConstSharedPtr hosts_per_locality = host_set->hostsPerLocalityPtr();
 
     // Filter current hosts in case we need to exclude a host.
-    HostVectorSharedPtr hosts_copy(new HostVector());
-    std::copy_if(host_set->hosts().begin(), host_set->hosts().end(),
-                 std::back_inserter(*hosts_copy),
-                 [&host_to_exclude](const HostSharedPtr& host) { return host_to_exclude != host; });
-
-    // Setup a hosts to remove vector in case we need to exclude a host.
     HostVector hosts_to_remove;
-    if (hosts_copy->size() != host_set->hosts().size()) {
-      ASSERT(hosts_copy->size() == host_set->hosts().size() - 1);
+    if (host_to_exclude != nullptr &&
+        std::find(hosts->begin(), hosts->end(), host_to_exclude) != hosts->end()) {
+      HostVectorSharedPtr hosts_copy(new HostVector());
+      std::copy_if(
+          hosts->begin(), hosts->end(), std::back_inserter(*hosts_copy),
+          [&host_to_exclude](const HostSharedPtr& host) { return host_to_exclude != host; });
+      hosts = std::move(hosts_copy);
       hosts_to_remove.emplace_back(host_to_exclude);
+      hosts_per_locality = hosts_per_locality->filter(
+          {[&host_to_exclude](const Host& host) { return &host != host_to_exclude.get(); }})[0];
     }
 
-    // Filter hosts per locality in case we need to exclude a host.
-    HostsPerLocalityConstSharedPtr hosts_per_locality_copy = host_set->hostsPerLocality().filter(
-        {[&host_to_exclude](const Host& host) { return &host != host_to_exclude.get(); }})[0];
-
-    prioritySet().updateHosts(priority,
-                              HostSetImpl::partitionHosts(hosts_copy, hosts_per_locality_copy),
+    // The host lists that the update didn't affect are shared with the current host set, and the
+    // host sets left unchanged by a single host update are not updated.
+    auto update_hosts_params =
+        HostSetImpl::partitionHosts(std::move(hosts), std::move(hosts_per_locality), *host_set);
+    if (host != nullptr && HostSetImpl::unchanged(update_hosts_params, *host_set)) {
+      continue;
+    }
+    prioritySet().updateHosts(priority, std::move(update_hosts_params),
                               host_set->localityWeights(), {}, hosts_to_remove, absl::nullopt);
   }
 
@@ -633,10 +633,11 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
     : ZoneAwareLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
                                 common_config),
       seed_(random_.random()) {
-  // We fully recompute the schedulers for a given host set here on membership change, which is
-  // consistent with what other LB implementations do (e.g. thread aware).
-  // The downside of a full recompute is that time complexity is O(n * log n),
-  // so we will need to do better at delta tracking to scale (see
+  // We recompute the schedulers of the host sources of a host set on membership change, which is
+  // consistent with what other LB implementations do (e.g. thread aware). The schedulers of the
+  // sources whose hosts didn't change are kept, so that a health change only rebuilds the
+  // schedulers of the sources the host moved in or out of. A rebuild is still O(n * log n), so we
+  // will need to do better at delta tracking to scale (see
   // https://github.com/envoyproxy/envoy/issues/2874).
   priority_set.addPriorityUpdateCb(
       [this](uint32_t priority, const HostVector&, const HostVector&) { refresh(priority); });
@@ -649,9 +650,19 @@ void EdfLoadBalancerBase::initialize() {
 }
 
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
-  const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
+  const auto add_hosts_source = [this](HostsSource source, HostVectorConstSharedPtr hosts_ptr) {
+    const HostVector& hosts = *hosts_ptr;
+    // Keep the existing scheduler if the host set still shares the host list it was built for,
+    // e.g. for the sources a health change didn't touch. Host lists are immutable, and in-place
+    // weight changes are picked up when the host is next picked, as for a rebuilt scheduler.
+    auto& scheduler = scheduler_[source];
+    if (scheduler.hosts_ == hosts_ptr) {
+      return;
+    }
+
     // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
+    scheduler = Scheduler{};
+    scheduler.hosts_ = hosts_ptr;
     refreshHostSource(source);
 
     // Check if the original host weights are equal and skip EDF creation if they are. When all
@@ -689,23 +700,30 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
   };
 
   // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
+  // The filtered host lists are shared through aliasing pointers, which keep their owner alive.
   const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts());
+  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hostsPtr());
+  const auto healthy_hosts = host_set->healthyHostsPtr();
   add_hosts_source(HostsSource(priority, HostsSource::SourceType::HealthyHosts),
-                   host_set->healthyHosts());
+                   HostVectorConstSharedPtr(healthy_hosts, &healthy_hosts->get()));
+  const auto degraded_hosts = host_set->degradedHostsPtr();
   add_hosts_source(HostsSource(priority, HostsSource::SourceType::DegradedHosts),
-                   host_set->degradedHosts());
-  for (uint32_t locality_index = 0;
-       locality_index < host_set->healthyHostsPerLocality().get().size(); ++locality_index) {
+                   HostVectorConstSharedPtr(degraded_hosts, &degraded_hosts->get()));
+  const auto healthy_hosts_per_locality = host_set->healthyHostsPerLocalityPtr();
+  for (uint32_t locality_index = 0; locality_index < healthy_hosts_per_locality->get().size();
+       ++locality_index) {
     add_hosts_source(
         HostsSource(priority, HostsSource::SourceType::LocalityHealthyHosts, locality_index),
-        host_set->healthyHostsPerLocality().get()[locality_index]);
+        HostVectorConstSharedPtr(healthy_hosts_per_locality,
+                                 &healthy_hosts_per_locality->get()[locality_index]));
   }
-  for (uint32_t locality_index = 0;
-       locality_index < host_set->degradedHostsPerLocality().get().size(); ++locality_index) {
+  const auto degraded_hosts_per_locality = host_set->degradedHostsPerLocalityPtr();
+  for (uint32_t locality_index = 0; locality_index < degraded_hosts_per_locality->get().size();
+       ++locality_index) {
     add_hosts_source(
         HostsSource(priority, HostsSource::SourceType::LocalityDegradedHosts, locality_index),
-        host_set->degradedHostsPerLocality().get()[locality_index]);
+        HostVectorConstSharedPtr(degraded_hosts_per_locality,
+                                 &degraded_hosts_per_locality->get()[locality_index]));
   }
 }
 
@@ -356,6 +356,9 @@ protected:
     // host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
     std::unique_ptr<EdfScheduler<const Host>> edf_;
+    // The hosts the scheduler was built for. The scheduler is kept when a refresh finds the same
+    // hosts in the source.
+    HostVectorConstSharedPtr hosts_;
   };
 
   void initialize();
@@ -60,14 +60,13 @@ MaglevTable::MaglevTable(const NormalizedHostWeightVector& normalized_host_weigh
     }
   }
 
-  uint64_t min_entries_per_host = table_size_;
-  uint64_t max_entries_per_host = 0;
+  min_entries_per_host_ = table_size_;
+  max_entries_per_host_ = 0;
   for (const auto& entry : table_build_entries) {
-    min_entries_per_host = std::min(entry.count_, min_entries_per_host);
-    max_entries_per_host = std::max(entry.count_, max_entries_per_host);
+    min_entries_per_host_ = std::min(entry.count_, min_entries_per_host_);
+    max_entries_per_host_ = std::max(entry.count_, max_entries_per_host_);
   }
-  stats_.min_entries_per_host_.set(min_entries_per_host);
-  stats_.max_entries_per_host_.set(max_entries_per_host);
+  applyStats();
 
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
     for (uint64_t i = 0; i < table_.size(); i++) {
@@ -84,6 +83,16 @@ HostConstSharedPtr MaglevTable::chooseHost(uint64_t hash) const {
   return table_[hash % table_size_];
 }
 
+void MaglevTable::applyStats() const {
+  // Like building an empty table, reusing one leaves the stats alone.
+  if (table_.empty()) {
+    return;
+  }
+
+  stats_.min_entries_per_host_.set(min_entries_per_host_);
+  stats_.max_entries_per_host_.set(max_entries_per_host_);
+}
+
 uint64_t MaglevTable::permutation(const TableBuildEntry& entry) {
   return (entry.offset_ + (entry.skip_ * entry.next_)) % table_size_;
 }
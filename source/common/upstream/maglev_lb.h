@@ -38,6 +38,7 @@ public:
 
   // ThreadAwareLoadBalancerBase::HashingLoadBalancer
   HostConstSharedPtr chooseHost(uint64_t hash) const override;
+  void applyStats() const override;
 
   // Recommended table size in section 5.3 of the paper.
   static const uint64_t DefaultTableSize = 65537;
@@ -60,6 +61,8 @@ private:
 
   const uint64_t table_size_;
   std::vector<HostConstSharedPtr> table_;
+  uint64_t min_entries_per_host_{};
+  uint64_t max_entries_per_host_{};
   MaglevLoadBalancerStats& stats_;
 };
 
@@ -79,6 +79,17 @@ HostConstSharedPtr RingHashLoadBalancer::Ring::chooseHost(uint64_t h) const {
   }
 }
 
+void RingHashLoadBalancer::Ring::applyStats() const {
+  // Like building an empty ring, reusing one leaves the stats alone.
+  if (ring_.empty()) {
+    return;
+  }
+
+  stats_.size_.set(ring_size_);
+  stats_.min_hashes_per_host_.set(min_hashes_per_host_);
+  stats_.max_hashes_per_host_.set(max_hashes_per_host_);
+}
+
 using HashFunction = envoy::api::v2::Cluster_RingHashLbConfig_HashFunction;
 RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_host_weights,
                                  double min_normalized_weight, uint64_t min_ring_size,
@@ -178,9 +189,10 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
     }
   }
 
-  stats_.size_.set(ring_size);
-  stats_.min_hashes_per_host_.set(min_hashes_per_host);
-  stats_.max_hashes_per_host_.set(max_hashes_per_host);
+  ring_size_ = ring_size;
+  min_hashes_per_host_ = min_hashes_per_host;
+  max_hashes_per_host_ = max_hashes_per_host;
+  applyStats();
 }
 
 } // namespace Upstream
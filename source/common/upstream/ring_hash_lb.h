@@ -62,8 +62,12 @@ private:
 
     // ThreadAwareLoadBalancerBase::HashingLoadBalancer
     HostConstSharedPtr chooseHost(uint64_t hash) const override;
+    void applyStats() const override;
 
     std::vector<RingEntry> ring_;
+    uint64_t ring_size_{};
+    uint64_t min_hashes_per_host_{};
+    uint64_t max_hashes_per_host_{};
 
     RingHashLoadBalancerStats& stats_;
   };
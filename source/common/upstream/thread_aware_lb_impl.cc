@@ -80,12 +80,14 @@ void ThreadAwareLoadBalancerBase::initialize() {
   // complicated initialization as the load balancer would need its own initialized callback. I
   // think the synchronous/asynchronous split is probably the best option.
   priority_set_.addPriorityUpdateCb(
-      [this](uint32_t, const HostVector&, const HostVector&) -> void { refresh(); });
+      [this](uint32_t priority, const HostVector&, const HostVector&) -> void {
+        refresh(priority);
+      });
 
-  refresh();
+  refresh(absl::nullopt);
 }
 
-void ThreadAwareLoadBalancerBase::refresh() {
+void ThreadAwareLoadBalancerBase::refresh(absl::optional<uint32_t> updated_priority) {
   auto per_priority_state_vector = std::make_shared<std::vector<PerPriorityStatePtr>>(
       priority_set_.hostSetsPerPriority().size());
   auto healthy_per_priority_load =
@@ -93,6 +95,13 @@ void ThreadAwareLoadBalancerBase::refresh() {
   auto degraded_per_priority_load =
       std::make_shared<DegradedLoad>(per_priority_load_.degraded_priority_load_);
 
+  // Only this thread writes the state, the lock is only needed by the annotations.
+  std::shared_ptr<std::vector<PerPriorityStatePtr>> previous_per_priority_state_vector;
+  {
+    absl::ReaderMutexLock lock(&factory_->mutex_);
+    previous_per_priority_state_vector = factory_->per_priority_state_;
+  }
+
   for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
     const uint32_t priority = host_set->priority();
     (*per_priority_state_vector)[priority] = std::make_unique<PerPriorityState>();
@@ -101,6 +110,19 @@ void ThreadAwareLoadBalancerBase::refresh() {
     // in hosts set or hosts' health.
     per_priority_state->global_panic_ = per_priority_panic_[priority];
 
+    // The hosts of the other priorities didn't change, so their load balancers are reused unless
+    // entering or leaving panic mode changed the hosts they use.
+    if (updated_priority.has_value() && priority != updated_priority.value() &&
+        previous_per_priority_state_vector != nullptr &&
+        priority < previous_per_priority_state_vector->size()) {
+      const auto& previous_per_priority_state = (*previous_per_priority_state_vector)[priority];
+      if (previous_per_priority_state->global_panic_ == per_priority_state->global_panic_) {
+        per_priority_state->current_lb_ = previous_per_priority_state->current_lb_;
+        per_priority_state->current_lb_->applyStats();
+        continue;
+      }
+    }
+
     // Normalize host and locality weights such that the sum of all normalized weights is 1.
     NormalizedHostWeightVector normalized_host_weights;
     double min_normalized_weight = 1.0;
@@ -5,6 +5,7 @@
 #include "common/upstream/load_balancer_impl.h"
 
 #include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -25,6 +26,13 @@ public:
   public:
     virtual ~HashingLoadBalancer() = default;
     virtual HostConstSharedPtr chooseHost(uint64_t hash) const PURE;
+
+    /**
+     * Set the load balancer stats to the values computed when this load balancer was built. Called
+     * when it is reused for a priority whose hosts didn't change, so that the stats end up as if
+     * the load balancers of all priorities had been rebuilt.
+     */
+    virtual void applyStats() const PURE;
   };
   using HashingLoadBalancerSharedPtr = std::shared_ptr<HashingLoadBalancer>;
 
@@ -84,7 +92,10 @@ private:
   virtual HashingLoadBalancerSharedPtr
   createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double max_normalized_weight) PURE;
-  void refresh();
+  // Rebuilds the load balancers of the updated priority, and of the priorities whose panic state
+  // changed. The load balancers of the other priorities are shared with the previous state. All of
+  // them are rebuilt if updated_priority is empty.
+  void refresh(absl::optional<uint32_t> updated_priority);
 
   std::shared_ptr<LoadBalancerFactoryImpl> factory_;
 };
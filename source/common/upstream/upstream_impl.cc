@@ -203,6 +203,64 @@ bool updateHealthFlag(const Host& updated_host, Host& existing_host, Host::Healt
   return false;
 }
 
+bool isHealthy(const Host& host) { return host.health() == Host::Health::Healthy; }
+bool isDegraded(const Host& host) { return host.health() == Host::Health::Degraded; }
+bool isExcluded(const Host& host) {
+  return host.healthFlagGet(Host::HealthFlag::PENDING_ACTIVE_HC);
+}
+
+// @return bool whether filtered holds, in order, the hosts matching the predicate.
+bool filterMatches(const HostVector& hosts, bool (*predicate)(const Host&),
+                   const HostVector& filtered) {
+  size_t matches = 0;
+  for (const auto& host : hosts) {
+    if (predicate(*host)) {
+      if (matches == filtered.size() || filtered[matches] != host) {
+        return false;
+      }
+      ++matches;
+    }
+  }
+  return matches == filtered.size();
+}
+
+// Filters a host list, returning the previous filtered list if it still holds the matching hosts.
+template <class FilteredHostVector>
+std::shared_ptr<const FilteredHostVector>
+filterHostList(const HostVector& hosts, bool (*predicate)(const Host&),
+               std::shared_ptr<const FilteredHostVector> previous) {
+  if (previous != nullptr && filterMatches(hosts, predicate, previous->get())) {
+    return previous;
+  }
+
+  auto filtered = std::make_shared<FilteredHostVector>();
+  for (const auto& host : hosts) {
+    if (predicate(*host)) {
+      filtered->get().emplace_back(host);
+    }
+  }
+  return filtered;
+}
+
+// Same as filterHostList() for hosts per locality.
+HostsPerLocalityConstSharedPtr filterHostsPerLocality(const HostsPerLocality& hosts_per_locality,
+                                                      bool (*predicate)(const Host&),
+                                                      HostsPerLocalityConstSharedPtr previous) {
+  if (previous != nullptr &&
+      previous->hasLocalLocality() == hosts_per_locality.hasLocalLocality() &&
+      previous->get().size() == hosts_per_locality.get().size()) {
+    bool matches = true;
+    for (size_t i = 0; matches && i < hosts_per_locality.get().size(); ++i) {
+      matches = filterMatches(hosts_per_locality.get()[i], predicate, previous->get()[i]);
+    }
+    if (matches) {
+      return previous;
+    }
+  }
+
+  return hosts_per_locality.filter({predicate})[0];
+}
+
 // Converts a set of hosts into a HostVector, excluding certain hosts.
 // @param hosts hosts to convert
 // @param excluded_hosts hosts to exclude from the resulting vector.
@@ -491,6 +549,39 @@ HostSetImpl::partitionHosts(HostVectorConstSharedPtr hosts,
                            std::move(std::get<2>(healthy_degraded_excluded_hosts_per_locality)));
 }
 
+PrioritySet::UpdateHostsParams
+HostSetImpl::partitionHosts(HostVectorConstSharedPtr hosts,
+                            HostsPerLocalityConstSharedPtr hosts_per_locality,
+                            const HostSet& previous) {
+  auto healthy_hosts = filterHostList(*hosts, isHealthy, previous.healthyHostsPtr());
+  auto degraded_hosts = filterHostList(*hosts, isDegraded, previous.degradedHostsPtr());
+  auto excluded_hosts = filterHostList(*hosts, isExcluded, previous.excludedHostsPtr());
+  auto healthy_hosts_per_locality =
+      filterHostsPerLocality(*hosts_per_locality, isHealthy, previous.healthyHostsPerLocalityPtr());
+  auto degraded_hosts_per_locality = filterHostsPerLocality(
+      *hosts_per_locality, isDegraded, previous.degradedHostsPerLocalityPtr());
+  auto excluded_hosts_per_locality = filterHostsPerLocality(
+      *hosts_per_locality, isExcluded, previous.excludedHostsPerLocalityPtr());
+
+  return updateHostsParams(std::move(hosts), std::move(hosts_per_locality),
+                           std::move(healthy_hosts), std::move(healthy_hosts_per_locality),
+                           std::move(degraded_hosts), std::move(degraded_hosts_per_locality),
+                           std::move(excluded_hosts), std::move(excluded_hosts_per_locality));
+}
+
+bool HostSetImpl::unchanged(const PrioritySet::UpdateHostsParams& update_hosts_params,
+                            const HostSet& host_set) {
+  return update_hosts_params.hosts == host_set.hostsPtr() &&
+         update_hosts_params.healthy_hosts == host_set.healthyHostsPtr() &&
+         update_hosts_params.degraded_hosts == host_set.degradedHostsPtr() &&
+         update_hosts_params.excluded_hosts == host_set.excludedHostsPtr() &&
+         update_hosts_params.hosts_per_locality == host_set.hostsPerLocalityPtr() &&
+         update_hosts_params.healthy_hosts_per_locality == host_set.healthyHostsPerLocalityPtr() &&
+         update_hosts_params.degraded_hosts_per_locality ==
+             host_set.degradedHostsPerLocalityPtr() &&
+         update_hosts_params.excluded_hosts_per_locality == host_set.excludedHostsPerLocalityPtr();
+}
+
 double HostSetImpl::effectiveLocalityWeight(uint32_t index,
                                             const HostsPerLocality& eligible_hosts_per_locality,
                                             const HostsPerLocality& excluded_hosts_per_locality,
@@ -995,16 +1086,19 @@ void ClusterImplBase::reloadHealthyHosts(const HostSharedPtr& host) {
   reloadHealthyHostsHelper(host);
 }
 
-void ClusterImplBase::reloadHealthyHostsHelper(const HostSharedPtr&) {
+void ClusterImplBase::reloadHealthyHostsHelper(const HostSharedPtr& host) {
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
-    // TODO(htuch): Can we skip these copies by exporting out const shared_ptr from HostSet?
-    HostVectorConstSharedPtr hosts_copy(new HostVector(host_set->hosts()));
-
-    HostsPerLocalityConstSharedPtr hosts_per_locality_copy = host_set->hostsPerLocality().clone();
-    prioritySet().updateHosts(priority,
-                              HostSetImpl::partitionHosts(hosts_copy, hosts_per_locality_copy),
+    // The host lists that the health change didn't affect are shared with the current host set.
+    auto update_hosts_params = HostSetImpl::partitionHosts(
+        host_set->hostsPtr(), host_set->hostsPerLocalityPtr(), *host_set);
+    // When a single host changed, the other host sets are left alone rather than updated in place
+    // on every worker.
+    if (host != nullptr && HostSetImpl::unchanged(update_hosts_params, *host_set)) {
+      continue;
+    }
+    prioritySet().updateHosts(priority, std::move(update_hosts_params),
                               host_set->localityWeights(), {}, {}, absl::nullopt);
   }
 }
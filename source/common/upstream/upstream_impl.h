@@ -344,6 +344,21 @@ public:
   static PrioritySet::UpdateHostsParams updateHostsParams(const HostSet& host_set);
   static PrioritySet::UpdateHostsParams
   partitionHosts(HostVectorConstSharedPtr hosts, HostsPerLocalityConstSharedPtr hosts_per_locality);
+  /**
+   * Same as partitionHosts(), but reuses the healthy, degraded and excluded host lists of the
+   * previous host set that still hold the same hosts. A health change then only copies the lists
+   * that the host moved in or out of.
+   * @param previous the host set being updated.
+   */
+  static PrioritySet::UpdateHostsParams
+  partitionHosts(HostVectorConstSharedPtr hosts, HostsPerLocalityConstSharedPtr hosts_per_locality,
+                 const HostSet& previous);
+  /**
+   * @return bool whether updating the host set with the params would leave all its host lists
+   *         unchanged.
+   */
+  static bool unchanged(const PrioritySet::UpdateHostsParams& update_hosts_params,
+                        const HostSet& host_set);
 
   void updateHosts(PrioritySet::UpdateHostsParams&& update_hosts_params,
                    LocalityWeightsConstSharedPtr locality_weights, const HostVector& hosts_added,
@@ -1,5 +1,7 @@
 #include "extensions/common/dynamic_forward_proxy/dns_cache_impl.h"
 
+#include <algorithm>
+
 #include "envoy/config/common/dynamic_forward_proxy/v2alpha/dns_cache.pb.h"
 
 #include "common/http/utility.h"
@@ -23,10 +25,15 @@ DnsCacheImpl::DnsCacheImpl(
       scope_(root_scope.createScope(fmt::format("dns_cache.{}.", config.name()))),
       stats_{ALL_DNS_CACHE_STATS(POOL_COUNTER(*scope_), POOL_GAUGE(*scope_))},
       refresh_interval_(PROTOBUF_GET_MS_OR_DEFAULT(config, dns_refresh_rate, 60000)),
+      respect_dns_ttl_(config.respect_dns_ttl()),
       host_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, host_ttl, 300000)),
       max_hosts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_hosts, 1024)) {
   tls_slot_->set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalHostInfo>(); });
   updateTlsHostsMap();
+
+  for (const auto& preresolve_host : config.preresolve_hostnames()) {
+    startCacheLoad(preresolve_host.host(), preresolve_host.default_port());
+  }
 }
 
 DnsCacheImpl::~DnsCacheImpl() {
@@ -49,6 +56,7 @@ DnsCacheImpl::loadDnsCacheEntry(absl::string_view host, uint16_t default_port,
   auto tls_host = tls_host_info.host_map_->find(host);
   if (tls_host != tls_host_info.host_map_->end()) {
     ENVOY_LOG(debug, "thread local hit for host '{}'", host);
+    stats_.cache_hit_.inc();
     return {LoadDnsCacheEntryStatus::InCache, nullptr};
   } else if (tls_host_info.host_map_->size() >= max_hosts_) {
     // Given that we do this check in thread local context, it's possible for two threads to race
@@ -59,6 +67,7 @@ DnsCacheImpl::loadDnsCacheEntry(absl::string_view host, uint16_t default_port,
     return {LoadDnsCacheEntryStatus::Overflow, nullptr};
   } else {
     ENVOY_LOG(debug, "thread local miss for host '{}', posting to main thread", host);
+    stats_.cache_miss_.inc();
     main_thread_dispatcher_.post(
         [this, host = std::string(host), default_port]() { startCacheLoad(host, default_port); });
     return {LoadDnsCacheEntryStatus::Loading,
@@ -187,7 +196,16 @@ void DnsCacheImpl::finishResolve(const std::string& host,
   // Kick off the refresh timer.
   // TODO(mattklein123): Consider jitter here. It may not be necessary since the initial host
   // is populated dynamically.
-  primary_host_info.refresh_timer_->enableTimer(refresh_interval_);
+  primary_host_info.refresh_timer_->enableTimer(refreshInterval(response));
+}
+
+std::chrono::milliseconds
+DnsCacheImpl::refreshInterval(const std::list<Network::DnsResponse>& response) const {
+  // The host uses the first address of the response, so its TTL is the one that matters.
+  if (respect_dns_ttl_ && !response.empty() && response.front().ttl_.count() > 0) {
+    return std::min<std::chrono::milliseconds>(response.front().ttl_, refresh_interval_);
+  }
+  return refresh_interval_;
 }
 
 void DnsCacheImpl::runAddUpdateCallbacks(const std::string& host,
@@ -19,6 +19,8 @@ namespace DynamicForwardProxy {
  * All DNS cache stats. @see stats_macros.h
  */
 #define ALL_DNS_CACHE_STATS(COUNTER, GAUGE)                                                        \
+  COUNTER(cache_hit)                                                                               \
+  COUNTER(cache_miss)                                                                              \
   COUNTER(dns_query_attempt)                                                                       \
   COUNTER(dns_query_failure)                                                                       \
   COUNTER(dns_query_success)                                                                       \
@@ -127,6 +129,7 @@ private:
   void runRemoveCallbacks(const std::string& host);
   void updateTlsHostsMap();
   void onReResolve(const std::string& host);
+  std::chrono::milliseconds refreshInterval(const std::list<Network::DnsResponse>& response) const;
 
   Event::Dispatcher& main_thread_dispatcher_;
   const Network::DnsLookupFamily dns_lookup_family_;
@@ -137,6 +140,7 @@ private:
   std::list<AddUpdateCallbacksHandleImpl*> update_callbacks_;
   absl::flat_hash_map<std::string, PrimaryHostInfoPtr> primary_hosts_;
   const std::chrono::milliseconds refresh_interval_;
+  const bool respect_dns_ttl_;
   const std::chrono::milliseconds host_ttl_;
   const uint32_t max_hosts_;
 };
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+#include "common/singleton/const_singleton.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+
+/**
+ * Well-known compressor library names.
+ */
+class CompressorNameValues {
+public:
+  // Compressor library producing the gzip content-encoding with zlib.
+  const std::string Zlib = "envoy.compressors.zlib";
+};
+
+using CompressorNames = ConstSingleton<CompressorNameValues>;
+
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,32 @@
+#include "extensions/compression/zlib/config.h"
+
+#include "envoy/config/compressor/zlib/v2alpha/zlib.pb.h"
+#include "envoy/config/compressor/zlib/v2alpha/zlib.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "common/protobuf/utility.h"
+
+#include "extensions/compression/zlib/zlib_compressor_factory.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zlib {
+
+Compressor::CompressorFactorySharedPtr
+ZlibCompressorLibraryFactory::createCompressorFactoryFromProto(
+    const Protobuf::Message& config, ProtobufMessage::ValidationVisitor& validation_visitor) {
+  return std::make_shared<ZlibCompressorFactory>(
+      MessageUtil::downcastAndValidate<const envoy::config::compressor::zlib::v2alpha::Zlib&>(
+          config, validation_visitor));
+}
+
+/**
+ * Static registration for the zlib compressor library. @see NamedCompressorLibraryConfigFactory.
+ */
+REGISTER_FACTORY(ZlibCompressorLibraryFactory, Compressor::NamedCompressorLibraryConfigFactory);
+
+} // namespace Zlib
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
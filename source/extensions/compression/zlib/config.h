@@ -0,0 +1,34 @@
+#pragma once
+
+#include "envoy/compressor/config.h"
+#include "envoy/config/compressor/zlib/v2alpha/zlib.pb.h"
+
+#include "common/protobuf/protobuf.h"
+
+#include "extensions/compression/well_known_names.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zlib {
+
+/**
+ * Config registration for the zlib compressor library. @see NamedCompressorLibraryConfigFactory.
+ */
+class ZlibCompressorLibraryFactory : public Compressor::NamedCompressorLibraryConfigFactory {
+public:
+  Compressor::CompressorFactorySharedPtr
+  createCompressorFactoryFromProto(const Protobuf::Message& config,
+                                   ProtobufMessage::ValidationVisitor& validation_visitor) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<envoy::config::compressor::zlib::v2alpha::Zlib>();
+  }
+
+  std::string name() const override { return CompressorNames::get().Zlib; }
+};
+
+} // namespace Zlib
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
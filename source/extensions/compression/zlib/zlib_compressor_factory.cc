@@ -0,0 +1,64 @@
+#include "extensions/compression/zlib/zlib_compressor_factory.h"
+
+#include "common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zlib {
+
+namespace {
+// Default zlib memory level.
+const uint64_t DefaultMemoryLevel = 5;
+
+// Default and maximum compression window size.
+const uint64_t DefaultWindowBits = 12;
+
+// When summed to window bits, this sets a gzip header and trailer around the compressed data.
+const uint64_t GzipHeaderValue = 16;
+} // namespace
+
+ZlibCompressorFactory::ZlibCompressorFactory(
+    const envoy::config::compressor::zlib::v2alpha::Zlib& zlib)
+    : compression_level_(compressionLevelEnum(zlib.compression_level())),
+      compression_strategy_(compressionStrategyEnum(zlib.compression_strategy())),
+      window_bits_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(zlib, window_bits, DefaultWindowBits) |
+                   GzipHeaderValue),
+      memory_level_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(zlib, memory_level, DefaultMemoryLevel)) {}
+
+Compressor::CompressorPtr ZlibCompressorFactory::createCompressor() {
+  auto compressor = std::make_unique<Compressor::ZlibCompressorImpl>();
+  compressor->init(compression_level_, compression_strategy_, window_bits_, memory_level_);
+  return compressor;
+}
+
+Compressor::ZlibCompressorImpl::CompressionLevel ZlibCompressorFactory::compressionLevelEnum(
+    envoy::config::compressor::zlib::v2alpha::Zlib_CompressionLevel_Enum compression_level) {
+  switch (compression_level) {
+  case envoy::config::compressor::zlib::v2alpha::Zlib_CompressionLevel_Enum_BEST:
+    return Compressor::ZlibCompressorImpl::CompressionLevel::Best;
+  case envoy::config::compressor::zlib::v2alpha::Zlib_CompressionLevel_Enum_SPEED:
+    return Compressor::ZlibCompressorImpl::CompressionLevel::Speed;
+  default:
+    return Compressor::ZlibCompressorImpl::CompressionLevel::Standard;
+  }
+}
+
+Compressor::ZlibCompressorImpl::CompressionStrategy ZlibCompressorFactory::compressionStrategyEnum(
+    envoy::config::compressor::zlib::v2alpha::Zlib_CompressionStrategy compression_strategy) {
+  switch (compression_strategy) {
+  case envoy::config::compressor::zlib::v2alpha::Zlib_CompressionStrategy_RLE:
+    return Compressor::ZlibCompressorImpl::CompressionStrategy::Rle;
+  case envoy::config::compressor::zlib::v2alpha::Zlib_CompressionStrategy_FILTERED:
+    return Compressor::ZlibCompressorImpl::CompressionStrategy::Filtered;
+  case envoy::config::compressor::zlib::v2alpha::Zlib_CompressionStrategy_HUFFMAN:
+    return Compressor::ZlibCompressorImpl::CompressionStrategy::Huffman;
+  default:
+    return Compressor::ZlibCompressorImpl::CompressionStrategy::Standard;
+  }
+}
+
+} // namespace Zlib
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "envoy/compressor/config.h"
+#include "envoy/config/compressor/zlib/v2alpha/zlib.pb.h"
+
+#include "common/compressor/zlib_compressor_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zlib {
+
+/**
+ * Creates zlib compressors writing gzip streams.
+ */
+class ZlibCompressorFactory : public Compressor::CompressorFactory {
+public:
+  ZlibCompressorFactory(const envoy::config::compressor::zlib::v2alpha::Zlib& zlib);
+
+  // Compressor::CompressorFactory
+  Compressor::CompressorPtr createCompressor() override;
+
+  Compressor::ZlibCompressorImpl::CompressionLevel compressionLevel() const {
+    return compression_level_;
+  }
+  Compressor::ZlibCompressorImpl::CompressionStrategy compressionStrategy() const {
+    return compression_strategy_;
+  }
+  // Includes the value that makes zlib write a gzip header and trailer.
+  uint64_t windowBits() const { return window_bits_; }
+  uint64_t memoryLevel() const { return memory_level_; }
+
+private:
+  static Compressor::ZlibCompressorImpl::CompressionLevel compressionLevelEnum(
+      envoy::config::compressor::zlib::v2alpha::Zlib_CompressionLevel_Enum compression_level);
+  static Compressor::ZlibCompressorImpl::CompressionStrategy compressionStrategyEnum(
+      envoy::config::compressor::zlib::v2alpha::Zlib_CompressionStrategy compression_strategy);
+
+  const Compressor::ZlibCompressorImpl::CompressionLevel compression_level_;
+  const Compressor::ZlibCompressorImpl::CompressionStrategy compression_strategy_;
+  const uint64_t window_bits_;
+  const uint64_t memory_level_;
+};
+
+} // namespace Zlib
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
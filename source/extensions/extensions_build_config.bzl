@@ -16,6 +16,12 @@ EXTENSIONS = {
     "envoy.clusters.dynamic_forward_proxy":             "//source/extensions/clusters/dynamic_forward_proxy:cluster",
     "envoy.clusters.redis":                             "//source/extensions/clusters/redis:redis_cluster",
 
+    #
+    # Compressor libraries
+    #
+
+    "envoy.compressors.zlib":                           "//source/extensions/compression/zlib:config",
+
     #
     # gRPC Credentials Plugins
     #
@@ -107,6 +113,12 @@ EXTENSIONS = {
     "envoy.resource_monitors.fixed_heap":               "//source/extensions/resource_monitors/fixed_heap:config",
     "envoy.resource_monitors.injected_resource":        "//source/extensions/resource_monitors/injected_resource:config",
 
+    #
+    # Private key providers
+    #
+
+    "envoy.tls.key_providers.thread_pool":              "//source/extensions/private_key_providers/thread_pool:config",
+
     #
     # Stat sinks
     #
@@ -12,6 +12,16 @@ namespace Filters {
 namespace Common {
 namespace Lua {
 
+namespace {
+
+// lua_Writer appending the bytecode of a function to a string.
+int writeBytecode(lua_State*, const void* data, size_t size, void* bytecode) {
+  static_cast<std::string*>(bytecode)->append(static_cast<const char*>(data), size);
+  return 0;
+}
+
+} // namespace
+
 Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state)
     : coroutine_state_(new_thread_state, false) {}
 
@@ -46,21 +56,60 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
   }
 }
 
-ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls)
+BytecodeCache::BytecodeSharedPtr BytecodeCache::find(const std::string& code) const {
+  auto it = bytecode_.find(code);
+  return it != bytecode_.end() ? it->second.lock() : nullptr;
+}
+
+void BytecodeCache::insert(const std::string& code, const BytecodeSharedPtr& bytecode) {
+  // Drop the bytecode that no state uses anymore, so that the cache does not grow with every
+  // script ever loaded.
+  for (auto it = bytecode_.begin(); it != bytecode_.end();) {
+    if (it->second.expired()) {
+      bytecode_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  bytecode_[code] = bytecode;
+}
+
+ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls,
+                                   BytecodeCache* bytecode_cache)
     : tls_slot_(tls.allocateSlot()) {
+  // A script found in the cache was already parsed and run without errors.
+  if (bytecode_cache != nullptr) {
+    bytecode_ = bytecode_cache->find(code);
+  }
+  if (bytecode_ == nullptr) {
+    bytecode_ = compile(code);
+    if (bytecode_cache != nullptr) {
+      bytecode_cache->insert(code, bytecode_);
+    }
+  }
+
+  // Now initialize on all threads.
+  tls_slot_->set([bytecode = bytecode_, code](Event::Dispatcher&) {
+    return ThreadLocal::ThreadLocalObjectSharedPtr{new LuaThreadLocal(*bytecode, code)};
+  });
+}
 
-  // First verify that the supplied code can be parsed.
+BytecodeCache::BytecodeSharedPtr ThreadLocalState::compile(const std::string& code) {
+  // First verify that the supplied code can be parsed and run. The parsed chunk is dumped as
+  // bytecode so that the workers only load it, rather than each parsing the script again.
   CSmartPtr<lua_State, lua_close> state(lua_open());
   luaL_openlibs(state.get());
 
-  if (0 != luaL_dostring(state.get(), code.c_str())) {
+  // The chunk is named after the code, as luaL_dostring() does, so that the error messages do not
+  // depend on how the script was loaded.
+  auto bytecode = std::make_shared<std::string>();
+  if (0 != luaL_loadbuffer(state.get(), code.data(), code.size(), code.c_str()) ||
+      0 != lua_dump(state.get(), writeBytecode, bytecode.get()) ||
+      0 != lua_pcall(state.get(), 0, LUA_MULTRET, 0)) {
     throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
   }
 
-  // Now initialize on all threads.
-  tls_slot_->set([code](Event::Dispatcher&) {
-    return ThreadLocal::ThreadLocalObjectSharedPtr{new LuaThreadLocal(code)};
-  });
+  return bytecode;
 }
 
 int ThreadLocalState::getGlobalRef(uint64_t slot) {
@@ -90,9 +139,13 @@ CoroutinePtr ThreadLocalState::createCoroutine() {
   return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state));
 }
 
-ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code) : state_(lua_open()) {
+ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& bytecode,
+                                                 const std::string& code)
+    : state_(lua_open()) {
   luaL_openlibs(state_.get());
-  int rc = luaL_dostring(state_.get(), code.c_str());
+  int rc = luaL_loadbuffer(state_.get(), bytecode.data(), bytecode.size(), code.c_str());
+  ASSERT(rc == 0);
+  rc = lua_pcall(state_.get(), 0, LUA_MULTRET, 0);
   ASSERT(rc == 0);
 }
 
@@ -5,12 +5,14 @@
 #include <vector>
 
 #include "envoy/common/exception.h"
+#include "envoy/singleton/instance.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "common/common/assert.h"
 #include "common/common/c_smart_ptr.h"
 #include "common/common/logger.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "luajit-2.1/lua.hpp"
 
 namespace Envoy {
@@ -353,6 +355,31 @@ private:
 
 using CoroutinePtr = std::unique_ptr<Coroutine>;
 
+/**
+ * The bytecode of the scripts loaded by ThreadLocalState, keyed by their code, so that a script
+ * loaded again, as it is when the configuration using it is reloaded, is not parsed again. The
+ * bytecode is kept only while a state that loaded it exists. Only used on the main thread.
+ */
+class BytecodeCache : public Singleton::Instance {
+public:
+  using BytecodeSharedPtr = std::shared_ptr<const std::string>;
+
+  /**
+   * @return BytecodeSharedPtr the bytecode of code, or nullptr if it is not cached.
+   */
+  BytecodeSharedPtr find(const std::string& code) const;
+
+  /**
+   * Caches the bytecode of code, for as long as bytecode is referenced elsewhere.
+   */
+  void insert(const std::string& code, const BytecodeSharedPtr& bytecode);
+
+private:
+  absl::flat_hash_map<std::string, std::weak_ptr<const std::string>> bytecode_;
+};
+
+using BytecodeCacheSharedPtr = std::shared_ptr<BytecodeCache>;
+
 /**
  * This class wraps a Lua state that can be used safely across threads. The model is that every
  * worker gets its own independent state. There is no truly global state that a script can access.
@@ -360,7 +387,14 @@ using CoroutinePtr = std::unique_ptr<Coroutine>;
  */
 class ThreadLocalState : Logger::Loggable<Logger::Id::lua> {
 public:
-  ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls);
+  /**
+   * @param code supplies the script.
+   * @param tls supplies the slot allocator of the workers.
+   * @param bytecode_cache supplies the cache of the bytecode of the scripts, or nullptr to always
+   *        parse the script.
+   */
+  ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls,
+                   BytecodeCache* bytecode_cache = nullptr);
 
   /**
    * @return CoroutinePtr a new coroutine.
@@ -407,14 +441,20 @@ public:
 
 private:
   struct LuaThreadLocal : public ThreadLocal::ThreadLocalObject {
-    LuaThreadLocal(const std::string& code);
+    LuaThreadLocal(const std::string& bytecode, const std::string& code);
 
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
   };
 
+  // Parses and runs code in a state of its own, so that errors are reported on the main thread,
+  // and returns its bytecode.
+  static BytecodeCache::BytecodeSharedPtr compile(const std::string& code);
+
   ThreadLocal::SlotPtr tls_slot_;
   uint64_t current_global_slot_{};
+  // Keeps the cached bytecode of the script, if any, for as long as the state exists.
+  BytecodeCache::BytecodeSharedPtr bytecode_;
 };
 
 /**
@@ -0,0 +1,205 @@
+#include "extensions/filters/http/ext_authz/check_cache.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+#include "common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/sha.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+// Default number of responses cached per worker thread.
+constexpr uint32_t DefaultMaxEntries = 1000;
+
+// Appends a key component, prefixed by its length so that the components can't be confused.
+void appendKeyComponent(std::string& key, absl::string_view value) {
+  absl::StrAppend(&key, value.size(), ":", value);
+}
+
+} // namespace
+
+CheckCacheSettings::CheckCacheSettings(
+    const envoy::config::filter::http::ext_authz::v2::CacheSettings& config)
+    : key_headers_(config.key_headers().begin(), config.key_headers().end()),
+      key_method_(config.key_method()), key_path_(config.key_path()),
+      key_path_segments_(config.key_path_segments()),
+      key_peer_identity_(config.key_peer_identity()),
+      ttl_(DurationUtil::durationToMilliseconds(config.ttl())),
+      negative_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, negative_ttl, 0)),
+      max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries)) {}
+
+std::string CheckCacheSettings::key(const envoy::service::auth::v2::CheckRequest& request) const {
+  const auto& attributes = request.attributes();
+  const auto& http = attributes.request().http();
+  std::string key;
+  for (const auto& name : key_headers_) {
+    // The header names of the check request are lower case.
+    const auto it = http.headers().find(name);
+    if (it == http.headers().end()) {
+      key.append("-");
+    } else {
+      appendKeyComponent(key, it->second);
+    }
+  }
+  if (key_method_) {
+    appendKeyComponent(key, http.method());
+  }
+  if (key_path_) {
+    appendKeyComponent(key, pathKey(http.path()));
+  }
+  if (key_peer_identity_) {
+    appendKeyComponent(key, attributes.source().principal());
+  }
+  // The routes can send different context extensions, which are always part of the key.
+  std::vector<std::pair<absl::string_view, absl::string_view>> context_extensions;
+  context_extensions.reserve(attributes.context_extensions().size());
+  for (const auto& extension : attributes.context_extensions()) {
+    context_extensions.emplace_back(extension.first, extension.second);
+  }
+  std::sort(context_extensions.begin(), context_extensions.end());
+  for (const auto& extension : context_extensions) {
+    appendKeyComponent(key, extension.first);
+    appendKeyComponent(key, extension.second);
+  }
+
+  // Hash the key, so that the cache doesn't keep the credentials of the requests.
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256(reinterpret_cast<const uint8_t*>(key.data()), key.size(),
+         reinterpret_cast<uint8_t*>(&digest[0]));
+  return digest;
+}
+
+absl::string_view CheckCacheSettings::pathKey(absl::string_view path) const {
+  path = path.substr(0, path.find('?'));
+  if (key_path_segments_ == 0) {
+    return path;
+  }
+  size_t end = 0;
+  for (uint32_t i = 0; i < key_path_segments_; ++i) {
+    end = path.find('/', end + 1);
+    if (end == absl::string_view::npos) {
+      return path;
+    }
+  }
+  return path.substr(0, end);
+}
+
+CheckCache::CheckCache(CheckCacheSettingsConstSharedPtr settings, Event::Dispatcher& dispatcher,
+                       const CheckCacheStats& stats)
+    : settings_(std::move(settings)), dispatcher_(dispatcher), stats_(stats) {}
+
+CheckCache::~CheckCache() {
+  for (auto& pending : pending_) {
+    pending.second->client_->cancel();
+  }
+}
+
+Filters::Common::ExtAuthz::ResponsePtr CheckCache::lookup(const std::string& key) {
+  const auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    stats_.cache_miss_.inc();
+    return nullptr;
+  }
+
+  const auto entry = it->second;
+  if (dispatcher_.timeSource().monotonicTime() >= entry->expiration_time_) {
+    lru_.erase(entry);
+    entries_.erase(it);
+    stats_.cache_miss_.inc();
+    return nullptr;
+  }
+
+  lru_.splice(lru_.begin(), lru_, entry);
+  stats_.cache_hit_.inc();
+  return std::make_unique<Filters::Common::ExtAuthz::Response>(entry->response_);
+}
+
+bool CheckCache::check(const std::string& key,
+                       Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                       Filters::Common::ExtAuthz::ClientPtr&& client,
+                       envoy::service::auth::v2::CheckRequest&& request,
+                       Tracing::Span& parent_span) {
+  const auto it = pending_.find(key);
+  if (it != pending_.end()) {
+    stats_.cache_coalesced_.inc();
+    it->second->callbacks_.push_back(&callbacks);
+    return true;
+  }
+
+  auto pending =
+      std::make_unique<PendingCheck>(*this, key, std::move(client), std::move(request));
+  PendingCheck& check = *pending;
+  pending_.emplace(key, std::move(pending));
+  check.callbacks_.push_back(&callbacks);
+  // The check may complete within this call, in which case its deletion is deferred.
+  check.client_->check(check, check.request_, parent_span);
+  return false;
+}
+
+void CheckCache::cancel(const std::string& key,
+                        Filters::Common::ExtAuthz::RequestCallbacks& callbacks) {
+  const auto it = pending_.find(key);
+  if (it != pending_.end()) {
+    it->second->callbacks_.remove(&callbacks);
+  }
+  for (PendingCheck* check : completing_) {
+    check->callbacks_.remove(&callbacks);
+  }
+}
+
+void CheckCache::onCheckComplete(PendingCheck& check,
+                                 Filters::Common::ExtAuthz::ResponsePtr&& response) {
+  const auto it = pending_.find(check.key_);
+  ASSERT(it != pending_.end() && it->second.get() == &check);
+  PendingCheckPtr completed = std::move(it->second);
+  pending_.erase(it);
+
+  using Filters::Common::ExtAuthz::CheckStatus;
+  if (response->status == CheckStatus::OK) {
+    insert(completed->key_, *response, settings_->ttl());
+  } else if (response->status == CheckStatus::Denied &&
+             settings_->negativeTtl() > std::chrono::milliseconds::zero()) {
+    insert(completed->key_, *response, settings_->negativeTtl());
+  }
+
+  // The callbacks may cancel the other ones, e.g. by resetting their streams.
+  completing_.push_back(completed.get());
+  while (!completed->callbacks_.empty()) {
+    Filters::Common::ExtAuthz::RequestCallbacks* callbacks = completed->callbacks_.front();
+    completed->callbacks_.pop_front();
+    callbacks->onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(*response));
+  }
+  completing_.remove(completed.get());
+
+  // This is called by the client of the check.
+  dispatcher_.deferredDelete(std::move(completed));
+}
+
+void CheckCache::insert(const std::string& key,
+                        const Filters::Common::ExtAuthz::Response& response,
+                        std::chrono::milliseconds ttl) {
+  const MonotonicTime expiration_time = dispatcher_.timeSource().monotonicTime() + ttl;
+  const auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    // The headers of a response can't be assigned, replace the entry.
+    lru_.erase(it->second);
+    entries_.erase(it);
+  } else if (lru_.size() >= settings_->maxEntries()) {
+    entries_.erase(lru_.back().key_);
+    lru_.pop_back();
+    stats_.cache_evicted_.inc();
+  }
+  lru_.push_front(Entry{key, response, expiration_time});
+  entries_.emplace(key, lru_.begin());
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
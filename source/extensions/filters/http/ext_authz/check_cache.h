@@ -0,0 +1,165 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/filter/http/ext_authz/v2/ext_authz.pb.h"
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/service/auth/v2/external_auth.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+#include "envoy/tracing/http_tracer.h"
+
+#include "extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+/**
+ * All stats for the ext_authz check cache. @see stats_macros.h
+ */
+#define ALL_EXT_AUTHZ_CACHE_STATS(COUNTER)                                                         \
+  COUNTER(cache_coalesced)                                                                         \
+  COUNTER(cache_evicted)                                                                           \
+  COUNTER(cache_hit)                                                                               \
+  COUNTER(cache_miss)
+
+/**
+ * Wrapper struct for ext_authz check cache stats. @see stats_macros.h
+ */
+struct CheckCacheStats {
+  ALL_EXT_AUTHZ_CACHE_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Settings of the check cache, shared by the caches of all the worker threads.
+ */
+class CheckCacheSettings {
+public:
+  CheckCacheSettings(const envoy::config::filter::http::ext_authz::v2::CacheSettings& config);
+
+  /**
+   * @param request supplies the check request.
+   * @return std::string the cache key of the request: the SHA-256 digest of the request attributes
+   *         selected by the settings and of the context extensions of the route.
+   */
+  std::string key(const envoy::service::auth::v2::CheckRequest& request) const;
+
+  std::chrono::milliseconds ttl() const { return ttl_; }
+  // Zero when the denied responses are not cached.
+  std::chrono::milliseconds negativeTtl() const { return negative_ttl_; }
+  uint32_t maxEntries() const { return max_entries_; }
+
+private:
+  absl::string_view pathKey(absl::string_view path) const;
+
+  const std::vector<std::string> key_headers_;
+  const bool key_method_;
+  const bool key_path_;
+  const uint32_t key_path_segments_;
+  const bool key_peer_identity_;
+  const std::chrono::milliseconds ttl_;
+  const std::chrono::milliseconds negative_ttl_;
+  const uint32_t max_entries_;
+};
+
+using CheckCacheSettingsConstSharedPtr = std::shared_ptr<const CheckCacheSettings>;
+
+/**
+ * Per worker thread cache of the authorization responses. It also coalesces the concurrent checks
+ * with the same key into a single call to the authorization service.
+ */
+class CheckCache : public ThreadLocal::ThreadLocalObject {
+public:
+  CheckCache(CheckCacheSettingsConstSharedPtr settings, Event::Dispatcher& dispatcher,
+             const CheckCacheStats& stats);
+  ~CheckCache() override;
+
+  /**
+   * @param key supplies the cache key of the request.
+   * @return a copy of the response cached for the key, or nullptr if there is none.
+   */
+  Filters::Common::ExtAuthz::ResponsePtr lookup(const std::string& key);
+
+  /**
+   * Checks a request whose response is not cached. If a check with the same key is in flight, the
+   * callbacks are called with its response. Otherwise a check is started with the client, and the
+   * cache owns the client until the check is done, so that it outlives the request starting it.
+   * NOTE: The callbacks may be called within the calling stack.
+   * @param key supplies the cache key of the request.
+   * @param callbacks supplies the completion callbacks.
+   * @param client supplies the client of the request.
+   * @param request supplies the check request.
+   * @param parent_span source for generating an egress child span as part of the trace.
+   * @return bool true if the request waits for a check in flight rather than starting one.
+   */
+  bool check(const std::string& key, Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+             Filters::Common::ExtAuthz::ClientPtr&& client,
+             envoy::service::auth::v2::CheckRequest&& request, Tracing::Span& parent_span);
+
+  /**
+   * Stops waiting for the response of a check started by check(). The check itself goes on, and
+   * its response is cached.
+   */
+  void cancel(const std::string& key, Filters::Common::ExtAuthz::RequestCallbacks& callbacks);
+
+  size_t size() const { return lru_.size(); }
+
+private:
+  struct PendingCheck : public Filters::Common::ExtAuthz::RequestCallbacks,
+                        public Event::DeferredDeletable {
+    PendingCheck(CheckCache& parent, const std::string& key,
+                 Filters::Common::ExtAuthz::ClientPtr&& client,
+                 envoy::service::auth::v2::CheckRequest&& request)
+        : parent_(parent), key_(key), client_(std::move(client)), request_(std::move(request)) {}
+
+    // Filters::Common::ExtAuthz::RequestCallbacks
+    void onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) override {
+      parent_.onCheckComplete(*this, std::move(response));
+    }
+
+    CheckCache& parent_;
+    const std::string key_;
+    Filters::Common::ExtAuthz::ClientPtr client_;
+    const envoy::service::auth::v2::CheckRequest request_;
+    std::list<Filters::Common::ExtAuthz::RequestCallbacks*> callbacks_;
+  };
+
+  using PendingCheckPtr = std::unique_ptr<PendingCheck>;
+
+  struct Entry {
+    std::string key_;
+    Filters::Common::ExtAuthz::Response response_;
+    MonotonicTime expiration_time_;
+  };
+
+  void onCheckComplete(PendingCheck& check, Filters::Common::ExtAuthz::ResponsePtr&& response);
+  void insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response,
+              std::chrono::milliseconds ttl);
+
+  const CheckCacheSettingsConstSharedPtr settings_;
+  Event::Dispatcher& dispatcher_;
+  CheckCacheStats stats_;
+  // The most recently used entry is at the front.
+  std::list<Entry> lru_;
+  absl::flat_hash_map<std::string, std::list<Entry>::iterator> entries_;
+  // The checks in flight, by key.
+  absl::flat_hash_map<std::string, PendingCheckPtr> pending_;
+  // The checks whose callbacks are being called. They are no longer in pending_, so that new
+  // requests don't wait for them, but their callbacks can still be cancelled.
+  std::list<PendingCheck*> completing_;
+};
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
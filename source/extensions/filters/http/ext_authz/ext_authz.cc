@@ -79,12 +79,36 @@ void Filter::initiateCall(const Http::HeaderMap& headers) {
       callbacks_, headers, std::move(context_extensions), std::move(metadata_context),
       check_request_, config_->maxRequestBytes(), config_->includePeerCertificate());
 
+  // The checks sending the request body are not cached.
+  CheckCache* cache = buffer_data_ ? nullptr : config_->checkCache();
+  if (cache != nullptr) {
+    cache_key_ = config_->cacheSettings()->key(check_request_);
+    Filters::Common::ExtAuthz::ResponsePtr response = cache->lookup(cache_key_);
+    if (response != nullptr) {
+      ENVOY_STREAM_LOG(trace, "ext_authz filter found the response in the cache", *callbacks_);
+      filter_return_ = FilterReturn::StopDecoding;
+      shared_response_ = true;
+      initiating_call_ = true;
+      onComplete(std::move(response));
+      initiating_call_ = false;
+      return;
+    }
+  }
+
   ENVOY_STREAM_LOG(trace, "ext_authz filter calling authorization server", *callbacks_);
   state_ = State::Calling;
   filter_return_ = FilterReturn::StopDecoding; // Don't let the filter chain continue as we are
                                                // going to invoke check call.
   initiating_call_ = true;
-  client_->check(*this, check_request_, callbacks_->activeSpan());
+  if (cache != nullptr) {
+    // The cache takes the client, so that the check outlives this request if other ones wait for
+    // its response.
+    cache_ = cache;
+    shared_response_ = cache->check(cache_key_, *this, std::move(client_),
+                                    std::move(check_request_), callbacks_->activeSpan());
+  } else {
+    client_->check(*this, check_request_, callbacks_->activeSpan());
+  }
   initiating_call_ = false;
 }
 
@@ -153,7 +177,11 @@ void Filter::setDecoderFilterCallbacks(Http::StreamDecoderFilterCallbacks& callb
 void Filter::onDestroy() {
   if (state_ == State::Calling) {
     state_ = State::Complete;
-    client_->cancel();
+    if (cache_ != nullptr) {
+      cache_->cancel(cache_key_, *this);
+    } else {
+      client_->cancel();
+    }
   }
 }
 
@@ -181,10 +209,14 @@ void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
         request_headers_->appendCopy(header.first, header.second);
       }
     }
-    if (cluster_) {
-      config_->incCounter(cluster_->statsScope(), config_->ext_authz_ok_);
+    // Cache hits and coalesced requests are only counted in the cache stats, as they didn't reach
+    // the authorization service themselves.
+    if (!shared_response_) {
+      if (cluster_) {
+        config_->incCounter(cluster_->statsScope(), config_->ext_authz_ok_);
+      }
+      stats_.ok_.inc();
     }
-    stats_.ok_.inc();
     continueDecoding();
     break;
   }
@@ -192,9 +224,11 @@ void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
   case CheckStatus::Denied: {
     ENVOY_STREAM_LOG(trace, "ext_authz filter rejected the request. Response status code: '{}",
                      *callbacks_, enumToInt(response->status_code));
-    stats_.denied_.inc();
+    if (!shared_response_) {
+      stats_.denied_.inc();
+    }
 
-    if (cluster_) {
+    if (cluster_ && !shared_response_) {
       config_->incCounter(cluster_->statsScope(), config_->ext_authz_denied_);
 
       Http::CodeStats::ResponseStatInfo info{config_->scope(),
@@ -12,6 +12,7 @@
 #include "envoy/service/auth/v2/external_auth.pb.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "common/common/assert.h"
@@ -24,6 +25,7 @@
 #include "extensions/filters/common/ext_authz/ext_authz.h"
 #include "extensions/filters/common/ext_authz/ext_authz_grpc_impl.h"
 #include "extensions/filters/common/ext_authz/ext_authz_http_impl.h"
+#include "extensions/filters/http/ext_authz/check_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -60,7 +62,7 @@ public:
   FilterConfig(const envoy::config::filter::http::ext_authz::v2::ExtAuthz& config,
                const LocalInfo::LocalInfo& local_info, Stats::Scope& scope,
                Runtime::Loader& runtime, Http::Context& http_context,
-               const std::string& stats_prefix)
+               ThreadLocal::SlotAllocator& tls, const std::string& stats_prefix)
       : allow_partial_message_(config.with_request_body().allow_partial_message()),
         failure_mode_allow_(config.failure_mode_allow()),
         clear_route_cache_(config.clear_route_cache()),
@@ -78,7 +80,19 @@ public:
         stats_(generateStats(stats_prefix, scope)), ext_authz_ok_(pool_.add("ext_authz.ok")),
         ext_authz_denied_(pool_.add("ext_authz.denied")),
         ext_authz_error_(pool_.add("ext_authz.error")),
-        ext_authz_failure_mode_allowed_(pool_.add("ext_authz.failure_mode_allowed")) {}
+        ext_authz_failure_mode_allowed_(pool_.add("ext_authz.failure_mode_allowed")) {
+    if (config.has_cache_settings()) {
+      cache_settings_ = std::make_shared<const CheckCacheSettings>(config.cache_settings());
+      const std::string final_prefix = stats_prefix + "ext_authz.";
+      const CheckCacheStats cache_stats{
+          ALL_EXT_AUTHZ_CACHE_STATS(POOL_COUNTER_PREFIX(scope, final_prefix))};
+      cache_tls_ = tls.allocateSlot();
+      cache_tls_->set([settings = cache_settings_, cache_stats](Event::Dispatcher& dispatcher)
+                          -> ThreadLocal::ThreadLocalObjectSharedPtr {
+        return std::make_shared<CheckCache>(settings, dispatcher, cache_stats);
+      });
+    }
+  }
 
   bool allowPartialMessage() const { return allow_partial_message_; }
 
@@ -114,6 +128,14 @@ public:
 
   bool includePeerCertificate() const { return include_peer_certificate_; }
 
+  // Settings of the check cache, nullptr when the responses are not cached.
+  const CheckCacheSettings* cacheSettings() const { return cache_settings_.get(); }
+
+  // Get the check cache of the worker thread, nullptr when the responses are not cached.
+  CheckCache* checkCache() const {
+    return cache_tls_ != nullptr ? &cache_tls_->getTyped<CheckCache>() : nullptr;
+  }
+
 private:
   static Http::Code toErrorCode(uint64_t status) {
     const auto code = static_cast<Http::Code>(status);
@@ -150,6 +172,10 @@ private:
   // The stats for the filter.
   ExtAuthzFilterStats stats_;
 
+  CheckCacheSettingsConstSharedPtr cache_settings_;
+  // Thread local slot of the check caches, only allocated when the responses are cached.
+  ThreadLocal::SlotPtr cache_tls_;
+
 public:
   // TODO(nezdolik): deprecate cluster scope stats counters in favor of filter scope stats
   // (ExtAuthzFilterStats stats_).
@@ -243,6 +269,14 @@ private:
   // The stats for the filter.
   ExtAuthzFilterStats stats_;
 
+  // The check cache of the worker thread when the check went through it, and the cache key of the
+  // request.
+  CheckCache* cache_{};
+  std::string cache_key_;
+  // Whether the response was found in the check cache or returned by a check started by another
+  // request, rather than by a call to the authorization service made for this request.
+  bool shared_response_{};
+
   // Used to identify if the callback to onComplete() is synchronous (on the stack) or asynchronous.
   bool initiating_call_{};
   bool buffer_data_{};
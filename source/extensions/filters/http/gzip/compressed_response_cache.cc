@@ -0,0 +1,45 @@
+#include "extensions/filters/http/gzip/compressed_response_cache.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Gzip {
+
+std::string CompressedResponseCache::key(absl::string_view authority, absl::string_view path,
+                                         absl::string_view etag) {
+  // The lengths keep the components from running into each other.
+  return absl::StrCat(authority.size(), ":", authority, path.size(), ":", path, etag);
+}
+
+CompressedBodyConstSharedPtr CompressedResponseCache::lookup(const std::string& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->body_;
+}
+
+void CompressedResponseCache::insert(const std::string& key, CompressedBodyConstSharedPtr body) {
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    it->second->body_ = std::move(body);
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+
+  if (lru_.size() >= max_entries_) {
+    entries_.erase(lru_.back().key_);
+    lru_.pop_back();
+    evicted_.inc();
+  }
+  lru_.push_front(Entry{key, std::move(body)});
+  entries_.emplace(key, lru_.begin());
+}
+
+} // namespace Gzip
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/stats/stats.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Gzip {
+
+using CompressedBodyConstSharedPtr = std::shared_ptr<const std::string>;
+
+/**
+ * Per worker thread LRU cache of compressed response bodies. The entries are keyed by the request
+ * authority and path and by the strong entity tag of the response, so that a body is reused only
+ * for a response the upstream asserts is byte for byte identical.
+ */
+class CompressedResponseCache : public ThreadLocal::ThreadLocalObject {
+public:
+  CompressedResponseCache(uint32_t max_entries, Stats::Counter& evicted)
+      : max_entries_(max_entries), evicted_(evicted) {}
+
+  /**
+   * @return std::string the cache key of a response.
+   */
+  static std::string key(absl::string_view authority, absl::string_view path,
+                         absl::string_view etag);
+
+  /**
+   * @return CompressedBodyConstSharedPtr the cached compressed body, or nullptr if there is none.
+   */
+  CompressedBodyConstSharedPtr lookup(const std::string& key);
+
+  /**
+   * Caches a compressed body, evicting the least recently used one if the cache is full.
+   */
+  void insert(const std::string& key, CompressedBodyConstSharedPtr body);
+
+  size_t size() const { return lru_.size(); }
+
+private:
+  struct Entry {
+    std::string key_;
+    CompressedBodyConstSharedPtr body_;
+  };
+
+  const uint32_t max_entries_;
+  Stats::Counter& evicted_;
+  std::list<Entry> lru_;
+  absl::flat_hash_map<std::string, std::list<Entry>::iterator> entries_;
+};
+
+} // namespace Gzip
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -4,6 +4,10 @@
 #include "envoy/stats/scope.h"
 
 #include "common/common/macros.h"
+#include "common/config/utility.h"
+#include "common/protobuf/utility.h"
+
+#include "extensions/compression/zlib/zlib_compressor_factory.h"
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
@@ -15,17 +19,14 @@ namespace HttpFilters {
 namespace Gzip {
 
 namespace {
-// Default zlib memory level.
-const uint64_t DefaultMemoryLevel = 5;
-
-// Default and maximum compression window size.
-const uint64_t DefaultWindowBits = 12;
-
 // Minimum length of an upstream response that allows compression.
 const uint64_t MinimumContentLength = 30;
 
-// When summed to window bits, this sets a gzip header and trailer around the compressed data.
-const uint64_t GzipHeaderValue = 16;
+// Default number of compressed bodies kept by the cache of each worker.
+const uint32_t DefaultCacheMaxEntries = 1000;
+
+// Default size of the largest compressed body that is cached.
+const uint32_t DefaultCacheMaxBodyBytes = 1024 * 1024;
 
 // Used for verifying accept-encoding values.
 const char ZeroQvalueString[] = "q=0";
@@ -42,46 +43,59 @@ const std::vector<std::string>& defaultContentEncoding() {
 
 GzipFilterConfig::GzipFilterConfig(const envoy::config::filter::http::gzip::v2::Gzip& gzip,
                                    const std::string& stats_prefix, Stats::Scope& scope,
-                                   Runtime::Loader& runtime)
-    : compression_level_(compressionLevelEnum(gzip.compression_level())),
-      compression_strategy_(compressionStrategyEnum(gzip.compression_strategy())),
+                                   Runtime::Loader& runtime, ThreadLocal::SlotAllocator& tls,
+                                   ProtobufMessage::ValidationVisitor& validation_visitor)
+    : compressor_factory_(makeCompressorFactory(gzip, validation_visitor)),
       content_length_(contentLengthUint(gzip.content_length().value())),
-      memory_level_(memoryLevelUint(gzip.memory_level().value())),
-      window_bits_(windowBitsUint(gzip.window_bits().value())),
       content_type_values_(contentTypeSet(gzip.content_type())),
       disable_on_etag_header_(gzip.disable_on_etag_header()),
       remove_accept_encoding_header_(gzip.remove_accept_encoding_header()),
-      stats_(generateStats(stats_prefix + "gzip.", scope)), runtime_(runtime) {}
-
-Compressor::ZlibCompressorImpl::CompressionLevel GzipFilterConfig::compressionLevelEnum(
-    envoy::config::filter::http::gzip::v2::Gzip_CompressionLevel_Enum compression_level) {
-  switch (compression_level) {
-  case envoy::config::filter::http::gzip::v2::Gzip_CompressionLevel_Enum::
-      Gzip_CompressionLevel_Enum_BEST:
-    return Compressor::ZlibCompressorImpl::CompressionLevel::Best;
-  case envoy::config::filter::http::gzip::v2::Gzip_CompressionLevel_Enum::
-      Gzip_CompressionLevel_Enum_SPEED:
-    return Compressor::ZlibCompressorImpl::CompressionLevel::Speed;
-  default:
-    return Compressor::ZlibCompressorImpl::CompressionLevel::Standard;
+      stats_(generateStats(stats_prefix + "gzip.", scope)), runtime_(runtime) {
+  if (gzip.has_compressed_response_cache()) {
+    const auto& cache = gzip.compressed_response_cache();
+    const uint32_t max_entries =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(cache, max_entries, DefaultCacheMaxEntries);
+    max_cached_body_bytes_ =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(cache, max_body_bytes, DefaultCacheMaxBodyBytes);
+    Stats::Counter& evicted = stats_.cache_evicted_;
+    cache_tls_ = tls.allocateSlot();
+    cache_tls_->set([max_entries, &evicted](
+                        Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
+      return std::make_shared<CompressedResponseCache>(max_entries, evicted);
+    });
   }
 }
 
-Compressor::ZlibCompressorImpl::CompressionStrategy GzipFilterConfig::compressionStrategyEnum(
-    envoy::config::filter::http::gzip::v2::Gzip_CompressionStrategy compression_strategy) {
-  switch (compression_strategy) {
-  case envoy::config::filter::http::gzip::v2::Gzip_CompressionStrategy::
-      Gzip_CompressionStrategy_RLE:
-    return Compressor::ZlibCompressorImpl::CompressionStrategy::Rle;
-  case envoy::config::filter::http::gzip::v2::Gzip_CompressionStrategy::
-      Gzip_CompressionStrategy_FILTERED:
-    return Compressor::ZlibCompressorImpl::CompressionStrategy::Filtered;
-  case envoy::config::filter::http::gzip::v2::Gzip_CompressionStrategy::
-      Gzip_CompressionStrategy_HUFFMAN:
-    return Compressor::ZlibCompressorImpl::CompressionStrategy::Huffman;
-  default:
-    return Compressor::ZlibCompressorImpl::CompressionStrategy::Standard;
+Compressor::CompressorFactorySharedPtr GzipFilterConfig::makeCompressorFactory(
+    const envoy::config::filter::http::gzip::v2::Gzip& gzip,
+    ProtobufMessage::ValidationVisitor& validation_visitor) {
+  if (gzip.has_compressor_library()) {
+    const auto& library = gzip.compressor_library();
+    auto& factory =
+        Config::Utility::getAndCheckFactory<Compressor::NamedCompressorLibraryConfigFactory>(
+            library.name());
+    ProtobufTypes::MessagePtr config = factory.createEmptyConfigProto();
+    Config::Utility::translateOpaqueConfig(library.name(), library.typed_config(),
+                                           ProtobufWkt::Struct(), validation_visitor, *config);
+    return factory.createCompressorFactoryFromProto(*config, validation_visitor);
   }
+
+  // Without a compressor library, zlib is set up with the fields of the filter. The enums of both
+  // messages have the same values.
+  envoy::config::compressor::zlib::v2alpha::Zlib zlib;
+  if (gzip.has_memory_level()) {
+    *zlib.mutable_memory_level() = gzip.memory_level();
+  }
+  if (gzip.has_window_bits()) {
+    *zlib.mutable_window_bits() = gzip.window_bits();
+  }
+  zlib.set_compression_level(
+      static_cast<envoy::config::compressor::zlib::v2alpha::Zlib_CompressionLevel_Enum>(
+          gzip.compression_level()));
+  zlib.set_compression_strategy(
+      static_cast<envoy::config::compressor::zlib::v2alpha::Zlib_CompressionStrategy>(
+          gzip.compression_strategy()));
+  return std::make_shared<Compression::Zlib::ZlibCompressorFactory>(zlib);
 }
 
 StringUtil::CaseUnorderedSet
@@ -95,14 +109,6 @@ uint64_t GzipFilterConfig::contentLengthUint(Protobuf::uint32 length) {
   return length >= MinimumContentLength ? length : MinimumContentLength;
 }
 
-uint64_t GzipFilterConfig::memoryLevelUint(Protobuf::uint32 level) {
-  return level > 0 ? level : DefaultMemoryLevel;
-}
-
-uint64_t GzipFilterConfig::windowBitsUint(Protobuf::uint32 window_bits) {
-  return (window_bits > 0 ? window_bits : DefaultWindowBits) | GzipHeaderValue;
-}
-
 GzipFilter::GzipFilter(const GzipFilterConfigSharedPtr& config)
     : skip_compression_{true}, config_(config) {}
 
@@ -110,6 +116,10 @@ Http::FilterHeadersStatus GzipFilter::decodeHeaders(Http::HeaderMap& headers, bo
   if (config_->runtime().snapshot().featureEnabled("gzip.filter_enabled", 100) &&
       isAcceptEncodingAllowed(headers)) {
     skip_compression_ = false;
+    if (config_->compressedResponseCache() != nullptr && headers.Host() && headers.Path()) {
+      authority_ = std::string(headers.Host()->value().getStringView());
+      path_ = std::string(headers.Path()->value().getStringView());
+    }
     if (config_->removeAcceptEncodingHeader()) {
       headers.removeAcceptEncoding();
     }
@@ -124,12 +134,15 @@ Http::FilterHeadersStatus GzipFilter::encodeHeaders(Http::HeaderMap& headers, bo
   if (!end_stream && !skip_compression_ && isMinimumContentLength(headers) &&
       isContentTypeAllowed(headers) && !hasCacheControlNoTransform(headers) &&
       isEtagAllowed(headers) && isTransferEncodingAllowed(headers) && !headers.ContentEncoding()) {
+    // The etag is read before sanitizeEtagHeader() possibly removes it.
+    lookupCompressedResponse(headers);
     sanitizeEtagHeader(headers);
     insertVaryHeader(headers);
     headers.removeContentLength();
     headers.setReferenceContentEncoding(Http::Headers::get().ContentEncodingValues.Gzip);
-    compressor_.init(config_->compressionLevel(), config_->compressionStrategy(),
-                     config_->windowBits(), config_->memoryLevel());
+    if (cached_body_ == nullptr) {
+      compressor_ = config_->makeCompressor();
+    }
     config_->stats().compressed_.inc();
   } else if (!skip_compression_) {
     skip_compression_ = true;
@@ -141,7 +154,18 @@ Http::FilterHeadersStatus GzipFilter::encodeHeaders(Http::HeaderMap& headers, bo
 Http::FilterDataStatus GzipFilter::encodeData(Buffer::Instance& data, bool end_stream) {
   if (!skip_compression_) {
     config_->stats().total_uncompressed_bytes_.add(data.length());
-    compressor_.compress(data, end_stream ? Compressor::State::Finish : Compressor::State::Flush);
+    if (cached_body_ != nullptr) {
+      // The compressed body is already known, so the upstream one is discarded.
+      data.drain(data.length());
+      if (!end_stream) {
+        return Http::FilterDataStatus::StopIterationNoBuffer;
+      }
+      data.add(*cached_body_);
+    } else {
+      compressor_->compress(data,
+                            end_stream ? Compressor::State::Finish : Compressor::State::Flush);
+      recordCompressedData(data, end_stream);
+    }
     config_->stats().total_compressed_bytes_.add(data.length());
   }
   return Http::FilterDataStatus::Continue;
@@ -149,10 +173,15 @@ Http::FilterDataStatus GzipFilter::encodeData(Buffer::Instance& data, bool end_s
 
 Http::FilterTrailersStatus GzipFilter::encodeTrailers(Http::HeaderMap&) {
   if (!skip_compression_) {
-    Buffer::OwnedImpl empty_buffer;
-    compressor_.compress(empty_buffer, Compressor::State::Finish);
-    config_->stats().total_compressed_bytes_.add(empty_buffer.length());
-    encoder_callbacks_->addEncodedData(empty_buffer, true);
+    Buffer::OwnedImpl buffer;
+    if (cached_body_ != nullptr) {
+      buffer.add(*cached_body_);
+    } else {
+      compressor_->compress(buffer, Compressor::State::Finish);
+      recordCompressedData(buffer, true);
+    }
+    config_->stats().total_compressed_bytes_.add(buffer.length());
+    encoder_callbacks_->addEncodedData(buffer, true);
   }
   return Http::FilterTrailersStatus::Continue;
 }
@@ -292,6 +321,53 @@ void GzipFilter::insertVaryHeader(Http::HeaderMap& headers) {
   }
 }
 
+void GzipFilter::lookupCompressedResponse(Http::HeaderMap& headers) {
+  CompressedResponseCache* cache = config_->compressedResponseCache();
+  const Http::HeaderEntry* etag = headers.Etag();
+  const Http::HeaderEntry* status = headers.Status();
+  if (cache == nullptr || path_.empty() || etag == nullptr || status == nullptr ||
+      status->value().getStringView() != "200") {
+    return;
+  }
+
+  // Only a strong etag guarantees that the bodies of two responses are identical.
+  const absl::string_view value(etag->value().getStringView());
+  if (value.empty() || (value.length() > 1 && (value[0] == 'w' || value[0] == 'W') &&
+                        value[1] == '/')) {
+    return;
+  }
+
+  std::string key = CompressedResponseCache::key(authority_, path_, value);
+  cached_body_ = cache->lookup(key);
+  if (cached_body_ != nullptr) {
+    config_->stats().cache_hit_.inc();
+  } else {
+    config_->stats().cache_miss_.inc();
+    cache_key_ = std::move(key);
+  }
+}
+
+void GzipFilter::recordCompressedData(const Buffer::Instance& data, bool end_stream) {
+  if (cache_key_.empty()) {
+    return;
+  }
+
+  if (cached_data_.length() + data.length() > config_->maxCachedBodyBytes()) {
+    // The compressed body is too large to be cached.
+    cache_key_.clear();
+    cached_data_.drain(cached_data_.length());
+    return;
+  }
+
+  cached_data_.add(data);
+  if (end_stream) {
+    config_->compressedResponseCache()->insert(
+        cache_key_, std::make_shared<const std::string>(cached_data_.toString()));
+    cache_key_.clear();
+    cached_data_.drain(cached_data_.length());
+  }
+}
+
 // TODO(gsagula): It seems that every proxy has a different opinion how to handle Etag. Some
 // discussions around this topic have been going on for over a decade, e.g.,
 // https://bz.apache.org/bugzilla/show_bug.cgi?id=45023
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/compressor/config.h"
 #include "envoy/config/filter/http/gzip/v2/gzip.pb.h"
 #include "envoy/http/filter.h"
 #include "envoy/http/header_map.h"
@@ -7,12 +8,14 @@
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "common/buffer/buffer_impl.h"
-#include "common/compressor/zlib_compressor_impl.h"
 #include "common/http/header_map_impl.h"
 #include "common/protobuf/protobuf.h"
 
+#include "extensions/filters/http/gzip/compressed_response_cache.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -26,7 +29,9 @@ namespace Gzip {
  * the filter increments "not_compressed", but does
  * not add to "total_uncompressed_bytes". This way,
  * the user can measure the memory performance of the
- * compression.
+ * compression. The "cache_*" counters are only
+ * updated when the compressed response cache is
+ * configured.
  */
 #define ALL_GZIP_STATS(COUNTER)                                                                    \
   COUNTER(compressed)                                                                              \
@@ -39,7 +44,10 @@ namespace Gzip {
   COUNTER(total_uncompressed_bytes)                                                                \
   COUNTER(total_compressed_bytes)                                                                  \
   COUNTER(content_length_too_small)                                                                \
-  COUNTER(not_compressed_etag)
+  COUNTER(not_compressed_etag)                                                                     \
+  COUNTER(cache_evicted)                                                                           \
+  COUNTER(cache_hit)                                                                               \
+  COUNTER(cache_miss)
 
 /**
  * Struct definition for gzip stats. @see stats_macros.h
@@ -55,52 +63,59 @@ class GzipFilterConfig {
 
 public:
   GzipFilterConfig(const envoy::config::filter::http::gzip::v2::Gzip& gzip,
-                   const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime);
-
-  Compressor::ZlibCompressorImpl::CompressionLevel compressionLevel() const {
-    return compression_level_;
-  }
-  Compressor::ZlibCompressorImpl::CompressionStrategy compressionStrategy() const {
-    return compression_strategy_;
+                   const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
+                   ThreadLocal::SlotAllocator& tls,
+                   ProtobufMessage::ValidationVisitor& validation_visitor);
+
+  /**
+   * @return Compressor::CompressorPtr a new compressor producing the gzip content-encoding, made
+   *         by the configured compressor library.
+   */
+  Compressor::CompressorPtr makeCompressor() const {
+    return compressor_factory_->createCompressor();
   }
+  const Compressor::CompressorFactory& compressorFactory() const { return *compressor_factory_; }
 
   Runtime::Loader& runtime() { return runtime_; }
   GzipStats& stats() { return stats_; }
   const StringUtil::CaseUnorderedSet& contentTypeValues() const { return content_type_values_; }
   bool disableOnEtagHeader() const { return disable_on_etag_header_; }
   bool removeAcceptEncodingHeader() const { return remove_accept_encoding_header_; }
-  uint64_t memoryLevel() const { return memory_level_; }
   uint64_t minimumLength() const { return content_length_; }
-  uint64_t windowBits() const { return window_bits_; }
+
+  /**
+   * @return CompressedResponseCache* the compressed response cache of the calling worker thread,
+   *         or nullptr if the cache is not configured.
+   */
+  CompressedResponseCache* compressedResponseCache() const {
+    return cache_tls_ != nullptr ? &cache_tls_->getTyped<CompressedResponseCache>() : nullptr;
+  }
+  uint64_t maxCachedBodyBytes() const { return max_cached_body_bytes_; }
 
 private:
-  static Compressor::ZlibCompressorImpl::CompressionLevel compressionLevelEnum(
-      envoy::config::filter::http::gzip::v2::Gzip_CompressionLevel_Enum compression_level);
-  static Compressor::ZlibCompressorImpl::CompressionStrategy compressionStrategyEnum(
-      envoy::config::filter::http::gzip::v2::Gzip_CompressionStrategy compression_strategy);
+  static Compressor::CompressorFactorySharedPtr
+  makeCompressorFactory(const envoy::config::filter::http::gzip::v2::Gzip& gzip,
+                        ProtobufMessage::ValidationVisitor& validation_visitor);
   static StringUtil::CaseUnorderedSet
   contentTypeSet(const Protobuf::RepeatedPtrField<std::string>& types);
 
   static uint64_t contentLengthUint(Protobuf::uint32 length);
-  static uint64_t memoryLevelUint(Protobuf::uint32 level);
-  static uint64_t windowBitsUint(Protobuf::uint32 window_bits);
 
   static GzipStats generateStats(const std::string& prefix, Stats::Scope& scope) {
     return GzipStats{ALL_GZIP_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
   }
 
-  Compressor::ZlibCompressorImpl::CompressionLevel compression_level_;
-  Compressor::ZlibCompressorImpl::CompressionStrategy compression_strategy_;
+  Compressor::CompressorFactorySharedPtr compressor_factory_;
 
   int32_t content_length_;
-  int32_t memory_level_;
-  int32_t window_bits_;
 
   StringUtil::CaseUnorderedSet content_type_values_;
   bool disable_on_etag_header_;
   bool remove_accept_encoding_header_;
   GzipStats stats_;
   Runtime::Loader& runtime_;
+  uint64_t max_cached_body_bytes_{};
+  ThreadLocal::SlotPtr cache_tls_;
 };
 using GzipFilterConfigSharedPtr = std::shared_ptr<GzipFilterConfig>;
 
@@ -154,12 +169,23 @@ private:
 
   void sanitizeEtagHeader(Http::HeaderMap& headers);
   void insertVaryHeader(Http::HeaderMap& headers);
+  void lookupCompressedResponse(Http::HeaderMap& headers);
+  void recordCompressedData(const Buffer::Instance& data, bool end_stream);
 
   bool skip_compression_;
-  Buffer::OwnedImpl compressed_data_;
-  Compressor::ZlibCompressorImpl compressor_;
+  Compressor::CompressorPtr compressor_;
   GzipFilterConfigSharedPtr config_;
 
+  // The authority and path of the request, only kept when the compressed response cache is
+  // configured.
+  std::string authority_;
+  std::string path_;
+  // Set when the response may be cached and was not found in the cache.
+  std::string cache_key_;
+  Buffer::OwnedImpl cached_data_;
+  // Set when the compressed body of the response was found in the cache.
+  CompressedBodyConstSharedPtr cached_body_;
+
   Http::StreamDecoderFilterCallbacks* decoder_callbacks_{nullptr};
   Http::StreamEncoderFilterCallbacks* encoder_callbacks_{nullptr};
 };
@@ -57,6 +57,9 @@ private:
   // Verify with a specific public key.
   void verifyKey();
 
+  // Handle a successfully verified JWT.
+  void handleGoodJwt();
+
   // Calls the callback with status.
   void doneWithStatus(const Status& status);
 
@@ -78,8 +81,8 @@ private:
   // The token data
   std::vector<JwtLocationConstPtr> tokens_;
   JwtLocationConstPtr curr_token_;
-  // The JWT object.
-  std::unique_ptr<::google::jwt_verify::Jwt> jwt_;
+  // The JWT object, either parsed from the token or found in the JWT cache.
+  JwtConstSharedPtr jwt_;
   // The JWKS data object
   JwksCache::JwksData* jwks_data_{};
 
@@ -136,11 +139,18 @@ void AuthenticatorImpl::startVerify() {
   curr_token_ = std::move(tokens_.back());
   tokens_.pop_back();
 
-  jwt_ = std::make_unique<::google::jwt_verify::Jwt>();
-  const Status status = jwt_->parseFromString(curr_token_->token());
-  if (status != Status::Ok) {
-    doneWithStatus(status);
-    return;
+  // With a specific provider, the JWT cache is checked before parsing the token.
+  jwks_data_ = provider_ ? jwks_cache_.findByProvider(provider_.value()) : nullptr;
+  jwt_ = jwks_data_ ? jwks_data_->getJwtCache().lookup(curr_token_->token()) : nullptr;
+  bool is_cached = jwt_ != nullptr;
+  if (!is_cached) {
+    auto jwt = std::make_shared<::google::jwt_verify::Jwt>();
+    const Status status = jwt->parseFromString(curr_token_->token());
+    if (status != Status::Ok) {
+      doneWithStatus(status);
+      return;
+    }
+    jwt_ = std::move(jwt);
   }
 
   ENVOY_LOG(debug, "{}: Verifying JWT token of issuer {}", name(), jwt_->iss_);
@@ -172,10 +182,18 @@ void AuthenticatorImpl::startVerify() {
   }
 
   // Check the issuer is configured or not.
-  jwks_data_ = provider_ ? jwks_cache_.findByProvider(provider_.value())
-                         : jwks_cache_.findByIssuer(jwt_->iss_);
+  if (!provider_) {
+    jwks_data_ = jwks_cache_.findByIssuer(jwt_->iss_);
+  }
   // isIssuerSpecified() check already make sure the issuer is in the cache.
   ASSERT(jwks_data_ != nullptr);
+  if (!is_cached && !provider_) {
+    const auto cached_jwt = jwks_data_->getJwtCache().lookup(curr_token_->token());
+    if (cached_jwt != nullptr) {
+      jwt_ = cached_jwt;
+      is_cached = true;
+    }
+  }
 
   // Check if audience is allowed
   bool is_allowed = check_audience_ ? check_audience_->areAudiencesAllowed(jwt_->audiences_)
@@ -194,7 +212,12 @@ void AuthenticatorImpl::startVerify() {
     // the key cached, if we do proceed to verify else try a new JWKS retrieval.
     // JWTs without a kid header field in the JWS we might be best to get each
     // time? This all only matters for remote JWKS.
-    verifyKey();
+    if (is_cached) {
+      // The JWT was verified with the current keys, skip the signature verification.
+      handleGoodJwt();
+    } else {
+      verifyKey();
+    }
     return;
   }
 
@@ -240,6 +263,11 @@ void AuthenticatorImpl::verifyKey() {
     return;
   }
 
+  jwks_data_->getJwtCache().insert(curr_token_->token(), jwt_);
+  handleGoodJwt();
+}
+
+void AuthenticatorImpl::handleGoodJwt() {
   // Forward the payload
   const auto& provider = jwks_data_->getJwtProvider();
   if (!provider.forward_payload_header().empty()) {
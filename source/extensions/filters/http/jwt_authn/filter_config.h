@@ -5,10 +5,10 @@
 #include "envoy/router/string_accessor.h"
 #include "envoy/server/filter_config.h"
 #include "envoy/stats/scope.h"
-#include "envoy/stats/stats_macros.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "extensions/filters/http/jwt_authn/matcher.h"
+#include "extensions/filters/http/jwt_authn/stats.h"
 #include "extensions/filters/http/jwt_authn/verifier.h"
 
 #include "absl/container/flat_hash_map.h"
@@ -20,16 +20,15 @@ namespace JwtAuthn {
 
 /**
  * Making cache as a thread local object, its read/write operations don't need to be protected.
- * Now it only has jwks_cache, but in the future, it will have token cache: to cache the tokens
- * with their verification results.
+ * It holds the jwks_cache, whose per provider data also holds the cache of verified tokens.
  */
 class ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
 public:
   // Load the config from envoy config.
   ThreadLocalCache(
       const ::envoy::config::filter::http::jwt_authn::v2alpha::JwtAuthentication& config,
-      TimeSource& time_source, Api::Api& api) {
-    jwks_cache_ = JwksCache::create(config, time_source, api);
+      TimeSource& time_source, Api::Api& api, JwtAuthnFilterStats& stats) {
+    jwks_cache_ = JwksCache::create(config, time_source, api, stats);
   }
 
   // Get the JwksCache object.
@@ -40,21 +39,6 @@ private:
   JwksCachePtr jwks_cache_;
 };
 
-/**
- * All stats for the Jwt Authn filter. @see stats_macros.h
- */
-#define ALL_JWT_AUTHN_FILTER_STATS(COUNTER)                                                        \
-  COUNTER(allowed)                                                                                 \
-  COUNTER(cors_preflight_bypassed)                                                                 \
-  COUNTER(denied)
-
-/**
- * Wrapper struct for jwt_authn filter stats. @see stats_macros.h
- */
-struct JwtAuthnFilterStats {
-  ALL_JWT_AUTHN_FILTER_STATS(GENERATE_COUNTER_STRUCT)
-};
-
 /**
  * The filter config object to hold config and relevant objects.
  */
@@ -70,7 +54,7 @@ public:
         time_source_(context.dispatcher().timeSource()), api_(context.api()) {
     ENVOY_LOG(info, "Loaded JwtAuthConfig: {}", proto_config_.DebugString());
     tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
-      return std::make_shared<ThreadLocalCache>(proto_config_, time_source_, api_);
+      return std::make_shared<ThreadLocalCache>(proto_config_, time_source_, api_, stats_);
     });
 
     for (const auto& rule : proto_config_.rules()) {
@@ -28,8 +28,10 @@ constexpr int PubkeyCacheExpirationSec = 600;
 
 class JwksDataImpl : public JwksCache::JwksData, public Logger::Loggable<Logger::Id::jwt> {
 public:
-  JwksDataImpl(const JwtProvider& jwt_provider, TimeSource& time_source, Api::Api& api)
-      : jwt_provider_(jwt_provider), time_source_(time_source) {
+  JwksDataImpl(const JwtProvider& jwt_provider, TimeSource& time_source, Api::Api& api,
+               JwtAuthnFilterStats& stats)
+      : jwt_provider_(jwt_provider), time_source_(time_source),
+        jwt_cache_(JwtCache::create(jwt_provider, time_source, stats)) {
     std::vector<std::string> audiences;
     for (const auto& aud : jwt_provider_.audiences()) {
       audiences.push_back(aud);
@@ -60,9 +62,13 @@ public:
   bool isExpired() const override { return time_source_.monotonicTime() >= expiration_time_; }
 
   const ::google::jwt_verify::Jwks* setRemoteJwks(::google::jwt_verify::JwksPtr&& jwks) override {
+    // The keys may have been rotated, don't trust the JWTs verified with the previous ones.
+    jwt_cache_->clear();
     return setKey(std::move(jwks), getRemoteJwksExpirationTime());
   }
 
+  JwtCache& getJwtCache() override { return *jwt_cache_; }
+
 private:
   // Get the expiration time for a remote Jwks
   std::chrono::steady_clock::time_point getRemoteJwksExpirationTime() const {
@@ -92,15 +98,18 @@ private:
   TimeSource& time_source_;
   // The pubkey expiration time.
   MonotonicTime expiration_time_;
+  // The cache of the JWTs verified with the jwks object.
+  JwtCachePtr jwt_cache_;
 };
 
 class JwksCacheImpl : public JwksCache {
 public:
   // Load the config from envoy config.
-  JwksCacheImpl(const JwtAuthentication& config, TimeSource& time_source, Api::Api& api) {
+  JwksCacheImpl(const JwtAuthentication& config, TimeSource& time_source, Api::Api& api,
+                JwtAuthnFilterStats& stats) {
     for (const auto& it : config.providers()) {
       const auto& provider = it.second;
-      jwks_data_map_.emplace(it.first, JwksDataImpl(provider, time_source, api));
+      jwks_data_map_.emplace(it.first, JwksDataImpl(provider, time_source, api, stats));
       if (issuer_ptr_map_.find(provider.issuer()) == issuer_ptr_map_.end()) {
         issuer_ptr_map_.emplace(provider.issuer(), findByProvider(it.first));
       }
@@ -134,8 +143,8 @@ private:
 
 JwksCachePtr JwksCache::create(
     const ::envoy::config::filter::http::jwt_authn::v2alpha::JwtAuthentication& config,
-    TimeSource& time_source, Api::Api& api) {
-  return JwksCachePtr(new JwksCacheImpl(config, time_source, api));
+    TimeSource& time_source, Api::Api& api, JwtAuthnFilterStats& stats) {
+  return JwksCachePtr(new JwksCacheImpl(config, time_source, api, stats));
 }
 
 } // namespace JwtAuthn
@@ -5,6 +5,9 @@
 #include "envoy/common/time.h"
 #include "envoy/config/filter/http/jwt_authn/v2alpha/config.pb.h"
 
+#include "extensions/filters/http/jwt_authn/jwt_cache.h"
+#include "extensions/filters/http/jwt_authn/stats.h"
+
 #include "jwt_verify_lib/jwks.h"
 
 namespace Envoy {
@@ -31,6 +34,7 @@ using JwksCachePtr = std::unique_ptr<JwksCache>;
  *     }
  *
  *     verifyJwt(jwks_data->getJwksObj(), jwt);
+ *     jwks_data->getJwtCache().insert(token, jwt);
  */
 
 class JwksCache {
@@ -55,9 +59,12 @@ public:
     // Return true if jwks object is expired.
     virtual bool isExpired() const PURE;
 
-    // Set a remote Jwks.
+    // Set a remote Jwks. The JWTs verified with the previous one are removed from the Jwt cache.
     virtual const ::google::jwt_verify::Jwks*
     setRemoteJwks(::google::jwt_verify::JwksPtr&& jwks) PURE;
+
+    // Get the cache of the JWTs verified with the Jwks object.
+    virtual JwtCache& getJwtCache() PURE;
   };
 
   // Lookup issuer cache map. The cache only stores Jwks specified in the config.
@@ -68,7 +75,7 @@ public:
   // Factory function to create an instance.
   static JwksCachePtr
   create(const ::envoy::config::filter::http::jwt_authn::v2alpha::JwtAuthentication& config,
-         TimeSource& time_source, Api::Api& api);
+         TimeSource& time_source, Api::Api& api, JwtAuthnFilterStats& stats);
 };
 
 } // namespace JwtAuthn
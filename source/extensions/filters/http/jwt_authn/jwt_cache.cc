@@ -0,0 +1,122 @@
+#include "extensions/filters/http/jwt_authn/jwt_cache.h"
+
+#include <chrono>
+#include <list>
+
+#include "absl/container/flat_hash_map.h"
+#include "openssl/sha.h"
+
+using ::envoy::config::filter::http::jwt_authn::v2alpha::JwtProvider;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace JwtAuthn {
+namespace {
+
+// Default number of verified JWTs cached per provider and per worker thread.
+constexpr uint32_t DefaultJwtCacheSize = 100;
+
+class NullJwtCache : public JwtCache {
+public:
+  JwtConstSharedPtr lookup(const std::string&) override { return nullptr; }
+  void insert(const std::string&, JwtConstSharedPtr) override {}
+  void clear() override {}
+};
+
+class JwtCacheImpl : public JwtCache {
+public:
+  JwtCacheImpl(uint32_t max_size, TimeSource& time_source, JwtAuthnFilterStats& stats)
+      : max_size_(max_size), time_source_(time_source), stats_(stats) {}
+
+  JwtConstSharedPtr lookup(const std::string& token) override {
+    const auto it = entries_.find(digest(token));
+    if (it == entries_.end()) {
+      stats_.jwt_cache_miss_.inc();
+      return nullptr;
+    }
+
+    const auto entry = it->second;
+    const JwtConstSharedPtr& jwt = entry->jwt_;
+    // The "exp" claim is defaulted to 0 when it is not in the JWT.
+    if (jwt->exp_ > 0 && jwt->exp_ < unixTimestamp()) {
+      lru_.erase(entry);
+      entries_.erase(it);
+      stats_.jwt_cache_miss_.inc();
+      return nullptr;
+    }
+
+    lru_.splice(lru_.begin(), lru_, entry);
+    stats_.jwt_cache_hit_.inc();
+    return entry->jwt_;
+  }
+
+  void insert(const std::string& token, JwtConstSharedPtr jwt) override {
+    std::string key = digest(token);
+    const auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      it->second->jwt_ = std::move(jwt);
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+
+    if (lru_.size() >= max_size_) {
+      entries_.erase(lru_.back().key_);
+      lru_.pop_back();
+      stats_.jwt_cache_evict_.inc();
+    }
+    lru_.push_front(Entry{key, std::move(jwt)});
+    entries_.emplace(std::move(key), lru_.begin());
+  }
+
+  void clear() override {
+    entries_.clear();
+    lru_.clear();
+  }
+
+private:
+  struct Entry {
+    std::string key_;
+    JwtConstSharedPtr jwt_;
+  };
+
+  // The tokens are keyed by their SHA-256 digest: it bounds the size of the keys, and a token
+  // can't be forged to hit the entry of another one.
+  static std::string digest(const std::string& token) {
+    std::string digest(SHA256_DIGEST_LENGTH, '\0');
+    SHA256(reinterpret_cast<const uint8_t*>(token.data()), token.size(),
+           reinterpret_cast<uint8_t*>(&digest[0]));
+    return digest;
+  }
+
+  uint64_t unixTimestamp() const {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               time_source_.systemTime().time_since_epoch())
+        .count();
+  }
+
+  const uint32_t max_size_;
+  TimeSource& time_source_;
+  JwtAuthnFilterStats& stats_;
+  // The most recently used entry is at the front.
+  std::list<Entry> lru_;
+  absl::flat_hash_map<std::string, std::list<Entry>::iterator> entries_;
+};
+
+} // namespace
+
+JwtCachePtr JwtCache::create(const JwtProvider& config, TimeSource& time_source,
+                             JwtAuthnFilterStats& stats) {
+  if (!config.has_jwt_cache_config()) {
+    return std::make_unique<NullJwtCache>();
+  }
+  const uint32_t max_size = config.jwt_cache_config().jwt_cache_size() > 0
+                                ? config.jwt_cache_config().jwt_cache_size()
+                                : DefaultJwtCacheSize;
+  return std::make_unique<JwtCacheImpl>(max_size, time_source, stats);
+}
+
+} // namespace JwtAuthn
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
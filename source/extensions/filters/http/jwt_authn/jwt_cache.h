@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+#include "envoy/common/time.h"
+#include "envoy/config/filter/http/jwt_authn/v2alpha/config.pb.h"
+
+#include "extensions/filters/http/jwt_authn/stats.h"
+
+#include "jwt_verify_lib/jwt.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace JwtAuthn {
+
+using JwtConstSharedPtr = std::shared_ptr<const ::google::jwt_verify::Jwt>;
+
+class JwtCache;
+using JwtCachePtr = std::unique_ptr<JwtCache>;
+
+/**
+ * Interface to cache the successfully verified JWTs of a provider. It is owned by the per worker
+ * JwksCache::JwksData of the provider, so it is not thread safe.
+ * Its usage:
+ *     auto jwt = jwt_cache->lookup(token);
+ *     if (jwt == nullptr) {
+ *        // Parse and verify the token.
+ *        if (verified) jwt_cache->insert(token, jwt);
+ *     }
+ */
+class JwtCache {
+public:
+  virtual ~JwtCache() = default;
+
+  // Returns the verified JWT cached for the token, or nullptr. Tokens that expired since they were
+  // cached are removed and not returned.
+  virtual JwtConstSharedPtr lookup(const std::string& token) PURE;
+
+  // Caches a successfully verified JWT, evicting the least recently used one if the cache is full.
+  virtual void insert(const std::string& token, JwtConstSharedPtr jwt) PURE;
+
+  // Removes all the cached JWTs, when the keys they were verified with are replaced.
+  virtual void clear() PURE;
+
+  // Factory function to create an instance. The returned cache doesn't cache anything if the
+  // provider doesn't configure jwt_cache_config.
+  static JwtCachePtr
+  create(const ::envoy::config::filter::http::jwt_authn::v2alpha::JwtProvider& config,
+         TimeSource& time_source, JwtAuthnFilterStats& stats);
+};
+
+} // namespace JwtAuthn
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -3,6 +3,7 @@
 #include "envoy/config/filter/http/lua/v2/lua.pb.h"
 #include "envoy/config/filter/http/lua/v2/lua.pb.validate.h"
 #include "envoy/registry/registry.h"
+#include "envoy/singleton/manager.h"
 
 #include "extensions/filters/http/lua/lua_filter.h"
 
@@ -11,11 +12,18 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Lua {
 
+// Singleton registration via macro defined in envoy/singleton/manager.h
+SINGLETON_MANAGER_REGISTRATION(lua_bytecode_cache);
+
 Http::FilterFactoryCb LuaFilterConfig::createFilterFactoryFromProtoTyped(
-    const envoy::config::filter::http::lua::v2::Lua& proto_config, const std::string&,
+    const envoy::config::filter::http::lua::v2::Lua& proto_config, const std::string& stats_prefix,
     Server::Configuration::FactoryContext& context) {
+  auto bytecode_cache = context.singletonManager().getTyped<Filters::Common::Lua::BytecodeCache>(
+      SINGLETON_MANAGER_REGISTERED_NAME(lua_bytecode_cache),
+      [] { return std::make_shared<Filters::Common::Lua::BytecodeCache>(); });
   FilterConfigConstSharedPtr filter_config(new FilterConfig{
-      proto_config.inline_code(), context.threadLocal(), context.clusterManager()});
+      proto_config.inline_code(), context.threadLocal(), context.clusterManager(), stats_prefix,
+      context.scope(), context.timeSource(), bytecode_cache});
   return [filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<Filter>(filter_config));
   };
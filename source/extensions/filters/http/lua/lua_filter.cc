@@ -246,6 +246,7 @@ void StreamHandleWrapper::onSuccess(Http::MessagePtr&& response) {
     markLive();
 
     try {
+      Filter::ScriptTimer timer(filter_);
       coroutine_.resume(2, yield_callback_);
       markDead();
     } catch (const Filters::Common::Lua::LuaException& e) {
@@ -485,8 +486,15 @@ int StreamHandleWrapper::luaImportPublicKey(lua_State* state) {
 }
 
 FilterConfig::FilterConfig(const std::string& lua_code, ThreadLocal::SlotAllocator& tls,
-                           Upstream::ClusterManager& cluster_manager)
-    : cluster_manager_(cluster_manager), lua_state_(lua_code, tls) {
+                           Upstream::ClusterManager& cluster_manager,
+                           const std::string& stats_prefix, Stats::Scope& scope,
+                           TimeSource& time_source,
+                           const Filters::Common::Lua::BytecodeCacheSharedPtr& bytecode_cache)
+    : cluster_manager_(cluster_manager),
+      stats_{ALL_LUA_FILTER_STATS(POOL_COUNTER_PREFIX(scope, stats_prefix + "lua."),
+                                  POOL_HISTOGRAM_PREFIX(scope, stats_prefix + "lua."))},
+      time_source_(time_source), bytecode_cache_(bytecode_cache),
+      lua_state_(lua_code, tls, bytecode_cache_.get()) {
   lua_state_.registerType<Filters::Common::Lua::BufferWrapper>();
   lua_state_.registerType<Filters::Common::Lua::MetadataMapWrapper>();
   lua_state_.registerType<Filters::Common::Lua::MetadataMapIterator>();
@@ -513,6 +521,12 @@ FilterConfig::FilterConfig(const std::string& lua_code, ThreadLocal::SlotAllocat
 
 void Filter::onDestroy() {
   destroyed_ = true;
+  // The script is still running if it destroyed the filter.
+  stopScriptTimer();
+  if (script_ran_) {
+    config_->stats().script_time_us_.recordValue(script_time_.count());
+    script_ran_ = false;
+  }
   if (request_stream_wrapper_.get()) {
     request_stream_wrapper_.get()->onReset();
   }
@@ -535,6 +549,7 @@ Http::FilterHeadersStatus Filter::doHeaders(StreamHandleRef& handle,
                true);
 
   Http::FilterHeadersStatus status = Http::FilterHeadersStatus::Continue;
+  ScriptTimer timer(*this);
   try {
     status = handle.get()->start(function_ref);
     handle.markDead();
@@ -549,6 +564,7 @@ Http::FilterDataStatus Filter::doData(StreamHandleRef& handle, Buffer::Instance&
                                       bool end_stream) {
   Http::FilterDataStatus status = Http::FilterDataStatus::Continue;
   if (handle.get() != nullptr) {
+    ScriptTimer timer(*this);
     try {
       handle.markLive();
       status = handle.get()->onData(data, end_stream);
@@ -564,6 +580,7 @@ Http::FilterDataStatus Filter::doData(StreamHandleRef& handle, Buffer::Instance&
 Http::FilterTrailersStatus Filter::doTrailers(StreamHandleRef& handle, Http::HeaderMap& trailers) {
   Http::FilterTrailersStatus status = Http::FilterTrailersStatus::Continue;
   if (handle.get() != nullptr) {
+    ScriptTimer timer(*this);
     try {
       handle.markLive();
       status = handle.get()->onTrailers(trailers);
@@ -576,7 +593,24 @@ Http::FilterTrailersStatus Filter::doTrailers(StreamHandleRef& handle, Http::Hea
   return status;
 }
 
+void Filter::startScriptTimer() {
+  // Once the filter is destroyed, the time is no longer counted.
+  if (!destroyed_) {
+    script_start_ = config_->timeSource().monotonicTime();
+    script_ran_ = true;
+  }
+}
+
+void Filter::stopScriptTimer() {
+  if (script_start_.has_value()) {
+    script_time_ += std::chrono::duration_cast<std::chrono::microseconds>(
+        config_->timeSource().monotonicTime() - script_start_.value());
+    script_start_.reset();
+  }
+}
+
 void Filter::scriptError(const Filters::Common::Lua::LuaException& e) {
+  config_->stats().errors_.inc();
   scriptLog(spdlog::level::err, e.what());
   request_stream_wrapper_.reset();
   response_stream_wrapper_.reset();
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "envoy/common/time.h"
 #include "envoy/http/filter.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "common/crypto/utility.h"
@@ -9,6 +12,8 @@
 #include "extensions/filters/http/lua/wrappers.h"
 #include "extensions/filters/http/well_known_names.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -286,22 +291,45 @@ private:
   Http::AsyncClient::Request* http_request_{};
 };
 
+/**
+ * All Lua filter stats. @see stats_macros.h
+ */
+#define ALL_LUA_FILTER_STATS(COUNTER, HISTOGRAM)                                                   \
+  COUNTER(errors)                                                                                  \
+  HISTOGRAM(script_time_us, Microseconds)
+
+/**
+ * Struct definition for all Lua filter stats. @see stats_macros.h
+ */
+struct LuaFilterStats {
+  ALL_LUA_FILTER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
 /**
  * Global configuration for the filter.
  */
 class FilterConfig : Logger::Loggable<Logger::Id::lua> {
 public:
   FilterConfig(const std::string& lua_code, ThreadLocal::SlotAllocator& tls,
-               Upstream::ClusterManager& cluster_manager);
+               Upstream::ClusterManager& cluster_manager, const std::string& stats_prefix,
+               Stats::Scope& scope, TimeSource& time_source,
+               const Filters::Common::Lua::BytecodeCacheSharedPtr& bytecode_cache);
   Filters::Common::Lua::CoroutinePtr createCoroutine() { return lua_state_.createCoroutine(); }
   int requestFunctionRef() { return lua_state_.getGlobalRef(request_function_slot_); }
   int responseFunctionRef() { return lua_state_.getGlobalRef(response_function_slot_); }
   uint64_t runtimeBytesUsed() { return lua_state_.runtimeBytesUsed(); }
   void runtimeGC() { return lua_state_.runtimeGC(); }
+  LuaFilterStats& stats() { return stats_; }
+  TimeSource& timeSource() { return time_source_; }
 
   Upstream::ClusterManager& cluster_manager_;
 
 private:
+  LuaFilterStats stats_;
+  TimeSource& time_source_;
+  // May be null. Kept so that the bytecode of the script outlives this configuration if the next
+  // one uses the same script.
+  const Filters::Common::Lua::BytecodeCacheSharedPtr bytecode_cache_;
   Filters::Common::Lua::ThreadLocalState lua_state_;
   uint64_t request_function_slot_;
   uint64_t response_function_slot_;
@@ -309,8 +337,6 @@ private:
 
 using FilterConfigConstSharedPtr = std::shared_ptr<FilterConfig>;
 
-// TODO(mattklein123): Filter stats.
-
 /**
  * The HTTP Lua filter. Allows scripts to run in both the request an response flow.
  */
@@ -318,6 +344,20 @@ class Filter : public Http::StreamFilter, Logger::Loggable<Logger::Id::lua> {
 public:
   Filter(FilterConfigConstSharedPtr config) : config_(config) {}
 
+  /**
+   * Adds the time from its construction to its destruction to the time spent running the script
+   * for the stream. If the script destroys the filter, as a local reply does, the time is counted
+   * up to then.
+   */
+  class ScriptTimer {
+  public:
+    ScriptTimer(Filter& filter) : filter_(filter) { filter_.startScriptTimer(); }
+    ~ScriptTimer() { filter_.stopScriptTimer(); }
+
+  private:
+    Filter& filter_;
+  };
+
   Upstream::ClusterManager& clusterManager() { return config_->cluster_manager_; }
   void scriptError(const Filters::Common::Lua::LuaException& e);
   virtual void scriptLog(spdlog::level::level_enum level, const char* message);
@@ -410,6 +450,8 @@ private:
                                       Http::HeaderMap& headers, bool end_stream);
   Http::FilterDataStatus doData(StreamHandleRef& handle, Buffer::Instance& data, bool end_stream);
   Http::FilterTrailersStatus doTrailers(StreamHandleRef& handle, Http::HeaderMap& trailers);
+  void startScriptTimer();
+  void stopScriptTimer();
 
   FilterConfigConstSharedPtr config_;
   DecoderCallbacks decoder_callbacks_{*this};
@@ -417,6 +459,11 @@ private:
   StreamHandleRef request_stream_wrapper_;
   StreamHandleRef response_stream_wrapper_;
   bool destroyed_{};
+  // The time spent running the script for the stream, recorded when the filter is destroyed.
+  std::chrono::microseconds script_time_{};
+  bool script_ran_{};
+  // Set while the script runs.
+  absl::optional<MonotonicTime> script_start_;
 
   // These coroutines used to be owned by the stream handles. After investigating #3570, it
   // became clear that there is a circular memory reference when a coroutine yields. Basically,
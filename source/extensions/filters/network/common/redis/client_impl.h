@@ -155,7 +155,8 @@ public:
   static ClientFactoryImpl instance_;
 
 private:
-  DecoderFactoryImpl decoder_factory_;
+  // Replies are mostly forwarded as they are, so the decoders keep the bytes of the large ones.
+  DecoderFactoryImpl decoder_factory_{true};
 };
 
 } // namespace Client
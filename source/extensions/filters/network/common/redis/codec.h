@@ -133,6 +133,17 @@ public:
   RespType type() const { return type_; }
   void type(RespType type);
 
+  /**
+   * Get/set the bytes the value was decoded from. Decoders only keep them for large top level
+   * values, and only when asked to, so that the value can be forwarded without encoding it again.
+   * They are moved along with the value, but not copied, and are dropped each time type() is
+   * called. Code that changes the value in place in any other way must drop them with
+   * raw(nullptr).
+   * @return the bytes the value was decoded from, or nullptr if they were not kept.
+   */
+  Buffer::Instance* raw() const { return raw_.get(); }
+  void raw(Buffer::InstancePtr&& raw) { raw_ = std::move(raw); }
+
 private:
   union {
     std::vector<RespValue> array_;
@@ -144,6 +155,7 @@ private:
   void cleanup();
 
   RespType type_{};
+  Buffer::InstancePtr raw_;
 };
 
 using RespValuePtr = std::unique_ptr<RespValue>;
@@ -1,6 +1,7 @@
 #include "extensions/filters/network/common/redis/codec_impl.h"
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -122,6 +123,7 @@ void RespValue::cleanup() {
 
 void RespValue::type(RespType type) {
   cleanup();
+  raw_.reset();
 
   // Need to use placement new because of the union.
   type_ = type;
@@ -173,7 +175,8 @@ RespValue::RespValue(const RespValue& other) : type_(RespType::Null) {
   }
 }
 
-RespValue::RespValue(RespValue&& other) noexcept : type_(other.type_) {
+RespValue::RespValue(RespValue&& other) noexcept
+    : type_(other.type_), raw_(std::move(other.raw_)) {
   switch (type_) {
   case RespType::Array: {
     new (&array_) std::vector<RespValue>(std::move(other.array_));
@@ -256,6 +259,7 @@ RespValue& RespValue::operator=(RespValue&& other) noexcept {
   case RespType::Null:
     break;
   }
+  raw_ = std::move(other.raw_);
   return *this;
 }
 
@@ -333,15 +337,39 @@ void DecoderImpl::decode(Buffer::Instance& data) {
   STACK_ARRAY(slices, Buffer::RawSlice, num_slices);
   data.getRawSlices(slices.begin(), num_slices);
   for (const Buffer::RawSlice& slice : slices) {
-    parseSlice(slice);
+    parseSlice(slice, data);
   }
 
-  data.drain(data.length());
+  if (keep_raw_values_) {
+    // Whatever is left belongs to the value still being decoded.
+    pending_raw_.move(data);
+    pending_raw_length_ = 0;
+  } else {
+    data.drain(data.length());
+  }
 }
 
-void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
+void DecoderImpl::keepRawValue(Buffer::Instance& data) {
+  // Everything before the current value has already been removed from the front of data, so the
+  // value is made of the bytes kept from earlier calls followed by the first pending_raw_length_
+  // bytes of data.
+  if (pending_raw_.length() + pending_raw_length_ >= MinRawValueBytes) {
+    Buffer::InstancePtr raw = std::make_unique<Buffer::OwnedImpl>();
+    raw->move(pending_raw_);
+    raw->move(data, pending_raw_length_);
+    pending_value_root_->raw(std::move(raw));
+  } else {
+    pending_raw_.drain(pending_raw_.length());
+    data.drain(pending_raw_length_);
+  }
+  pending_raw_length_ = 0;
+}
+
+void DecoderImpl::parseSlice(const Buffer::RawSlice& slice, Buffer::Instance& data) {
   const char* buffer = reinterpret_cast<const char*>(slice.mem_);
   uint64_t remaining = slice.len_;
+  // Start of the bytes of the slice not yet counted in pending_raw_length_.
+  const char* mark = buffer;
 
   while (remaining || state_ == State::ValueComplete) {
     ENVOY_LOG(trace, "parse slice: {} remaining", remaining);
@@ -349,7 +377,7 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
     case State::ValueRootStart: {
       ENVOY_LOG(trace, "parse slice: ValueRootStart");
       pending_value_root_ = std::make_unique<RespValue>();
-      pending_value_stack_.push_front({pending_value_root_.get(), 0});
+      pending_value_stack_.push_back({pending_value_root_.get(), 0});
       state_ = State::ValueStart;
       break;
     }
@@ -360,27 +388,27 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       switch (buffer[0]) {
       case '*': {
         state_ = State::IntegerStart;
-        pending_value_stack_.front().value_->type(RespType::Array);
+        pending_value_stack_.back().value_->type(RespType::Array);
         break;
       }
       case '$': {
         state_ = State::IntegerStart;
-        pending_value_stack_.front().value_->type(RespType::BulkString);
+        pending_value_stack_.back().value_->type(RespType::BulkString);
         break;
       }
       case '-': {
         state_ = State::SimpleString;
-        pending_value_stack_.front().value_->type(RespType::Error);
+        pending_value_stack_.back().value_->type(RespType::Error);
         break;
       }
       case '+': {
         state_ = State::SimpleString;
-        pending_value_stack_.front().value_->type(RespType::SimpleString);
+        pending_value_stack_.back().value_->type(RespType::SimpleString);
         break;
       }
       case ':': {
         state_ = State::IntegerStart;
-        pending_value_stack_.front().value_->type(RespType::Integer);
+        pending_value_stack_.back().value_->type(RespType::Integer);
         break;
       }
       default: {
@@ -407,19 +435,22 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
 
     case State::Integer: {
       ENVOY_LOG(trace, "parse slice: Integer: {}", buffer[0]);
-      char c = buffer[0];
-      if (buffer[0] == '\r') {
-        state_ = State::IntegerLF;
-      } else {
+      // Consume all the digits available in the slice at once.
+      while (remaining && buffer[0] != '\r') {
+        const char c = buffer[0];
         if (c < '0' || c > '9') {
           throw ProtocolError("invalid integer character");
-        } else {
-          pending_integer_.integer_ = (pending_integer_.integer_ * 10) + (c - '0');
         }
+        pending_integer_.integer_ = (pending_integer_.integer_ * 10) + (c - '0');
+        remaining--;
+        buffer++;
       }
 
-      remaining--;
-      buffer++;
+      if (remaining) {
+        state_ = State::IntegerLF;
+        remaining--;
+        buffer++;
+      }
       break;
     }
 
@@ -432,7 +463,7 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       remaining--;
       buffer++;
 
-      PendingValue& current_value = pending_value_stack_.front();
+      PendingValue& current_value = pending_value_stack_.back();
       if (current_value.value_->type() == RespType::Array) {
         if (pending_integer_.negative_) {
           // Null array. Convert to null.
@@ -443,7 +474,8 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
         } else {
           std::vector<RespValue> values(pending_integer_.integer_);
           current_value.value_->asArray().swap(values);
-          pending_value_stack_.push_front({&current_value.value_->asArray()[0], 0});
+          // This may reallocate the stack, so current_value must not be used after it.
+          pending_value_stack_.push_back({&current_value.value_->asArray()[0], 0});
           state_ = State::ValueStart;
         }
       } else if (current_value.value_->type() == RespType::Integer) {
@@ -476,14 +508,14 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       ASSERT(!pending_integer_.negative_);
       uint64_t length_to_copy =
           std::min(static_cast<uint64_t>(pending_integer_.integer_), remaining);
-      pending_value_stack_.front().value_->asString().append(buffer, length_to_copy);
+      pending_value_stack_.back().value_->asString().append(buffer, length_to_copy);
       pending_integer_.integer_ -= length_to_copy;
       remaining -= length_to_copy;
       buffer += length_to_copy;
 
       if (pending_integer_.integer_ == 0) {
         ENVOY_LOG(trace, "parse slice: BulkStringBody complete: {}",
-                  pending_value_stack_.front().value_->asString());
+                  pending_value_stack_.back().value_->asString());
         state_ = State::CR;
       }
 
@@ -516,31 +548,43 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
 
     case State::SimpleString: {
       ENVOY_LOG(trace, "parse slice: SimpleString: {}", buffer[0]);
-      if (buffer[0] == '\r') {
+      // Append everything up to the CR, or the rest of the slice, at once.
+      const char* cr = static_cast<const char*>(memchr(buffer, '\r', remaining));
+      const uint64_t length = cr != nullptr ? cr - buffer : remaining;
+      pending_value_stack_.back().value_->asString().append(buffer, length);
+      remaining -= length;
+      buffer += length;
+
+      if (cr != nullptr) {
         state_ = State::LF;
-      } else {
-        pending_value_stack_.front().value_->asString().push_back(buffer[0]);
+        remaining--;
+        buffer++;
       }
-
-      remaining--;
-      buffer++;
       break;
     }
 
     case State::ValueComplete: {
       ENVOY_LOG(trace, "parse slice: ValueComplete");
       ASSERT(!pending_value_stack_.empty());
-      pending_value_stack_.pop_front();
+      pending_value_stack_.pop_back();
       if (pending_value_stack_.empty()) {
+        if (keep_raw_values_) {
+          // The slice being parsed is only moved out of data whole, and possibly freed along with
+          // the value, once all of it has been parsed.
+          pending_raw_length_ += buffer - mark;
+          mark = buffer;
+          keepRawValue(data);
+        }
         callbacks_.onRespValue(std::move(pending_value_root_));
         state_ = State::ValueRootStart;
       } else {
-        PendingValue& current_value = pending_value_stack_.front();
+        PendingValue& current_value = pending_value_stack_.back();
         ASSERT(current_value.value_->type() == RespType::Array);
         if (current_value.current_array_element_ < current_value.value_->asArray().size() - 1) {
           current_value.current_array_element_++;
-          pending_value_stack_.push_front(
-              {&current_value.value_->asArray()[current_value.current_array_element_], 0});
+          RespValue* next_value =
+              &current_value.value_->asArray()[current_value.current_array_element_];
+          pending_value_stack_.push_back({next_value, 0});
           state_ = State::ValueStart;
         }
       }
@@ -549,6 +593,8 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
     }
     }
   }
+
+  pending_raw_length_ += buffer - mark;
 }
 
 void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
@@ -1,10 +1,10 @@
 #pragma once
 
 #include <cstdint>
-#include <forward_list>
 #include <string>
 #include <vector>
 
+#include "common/buffer/buffer_impl.h"
 #include "common/common/logger.h"
 
 #include "extensions/filters/network/common/redis/codec.h"
@@ -19,10 +19,18 @@ namespace Redis {
  * Decoder implementation of https://redis.io/topics/protocol
  *
  * This implementation buffers when needed and will always consume all bytes passed for decoding.
+ * When asked to keep raw values, it hands top level values of at least MinRawValueBytes over
+ * along with the bytes they were decoded from (see RespValue::raw()), moving whole slices out of
+ * the decoded buffers rather than copying them where it can.
  */
 class DecoderImpl : public Decoder, Logger::Loggable<Logger::Id::redis> {
 public:
-  DecoderImpl(DecoderCallbacks& callbacks) : callbacks_(callbacks) {}
+  DecoderImpl(DecoderCallbacks& callbacks, bool keep_raw_values = false)
+      : callbacks_(callbacks), keep_raw_values_(keep_raw_values) {}
+
+  // Smaller values are cheap to encode again, and would mostly be copied out of the slices they
+  // share with other values anyway.
+  static constexpr uint64_t MinRawValueBytes = 16384;
 
   // RedisProxy::Decoder
   void decode(Buffer::Instance& data) override;
@@ -56,13 +64,23 @@ private:
     uint64_t current_array_element_;
   };
 
-  void parseSlice(const Buffer::RawSlice& slice);
+  void parseSlice(const Buffer::RawSlice& slice, Buffer::Instance& data);
+  // Called when the root value is complete, to set its raw bytes if it is large enough, and to
+  // remove them from the front of data.
+  void keepRawValue(Buffer::Instance& data);
 
   DecoderCallbacks& callbacks_;
+  const bool keep_raw_values_;
   State state_{State::ValueRootStart};
   PendingInteger pending_integer_;
   RespValuePtr pending_value_root_;
-  std::forward_list<PendingValue> pending_value_stack_;
+  // Used as a stack. It keeps its capacity across values so that decoding does not allocate for
+  // each nested value or array element.
+  std::vector<PendingValue> pending_value_stack_;
+  // Bytes of the value being decoded that were passed to earlier decode() calls.
+  Buffer::OwnedImpl pending_raw_;
+  // Bytes of the value being decoded at the front of the buffer being decoded.
+  uint64_t pending_raw_length_{0};
 };
 
 /**
@@ -70,10 +88,15 @@ private:
  */
 class DecoderFactoryImpl : public DecoderFactory {
 public:
+  DecoderFactoryImpl(bool keep_raw_values = false) : keep_raw_values_(keep_raw_values) {}
+
   // RedisProxy::DecoderFactory
   DecoderPtr create(DecoderCallbacks& callbacks) override {
-    return DecoderPtr{new DecoderImpl(callbacks)};
+    return DecoderPtr{new DecoderImpl(callbacks, keep_raw_values_)};
   }
+
+private:
+  const bool keep_raw_values_;
 };
 
 /**
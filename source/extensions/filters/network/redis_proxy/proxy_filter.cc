@@ -103,7 +103,13 @@ void ProxyFilter::onResponse(PendingRequest& request, Common::Redis::RespValuePt
   // The response we got might not be in order, so flush out what we can. (A new response may
   // unlock several out of order responses).
   while (!pending_requests_.empty() && pending_requests_.front().pending_response_) {
-    encoder_->encode(*pending_requests_.front().pending_response_, encoder_buffer_);
+    Common::Redis::RespValue& response = *pending_requests_.front().pending_response_;
+    if (response.raw() != nullptr) {
+      // The response is exactly what the upstream sent, so forward its bytes without encoding it.
+      encoder_buffer_.move(*response.raw());
+    } else {
+      encoder_->encode(response, encoder_buffer_);
+    }
     pending_requests_.pop_front();
   }
 
@@ -80,6 +80,7 @@ public:
   TransportPtr createTransport() override;
   ProtocolPtr createProtocol() override;
   Router::Config& routerConfig() override { return *this; }
+  bool payloadPassthrough() const override { return payload_passthrough_; }
 
 private:
   void processFilter(
@@ -91,6 +92,7 @@ private:
   const TransportType transport_;
   const ProtocolType proto_;
   std::unique_ptr<Router::RouteMatcher> route_matcher_;
+  const bool payload_passthrough_;
 
   std::list<ThriftFilters::FilterFactoryCb> filter_factories_;
 };
@@ -1,5 +1,7 @@
 #include "extensions/filters/network/thrift_proxy/conn_manager.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/event/dispatcher.h"
 
@@ -176,6 +178,16 @@ DecoderEventHandler& ConnectionManager::newDecoderEventHandler() {
   return **rpcs_.begin();
 }
 
+bool ConnectionManager::passthroughEnabled() const {
+  if (!config_.payloadPassthrough() || protocol_->supportsUpgrade()) {
+    return false;
+  }
+
+  // This is called while decoding the request most recently added by newDecoderEventHandler.
+  ASSERT(!rpcs_.empty());
+  return (*rpcs_.begin())->passthroughSupported();
+}
+
 bool ConnectionManager::ResponseDecoder::onData(Buffer::Instance& data) {
   upstream_buffer_.move(data);
 
@@ -208,6 +220,30 @@ FilterStatus ConnectionManager::ResponseDecoder::fieldBegin(absl::string_view na
   return ProtocolConverter::fieldBegin(name, field_type, field_id);
 }
 
+FilterStatus ConnectionManager::ResponseDecoder::passthroughData(Buffer::Instance& data) {
+  if (first_reply_field_) {
+    // The reply struct is not decoded, so peek at its first field header to tell successes from
+    // IDL exceptions (see fieldBegin). A field header takes at most a few bytes in any protocol.
+    char prefix[16];
+    const uint64_t prefix_len = std::min<uint64_t>(data.length(), sizeof(prefix));
+    data.copyOut(0, prefix_len, prefix);
+    Buffer::OwnedImpl field(prefix, prefix_len);
+    ProtocolPtr protocol =
+        NamedProtocolConfigFactory::getFactory(decoder_->protocolType()).createProtocol();
+
+    std::string name;
+    FieldType field_type;
+    int16_t field_id;
+    if (protocol->readStructBegin(field, name) &&
+        protocol->readFieldBegin(field, name, field_type, field_id)) {
+      success_ = field_id == 0 && field_type != FieldType::Stop;
+    }
+    first_reply_field_ = false;
+  }
+
+  return ProtocolConverter::passthroughData(data);
+}
+
 FilterStatus ConnectionManager::ResponseDecoder::transportEnd() {
   ASSERT(metadata_ != nullptr);
 
@@ -270,6 +306,19 @@ void ConnectionManager::ActiveRpcDecoderFilter::continueDecoding() {
   }
 }
 
+bool ConnectionManager::ActiveRpc::passthroughSupported() const {
+  if (upgrade_handler_) {
+    return false;
+  }
+
+  for (auto& entry : decoder_filters_) {
+    if (!entry->handle_->passthroughSupported()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 FilterStatus ConnectionManager::ActiveRpc::applyDecoderFilters(ActiveRpcDecoderFilter* filter) {
   ASSERT(filter_action_ != nullptr);
 
@@ -578,6 +627,16 @@ FilterStatus ConnectionManager::ActiveRpc::setEnd() {
   return applyDecoderFilters(nullptr);
 }
 
+FilterStatus ConnectionManager::ActiveRpc::passthroughData(Buffer::Instance& data) {
+  filter_context_ = &data;
+  filter_action_ = [this](DecoderEventHandler* filter) -> FilterStatus {
+    Buffer::Instance* data = absl::any_cast<Buffer::Instance*>(filter_context_);
+    return filter->passthroughData(*data);
+  };
+
+  return applyDecoderFilters(nullptr);
+}
+
 void ConnectionManager::ActiveRpc::createFilterChain() {
   parent_.config_.filterFactory().createFilterChain(*this);
 }
@@ -39,6 +39,7 @@ public:
   virtual TransportPtr createTransport() PURE;
   virtual ProtocolPtr createProtocol() PURE;
   virtual Router::Config& routerConfig() PURE;
+  virtual bool payloadPassthrough() const PURE;
 };
 
 /**
@@ -76,6 +77,7 @@ public:
 
   // DecoderCallbacks
   DecoderEventHandler& newDecoderEventHandler() override;
+  bool passthroughEnabled() const override;
 
 private:
   struct ActiveRpc;
@@ -83,7 +85,10 @@ private:
   struct ResponseDecoder : public DecoderCallbacks, public ProtocolConverter {
     ResponseDecoder(ActiveRpc& parent, Transport& transport, Protocol& protocol)
         : parent_(parent), decoder_(std::make_unique<Decoder>(transport, protocol, *this)),
-          complete_(false), first_reply_field_(false) {
+          complete_(false), first_reply_field_(false),
+          passthrough_(parent_.parent_.config_.payloadPassthrough() &&
+                       protocol.type() == parent_.parent_.decoder_->protocolType() &&
+                       !protocol.supportsUpgrade()) {
       initProtocolConverter(*parent_.parent_.protocol_, parent_.response_buffer_);
     }
 
@@ -98,9 +103,11 @@ private:
       return FilterStatus::Continue;
     }
     FilterStatus transportEnd() override;
+    FilterStatus passthroughData(Buffer::Instance& data) override;
 
     // DecoderCallbacks
     DecoderEventHandler& newDecoderEventHandler() override { return *this; }
+    bool passthroughEnabled() const override { return passthrough_; }
 
     ActiveRpc& parent_;
     DecoderPtr decoder_;
@@ -109,6 +116,8 @@ private:
     absl::optional<bool> success_;
     bool complete_ : 1;
     bool first_reply_field_ : 1;
+    // Responses are passed through if enabled and encoded with the downstream protocol.
+    const bool passthrough_ : 1;
   };
   using ResponseDecoderPtr = std::unique_ptr<ResponseDecoder>;
 
@@ -197,6 +206,7 @@ private:
     FilterStatus listEnd() override;
     FilterStatus setBegin(FieldType& elem_type, uint32_t& size) override;
     FilterStatus setEnd() override;
+    FilterStatus passthroughData(Buffer::Instance& data) override;
 
     // ThriftFilters::DecoderFilterCallbacks
     uint64_t streamId() const override { return stream_id_; }
@@ -222,6 +232,7 @@ private:
       wrapper->moveIntoListBack(std::move(wrapper), decoder_filters_);
     }
 
+    bool passthroughSupported() const;
     FilterStatus applyDecoderFilters(ActiveRpcDecoderFilter* filter);
     void finalizeRequest();
 
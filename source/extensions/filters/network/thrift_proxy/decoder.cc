@@ -14,8 +14,10 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace ThriftProxy {
 
+// MessageBegin -> PassthroughData (transport provides the message size), or
 // MessageBegin -> StructBegin
 DecoderStateMachine::DecoderStatus DecoderStateMachine::messageBegin(Buffer::Instance& buffer) {
+  const uint64_t available = buffer.length();
   if (!proto_.readMessageBegin(buffer, *metadata_)) {
     return {ProtocolState::WaitForData};
   }
@@ -23,7 +25,36 @@ DecoderStateMachine::DecoderStatus DecoderStateMachine::messageBegin(Buffer::Ins
   stack_.clear();
   stack_.emplace_back(Frame(ProtocolState::MessageEnd));
 
-  return {ProtocolState::StructBegin, handler_.messageBegin(metadata_)};
+  ProtocolState next_state = ProtocolState::StructBegin;
+  if (metadata_->hasFrameSize()) {
+    const uint64_t message_begin_bytes = available - buffer.length();
+    if (message_begin_bytes > metadata_->frameSize()) {
+      throw EnvoyException(fmt::format("message begin size {} exceeds frame size {}",
+                                       message_begin_bytes, metadata_->frameSize()));
+    }
+
+    body_bytes_ = metadata_->frameSize() - message_begin_bytes;
+    next_state = ProtocolState::PassthroughData;
+  }
+
+  return {next_state, handler_.messageBegin(metadata_)};
+}
+
+// PassthroughData -> MessageEnd, or
+// PassthroughData -> StructBegin (passthrough disabled for this message)
+DecoderStateMachine::DecoderStatus DecoderStateMachine::passthroughData(Buffer::Instance& buffer) {
+  // Checked after the message begin has been handled, since that is where filters and the router
+  // learn enough about the message to decide.
+  if (!callbacks_.passthroughEnabled()) {
+    return {ProtocolState::StructBegin, FilterStatus::Continue};
+  }
+
+  if (buffer.length() < body_bytes_) {
+    return {ProtocolState::WaitForData};
+  }
+
+  body_.move(buffer, body_bytes_);
+  return {ProtocolState::MessageEnd, handler_.passthroughData(body_)};
 }
 
 // MessageEnd -> Done
@@ -288,6 +319,8 @@ DecoderStateMachine::DecoderStatus DecoderStateMachine::handleState(Buffer::Inst
   switch (state_) {
   case ProtocolState::MessageBegin:
     return messageBegin(buffer);
+  case ProtocolState::PassthroughData:
+    return passthroughData(buffer);
   case ProtocolState::StructBegin:
     return structBegin(buffer);
   case ProtocolState::StructEnd:
@@ -408,8 +441,8 @@ FilterStatus Decoder::onData(Buffer::Instance& data, bool& buffer_underflow) {
 
     request_ = std::make_unique<ActiveRequest>(callbacks_.newDecoderEventHandler());
     frame_started_ = true;
-    state_machine_ =
-        std::make_unique<DecoderStateMachine>(protocol_, metadata_, request_->handler_);
+    state_machine_ = std::make_unique<DecoderStateMachine>(protocol_, metadata_, request_->handler_,
+                                                           callbacks_);
 
     if (request_->handler_.transportBegin(metadata_) == FilterStatus::StopIteration) {
       return FilterStatus::StopIteration;
@@ -2,6 +2,7 @@
 
 #include "envoy/buffer/buffer.h"
 
+#include "common/buffer/buffer_impl.h"
 #include "common/common/assert.h"
 #include "common/common/logger.h"
 
@@ -19,6 +20,7 @@ namespace ThriftProxy {
   FUNCTION(WaitForData)                                                                            \
   FUNCTION(MessageBegin)                                                                           \
   FUNCTION(MessageEnd)                                                                             \
+  FUNCTION(PassthroughData)                                                                        \
   FUNCTION(StructBegin)                                                                            \
   FUNCTION(StructEnd)                                                                              \
   FUNCTION(FieldBegin)                                                                             \
@@ -56,6 +58,23 @@ private:
   }
 };
 
+class DecoderCallbacks {
+public:
+  virtual ~DecoderCallbacks() = default;
+
+  /**
+   * @return DecoderEventHandler& a new DecoderEventHandler for a message.
+   */
+  virtual DecoderEventHandler& newDecoderEventHandler() PURE;
+
+  /**
+   * Called once the message begin of a message with a known size has been handled.
+   * @return bool true if the body of the message can be handed to the DecoderEventHandler
+   *         undecoded, via DecoderEventHandler::passthroughData.
+   */
+  virtual bool passthroughEnabled() const PURE;
+};
+
 /**
  * DecoderStateMachine is the Thrift message state machine as described in
  * source/extensions/filters/network/thrift_proxy/docs.
@@ -63,9 +82,9 @@ private:
 class DecoderStateMachine : public Logger::Loggable<Logger::Id::thrift> {
 public:
   DecoderStateMachine(Protocol& proto, MessageMetadataSharedPtr& metadata,
-                      DecoderEventHandler& handler)
-      : proto_(proto), metadata_(metadata), handler_(handler), state_(ProtocolState::MessageBegin) {
-  }
+                      DecoderEventHandler& handler, DecoderCallbacks& callbacks)
+      : proto_(proto), metadata_(metadata), handler_(handler), callbacks_(callbacks),
+        state_(ProtocolState::MessageBegin) {}
 
   /**
    * Consumes as much data from the configured Buffer as possible and executes the decoding state
@@ -131,6 +150,7 @@ private:
   // or ProtocolState::WaitForData if more data is required.
   DecoderStatus messageBegin(Buffer::Instance& buffer);
   DecoderStatus messageEnd(Buffer::Instance& buffer);
+  DecoderStatus passthroughData(Buffer::Instance& buffer);
   DecoderStatus structBegin(Buffer::Instance& buffer);
   DecoderStatus structEnd(Buffer::Instance& buffer);
   DecoderStatus fieldBegin(Buffer::Instance& buffer);
@@ -165,22 +185,18 @@ private:
   Protocol& proto_;
   MessageMetadataSharedPtr metadata_;
   DecoderEventHandler& handler_;
+  DecoderCallbacks& callbacks_;
   ProtocolState state_;
   std::vector<Frame> stack_;
+  // Size of the message body, when the transport provides the size of the message.
+  uint64_t body_bytes_{};
+  // The undecoded message body, kept until the message is complete in case a handler stops
+  // iteration.
+  Buffer::OwnedImpl body_;
 };
 
 using DecoderStateMachinePtr = std::unique_ptr<DecoderStateMachine>;
 
-class DecoderCallbacks {
-public:
-  virtual ~DecoderCallbacks() = default;
-
-  /**
-   * @return DecoderEventHandler& a new DecoderEventHandler for a message.
-   */
-  virtual DecoderEventHandler& newDecoderEventHandler() PURE;
-};
-
 /**
  * Decoder encapsulates a configured Transport and Protocol and provides the ability to decode
  * Thrift messages.
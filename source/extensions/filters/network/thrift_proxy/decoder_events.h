@@ -1,5 +1,7 @@
 #pragma once
 
+#include "envoy/buffer/buffer.h"
+
 #include "extensions/filters/network/thrift_proxy/metadata.h"
 #include "extensions/filters/network/thrift_proxy/thrift.h"
 
@@ -132,6 +134,16 @@ public:
    * @return FilterStatus to indicate if filter chain iteration should continue
    */
   virtual FilterStatus setEnd() PURE;
+
+  /**
+   * Indicates that the body of a message, everything that follows the message begin, was received
+   * and is not decoded. It replaces the struct, field and value events of the message. Only used
+   * when DecoderCallbacks::passthroughEnabled() is true once the message begin is handled.
+   * @param data the encoded message body, which a handler forwarding the message moves out of the
+   *             buffer
+   * @return FilterStatus to indicate if filter chain iteration should continue
+   */
+  virtual FilterStatus passthroughData(Buffer::Instance& data) PURE;
 };
 
 using DecoderEventHandlerSharedPtr = std::shared_ptr<DecoderEventHandler>;
@@ -123,6 +123,14 @@ public:
    * filter should use. Callbacks will not be invoked by the filter after onDestroy() is called.
    */
   virtual void setDecoderFilterCallbacks(DecoderFilterCallbacks& callbacks) PURE;
+
+  /**
+   * Called once the filter chain has handled the message begin.
+   * @return bool true if the filter can handle the message body as a single passthroughData event
+   *         instead of the struct, field and value events. The body is only passed through if all
+   *         the filters of the chain support it.
+   */
+  virtual bool passthroughSupported() const PURE;
 };
 
 using DecoderFilterSharedPtr = std::shared_ptr<DecoderFilter>;
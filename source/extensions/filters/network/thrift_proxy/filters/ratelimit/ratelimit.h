@@ -77,6 +77,7 @@ public:
       ThriftProxy::ThriftFilters::DecoderFilterCallbacks& callbacks) override {
     callbacks_ = &callbacks;
   };
+  bool passthroughSupported() const override { return true; }
   ThriftProxy::FilterStatus
   transportBegin(NetworkFilters::ThriftProxy::MessageMetadataSharedPtr) override {
     return ThriftProxy::FilterStatus::Continue;
@@ -127,6 +128,9 @@ public:
     return ThriftProxy::FilterStatus::Continue;
   }
   ThriftProxy::FilterStatus setEnd() override { return ThriftProxy::FilterStatus::Continue; }
+  ThriftProxy::FilterStatus passthroughData(Buffer::Instance&) override {
+    return ThriftProxy::FilterStatus::Continue;
+  }
 
   // RateLimit::RequestCallbacks
   void complete(Filters::Common::RateLimit::LimitStatus status,
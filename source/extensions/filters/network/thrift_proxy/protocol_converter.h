@@ -122,6 +122,12 @@ public:
     return FilterStatus::Continue;
   }
 
+  // The body is only passed through when it is already encoded with the converter's protocol.
+  FilterStatus passthroughData(Buffer::Instance& data) override {
+    buffer_->move(data);
+    return FilterStatus::Continue;
+  }
+
 protected:
   ProtocolType protocolType() const { return proto_->type(); }
 
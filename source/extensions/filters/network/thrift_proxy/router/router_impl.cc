@@ -255,8 +255,9 @@ FilterStatus Router::messageBegin(MessageMetadataSharedPtr metadata) {
                                       : callbacks_->downstreamTransportType();
   ASSERT(transport != TransportType::Auto);
 
-  const ProtocolType protocol = options ? options->protocol(callbacks_->downstreamProtocolType())
-                                        : callbacks_->downstreamProtocolType();
+  const ProtocolType downstream_protocol = callbacks_->downstreamProtocolType();
+  const ProtocolType protocol =
+      options ? options->protocol(downstream_protocol) : downstream_protocol;
   ASSERT(protocol != ProtocolType::Auto);
 
   Tcp::ConnectionPool::Instance* conn_pool = cluster_manager_.tcpConnPoolForCluster(
@@ -282,6 +283,9 @@ FilterStatus Router::messageBegin(MessageMetadataSharedPtr metadata) {
 
   upstream_request_ =
       std::make_unique<UpstreamRequest>(*this, *conn_pool, metadata, transport, protocol);
+  // The request body can be passed through as is when the upstream speaks the downstream protocol.
+  passthrough_supported_ = protocol == downstream_protocol &&
+                           !upstream_request_->protocol_->supportsUpgrade();
   return upstream_request_->start();
 }
 
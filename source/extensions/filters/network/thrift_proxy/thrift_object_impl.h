@@ -43,6 +43,8 @@ public:
   FilterStatus listEnd() override;
   FilterStatus setBegin(FieldType& elem_type, uint32_t& size) override;
   FilterStatus setEnd() override;
+  // Objects are always fully decoded, see ThriftObjectImpl::passthroughEnabled().
+  FilterStatus passthroughData(Buffer::Instance&) override { NOT_REACHED_GCOVR_EXCL_LINE; }
 
   // Invoked when the current delegate is complete. Completion implies that the delegate is fully
   // specified (all list values processed, all struct fields processed, etc).
@@ -242,6 +244,7 @@ public:
 
   // DecoderCallbacks
   DecoderEventHandler& newDecoderEventHandler() override { return *this; }
+  bool passthroughEnabled() const override { return false; }
   FilterStatus transportEnd() override {
     complete_ = true;
     return FilterStatus::Continue;
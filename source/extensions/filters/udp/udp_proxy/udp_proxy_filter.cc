@@ -202,6 +202,7 @@ void UdpProxyFilter::ActiveSession::onReadReady() {
   const Api::IoErrorPtr result = Network::Utility::readPacketsFromSocket(
       *io_handle_, *addresses_.local_, *this, cluster_.filter_.config_->timeSource(),
       packets_dropped);
+  flushDownstreamDatagrams();
   // TODO(mattklein123): Handle no error when we limit the number of packets read.
   if (result->getErrorCode() != Api::IoError::IoErrorCode::Again) {
     cluster_.cluster_stats_.sess_rx_errors_.inc();
@@ -235,22 +236,55 @@ void UdpProxyFilter::ActiveSession::write(const Buffer::Instance& buffer) {
 void UdpProxyFilter::ActiveSession::processPacket(Network::Address::InstanceConstSharedPtr,
                                                   Network::Address::InstanceConstSharedPtr,
                                                   Buffer::InstancePtr buffer, MonotonicTime) {
-  ENVOY_LOG(trace, "writing {} byte datagram downstream: downstream={} local={} upstream={}",
+  ENVOY_LOG(trace, "queueing {} byte datagram downstream: downstream={} local={} upstream={}",
             buffer->length(), addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host_->address()->asStringView());
-  const uint64_t buffer_length = buffer->length();
-
   cluster_.cluster_stats_.sess_rx_datagrams_.inc();
-  cluster_.cluster_.info()->stats().upstream_cx_rx_bytes_total_.add(buffer_length);
+  cluster_.cluster_.info()->stats().upstream_cx_rx_bytes_total_.add(buffer->length());
 
-  Network::UdpSendData data{addresses_.local_->ip(), *addresses_.peer_, *buffer};
-  const Api::IoCallUint64Result rc = cluster_.filter_.read_callbacks_->udpListener().send(data);
-  if (!rc.ok()) {
-    cluster_.filter_.config_->stats().downstream_sess_tx_errors_.inc();
-  } else {
-    cluster_.filter_.config_->stats().downstream_sess_tx_bytes_.add(buffer_length);
-    cluster_.filter_.config_->stats().downstream_sess_tx_datagrams_.inc();
+  downstream_datagrams_.push_back(std::move(buffer));
+  if (downstream_datagrams_.size() == MaxDownstreamBatchSize) {
+    flushDownstreamDatagrams();
+  }
+}
+
+void UdpProxyFilter::ActiveSession::flushDownstreamDatagrams() {
+  if (downstream_datagrams_.empty()) {
+    return;
+  }
+
+  ENVOY_LOG(trace, "writing {} datagrams downstream: downstream={} local={} upstream={}",
+            downstream_datagrams_.size(), addresses_.peer_->asStringView(),
+            addresses_.local_->asStringView(), host_->address()->asStringView());
+  std::vector<Network::UdpSendData> send_data;
+  std::vector<uint64_t> lengths;
+  send_data.reserve(downstream_datagrams_.size());
+  lengths.reserve(downstream_datagrams_.size());
+  for (const Buffer::InstancePtr& buffer : downstream_datagrams_) {
+    send_data.push_back({addresses_.local_->ip(), *addresses_.peer_, *buffer});
+    lengths.push_back(buffer->length());
+  }
+
+  UdpProxyDownstreamStats& stats = cluster_.filter_.config_->stats();
+  Network::UdpListener& listener = cluster_.filter_.read_callbacks_->udpListener();
+  uint64_t next = 0;
+  while (next < send_data.size()) {
+    const Api::IoCallUint64Result rc =
+        listener.sendBatch(&send_data[next], send_data.size() - next);
+    if (!rc.ok() || rc.rc_ == 0) {
+      // Drop the datagram that couldn't be sent and go on with the next ones, as sending them one
+      // by one would.
+      stats.downstream_sess_tx_errors_.inc();
+      next++;
+      continue;
+    }
+    for (uint64_t i = next; i < next + rc.rc_; i++) {
+      stats.downstream_sess_tx_bytes_.add(lengths[i]);
+      stats.downstream_sess_tx_datagrams_.inc();
+    }
+    next += rc.rc_;
   }
+  downstream_datagrams_.clear();
 }
 
 } // namespace UdpProxy
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "envoy/config/filter/udp/udp_proxy/v2alpha/udp_proxy.pb.h"
 #include "envoy/event/file_event.h"
 #include "envoy/event/timer.h"
@@ -119,8 +121,13 @@ private:
     void write(const Buffer::Instance& buffer);
 
   private:
+    // The maximum number of datagrams from the upstream host sent downstream with one batch.
+    static constexpr size_t MaxDownstreamBatchSize = 16;
+
     void onIdleTimer();
     void onReadReady();
+    // Sends the datagrams queued by processPacket() to the downstream peer.
+    void flushDownstreamDatagrams();
 
     // Network::UdpPacketProcessor
     void processPacket(Network::Address::InstanceConstSharedPtr local_address,
@@ -147,6 +154,9 @@ private:
     // write to the upstream host.
     const Network::IoHandlePtr io_handle_;
     const Event::FileEventPtr socket_event_;
+    // Datagrams read from the upstream host and not yet sent downstream. Every read event sends
+    // them in batches before returning, so this is empty between events.
+    std::vector<Buffer::InstancePtr> downstream_datagrams_;
   };
 
   using ActiveSessionPtr = std::unique_ptr<ActiveSession>;
@@ -0,0 +1,37 @@
+#include "extensions/private_key_providers/thread_pool/config.h"
+
+#include "envoy/config/private_key_provider/thread_pool/v2alpha/thread_pool.pb.h"
+#include "envoy/config/private_key_provider/thread_pool/v2alpha/thread_pool.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "common/config/utility.h"
+#include "common/protobuf/utility.h"
+
+#include "extensions/private_key_providers/thread_pool/thread_pool_provider.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyProviders {
+namespace ThreadPool {
+
+Ssl::PrivateKeyMethodProviderSharedPtr
+ThreadPoolPrivateKeyMethodFactory::createPrivateKeyMethodProviderInstance(
+    const envoy::api::v2::auth::PrivateKeyProvider& config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context) {
+  envoy::config::private_key_provider::thread_pool::v2alpha::ThreadPoolPrivateKeyProviderConfig
+      message;
+  Config::Utility::translateOpaqueConfig(name(), config.typed_config(), config.config(),
+                                         factory_context.messageValidationVisitor(), message);
+  MessageUtil::validate(message, factory_context.messageValidationVisitor());
+  return std::make_shared<ThreadPoolPrivateKeyMethodProvider>(message, factory_context);
+}
+
+/**
+ * Static registration for the thread pool private key provider. @see RegisterFactory.
+ */
+REGISTER_FACTORY(ThreadPoolPrivateKeyMethodFactory, Ssl::PrivateKeyMethodProviderInstanceFactory);
+
+} // namespace ThreadPool
+} // namespace PrivateKeyProviders
+} // namespace Extensions
+} // namespace Envoy
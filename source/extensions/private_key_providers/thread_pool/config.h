@@ -0,0 +1,28 @@
+#pragma once
+
+#include "envoy/ssl/private_key/private_key_config.h"
+
+#include "extensions/private_key_providers/well_known_names.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyProviders {
+namespace ThreadPool {
+
+/**
+ * Config registration for the thread pool private key provider. @see
+ * PrivateKeyMethodProviderInstanceFactory.
+ */
+class ThreadPoolPrivateKeyMethodFactory : public Ssl::PrivateKeyMethodProviderInstanceFactory {
+public:
+  // Ssl::PrivateKeyMethodProviderInstanceFactory
+  Ssl::PrivateKeyMethodProviderSharedPtr createPrivateKeyMethodProviderInstance(
+      const envoy::api::v2::auth::PrivateKeyProvider& config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context) override;
+  std::string name() const override { return PrivateKeyProviderNames::get().ThreadPool; }
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyProviders
+} // namespace Extensions
+} // namespace Envoy
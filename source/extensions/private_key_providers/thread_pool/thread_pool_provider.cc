@@ -0,0 +1,426 @@
+#include "extensions/private_key_providers/thread_pool/thread_pool_provider.h"
+
+#include <chrono>
+#include <memory>
+
+#include "envoy/common/exception.h"
+
+#include "common/common/assert.h"
+#include "common/common/macros.h"
+#include "common/config/datasource.h"
+#include "common/protobuf/utility.h"
+
+#include "openssl/evp.h"
+#include "openssl/rsa.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyProviders {
+namespace ThreadPool {
+
+namespace {
+
+constexpr uint32_t DefaultThreadCount = 1;
+constexpr uint32_t DefaultMaxQueuedOperations = 1024;
+constexpr uint32_t DefaultMaxBatchSize = 8;
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+ssl_private_key_result_t startOperation(SSL* ssl, int index, PrivateKeyOperation::Type type,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len, uint8_t* out, size_t* out_len,
+                                        size_t max_out) {
+  auto* connection = static_cast<ThreadPoolPrivateKeyConnection*>(SSL_get_ex_data(ssl, index));
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->start(type, signature_algorithm, in, in_len, out, out_len, max_out);
+}
+
+ssl_private_key_result_t completeOperation(SSL* ssl, int index, uint8_t* out, size_t* out_len,
+                                           size_t max_out) {
+  auto* connection = static_cast<ThreadPoolPrivateKeyConnection*>(SSL_get_ex_data(ssl, index));
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->complete(out, out_len, max_out);
+}
+
+ssl_private_key_result_t rsaPrivateKeySign(SSL* ssl, uint8_t* out, size_t* out_len,
+                                           size_t max_out, uint16_t signature_algorithm,
+                                           const uint8_t* in, size_t in_len) {
+  return startOperation(ssl, ThreadPoolPrivateKeyMethodProvider::rsaConnectionIndex(),
+                        PrivateKeyOperation::Type::Sign, signature_algorithm, in, in_len, out,
+                        out_len, max_out);
+}
+
+ssl_private_key_result_t rsaPrivateKeyDecrypt(SSL* ssl, uint8_t* out, size_t* out_len,
+                                              size_t max_out, const uint8_t* in, size_t in_len) {
+  return startOperation(ssl, ThreadPoolPrivateKeyMethodProvider::rsaConnectionIndex(),
+                        PrivateKeyOperation::Type::Decrypt, 0, in, in_len, out, out_len, max_out);
+}
+
+ssl_private_key_result_t rsaPrivateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                               size_t max_out) {
+  return completeOperation(ssl, ThreadPoolPrivateKeyMethodProvider::rsaConnectionIndex(), out,
+                           out_len, max_out);
+}
+
+ssl_private_key_result_t ecdsaPrivateKeySign(SSL* ssl, uint8_t* out, size_t* out_len,
+                                             size_t max_out, uint16_t signature_algorithm,
+                                             const uint8_t* in, size_t in_len) {
+  return startOperation(ssl, ThreadPoolPrivateKeyMethodProvider::ecdsaConnectionIndex(),
+                        PrivateKeyOperation::Type::Sign, signature_algorithm, in, in_len, out,
+                        out_len, max_out);
+}
+
+ssl_private_key_result_t ecdsaPrivateKeyDecrypt(SSL*, uint8_t*, size_t*, size_t, const uint8_t*,
+                                                size_t) {
+  // Decryption is only used by the RSA key exchange.
+  return ssl_private_key_failure;
+}
+
+ssl_private_key_result_t ecdsaPrivateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                                 size_t max_out) {
+  return completeOperation(ssl, ThreadPoolPrivateKeyMethodProvider::ecdsaConnectionIndex(), out,
+                           out_len, max_out);
+}
+
+bool sign(EVP_PKEY* pkey, const PrivateKeyOperation& operation, std::vector<uint8_t>& output) {
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(operation.signature_algorithm_);
+  if (md == nullptr) {
+    return false;
+  }
+
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pkey_ctx;
+  if (!EVP_DigestSignInit(ctx.get(), &pkey_ctx, md, nullptr, pkey)) {
+    return false;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(operation.signature_algorithm_) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1 /* salt length is the digest length */))) {
+    return false;
+  }
+
+  size_t out_len = EVP_PKEY_size(pkey);
+  output.resize(out_len);
+  if (!EVP_DigestSign(ctx.get(), output.data(), &out_len, operation.input_.data(),
+                      operation.input_.size())) {
+    return false;
+  }
+  output.resize(out_len);
+  return true;
+}
+
+bool decrypt(EVP_PKEY* pkey, const PrivateKeyOperation& operation, std::vector<uint8_t>& output) {
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey);
+  if (rsa == nullptr) {
+    return false;
+  }
+
+  size_t out_len;
+  output.resize(RSA_size(rsa));
+  if (!RSA_decrypt(rsa, &out_len, output.data(), output.size(), operation.input_.data(),
+                   operation.input_.size(), RSA_NO_PADDING)) {
+    return false;
+  }
+  output.resize(out_len);
+  return true;
+}
+
+} // namespace
+
+void CompletionQueue::complete(PrivateKeyOperationSharedPtr operation) {
+  Thread::LockGuard lock(lock_);
+  if (operation->connection_ == nullptr) {
+    // Nobody is waiting for the operation anymore.
+    return;
+  }
+
+  completed_.push_back(std::move(operation));
+  if (!drain_posted_) {
+    // Posting under the lock guarantees that nothing is posted to the dispatcher once every
+    // connection using it has cancelled its operation.
+    drain_posted_ = true;
+    dispatcher_.post([self = shared_from_this()]() { self->drain(); });
+  }
+}
+
+void CompletionQueue::cancel(PrivateKeyOperation& operation) {
+  Thread::LockGuard lock(lock_);
+  operation.connection_ = nullptr;
+}
+
+void CompletionQueue::drain() {
+  std::vector<PrivateKeyOperationSharedPtr> completed;
+  {
+    Thread::LockGuard lock(lock_);
+    completed.swap(completed_);
+    drain_posted_ = false;
+  }
+
+  for (const auto& operation : completed) {
+    // Completing an operation may destroy another connection of the batch, which cancels the
+    // operation of that connection, so check again before each hand-off.
+    ThreadPoolPrivateKeyConnection* connection;
+    {
+      Thread::LockGuard lock(lock_);
+      connection = operation->connection_;
+    }
+    if (connection != nullptr) {
+      connection->onOperationComplete();
+    }
+  }
+}
+
+ThreadPoolPrivateKeyConnection::ThreadPoolPrivateKeyConnection(
+    ThreadPoolPrivateKeyMethodProvider& provider, Ssl::PrivateKeyConnectionCallbacks& cb,
+    CompletionQueueSharedPtr completion_queue)
+    : provider_(provider), cb_(cb), completion_queue_(std::move(completion_queue)) {}
+
+ThreadPoolPrivateKeyConnection::~ThreadPoolPrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    completion_queue_->cancel(*operation_);
+  }
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::start(
+    PrivateKeyOperation::Type type, uint16_t signature_algorithm, const uint8_t* in,
+    size_t in_len, uint8_t* out, size_t* out_len, size_t max_out) {
+  ASSERT(operation_ == nullptr);
+  auto operation = std::make_shared<PrivateKeyOperation>(type, signature_algorithm, in, in_len);
+  operation->completion_queue_ = completion_queue_;
+  operation->connection_ = this;
+  operation->enqueue_time_ = provider_.timeSource().monotonicTime();
+
+  if (provider_.enqueue(operation)) {
+    operation_ = std::move(operation);
+    finished_ = false;
+    return ssl_private_key_retry;
+  }
+
+  // The pool is saturated, so waiting for it would only add latency to the handshake.
+  provider_.stats().queue_overflow_.inc();
+  provider_.run(*operation);
+  if (!operation->success_ || operation->output_.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(operation->output_.begin(), operation->output_.end(), out);
+  *out_len = operation->output_.size();
+  return ssl_private_key_success;
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                                  size_t max_out) {
+  if (!finished_) {
+    // The operation didn't finish yet, retry.
+    return ssl_private_key_retry;
+  }
+
+  PrivateKeyOperationSharedPtr operation = std::move(operation_);
+  finished_ = false;
+  if (operation == nullptr || !operation->success_ || operation->output_.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(operation->output_.begin(), operation->output_.end(), out);
+  *out_len = operation->output_.size();
+  return ssl_private_key_success;
+}
+
+void ThreadPoolPrivateKeyConnection::onOperationComplete() {
+  ASSERT(operation_ != nullptr);
+  ThreadPoolPrivateKeyProviderStats& stats = provider_.stats();
+  stats.queue_time_us_.recordValue(std::chrono::duration_cast<std::chrono::microseconds>(
+                                       operation_->start_time_ - operation_->enqueue_time_)
+                                       .count());
+  stats.operation_time_us_.recordValue(std::chrono::duration_cast<std::chrono::microseconds>(
+                                           operation_->end_time_ - operation_->start_time_)
+                                           .count());
+  finished_ = true;
+  cb_.onPrivateKeyMethodComplete();
+}
+
+ThreadPoolPrivateKeyMethodProvider::ThreadPoolPrivateKeyMethodProvider(
+    const envoy::config::private_key_provider::thread_pool::v2alpha::
+        ThreadPoolPrivateKeyProviderConfig& config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : time_source_(factory_context.api().timeSource()),
+      stats_({ALL_THREAD_POOL_PRIVATE_KEY_PROVIDER_STATS(
+          POOL_COUNTER_PREFIX(factory_context.statsScope(), "private_key_provider.thread_pool."),
+          POOL_GAUGE_PREFIX(factory_context.statsScope(), "private_key_provider.thread_pool."),
+          POOL_HISTOGRAM_PREFIX(factory_context.statsScope(),
+                                "private_key_provider.thread_pool."))}),
+      max_queued_operations_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_queued_operations,
+                                                             DefaultMaxQueuedOperations)),
+      max_batch_size_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_batch_size, DefaultMaxBatchSize)) {
+  const std::string private_key =
+      Config::DataSource::read(config.private_key(), false, factory_context.api());
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey_ == nullptr) {
+    throw EnvoyException("Failed to load private key for the thread pool private key provider.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  switch (EVP_PKEY_id(pkey_.get())) {
+  case EVP_PKEY_RSA:
+    connection_index_ = rsaConnectionIndex();
+    method_->sign = rsaPrivateKeySign;
+    method_->decrypt = rsaPrivateKeyDecrypt;
+    method_->complete = rsaPrivateKeyComplete;
+    break;
+  case EVP_PKEY_EC:
+    connection_index_ = ecdsaConnectionIndex();
+    method_->sign = ecdsaPrivateKeySign;
+    method_->decrypt = ecdsaPrivateKeyDecrypt;
+    method_->complete = ecdsaPrivateKeyComplete;
+    break;
+  default:
+    throw EnvoyException("Only RSA and ECDSA private keys are supported by the thread pool private "
+                         "key provider.");
+  }
+
+  const uint32_t thread_count =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, thread_count, DefaultThreadCount);
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    threads_.push_back(
+        factory_context.api().threadFactory().createThread([this]() { threadRoutine(); }));
+  }
+}
+
+ThreadPoolPrivateKeyMethodProvider::~ThreadPoolPrivateKeyMethodProvider() {
+  {
+    Thread::LockGuard lock(queue_lock_);
+    shutdown_ = true;
+  }
+  queue_event_.notifyAll();
+  for (auto& thread : threads_) {
+    thread->join();
+  }
+}
+
+void ThreadPoolPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  // RSA and ECDSA keys use different user data indexes, so that a provider of each type can be
+  // registered for the same SSL object in the multi-cert case.
+  if (SSL_get_ex_data(ssl, connection_index_) != nullptr) {
+    throw EnvoyException(
+        "Can't distinguish between two registered providers for the same SSL object.");
+  }
+
+  SSL_set_ex_data(ssl, connection_index_,
+                  new ThreadPoolPrivateKeyConnection(*this, cb, completionQueue(dispatcher)));
+}
+
+void ThreadPoolPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  auto* connection =
+      static_cast<ThreadPoolPrivateKeyConnection*>(SSL_get_ex_data(ssl, connection_index_));
+  SSL_set_ex_data(ssl, connection_index_, nullptr);
+  delete connection;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::checkFips() {
+  if (EVP_PKEY_id(pkey_.get()) == EVP_PKEY_RSA) {
+    RSA* rsa_private_key = EVP_PKEY_get0_RSA(pkey_.get());
+    return rsa_private_key != nullptr && RSA_check_fips(rsa_private_key);
+  }
+  const EC_KEY* ecdsa_private_key = EVP_PKEY_get0_EC_KEY(pkey_.get());
+  return ecdsa_private_key != nullptr && EC_KEY_check_fips(ecdsa_private_key);
+}
+
+Ssl::BoringSslPrivateKeyMethodSharedPtr
+ThreadPoolPrivateKeyMethodProvider::getBoringSslPrivateKeyMethod() {
+  return method_;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::enqueue(PrivateKeyOperationSharedPtr operation) {
+  {
+    Thread::LockGuard lock(queue_lock_);
+    if (queue_.size() >= max_queued_operations_) {
+      return false;
+    }
+    queue_.push_back(std::move(operation));
+    stats_.queue_depth_.set(queue_.size());
+  }
+  stats_.offloaded_.inc();
+  queue_event_.notifyOne();
+  return true;
+}
+
+void ThreadPoolPrivateKeyMethodProvider::run(PrivateKeyOperation& operation) {
+  switch (operation.type_) {
+  case PrivateKeyOperation::Type::Sign:
+    operation.success_ = sign(pkey_.get(), operation, operation.output_);
+    break;
+  case PrivateKeyOperation::Type::Decrypt:
+    operation.success_ = decrypt(pkey_.get(), operation, operation.output_);
+    break;
+  }
+  if (!operation.success_) {
+    stats_.failed_.inc();
+  }
+}
+
+void ThreadPoolPrivateKeyMethodProvider::threadRoutine() {
+  std::vector<PrivateKeyOperationSharedPtr> batch;
+  batch.reserve(max_batch_size_);
+  while (true) {
+    {
+      Thread::LockGuard lock(queue_lock_);
+      while (queue_.empty() && !shutdown_) {
+        queue_event_.wait(queue_lock_);
+      }
+      if (shutdown_) {
+        // Connections keep the provider alive, so nothing is waiting for the operations left.
+        return;
+      }
+      while (!queue_.empty() && batch.size() < max_batch_size_) {
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
+      stats_.queue_depth_.set(queue_.size());
+    }
+
+    for (auto& operation : batch) {
+      operation->start_time_ = time_source_.monotonicTime();
+      run(*operation);
+      operation->end_time_ = time_source_.monotonicTime();
+      CompletionQueueSharedPtr completion_queue = operation->completion_queue_;
+      completion_queue->complete(std::move(operation));
+    }
+    batch.clear();
+  }
+}
+
+CompletionQueueSharedPtr
+ThreadPoolPrivateKeyMethodProvider::completionQueue(Event::Dispatcher& dispatcher) {
+  Thread::LockGuard lock(completion_queues_lock_);
+  std::weak_ptr<CompletionQueue>& weak_completion_queue = completion_queues_[&dispatcher];
+  CompletionQueueSharedPtr completion_queue = weak_completion_queue.lock();
+  if (completion_queue == nullptr) {
+    completion_queue = std::make_shared<CompletionQueue>(dispatcher);
+    weak_completion_queue = completion_queue;
+  }
+  return completion_queue;
+}
+
+int ThreadPoolPrivateKeyMethodProvider::rsaConnectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+int ThreadPoolPrivateKeyMethodProvider::ecdsaConnectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace ThreadPool
+} // namespace PrivateKeyProviders
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/common/time.h"
+#include "envoy/config/private_key_provider/thread_pool/v2alpha/thread_pool.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/server/transport_socket_config.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_callbacks.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread/thread.h"
+
+#include "common/common/thread.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyProviders {
+namespace ThreadPool {
+
+/**
+ * All thread pool private key provider stats. @see stats_macros.h
+ */
+#define ALL_THREAD_POOL_PRIVATE_KEY_PROVIDER_STATS(COUNTER, GAUGE, HISTOGRAM)                      \
+  COUNTER(failed)                                                                                  \
+  COUNTER(offloaded)                                                                               \
+  COUNTER(queue_overflow)                                                                          \
+  GAUGE(queue_depth, NeverImport)                                                                  \
+  HISTOGRAM(operation_time_us, Microseconds)                                                       \
+  HISTOGRAM(queue_time_us, Microseconds)
+
+/**
+ * Struct definition for all thread pool private key provider stats. @see stats_macros.h
+ */
+struct ThreadPoolPrivateKeyProviderStats {
+  ALL_THREAD_POOL_PRIVATE_KEY_PROVIDER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT,
+                                             GENERATE_HISTOGRAM_STRUCT)
+};
+
+class CompletionQueue;
+class ThreadPoolPrivateKeyConnection;
+
+/**
+ * A private key operation. The worker thread fills in the input before queueing the operation and
+ * only reads the output once the operation has been handed back to it.
+ */
+struct PrivateKeyOperation {
+  enum class Type { Sign, Decrypt };
+
+  PrivateKeyOperation(Type type, uint16_t signature_algorithm, const uint8_t* in, size_t in_len)
+      : type_(type), signature_algorithm_(signature_algorithm), input_(in, in + in_len) {}
+
+  const Type type_;
+  const uint16_t signature_algorithm_;
+  const std::vector<uint8_t> input_;
+  std::vector<uint8_t> output_;
+  bool success_{};
+  MonotonicTime enqueue_time_;
+  MonotonicTime start_time_;
+  MonotonicTime end_time_;
+  std::shared_ptr<CompletionQueue> completion_queue_;
+  // The connection waiting for the operation. Only the worker thread writes it, under the lock of
+  // the completion queue, and clears it when the connection goes away before the operation is done.
+  ThreadPoolPrivateKeyConnection* connection_{};
+};
+
+using PrivateKeyOperationSharedPtr = std::shared_ptr<PrivateKeyOperation>;
+
+/**
+ * Hands finished operations back to the worker thread of a dispatcher. The operations finished
+ * while a hand-off is pending are delivered by the same dispatcher event.
+ */
+class CompletionQueue : public std::enable_shared_from_this<CompletionQueue> {
+public:
+  explicit CompletionQueue(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  /**
+   * Called by the pool threads once an operation is done.
+   */
+  void complete(PrivateKeyOperationSharedPtr operation);
+
+  /**
+   * Called by the worker thread when the connection waiting for an operation goes away. The
+   * operation is not handed back once this returns.
+   */
+  void cancel(PrivateKeyOperation& operation);
+
+private:
+  void drain();
+
+  Event::Dispatcher& dispatcher_;
+  Thread::MutexBasicLockable lock_;
+  std::vector<PrivateKeyOperationSharedPtr> completed_ ABSL_GUARDED_BY(lock_);
+  bool drain_posted_ ABSL_GUARDED_BY(lock_){};
+};
+
+using CompletionQueueSharedPtr = std::shared_ptr<CompletionQueue>;
+
+class ThreadPoolPrivateKeyMethodProvider;
+
+/**
+ * Per SSL object state, stored in the SSL user data.
+ */
+class ThreadPoolPrivateKeyConnection {
+public:
+  ThreadPoolPrivateKeyConnection(ThreadPoolPrivateKeyMethodProvider& provider,
+                                 Ssl::PrivateKeyConnectionCallbacks& cb,
+                                 CompletionQueueSharedPtr completion_queue);
+  ~ThreadPoolPrivateKeyConnection();
+
+  ssl_private_key_result_t start(PrivateKeyOperation::Type type, uint16_t signature_algorithm,
+                                 const uint8_t* in, size_t in_len, uint8_t* out, size_t* out_len,
+                                 size_t max_out);
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+  void onOperationComplete();
+
+private:
+  ThreadPoolPrivateKeyMethodProvider& provider_;
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  const CompletionQueueSharedPtr completion_queue_;
+  // The operation in progress, if any.
+  PrivateKeyOperationSharedPtr operation_;
+  // The complete callback can return other value than "retry" only after the operation has been
+  // handed back to the worker thread.
+  bool finished_{};
+};
+
+/**
+ * Private key method provider running the private key operations on a pool of threads. Each
+ * thread takes a batch of operations off a shared queue, and the results are handed back to the
+ * dispatcher of the connection that started them.
+ */
+class ThreadPoolPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider {
+public:
+  ThreadPoolPrivateKeyMethodProvider(
+      const envoy::config::private_key_provider::thread_pool::v2alpha::
+          ThreadPoolPrivateKeyProviderConfig& config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context);
+  ~ThreadPoolPrivateKeyMethodProvider() override;
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override;
+
+  /**
+   * Queue an operation for the pool.
+   * @return false if the queue is full, in which case the operation is not queued.
+   */
+  bool enqueue(PrivateKeyOperationSharedPtr operation);
+
+  /**
+   * Run an operation on the calling thread, setting its output and success flag.
+   */
+  void run(PrivateKeyOperation& operation);
+
+  ThreadPoolPrivateKeyProviderStats& stats() { return stats_; }
+  TimeSource& timeSource() { return time_source_; }
+
+  static int rsaConnectionIndex();
+  static int ecdsaConnectionIndex();
+
+private:
+  CompletionQueueSharedPtr completionQueue(Event::Dispatcher& dispatcher);
+  void threadRoutine();
+
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  int connection_index_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  TimeSource& time_source_;
+  ThreadPoolPrivateKeyProviderStats stats_;
+  const uint32_t max_queued_operations_;
+  const uint32_t max_batch_size_;
+
+  Thread::MutexBasicLockable queue_lock_;
+  Thread::CondVar queue_event_;
+  std::deque<PrivateKeyOperationSharedPtr> queue_ ABSL_GUARDED_BY(queue_lock_);
+  bool shutdown_ ABSL_GUARDED_BY(queue_lock_){};
+
+  Thread::MutexBasicLockable completion_queues_lock_;
+  absl::flat_hash_map<Event::Dispatcher*, std::weak_ptr<CompletionQueue>>
+      completion_queues_ ABSL_GUARDED_BY(completion_queues_lock_);
+
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyProviders
+} // namespace Extensions
+} // namespace Envoy
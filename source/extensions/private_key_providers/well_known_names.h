@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "common/singleton/const_singleton.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyProviders {
+
+/**
+ * Well-known private key provider names.
+ * NOTE: New private key providers should use the well known name: envoy.tls.key_providers.name.
+ */
+class PrivateKeyProviderNameValues {
+public:
+  // Private key operations offloaded to a thread pool.
+  const std::string ThreadPool = "envoy.tls.key_providers.thread_pool";
+};
+
+using PrivateKeyProviderNames = ConstSingleton<PrivateKeyProviderNameValues>;
+
+} // namespace PrivateKeyProviders
+} // namespace Extensions
+} // namespace Envoy
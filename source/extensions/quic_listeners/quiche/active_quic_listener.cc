@@ -26,7 +26,8 @@ ActiveQuicListener::ActiveQuicListener(Event::Dispatcher& dispatcher,
     : Server::ConnectionHandlerImpl::ActiveListenerImplBase(parent, listener_config),
       dispatcher_(dispatcher), version_manager_(quic::CurrentSupportedVersions()),
       listen_socket_(*listen_socket) {
-  udp_listener_ = dispatcher_.createUdpListener(std::move(listen_socket), *this);
+  udp_listener_ = dispatcher_.createUdpListener(std::move(listen_socket), *this,
+                                                Network::UdpReadOptions());
   quic::QuicRandom* const random = quic::QuicRandom::GetInstance();
   random->RandBytes(random_seed_, sizeof(random_seed_));
   crypto_config_ = std::make_unique<quic::QuicCryptoServerConfig>(
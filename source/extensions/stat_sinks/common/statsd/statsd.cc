@@ -1,5 +1,6 @@
 #include "extensions/stat_sinks/common/statsd/statsd.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <string>
@@ -17,7 +18,7 @@
 #include "common/config/utility.h"
 #include "common/stats/symbol_table_impl.h"
 
-#include "absl/strings/str_join.h"
+#include "absl/strings/str_cat.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -26,10 +27,11 @@ namespace Common {
 namespace Statsd {
 
 Writer::Writer(Network::Address::InstanceConstSharedPtr address)
-    : io_handle_(address->socket(Network::Address::SocketType::Datagram)) {
+    : address_(std::move(address)),
+      io_handle_(address_->socket(Network::Address::SocketType::Datagram)) {
   ASSERT(io_handle_->fd() != -1);
 
-  const Api::SysCallIntResult result = address->connect(io_handle_->fd());
+  const Api::SysCallIntResult result = address_->connect(io_handle_->fd());
   ASSERT(result.rc_ != -1);
 }
 
@@ -43,31 +45,104 @@ void Writer::write(const std::string& message) {
   ::send(io_handle_->fd(), message.c_str(), message.size(), MSG_DONTWAIT);
 }
 
+void Writer::writeBatch(const std::vector<absl::string_view>& datagrams) {
+  if (datagrams.size() == 1 || !io_handle_->supportsMmsg()) {
+    for (const absl::string_view datagram : datagrams) {
+      ::send(io_handle_->fd(), datagram.data(), datagram.size(), MSG_DONTWAIT);
+    }
+    return;
+  }
+
+  std::vector<Buffer::RawSlice> slices(datagrams.size());
+  std::vector<Network::IoHandle::SendMsgEntry> messages(datagrams.size());
+  for (size_t i = 0; i < datagrams.size(); i++) {
+    slices[i].mem_ = const_cast<char*>(datagrams[i].data());
+    slices[i].len_ = datagrams[i].size();
+    messages[i] = {&slices[i], 1, nullptr, address_.get()};
+  }
+  for (uint64_t sent = 0; sent < messages.size();) {
+    const uint64_t num_messages =
+        std::min<uint64_t>(messages.size() - sent, MAX_DATAGRAMS_PER_SEND);
+    const Api::IoCallUint64Result result = io_handle_->sendmmsg(&messages[sent], num_messages);
+    if (!result.ok() || result.rc_ == 0) {
+      // Like write(), don't wait for the send buffer to drain. The rest of this flush is dropped.
+      return;
+    }
+    sent += result.rc_;
+  }
+}
+
+void UdpStatsdSink::DatagramBatch::beginLine() {
+  line_start_ = buffer_.size();
+  if (line_start_ > datagram_start_) {
+    buffer_.push_back('\n');
+  }
+}
+
+void UdpStatsdSink::DatagramBatch::endLine() {
+  // A line that doesn't fit in the datagram being filled starts the next one. The separator in
+  // front of it is then left out of both datagrams.
+  if (line_start_ > datagram_start_ && buffer_.size() - datagram_start_ > max_bytes_per_datagram_) {
+    ranges_.emplace_back(datagram_start_, line_start_);
+    datagram_start_ = line_start_ + 1;
+  }
+}
+
+const std::vector<absl::string_view>& UdpStatsdSink::DatagramBatch::datagrams() {
+  if (buffer_.size() > datagram_start_) {
+    ranges_.emplace_back(datagram_start_, buffer_.size());
+    datagram_start_ = buffer_.size();
+  }
+  // The views are built last since appending to buffer_ may move its contents.
+  datagrams_.clear();
+  for (const auto& range : ranges_) {
+    datagrams_.emplace_back(buffer_.data() + range.first, range.second - range.first);
+  }
+  return datagrams_;
+}
+
+void UdpStatsdSink::DatagramBatch::clear() {
+  // clear() keeps the capacity of the containers, so steady state flushes don't allocate.
+  buffer_.clear();
+  ranges_.clear();
+  datagrams_.clear();
+  datagram_start_ = 0;
+  line_start_ = 0;
+}
+
 UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
                              Network::Address::InstanceConstSharedPtr address, const bool use_tag,
-                             const std::string& prefix)
+                             const std::string& prefix, uint64_t max_bytes_per_datagram)
     : tls_(tls.allocateSlot()), server_address_(std::move(address)), use_tag_(use_tag),
-      prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix) {
+      prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
+      max_bytes_per_datagram_(max_bytes_per_datagram), batch_(max_bytes_per_datagram) {
   tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
     return std::make_shared<Writer>(this->server_address_);
   });
 }
 
 void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
-  Writer& writer = tls_->getTyped<Writer>();
+  batch_.clear();
   for (const auto& counter : snapshot.counters()) {
     if (counter.counter_.get().used()) {
-      writer.write(fmt::format("{}.{}:{}|c{}", prefix_, getName(counter.counter_.get()),
-                               counter.delta_, buildTagStr(counter.counter_.get().tags())));
+      batch_.beginLine();
+      appendMetric(batch_.buffer(), counter.counter_.get(), counter.delta_, "|c");
+      batch_.endLine();
     }
   }
 
   for (const auto& gauge : snapshot.gauges()) {
     if (gauge.get().used()) {
-      writer.write(fmt::format("{}.{}:{}|g{}", prefix_, getName(gauge.get()), gauge.get().value(),
-                               buildTagStr(gauge.get().tags())));
+      batch_.beginLine();
+      appendMetric(batch_.buffer(), gauge.get(), gauge.get().value(), "|g");
+      batch_.endLine();
     }
   }
+
+  const std::vector<absl::string_view>& datagrams = batch_.datagrams();
+  if (!datagrams.empty()) {
+    tls_->getTyped<Writer>().writeBatch(datagrams);
+  }
 }
 
 void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) {
@@ -77,12 +152,26 @@ void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint6
   // are timers but record in units other than milliseconds, it may make sense to scale the value to
   // milliseconds here and potentially suffix the names accordingly (minus the pre-existing ones for
   // backwards compatibility).
-  const std::string message(fmt::format("{}.{}:{}|ms{}", prefix_, getName(histogram),
-                                        std::chrono::milliseconds(value).count(),
-                                        buildTagStr(histogram.tags())));
+  std::string message;
+  appendMetric(message, histogram, std::chrono::milliseconds(value).count(), "|ms");
   tls_->getTyped<Writer>().write(message);
 }
 
+void UdpStatsdSink::appendMetric(std::string& buffer, const Stats::Metric& metric,
+                                 uint64_t value, absl::string_view stat_type) {
+  // Produces something like "envoy.{}:{}|c|#{}:{},{}:{}". This runs for every used counter and
+  // gauge on each flush, so it appends the pieces in place instead of formatting substrings.
+  absl::StrAppend(&buffer, prefix_, ".", getName(metric), ":", value, stat_type);
+  if (!use_tag_) {
+    return;
+  }
+  bool first = true;
+  for (const Stats::Tag& tag : metric.tags()) {
+    absl::StrAppend(&buffer, first ? "|#" : ",", tag.name_, ":", tag.value_);
+    first = false;
+  }
+}
+
 const std::string UdpStatsdSink::getName(const Stats::Metric& metric) {
   if (use_tag_) {
     return metric.tagExtractedName();
@@ -91,19 +180,6 @@ const std::string UdpStatsdSink::getName(const Stats::Metric& metric) {
   }
 }
 
-const std::string UdpStatsdSink::buildTagStr(const std::vector<Stats::Tag>& tags) {
-  if (!use_tag_ || tags.empty()) {
-    return "";
-  }
-
-  std::vector<std::string> tag_strings;
-  tag_strings.reserve(tags.size());
-  for (const Stats::Tag& tag : tags) {
-    tag_strings.emplace_back(tag.name_ + ":" + tag.value_);
-  }
-  return "|#" + absl::StrJoin(tag_strings, ",");
-}
-
 TcpStatsdSink::TcpStatsdSink(const LocalInfo::LocalInfo& local_info,
                              const std::string& cluster_name, ThreadLocal::SlotAllocator& tls,
                              Upstream::ClusterManager& cluster_manager, Stats::Scope& scope,
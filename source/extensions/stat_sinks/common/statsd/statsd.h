@@ -15,6 +15,8 @@
 #include "common/common/macros.h"
 #include "common/network/io_socket_handle_impl.h"
 
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace StatSinks {
@@ -34,10 +36,19 @@ public:
   ~Writer() override;
 
   virtual void write(const std::string& message);
+  /**
+   * Sends each of the datagrams in order, using as few system calls as the platform allows.
+   * Datagrams that don't fit in the socket send buffer are dropped, as with write().
+   */
+  virtual void writeBatch(const std::vector<absl::string_view>& datagrams);
   // Called in unit test to validate address.
   int getFdForTests() const { return io_handle_->fd(); }
 
 private:
+  // Bounds the stack space used by a single sendmmsg() call.
+  static constexpr uint64_t MAX_DATAGRAMS_PER_SEND = 64;
+
+  Network::Address::InstanceConstSharedPtr address_;
   Network::IoHandlePtr io_handle_;
 };
 
@@ -47,12 +58,15 @@ private:
 class UdpStatsdSink : public Stats::Sink {
 public:
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Network::Address::InstanceConstSharedPtr address,
-                const bool use_tag, const std::string& prefix = getDefaultPrefix());
+                const bool use_tag, const std::string& prefix = getDefaultPrefix(),
+                uint64_t max_bytes_per_datagram = 0);
   // For testing.
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, const std::shared_ptr<Writer>& writer,
-                const bool use_tag, const std::string& prefix = getDefaultPrefix())
+                const bool use_tag, const std::string& prefix = getDefaultPrefix(),
+                uint64_t max_bytes_per_datagram = 0)
       : tls_(tls.allocateSlot()), use_tag_(use_tag),
-        prefix_(prefix.empty() ? getDefaultPrefix() : prefix) {
+        prefix_(prefix.empty() ? getDefaultPrefix() : prefix),
+        max_bytes_per_datagram_(max_bytes_per_datagram), batch_(max_bytes_per_datagram) {
     tls_->set(
         [writer](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr { return writer; });
   }
@@ -65,16 +79,57 @@ public:
   int getFdForTests() { return tls_->getTyped<Writer>().getFdForTests(); }
   bool getUseTagForTest() { return use_tag_; }
   const std::string& getPrefix() { return prefix_; }
+  uint64_t getMaxBytesPerDatagramForTest() { return max_bytes_per_datagram_; }
 
 private:
+  /**
+   * Packs the metric lines of a flush into datagrams. Lines are formatted directly into a buffer
+   * that is reused across flushes, and a datagram is closed whenever the next line would push it
+   * past the size limit.
+   */
+  class DatagramBatch {
+  public:
+    DatagramBatch(uint64_t max_bytes_per_datagram)
+        : max_bytes_per_datagram_(max_bytes_per_datagram) {}
+
+    /**
+     * Starts a new line, separating it from the previous one if they share a datagram. The caller
+     * appends the line to buffer() and then calls endLine().
+     */
+    void beginLine();
+    void endLine();
+    std::string& buffer() { return buffer_; }
+    /**
+     * @return views of the packed datagrams. They are valid until the next call to clear().
+     */
+    const std::vector<absl::string_view>& datagrams();
+    void clear();
+
+  private:
+    const uint64_t max_bytes_per_datagram_;
+    std::string buffer_;
+    // Offset in buffer_ of the first byte of the datagram being filled.
+    uint64_t datagram_start_{};
+    // Offset in buffer_ of the first byte of the line being formatted.
+    uint64_t line_start_{};
+    // [start, end) offsets in buffer_ of every closed datagram.
+    std::vector<std::pair<uint64_t, uint64_t>> ranges_;
+    std::vector<absl::string_view> datagrams_;
+  };
+
+  void appendMetric(std::string& buffer, const Stats::Metric& metric, uint64_t value,
+                    absl::string_view stat_type);
   const std::string getName(const Stats::Metric& metric);
-  const std::string buildTagStr(const std::vector<Stats::Tag>& tags);
 
   ThreadLocal::SlotPtr tls_;
   Network::Address::InstanceConstSharedPtr server_address_;
   const bool use_tag_;
   // Prefix for all flushed stats.
   const std::string prefix_;
+  // Zero sends every metric in its own datagram.
+  const uint64_t max_bytes_per_datagram_;
+  // Flushes only happen on the main thread, so a single batch is reused by every flush.
+  DatagramBatch batch_;
 };
 
 /**
@@ -7,6 +7,7 @@
 #include "envoy/registry/registry.h"
 
 #include "common/network/resolver_impl.h"
+#include "common/protobuf/utility.h"
 
 #include "extensions/stat_sinks/common/statsd/statsd.h"
 #include "extensions/stat_sinks/well_known_names.h"
@@ -24,8 +25,9 @@ Stats::SinkPtr DogStatsdSinkFactory::createStatsSink(const Protobuf::Message& co
   Network::Address::InstanceConstSharedPtr address =
       Network::Address::resolveProtoAddress(sink_config.address());
   ENVOY_LOG(debug, "dog_statsd UDP ip address: {}", address->asString());
-  return std::make_unique<Common::Statsd::UdpStatsdSink>(server.threadLocal(), std::move(address),
-                                                         true, sink_config.prefix());
+  return std::make_unique<Common::Statsd::UdpStatsdSink>(
+      server.threadLocal(), std::move(address), true, sink_config.prefix(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, max_bytes_per_datagram, 0));
 }
 
 ProtobufTypes::MessagePtr DogStatsdSinkFactory::createEmptyConfigProto() {
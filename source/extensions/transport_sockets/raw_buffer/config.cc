@@ -1,25 +1,59 @@
 #include "extensions/transport_sockets/raw_buffer/config.h"
 
+#include "envoy/config/transport_socket/raw_buffer/v2alpha/raw_buffer.pb.h"
+#include "envoy/config/transport_socket/raw_buffer/v2alpha/raw_buffer.pb.validate.h"
+
 #include "common/network/raw_buffer_socket.h"
+#include "common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace TransportSockets {
 namespace RawBuffer {
 
+namespace {
+
+Network::TransportSocketFactoryPtr
+createRawBufferSocketFactory(const Protobuf::Message& message,
+                             Server::Configuration::TransportSocketFactoryContext& context) {
+  const auto& config = MessageUtil::downcastAndValidate<
+      const envoy::config::transport_socket::raw_buffer::v2alpha::RawBuffer&>(
+      message, context.messageValidationVisitor());
+  if (!config.has_adaptive_read_size()) {
+    return std::make_unique<Network::RawBufferSocketFactory>();
+  }
+
+  const auto& adaptive = config.adaptive_read_size();
+  const uint64_t min_read_size = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+      adaptive, min_read_size, Network::AdaptiveReadSizeConfig::DefaultMinReadSize);
+  const uint64_t max_read_size = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+      adaptive, max_read_size, Network::AdaptiveReadSizeConfig::DefaultMaxReadSize);
+  if (min_read_size > max_read_size) {
+    throw EnvoyException(fmt::format("raw_buffer: min_read_size ({}) is greater than "
+                                     "max_read_size ({})",
+                                     min_read_size, max_read_size));
+  }
+  return std::make_unique<Network::RawBufferSocketFactory>(
+      std::make_shared<Network::AdaptiveReadSizeConfig>(
+          min_read_size, max_read_size, adaptive.use_pending_bytes(), context.statsScope()));
+}
+
+} // namespace
+
 Network::TransportSocketFactoryPtr UpstreamRawBufferSocketFactory::createTransportSocketFactory(
-    const Protobuf::Message&, Server::Configuration::TransportSocketFactoryContext&) {
-  return std::make_unique<Network::RawBufferSocketFactory>();
+    const Protobuf::Message& message,
+    Server::Configuration::TransportSocketFactoryContext& context) {
+  return createRawBufferSocketFactory(message, context);
 }
 
 Network::TransportSocketFactoryPtr DownstreamRawBufferSocketFactory::createTransportSocketFactory(
-    const Protobuf::Message&, Server::Configuration::TransportSocketFactoryContext&,
+    const Protobuf::Message& message, Server::Configuration::TransportSocketFactoryContext& context,
     const std::vector<std::string>&) {
-  return std::make_unique<Network::RawBufferSocketFactory>();
+  return createRawBufferSocketFactory(message, context);
 }
 
 ProtobufTypes::MessagePtr RawBufferSocketFactory::createEmptyConfigProto() {
-  return std::make_unique<ProtobufWkt::Empty>();
+  return std::make_unique<envoy::config::transport_socket::raw_buffer::v2alpha::RawBuffer>();
 }
 
 REGISTER_FACTORY(UpstreamRawBufferSocketFactory,
@@ -363,6 +363,7 @@ ServerContextConfigImpl::ServerContextConfigImpl(
                         DEFAULT_CIPHER_SUITES, DEFAULT_CURVES, factory_context),
       require_client_certificate_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, require_client_certificate, false)),
+      share_session_cache_(config.share_session_cache()),
       session_ticket_keys_provider_(
           getTlsSessionTicketKeysConfigProvider(factory_context, config)) {
   if (session_ticket_keys_provider_ != nullptr) {
@@ -134,6 +134,7 @@ public:
   const std::vector<SessionTicketKey>& sessionTicketKeys() const override {
     return session_ticket_keys_;
   }
+  bool shareSessionCache() const override { return share_session_cache_; }
 
   bool isReady() const override {
     const bool parent_is_ready = ContextConfigImpl::isReady();
@@ -151,6 +152,7 @@ private:
   static const std::string DEFAULT_CURVES;
 
   const bool require_client_certificate_;
+  const bool share_session_cache_;
   std::vector<SessionTicketKey> session_ticket_keys_;
   const Secret::TlsSessionTicketKeysConfigProviderSharedPtr session_ticket_keys_provider_;
   Common::CallbackHandle* stk_update_callback_handle_{};
@@ -748,11 +748,13 @@ Envoy::Ssl::CertificateDetailsPtr ContextImpl::certificateDetails(X509* cert,
 
 ClientContextImpl::ClientContextImpl(Stats::Scope& scope,
                                      const Envoy::Ssl::ClientContextConfig& config,
-                                     TimeSource& time_source)
+                                     TimeSource& time_source,
+                                     Envoy::Ssl::SessionCacheSharedPtr session_cache)
     : ContextImpl(scope, config, time_source),
       server_name_indication_(config.serverNameIndication()),
       allow_renegotiation_(config.allowRenegotiation()),
-      max_session_keys_(config.maxSessionKeys()) {
+      max_session_keys_(config.maxSessionKeys()), session_cache_(std::move(session_cache)),
+      session_cache_key_prefix_(generateSessionCacheKeyPrefix(config)) {
   // This should be guaranteed during configuration ingestion for client contexts.
   ASSERT(tls_contexts_.size() == 1);
   if (!parsed_alpn_protocols_.empty()) {
@@ -781,7 +783,7 @@ ClientContextImpl::ClientContextImpl(Stats::Scope& scope,
               static_cast<ContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
           ClientContextImpl* client_context_impl = dynamic_cast<ClientContextImpl*>(context_impl);
           RELEASE_ASSERT(client_context_impl != nullptr, ""); // for Coverity
-          return client_context_impl->newSessionKey(session);
+          return client_context_impl->newSessionKey(ssl, session);
         });
   }
 }
@@ -818,27 +820,31 @@ bssl::UniquePtr<SSL> ClientContextImpl::newSsl(const Network::TransportSocketOpt
   }
 
   if (max_session_keys_ > 0) {
-    if (session_keys_single_use_) {
-      // Stored single-use session keys, use write/write locks.
-      absl::WriterMutexLock l(&session_keys_mu_);
-      if (!session_keys_.empty()) {
-        // Use the most recently stored session key, since it has the highest
-        // probability of still being recognized/accepted by the server.
-        SSL_SESSION* session = session_keys_.front().get();
-        SSL_set_session(ssl_con.get(), session);
-        // Remove single-use session key (TLS 1.3) after first use.
-        if (SSL_SESSION_should_be_single_use(session)) {
-          session_keys_.pop_front();
-        }
-      }
-    } else {
-      // Never stored single-use session keys, use read/write locks.
+    bool session_set = false;
+    {
+      // Only multi-use session keys are stored here, so they can be shared by concurrent
+      // connections under a reader lock.
       absl::ReaderMutexLock l(&session_keys_mu_);
       if (!session_keys_.empty()) {
         // Use the most recently stored session key, since it has the highest
         // probability of still being recognized/accepted by the server.
         SSL_SESSION* session = session_keys_.front().get();
         SSL_set_session(ssl_con.get(), session);
+        session_set = true;
+      }
+    }
+
+    if (!session_set) {
+      // Nothing negotiated by this context yet, e.g. right after a secret update replaced the
+      // previous context, or the session keys are single-use (TLS 1.3). Fall back to the sessions
+      // shared by all the contexts, which removes a single-use session key once it is handed out.
+      bssl::UniquePtr<SSL_SESSION> session =
+          session_cache_->lookup(sessionCacheKey(server_name_indication, options));
+      if (session != nullptr) {
+        stats_.session_cache_hit_.inc();
+        SSL_set_session(ssl_con.get(), session.get());
+      } else {
+        stats_.session_cache_miss_.inc();
       }
     }
   }
@@ -846,12 +852,88 @@ bssl::UniquePtr<SSL> ClientContextImpl::newSsl(const Network::TransportSocketOpt
   return ssl_con;
 }
 
-int ClientContextImpl::newSessionKey(SSL_SESSION* session) {
-  // In case we ever store single-use session key (TLS 1.3),
-  // we need to switch to using write/write locks.
+std::string
+ClientContextImpl::generateSessionCacheKeyPrefix(const Envoy::Ssl::ClientContextConfig& config) {
+  EVP_MD_CTX md;
+  int rc = EVP_DigestInit(&md, EVP_sha256());
+  RELEASE_ASSERT(rc == 1, "");
+
+  // Hash all the settings that the upstream certificate is validated against, so that a session
+  // established with a context that accepts an upstream is never resumed by a context that would
+  // have rejected it.
+  const Envoy::Ssl::CertificateValidationContextConfig* validation_context =
+      config.certificateValidationContext();
+  if (validation_context != nullptr) {
+    for (const std::string* value :
+         {&validation_context->caCert(), &validation_context->certificateRevocationList()}) {
+      rc = EVP_DigestUpdate(&md, value->data(), value->size());
+      RELEASE_ASSERT(rc == 1, "");
+    }
+    const uint8_t allow_expired_certificate = validation_context->allowExpiredCertificate();
+    rc = EVP_DigestUpdate(&md, &allow_expired_certificate, sizeof(allow_expired_certificate));
+    RELEASE_ASSERT(rc == 1, "");
+  }
+
+  for (const std::string& name : verify_subject_alt_name_list_) {
+    rc = EVP_DigestUpdate(&md, name.data(), name.size());
+    RELEASE_ASSERT(rc == 1, "");
+  }
+
+  for (const auto* hashes : {&verify_certificate_hash_list_, &verify_certificate_spki_list_}) {
+    for (const auto& hash : *hashes) {
+      rc = EVP_DigestUpdate(&md, hash.data(), hash.size());
+      RELEASE_ASSERT(rc == 1, "");
+    }
+  }
+
+  // Hash the client certificate as well, so that a session is only resumed with the identity it
+  // was established with.
+  uint8_t digest[EVP_MAX_MD_SIZE];
+  unsigned digest_len = 0;
+  if (tls_contexts_[0].cert_chain_ != nullptr) {
+    rc = X509_digest(tls_contexts_[0].cert_chain_.get(), EVP_sha256(), digest, &digest_len);
+    RELEASE_ASSERT(rc == 1 && digest_len == SHA256_DIGEST_LENGTH, "");
+    rc = EVP_DigestUpdate(&md, digest, digest_len);
+    RELEASE_ASSERT(rc == 1, "");
+  }
+
+  rc = EVP_DigestFinal(&md, digest, &digest_len);
+  RELEASE_ASSERT(rc == 1, "");
+  return absl::StrCat("client:", Hex::encode(digest, digest_len), ":");
+}
+
+std::string
+ClientContextImpl::sessionCacheKey(absl::string_view server_name_indication,
+                                   const Network::TransportSocketOptions* options) const {
+  std::string key = absl::StrCat(session_cache_key_prefix_, server_name_indication.size(), ":",
+                                 server_name_indication);
+  if (options != nullptr) {
+    // Sessions are resumed without validating the upstream certificate again.
+    for (const std::string& name : options->verifySubjectAltNameListOverride()) {
+      absl::StrAppend(&key, ":", name.size(), ":", name);
+    }
+  }
+  return key;
+}
+
+int ClientContextImpl::newSessionKey(SSL* ssl, SSL_SESSION* session) {
+  // Share the session with the other contexts, under the same key as newSsl() looks it up with.
+  const char* server_name_indication = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+  const auto* options = static_cast<const Network::TransportSocketOptions*>(SSL_get_app_data(ssl));
+  const std::string key =
+      sessionCacheKey(server_name_indication != nullptr ? server_name_indication : "", options);
+
+  // Single-use session keys (TLS 1.3) are only stored in the shared cache, which removes them on
+  // lookup. A second copy here could be used once by this context and once more by newSsl()
+  // falling back to the shared cache, or by another context.
   if (SSL_SESSION_should_be_single_use(session)) {
-    session_keys_single_use_ = true;
+    session_cache_->insert(key, bssl::UniquePtr<SSL_SESSION>(session));
+    return 1; // Tell BoringSSL that we took ownership of the session.
   }
+
+  SSL_SESSION_up_ref(session);
+  session_cache_->insert(key, bssl::UniquePtr<SSL_SESSION>(session));
+
   absl::WriterMutexLock l(&session_keys_mu_);
   // Evict oldest entries.
   while (session_keys_.size() >= max_session_keys_) {
@@ -876,8 +958,10 @@ uint16_t ClientContextImpl::parseSigningAlgorithmsForTest(const std::string& sig
 ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
                                      const Envoy::Ssl::ServerContextConfig& config,
                                      const std::vector<std::string>& server_names,
-                                     TimeSource& time_source)
-    : ContextImpl(scope, config, time_source), session_ticket_keys_(config.sessionTicketKeys()) {
+                                     TimeSource& time_source,
+                                     Envoy::Ssl::SessionCacheSharedPtr session_cache)
+    : ContextImpl(scope, config, time_source), session_ticket_keys_(config.sessionTicketKeys()),
+      session_cache_(std::move(session_cache)) {
   if (config.tlsCertificates().empty()) {
     throw EnvoyException("Server TlsCertificates must have a certificate specified");
   }
@@ -897,6 +981,8 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
   uint8_t session_context_buf[EVP_MAX_MD_SIZE] = {};
   unsigned session_context_len = 0;
   generateHashForSessionContexId(server_names, session_context_buf, session_context_len);
+  session_cache_key_prefix_ =
+      absl::StrCat("server:", Hex::encode(session_context_buf, session_context_len), ":");
   for (auto& ctx : tls_contexts_) {
     if (config.certificateValidationContext() != nullptr &&
         !config.certificateValidationContext()->caCert().empty()) {
@@ -928,12 +1014,61 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
           });
     }
 
+    if (config.shareSessionCache()) {
+      // Keep the sessions in the shared cache only. They are keyed by session ID context, so they
+      // are only resumed by contexts that would have accepted the same client.
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(),
+                                     SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+            ->newSession(session);
+      });
+      SSL_CTX_sess_set_get_cb(
+          ctx.ssl_ctx_.get(),
+          [](SSL* ssl, const uint8_t* id, int id_len, int* out_copy) -> SSL_SESSION* {
+            // The returned reference is handed over to BoringSSL.
+            *out_copy = 0;
+            return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+                ->getSession(id, id_len);
+          });
+      SSL_CTX_sess_set_remove_cb(ctx.ssl_ctx_.get(), [](SSL_CTX* ssl_ctx, SSL_SESSION* session) {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(ssl_ctx))->removeSession(session);
+      });
+    }
+
     int rc = SSL_CTX_set_session_id_context(ctx.ssl_ctx_.get(), session_context_buf,
                                             session_context_len);
     RELEASE_ASSERT(rc == 1, "");
   }
 }
 
+std::string ServerContextImpl::sessionCacheKey(const uint8_t* id, size_t id_len) const {
+  return absl::StrCat(session_cache_key_prefix_, Hex::encode(id, id_len));
+}
+
+int ServerContextImpl::newSession(SSL_SESSION* session) {
+  unsigned id_len = 0;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_len);
+  session_cache_->insert(sessionCacheKey(id, id_len), bssl::UniquePtr<SSL_SESSION>(session));
+  return 1; // Tell BoringSSL that we took ownership of the session.
+}
+
+SSL_SESSION* ServerContextImpl::getSession(const uint8_t* id, int id_len) {
+  bssl::UniquePtr<SSL_SESSION> session = session_cache_->lookup(sessionCacheKey(id, id_len));
+  if (session == nullptr) {
+    stats_.session_cache_miss_.inc();
+    return nullptr;
+  }
+  stats_.session_cache_hit_.inc();
+  return session.release();
+}
+
+void ServerContextImpl::removeSession(SSL_SESSION* session) {
+  unsigned id_len = 0;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_len);
+  session_cache_->remove(sessionCacheKey(id, id_len));
+}
+
 void ServerContextImpl::generateHashForSessionContexId(const std::vector<std::string>& server_names,
                                                        uint8_t* session_context_buf,
                                                        unsigned& session_context_len) {
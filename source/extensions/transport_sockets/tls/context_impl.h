@@ -9,6 +9,7 @@
 #include "envoy/ssl/context.h"
 #include "envoy/ssl/context_config.h"
 #include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/session_cache.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats_macros.h"
 
@@ -33,6 +34,8 @@ namespace Tls {
   COUNTER(connection_error)                                                                        \
   COUNTER(handshake)                                                                               \
   COUNTER(session_reused)                                                                          \
+  COUNTER(session_cache_hit)                                                                       \
+  COUNTER(session_cache_miss)                                                                      \
   COUNTER(no_certificate)                                                                          \
   COUNTER(fail_verify_no_cert)                                                                     \
   COUNTER(fail_verify_error)                                                                       \
@@ -185,26 +188,34 @@ using ContextImplSharedPtr = std::shared_ptr<ContextImpl>;
 class ClientContextImpl : public ContextImpl, public Envoy::Ssl::ClientContext {
 public:
   ClientContextImpl(Stats::Scope& scope, const Envoy::Ssl::ClientContextConfig& config,
-                    TimeSource& time_source);
+                    TimeSource& time_source, Envoy::Ssl::SessionCacheSharedPtr session_cache);
 
   bssl::UniquePtr<SSL> newSsl(const Network::TransportSocketOptions* options) override;
 
 private:
-  int newSessionKey(SSL_SESSION* session);
+  int newSessionKey(SSL* ssl, SSL_SESSION* session);
   uint16_t parseSigningAlgorithmsForTest(const std::string& sigalgs);
+  // Computes the hash of the settings that a session has been validated against, so that sessions
+  // are only shared between contexts validating the upstream the same way.
+  std::string generateSessionCacheKeyPrefix(const Envoy::Ssl::ClientContextConfig& config);
+  std::string sessionCacheKey(absl::string_view server_name_indication,
+                              const Network::TransportSocketOptions* options) const;
 
   const std::string server_name_indication_;
   const bool allow_renegotiation_;
   const size_t max_session_keys_;
+  const Envoy::Ssl::SessionCacheSharedPtr session_cache_;
+  const std::string session_cache_key_prefix_;
   absl::Mutex session_keys_mu_;
+  // Multi-use session keys negotiated by this context. Single-use ones are only in session_cache_.
   std::deque<bssl::UniquePtr<SSL_SESSION>> session_keys_ ABSL_GUARDED_BY(session_keys_mu_);
-  bool session_keys_single_use_{false};
 };
 
 class ServerContextImpl : public ContextImpl, public Envoy::Ssl::ServerContext {
 public:
   ServerContextImpl(Stats::Scope& scope, const Envoy::Ssl::ServerContextConfig& config,
-                    const std::vector<std::string>& server_names, TimeSource& time_source);
+                    const std::vector<std::string>& server_names, TimeSource& time_source,
+                    Envoy::Ssl::SessionCacheSharedPtr session_cache);
 
 private:
   int alpnSelectCallback(const unsigned char** out, unsigned char* outlen, const unsigned char* in,
@@ -217,8 +228,16 @@ private:
   enum ssl_select_cert_result_t selectTlsContext(const SSL_CLIENT_HELLO* ssl_client_hello);
   void generateHashForSessionContexId(const std::vector<std::string>& server_names,
                                       uint8_t* session_context_buf, unsigned& session_context_len);
+  // Shared session cache callbacks, @see SSL_CTX_sess_set_new_cb().
+  int newSession(SSL_SESSION* session);
+  SSL_SESSION* getSession(const uint8_t* id, int id_len);
+  void removeSession(SSL_SESSION* session);
+  std::string sessionCacheKey(const uint8_t* id, size_t id_len) const;
 
   const std::vector<Envoy::Ssl::ServerContextConfig::SessionTicketKey> session_ticket_keys_;
+  const Envoy::Ssl::SessionCacheSharedPtr session_cache_;
+  // Session ID context of the context, which prefixes its keys in the shared session cache.
+  std::string session_cache_key_prefix_;
 };
 
 } // namespace Tls
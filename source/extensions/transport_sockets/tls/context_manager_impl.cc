@@ -30,7 +30,7 @@ ContextManagerImpl::createSslClientContext(Stats::Scope& scope,
   }
 
   Envoy::Ssl::ClientContextSharedPtr context =
-      std::make_shared<ClientContextImpl>(scope, config, time_source_);
+      std::make_shared<ClientContextImpl>(scope, config, time_source_, session_cache_);
   removeEmptyContexts();
   contexts_.emplace_back(context);
   return context;
@@ -45,7 +45,8 @@ ContextManagerImpl::createSslServerContext(Stats::Scope& scope,
   }
 
   Envoy::Ssl::ServerContextSharedPtr context =
-      std::make_shared<ServerContextImpl>(scope, config, server_names, time_source_);
+      std::make_shared<ServerContextImpl>(scope, config, server_names, time_source_,
+                                          session_cache_);
   removeEmptyContexts();
   contexts_.emplace_back(context);
   return context;
@@ -6,9 +6,11 @@
 #include "envoy/common/time.h"
 #include "envoy/ssl/context_manager.h"
 #include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/session_cache.h"
 #include "envoy/stats/scope.h"
 
 #include "extensions/transport_sockets/tls/private_key/private_key_manager_impl.h"
+#include "extensions/transport_sockets/tls/session_cache_impl.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -21,10 +23,15 @@ namespace Tls {
  * thread). They can be released from any thread (and in practice are since cluster information can
  * be released from any thread). Context allocation/free is a very uncommon thing so we just do a
  * global lock to protect it all.
+ *
+ * All the contexts share the manager's session cache, which is thread safe on its own.
  */
 class ContextManagerImpl final : public Envoy::Ssl::ContextManager {
 public:
-  ContextManagerImpl(TimeSource& time_source) : time_source_(time_source) {}
+  ContextManagerImpl(TimeSource& time_source)
+      : ContextManagerImpl(time_source, std::make_shared<SessionCacheImpl>()) {}
+  ContextManagerImpl(TimeSource& time_source, Envoy::Ssl::SessionCacheSharedPtr session_cache)
+      : time_source_(time_source), session_cache_(std::move(session_cache)) {}
   ~ContextManagerImpl() override;
 
   // Ssl::ContextManager
@@ -40,9 +47,12 @@ public:
     return private_key_method_manager_;
   };
 
+  Envoy::Ssl::SessionCache& sessionCache() { return *session_cache_; }
+
 private:
   void removeEmptyContexts();
   TimeSource& time_source_;
+  const Envoy::Ssl::SessionCacheSharedPtr session_cache_;
   std::list<std::weak_ptr<Envoy::Ssl::Context>> contexts_;
   PrivateKeyMethodManagerImpl private_key_method_manager_{};
 };
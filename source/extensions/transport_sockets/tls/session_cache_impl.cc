@@ -0,0 +1,89 @@
+#include "extensions/transport_sockets/tls/session_cache_impl.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+
+#include "absl/hash/hash.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+SessionCacheImpl::SessionCacheImpl(size_t max_sessions, size_t shard_count)
+    : max_sessions_per_shard_(std::max<size_t>(1, max_sessions / shard_count)) {
+  ASSERT(shard_count > 0);
+  shards_.reserve(shard_count);
+  for (size_t i = 0; i < shard_count; ++i) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+}
+
+SessionCacheImpl::Shard& SessionCacheImpl::shard(const std::string& key) {
+  return *shards_[absl::Hash<std::string>()(key) % shards_.size()];
+}
+
+void SessionCacheImpl::insert(const std::string& key, bssl::UniquePtr<SSL_SESSION> session) {
+  ASSERT(session != nullptr);
+  Shard& shard = this->shard(key);
+  absl::MutexLock l(&shard.mu_);
+  auto it = shard.entries_.find(key);
+  if (it != shard.entries_.end()) {
+    it->second->session_ = std::move(session);
+    shard.lru_.splice(shard.lru_.begin(), shard.lru_, it->second);
+    return;
+  }
+
+  if (shard.lru_.size() >= max_sessions_per_shard_) {
+    shard.entries_.erase(shard.lru_.back().key_);
+    shard.lru_.pop_back();
+  }
+  shard.lru_.push_front(Entry{key, std::move(session)});
+  shard.entries_.emplace(key, shard.lru_.begin());
+}
+
+bssl::UniquePtr<SSL_SESSION> SessionCacheImpl::lookup(const std::string& key) {
+  Shard& shard = this->shard(key);
+  absl::MutexLock l(&shard.mu_);
+  auto it = shard.entries_.find(key);
+  if (it == shard.entries_.end()) {
+    return nullptr;
+  }
+
+  auto entry = it->second;
+  if (SSL_SESSION_should_be_single_use(entry->session_.get())) {
+    bssl::UniquePtr<SSL_SESSION> session = std::move(entry->session_);
+    shard.lru_.erase(entry);
+    shard.entries_.erase(it);
+    return session;
+  }
+
+  shard.lru_.splice(shard.lru_.begin(), shard.lru_, entry);
+  SSL_SESSION_up_ref(entry->session_.get());
+  return bssl::UniquePtr<SSL_SESSION>(entry->session_.get());
+}
+
+void SessionCacheImpl::remove(const std::string& key) {
+  Shard& shard = this->shard(key);
+  absl::MutexLock l(&shard.mu_);
+  auto it = shard.entries_.find(key);
+  if (it != shard.entries_.end()) {
+    shard.lru_.erase(it->second);
+    shard.entries_.erase(it);
+  }
+}
+
+size_t SessionCacheImpl::size() const {
+  size_t size = 0;
+  for (const auto& shard : shards_) {
+    absl::MutexLock l(&shard->mu_);
+    size += shard->lru_.size();
+  }
+  return size;
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/ssl/session_cache.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * In-process session cache. The keys are spread over independently locked shards, each of which
+ * evicts its least recently used session once it is full, so that handshakes on different workers
+ * rarely contend on the same lock.
+ */
+class SessionCacheImpl : public Envoy::Ssl::SessionCache {
+public:
+  /**
+   * @param max_sessions supplies the maximum number of sessions stored. It is split evenly
+   *        between the shards, every shard holding at least one session.
+   * @param shard_count supplies the number of shards.
+   */
+  explicit SessionCacheImpl(size_t max_sessions = DefaultMaxSessions,
+                            size_t shard_count = DefaultShardCount);
+
+  // Ssl::SessionCache
+  void insert(const std::string& key, bssl::UniquePtr<SSL_SESSION> session) override;
+  bssl::UniquePtr<SSL_SESSION> lookup(const std::string& key) override;
+  void remove(const std::string& key) override;
+  size_t size() const override;
+
+  static constexpr size_t DefaultMaxSessions = 65536;
+  static constexpr size_t DefaultShardCount = 16;
+
+private:
+  struct Entry {
+    std::string key_;
+    bssl::UniquePtr<SSL_SESSION> session_;
+  };
+
+  struct Shard {
+    mutable absl::Mutex mu_;
+    // Most recently used sessions are at the front.
+    std::list<Entry> lru_ ABSL_GUARDED_BY(mu_);
+    absl::flat_hash_map<std::string, std::list<Entry>::iterator> entries_ ABSL_GUARDED_BY(mu_);
+  };
+
+  Shard& shard(const std::string& key);
+
+  const size_t max_sessions_per_shard_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
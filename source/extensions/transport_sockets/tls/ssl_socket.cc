@@ -1,5 +1,7 @@
 #include "extensions/transport_sockets/tls/ssl_socket.h"
 
+#include <array>
+
 #include "envoy/stats/scope.h"
 
 #include "common/common/assert.h"
@@ -48,6 +50,8 @@ SslSocket::SslSocket(Envoy::Ssl::ContextSharedPtr ctx, InitialState state,
       ctx_(std::dynamic_pointer_cast<ContextImpl>(ctx)), state_(SocketState::PreHandshake) {
   bssl::UniquePtr<SSL> ssl = ctx_->newSsl(transport_socket_options_.get());
   ssl_ = ssl.get();
+  // A retried SSL_write() may pass the same data from a different address, see recordData().
+  SSL_set_mode(ssl_, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
   info_ = std::make_shared<SslSocketInfo>(std::move(ssl));
   if (state == InitialState::Client) {
     SSL_set_connect_state(ssl_);
@@ -238,12 +242,20 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (write_buffer.length() > 0) {
+    const MonotonicTime now = callbacks_->connection().dispatcher().timeSource().monotonicTime();
+    if (now - last_write_time_ > DynamicRecordIdleTimeout) {
+      bytes_written_since_idle_ = 0;
+    }
+    last_write_time_ = now;
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
     bytes_to_retry_ = 0;
   } else {
-    bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
+    bytes_to_write = nextRecordSize(write_buffer);
   }
 
   uint64_t total_bytes_written = 0;
@@ -253,15 +265,16 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
 
     // SSL_write() requires that if a previous call returns SSL_ERROR_WANT_WRITE, we need to call
     // it again with the same parameters. This is done by tracking last write size, but not write
-    // data, since linearize() will return the same undrained data anyway.
+    // data, since recordData() will return the same undrained data anyway.
     ASSERT(bytes_to_write <= write_buffer.length());
-    int rc = SSL_write(ssl_, write_buffer.linearize(bytes_to_write), bytes_to_write);
+    int rc = SSL_write(ssl_, recordData(write_buffer, bytes_to_write), bytes_to_write);
     ENVOY_CONN_LOG(trace, "ssl write returns: {}", callbacks_->connection(), rc);
     if (rc > 0) {
       ASSERT(rc == static_cast<int>(bytes_to_write));
       total_bytes_written += rc;
+      bytes_written_since_idle_ += rc;
       write_buffer.drain(rc);
-      bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
+      bytes_to_write = nextRecordSize(write_buffer);
     } else {
       int err = SSL_get_error(ssl_, rc);
       switch (err) {
@@ -286,6 +299,34 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+uint64_t SslSocket::nextRecordSize(const Buffer::Instance& write_buffer) const {
+  const uint64_t max_record_size =
+      bytes_written_since_idle_ < SmallRecordBytes ? SmallRecordSize : MaxRecordSize;
+  const uint64_t record_size = std::min(write_buffer.length(), max_record_size);
+  // End the record at the end of the front slice rather than copying the rest of the record from
+  // the following slices, unless that makes the record much smaller than it could be.
+  const uint64_t front_slice_size = write_buffer.frontSlice().len_;
+  if (front_slice_size < record_size && front_slice_size >= MinUncopiedRecordSize) {
+    return front_slice_size;
+  }
+  return record_size;
+}
+
+const void* SslSocket::recordData(const Buffer::Instance& write_buffer, uint64_t size) {
+  const Buffer::RawSlice front_slice = write_buffer.frontSlice();
+  if (front_slice.len_ >= size) {
+    return front_slice.mem_;
+  }
+  // The record spans slices, which are small. Copy them into a scratch buffer that is shared by all
+  // the sockets of the thread rather than linearizing the write buffer, which would allocate a new
+  // slice and move the data into it. SSL_write() seals the record before returning, so the scratch
+  // buffer can be reused by the next write.
+  static thread_local std::array<uint8_t, MaxRecordSize> record_scratch;
+  ASSERT(size <= record_scratch.size());
+  write_buffer.copyOut(0, size, record_scratch.data());
+  return record_scratch.data();
+}
+
 void SslSocket::onConnected() { ASSERT(state_ == SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
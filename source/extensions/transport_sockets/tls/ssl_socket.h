@@ -1,8 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 
+#include "envoy/common/time.h"
 #include "envoy/network/connection.h"
 #include "envoy/network/transport_socket.h"
 #include "envoy/secret/secret_callbacks.h"
@@ -112,6 +114,28 @@ private:
   };
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
+  // Dynamic record sizing: after the connection has been idle, records are kept small enough to
+  // fit in a single TCP segment, so the peer can decrypt the first bytes of a response as soon as
+  // they arrive. Once a bulk transfer is under way records grow to the TLS maximum, which costs
+  // less CPU and framing overhead per byte.
+  static constexpr uint64_t SmallRecordSize = 1400;
+  static constexpr uint64_t MaxRecordSize = 16384;
+  static constexpr uint64_t SmallRecordBytes = 64 * 1024;
+  static constexpr std::chrono::milliseconds DynamicRecordIdleTimeout{1000};
+  // Records that could only be filled by copying from several slices are ended at the first
+  // slice boundary instead, as long as that leaves them at least this big.
+  static constexpr uint64_t MinUncopiedRecordSize = 4096;
+
+  /**
+   * @return the size of the next record to write from write_buffer.
+   */
+  uint64_t nextRecordSize(const Buffer::Instance& write_buffer) const;
+
+  /**
+   * @return a pointer to the first size bytes of write_buffer, without linearizing the buffer.
+   */
+  static const void* recordData(const Buffer::Instance& write_buffer, uint64_t size);
+
   Network::PostIoAction doHandshake();
   void drainErrorQueue();
   void shutdownSsl();
@@ -123,6 +147,8 @@ private:
   Network::TransportSocketCallbacks* callbacks_{};
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
+  uint64_t bytes_written_since_idle_{};
+  MonotonicTime last_write_time_;
   std::string failure_reason_;
   SocketState state_;
 
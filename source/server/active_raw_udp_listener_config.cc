@@ -1,26 +1,39 @@
 #include "server/active_raw_udp_listener_config.h"
 
+#include "common/protobuf/message_validator_impl.h"
+#include "common/protobuf/utility.h"
+
 #include "server/connection_handler_impl.h"
 #include "server/well_known_names.h"
 
 namespace Envoy {
 namespace Server {
 
+ActiveRawUdpListenerFactory::ActiveRawUdpListenerFactory(
+    const envoy::api::v2::listener::RawUdpListenerConfig& config) {
+  read_options_.max_packets_per_event_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+      config, max_read_packets_per_event, read_options_.max_packets_per_event_);
+  read_options_.prefer_gro_ = config.prefer_gro();
+}
+
 Network::ConnectionHandler::ActiveListenerPtr
 ActiveRawUdpListenerFactory::createActiveUdpListener(Network::ConnectionHandler& parent,
                                                      Event::Dispatcher& dispatcher,
                                                      Network::ListenerConfig& config) const {
-  return std::make_unique<ActiveUdpListener>(parent, dispatcher, config);
+  return std::make_unique<ActiveUdpListener>(parent, dispatcher, config, read_options_);
 }
 
 ProtobufTypes::MessagePtr ActiveRawUdpListenerConfigFactory::createEmptyConfigProto() {
-  return std::make_unique<ProtobufWkt::Empty>();
+  return std::make_unique<envoy::api::v2::listener::RawUdpListenerConfig>();
 }
 
 Network::ActiveUdpListenerFactoryPtr
 ActiveRawUdpListenerConfigFactory::createActiveUdpListenerFactory(
-    const Protobuf::Message& /*message*/) {
-  return std::make_unique<Server::ActiveRawUdpListenerFactory>();
+    const Protobuf::Message& message) {
+  const auto& config =
+      MessageUtil::downcastAndValidate<const envoy::api::v2::listener::RawUdpListenerConfig&>(
+          message, ProtobufMessage::getStrictValidationVisitor());
+  return std::make_unique<Server::ActiveRawUdpListenerFactory>(config);
 }
 
 std::string ActiveRawUdpListenerConfigFactory::name() { return UdpListenerNames::get().RawUdp; }
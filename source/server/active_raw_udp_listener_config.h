@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/api/v2/listener/udp_listener_config.pb.h"
 #include "envoy/network/connection_handler.h"
 #include "envoy/registry/registry.h"
 #include "envoy/server/active_udp_listener_config.h"
@@ -9,11 +10,17 @@ namespace Server {
 
 class ActiveRawUdpListenerFactory : public Network::ActiveUdpListenerFactory {
 public:
+  explicit ActiveRawUdpListenerFactory(
+      const envoy::api::v2::listener::RawUdpListenerConfig& config);
+
   Network::ConnectionHandler::ActiveListenerPtr
   createActiveUdpListener(Network::ConnectionHandler& parent, Event::Dispatcher& disptacher,
                           Network::ListenerConfig& config) const override;
 
   bool isTransportConnectionless() const override { return true; }
+
+private:
+  Network::UdpReadOptions read_options_;
 };
 
 // This class uses a protobuf config to create a UDP listener factory which
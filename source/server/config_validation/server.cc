@@ -48,7 +48,7 @@ ValidationInstance::ValidationInstance(
       dispatcher_(api_->allocateDispatcher()),
       singleton_manager_(new Singleton::ManagerImpl(api_->threadFactory())),
       access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
-                          store),
+                          store, options.fileFlushSharedThreadEnabled()),
       mutex_tracer_(nullptr), grpc_context_(stats_store_.symbolTable()),
       http_context_(stats_store_.symbolTable()), time_system_(time_system), server_context_(*this) {
   try {
@@ -408,11 +408,12 @@ ConnectionHandlerImpl::ActiveTcpConnection::~ActiveTcpConnection() {
 }
 
 ActiveUdpListener::ActiveUdpListener(Network::ConnectionHandler& parent,
-                                     Event::Dispatcher& dispatcher, Network::ListenerConfig& config)
-    : ActiveUdpListener(
-          parent,
-          dispatcher.createUdpListener(config.listenSocketFactory().getListenSocket(), *this),
-          config) {}
+                                     Event::Dispatcher& dispatcher, Network::ListenerConfig& config,
+                                     const Network::UdpReadOptions& read_options)
+    : ActiveUdpListener(parent,
+                        dispatcher.createUdpListener(config.listenSocketFactory().getListenSocket(),
+                                                     *this, read_options),
+                        config) {}
 
 ActiveUdpListener::ActiveUdpListener(Network::ConnectionHandler& parent,
                                      Network::UdpListenerPtr&& listener,
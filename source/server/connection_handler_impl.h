@@ -255,7 +255,7 @@ class ActiveUdpListener : public Network::UdpListenerCallbacks,
                           public Network::UdpReadFilterCallbacks {
 public:
   ActiveUdpListener(Network::ConnectionHandler& parent, Event::Dispatcher& dispatcher,
-                    Network::ListenerConfig& config);
+                    Network::ListenerConfig& config, const Network::UdpReadOptions& read_options);
   ActiveUdpListener(Network::ConnectionHandler& parent, Network::UdpListenerPtr&& listener,
                     Network::ListenerConfig& config);
 
@@ -107,6 +107,9 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   TCLAP::ValueArg<uint32_t> file_flush_interval_msec("", "file-flush-interval-msec",
                                                      "Interval for log flushing in msec", false,
                                                      10000, "uint32_t", cmd);
+  TCLAP::SwitchArg file_flush_shared_thread(
+      "", "file-flush-shared-thread",
+      "Flush all log files from a single thread, with lock-free buffering on workers", cmd, false);
   TCLAP::ValueArg<uint32_t> drain_time_s("", "drain-time-s",
                                          "Hot restart and LDS removal drain time in seconds", false,
                                          600, "uint32_t", cmd);
@@ -162,6 +165,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
 
   fake_symbol_table_enabled_ = use_fake_symbol_table.getValue();
   cpuset_threads_ = cpuset_threads.getValue();
+  file_flush_shared_thread_ = file_flush_shared_thread.getValue();
 
   log_level_ = default_log_level;
   for (size_t i = 0; i < ARRAY_SIZE(spdlog::level::level_string_views); i++) {
@@ -310,6 +314,7 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   }
   command_line_options->mutable_file_flush_interval()->MergeFrom(
       Protobuf::util::TimeUtil::MillisecondsToDuration(fileFlushIntervalMsec().count()));
+  command_line_options->set_file_flush_shared_thread(fileFlushSharedThreadEnabled());
   command_line_options->mutable_parent_shutdown_time()->MergeFrom(
       Protobuf::util::TimeUtil::SecondsToDuration(parentShutdownTime().count()));
   command_line_options->mutable_drain_time()->MergeFrom(
@@ -330,7 +335,8 @@ OptionsImpl::OptionsImpl(const std::string& service_cluster, const std::string&
       local_address_ip_version_(Network::Address::IpVersion::v4), log_level_(log_level),
       log_format_(Logger::Logger::DEFAULT_LOG_FORMAT), log_format_escaped_(false),
       restart_epoch_(0u), service_cluster_(service_cluster), service_node_(service_node),
-      service_zone_(service_zone), file_flush_interval_msec_(10000), drain_time_(600),
+      service_zone_(service_zone), file_flush_interval_msec_(10000),
+      file_flush_shared_thread_(false), drain_time_(600),
       parent_shutdown_time_(900), mode_(Server::Mode::Serve), hot_restart_disabled_(false),
       signal_handling_enabled_(true), mutex_tracing_enabled_(false), cpuset_threads_(false),
       fake_symbol_table_enabled_(false) {}
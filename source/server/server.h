@@ -51,9 +51,12 @@ namespace Server {
  * All server wide stats. @see stats_macros.h
  */
 #define ALL_SERVER_STATS(COUNTER, GAUGE, HISTOGRAM)                                                \
+  COUNTER(buffer_slice_pool_hits)                                                                  \
+  COUNTER(buffer_slice_pool_misses)                                                                \
   COUNTER(debug_assertion_failures)                                                                \
   COUNTER(dynamic_unknown_fields)                                                                  \
   COUNTER(static_unknown_fields)                                                                   \
+  GAUGE(buffer_slice_pool_cached_bytes, NeverImport)                                               \
   GAUGE(concurrency, NeverImport)                                                                  \
   GAUGE(days_until_first_cert_expiring, Accumulate)                                                \
   GAUGE(hot_restart_epoch, NeverImport)                                                            \
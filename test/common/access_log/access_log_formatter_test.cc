@@ -1550,6 +1550,132 @@ TEST(AccessLogFormatterTest, CompositeFormatterSuccess) {
   }
 }
 
+TEST(AccessLogFormatterTest, CompositeFormatterFormatTo) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
+  Http::TestHeaderMapImpl response_header{{"second", "PUT"}};
+  Http::TestHeaderMapImpl response_trailer;
+
+  const SystemTime start_time(std::chrono::microseconds(1522796769123456));
+  EXPECT_CALL(stream_info, startTime()).WillRepeatedly(Return(start_time));
+  absl::optional<uint32_t> response_code{200};
+  EXPECT_CALL(stream_info, responseCode()).WillRepeatedly(Return(response_code));
+
+  FormatterImpl formatter("%START_TIME(%s.%3f)% %REQ(FIRST):2% %RESPONSE_CODE% %RESP(SECOND)% "
+                          "%RESP(NONE)% %DURATION%\n");
+
+  // formatTo() appends to what the buffer already holds and produces the same line as format().
+  std::string output = "existing ";
+  formatter.formatTo(request_header, response_header, response_trailer, stream_info, output);
+  const std::string expected = "1522796769.123 GE 200 PUT - -\n";
+  EXPECT_EQ("existing " + expected, output);
+  EXPECT_EQ(expected,
+            formatter.format(request_header, response_header, response_trailer, stream_info));
+}
+
+TEST(AccessLogFormatterTest, JsonFormatterEscapesValues) {
+  StreamInfo::MockStreamInfo stream_info;
+  Http::TestHeaderMapImpl request_header{{"quoted", "say \"hi\"\\"}, {"control", "a\tb\x01"}};
+  Http::TestHeaderMapImpl response_header;
+  Http::TestHeaderMapImpl response_trailer;
+
+  std::unordered_map<std::string, std::string> key_mapping = {
+      {"quoted", "%REQ(QUOTED)%"},
+      {"control", "[%REQ(CONTROL)%]"},
+      {"key \"with\" quotes", "plain"}};
+
+  for (const bool preserve_types : {false, true}) {
+    JsonFormatterImpl formatter(key_mapping, preserve_types);
+    const std::string json =
+        formatter.format(request_header, response_header, response_trailer, stream_info);
+    EXPECT_EQ("{\"control\":\"[a\\tb\\u0001]\",\"key \\\"with\\\" quotes\":\"plain\","
+              "\"quoted\":\"say \\\"hi\\\"\\\\\"}\n",
+              json);
+
+    ProtobufWkt::Struct output;
+    MessageUtil::loadFromJson(json, output);
+    EXPECT_EQ("say \"hi\"\\", output.fields().at("quoted").string_value());
+    EXPECT_EQ("[a\tb\x01]", output.fields().at("control").string_value());
+    EXPECT_EQ("plain", output.fields().at("key \"with\" quotes").string_value());
+  }
+}
+
+// Test that values are escaped like the protobuf JSON printer escapes them, and that bytes which
+// are not valid UTF-8 are escaped too.
+TEST(AccessLogFormatterTest, JsonFormatterEscapesLikeProtobufPrinter) {
+  StreamInfo::MockStreamInfo stream_info;
+  Http::TestHeaderMapImpl response_header;
+  Http::TestHeaderMapImpl response_trailer;
+  std::unordered_map<std::string, std::string> key_mapping = {{"value", "%REQ(VALUE)%"}};
+
+  const std::vector<std::pair<std::string, std::string>> valid_values = {
+      {"<b>", "\\u003cb\\u003e"},
+      {"a\x7f", "a\\u007f"},
+      // U+0080 and U+009F, the first and last C1 controls.
+      {"\xc2\x80\xc2\x9f", "\\u0080\\u009f"},
+      {"caf\xc3\xa9 \xe2\x82\xac", "caf\xc3\xa9 \xe2\x82\xac"},
+      // U+200B, a zero width space, and U+E0001, a language tag outside of the BMP.
+      {"\xe2\x80\x8b\xf3\xa0\x80\x81", "\\u200b\\udb40\\udc01"},
+  };
+  for (const auto& value : valid_values) {
+    Http::TestHeaderMapImpl request_header{{"value", value.first}};
+    ProtobufWkt::Struct expected;
+    (*expected.mutable_fields())["value"].set_string_value(value.first);
+    const std::string expected_json = MessageUtil::getJsonStringFromMessage(expected, false, true);
+    EXPECT_EQ("{\"value\":\"" + value.second + "\"}", expected_json);
+
+    for (const bool preserve_types : {false, true}) {
+      JsonFormatterImpl formatter(key_mapping, preserve_types);
+      EXPECT_EQ(expected_json + "\n", formatter.format(request_header, response_header,
+                                                       response_trailer, stream_info));
+    }
+  }
+
+  const std::vector<std::pair<std::string, std::string>> invalid_values = {
+      // Continuation bytes without a lead byte.
+      {"\x80\x9f\xbf", "\\u0080\\u009f\\u00bf"},
+      // Truncated sequences, at the end and in the middle of the value.
+      {"a\xc3", "a\\u00c3"},
+      {"\xe2\x82z", "\\u00e2\\u0082z"},
+      // An overlong encoding of '/', an encoded surrogate and bytes that never appear in UTF-8.
+      {"\xc0\xaf", "\\u00c0\\u00af"},
+      {"\xed\xa0\x80", "\\u00ed\\u00a0\\u0080"},
+      {"\xf8\xff", "\\u00f8\\u00ff"},
+  };
+  for (const auto& value : invalid_values) {
+    Http::TestHeaderMapImpl request_header{{"value", value.first}};
+    for (const bool preserve_types : {false, true}) {
+      JsonFormatterImpl formatter(key_mapping, preserve_types);
+      const std::string json =
+          formatter.format(request_header, response_header, response_trailer, stream_info);
+      EXPECT_EQ("{\"value\":\"" + value.second + "\"}\n", json);
+      ProtobufWkt::Struct output;
+      EXPECT_NO_THROW(MessageUtil::loadFromJson(json, output));
+    }
+  }
+}
+
+TEST(AccessLogFormatterTest, JsonFormatterFormatTo) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestHeaderMapImpl header;
+  EXPECT_CALL(Const(stream_info), lastDownstreamRxByteReceived())
+      .WillRepeatedly(Return(std::chrono::nanoseconds(5000000)));
+
+  std::unordered_map<std::string, std::string> key_mapping = {
+      {"request_duration", "%REQUEST_DURATION%"}, {"missing", "%REQ(MISSING)%"}};
+
+  JsonFormatterImpl string_formatter(key_mapping, false);
+  std::string output = "existing ";
+  string_formatter.formatTo(header, header, header, stream_info, output);
+  EXPECT_EQ("existing {\"missing\":\"-\",\"request_duration\":\"5\"}\n", output);
+
+  // Typed output writes numbers and null values without quotes.
+  JsonFormatterImpl typed_formatter(key_mapping, true);
+  output.clear();
+  typed_formatter.formatTo(header, header, header, stream_info, output);
+  EXPECT_EQ("{\"missing\":null,\"request_duration\":5}\n", output);
+}
+
 TEST(AccessLogFormatterTest, ParserFailures) {
   AccessLogFormatParser parser;
 
@@ -11,6 +11,10 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/synchronization/notification.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -518,6 +522,238 @@ TEST_F(AccessLogManagerImplTest, reopenAllFiles) {
       .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+class SharedFlushAccessLogManagerImplTest : public testing::Test {
+protected:
+  SharedFlushAccessLogManagerImplTest()
+      : file_(new NiceMock<Filesystem::MockFile>), thread_factory_(Thread::threadFactoryForTest()),
+        access_log_manager_(timeout_1h_, api_, dispatcher_, lock_, store_, true) {
+    EXPECT_CALL(file_system_, createFile("foo"))
+        .WillOnce(Return(ByMove(std::unique_ptr<NiceMock<Filesystem::MockFile>>(file_))));
+
+    EXPECT_CALL(api_, fileSystem()).WillRepeatedly(ReturnRef(file_system_));
+    EXPECT_CALL(api_, threadFactory()).WillRepeatedly(ReturnRef(thread_factory_));
+    // The shared flush thread doesn't use dispatcher timers.
+    EXPECT_CALL(dispatcher_, createTimer_(_)).Times(0);
+  }
+
+  void waitForWrites(uint32_t expected_writes) {
+    Thread::LockGuard lock(file_->write_mutex_);
+    while (file_->num_writes_ != expected_writes) {
+      file_->write_event_.wait(file_->write_mutex_);
+    }
+  }
+
+  // flush() only wakes the flush thread up, which updates the stats after writing.
+  void waitForCounterEq(const std::string& name, uint64_t value) {
+    TestUtility::waitForCounterEq(store_, name, value, time_system_);
+  }
+
+  void waitForGaugeEq(const std::string& name, uint64_t value) {
+    TestUtility::waitForGaugeEq(store_, name, value, time_system_);
+  }
+
+  NiceMock<Api::MockApi> api_;
+  NiceMock<Filesystem::MockInstance> file_system_;
+  NiceMock<Filesystem::MockFile>* file_;
+  // Long enough that the flush thread only runs when it is woken up.
+  const std::chrono::milliseconds timeout_1h_{3600 * 1000};
+  Stats::IsolatedStoreImpl store_;
+  Thread::ThreadFactory& thread_factory_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Thread::MutexBasicLockable lock_;
+  AccessLogManagerImpl access_log_manager_;
+  Event::TestRealTimeSystem time_system_;
+};
+
+TEST_F(SharedFlushAccessLogManagerImplTest, BadFile) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultFailure<bool>(false, 0))));
+  EXPECT_THROW(access_log_manager_.createAccessLog("foo"), EnvoyException);
+}
+
+TEST_F(SharedFlushAccessLogManagerImplTest, FlushGathersLines) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog("foo");
+  EXPECT_EQ(log_file, access_log_manager_.createAccessLog("foo"));
+
+  // Both lines are handed to the file in a single gathered write.
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ("first\nsecond\n", data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->write("first\n");
+  log_file->write("second\n");
+  EXPECT_EQ(13UL,
+            store_.gauge("filesystem.write_total_buffered", Stats::Gauge::ImportMode::Accumulate)
+                .value());
+
+  log_file->flush();
+  waitForWrites(1);
+  waitForCounterEq("filesystem.write_completed", 1);
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+  EXPECT_EQ(2UL, store_.counter("filesystem.write_buffered").value());
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_dropped").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(SharedFlushAccessLogManagerImplTest, BigDataChunkWakesFlushThread) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog("foo");
+
+  const std::string big_line(1024 * 64 + 1, 'a');
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([&big_line](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(big_line, data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->write(big_line);
+  waitForWrites(1);
+  EXPECT_EQ(0UL, store_.counter("filesystem.flushed_by_timer").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(SharedFlushAccessLogManagerImplTest, CountsIOErrors) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog("foo");
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Return(ByMove(Filesystem::resultFailure<ssize_t>(-1, ENOSPC))));
+  log_file->write("test");
+  log_file->flush();
+  waitForCounterEq("filesystem.write_failed", 1);
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_completed").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(SharedFlushAccessLogManagerImplTest, ReopenFile) {
+  Sequence sq;
+  EXPECT_CALL(*file_, open_(_))
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog("foo");
+
+  access_log_manager_.reopen();
+  EXPECT_CALL(*file_, close_())
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file_, open_(_))
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file_, write_(_))
+      .InSequence(sq)
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ("reopened", data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->write("reopened");
+  log_file->flush();
+  waitForWrites(1);
+
+  EXPECT_CALL(*file_, close_())
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(SharedFlushAccessLogManagerImplTest, SlowDiskDoesNotBlockNewFiles) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog("foo");
+
+  absl::Notification write_started;
+  absl::Notification disk_unstalled;
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        write_started.Notify();
+        disk_unstalled.WaitForNotification();
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->write("slow");
+  log_file->flush();
+  write_started.WaitForNotification();
+
+  // The flush thread is stuck writing foo, which must not hold up adding another file.
+  NiceMock<Filesystem::MockFile>* bar_file = new NiceMock<Filesystem::MockFile>;
+  EXPECT_CALL(file_system_, createFile("bar"))
+      .WillOnce(Return(ByMove(std::unique_ptr<NiceMock<Filesystem::MockFile>>(bar_file))));
+  EXPECT_CALL(*bar_file, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_NE(nullptr, access_log_manager_.createAccessLog("bar"));
+
+  disk_unstalled.Notify();
+  waitForCounterEq("filesystem.write_completed", 1);
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*bar_file, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST(AccessLogRingTest, DropsWhenFull) {
+  AccessLogRing ring(4);
+  EXPECT_EQ(4UL, ring.capacity());
+  EXPECT_TRUE(ring.push("a"));
+  EXPECT_TRUE(ring.push("b"));
+  EXPECT_TRUE(ring.push("c"));
+  EXPECT_TRUE(ring.push("d"));
+  EXPECT_FALSE(ring.push("e"));
+  EXPECT_EQ(4UL, ring.size());
+
+  absl::string_view lines[8];
+  ASSERT_EQ(2UL, ring.peek(lines, 2));
+  EXPECT_EQ("a", lines[0]);
+  EXPECT_EQ("b", lines[1]);
+  ring.pop(2);
+  EXPECT_EQ(2UL, ring.size());
+
+  // Freed slots are reused once the writers wrap around.
+  EXPECT_TRUE(ring.push("f"));
+  EXPECT_TRUE(ring.push("g"));
+  EXPECT_FALSE(ring.push("h"));
+
+  ASSERT_EQ(4UL, ring.peek(lines, 8));
+  EXPECT_EQ("c", lines[0]);
+  EXPECT_EQ("d", lines[1]);
+  EXPECT_EQ("f", lines[2]);
+  EXPECT_EQ("g", lines[3]);
+  ring.pop(4);
+  EXPECT_EQ(0UL, ring.size());
+  EXPECT_EQ(0UL, ring.peek(lines, 8));
+}
+
+TEST(AccessLogRingTest, ConcurrentWriters) {
+  AccessLogRing ring(1024);
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  constexpr uint64_t num_threads = 4;
+  constexpr uint64_t lines_per_thread = 256;
+
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint64_t i = 0; i < num_threads; i++) {
+    threads.push_back(thread_factory.createThread([&ring, i]() -> void {
+      for (uint64_t j = 0; j < lines_per_thread; j++) {
+        EXPECT_TRUE(ring.push(absl::StrCat(i, ":", j)));
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+
+  // Every line arrives, and each writer's lines arrive in the order they were written.
+  absl::string_view lines[num_threads * lines_per_thread];
+  ASSERT_EQ(num_threads * lines_per_thread, ring.peek(lines, num_threads * lines_per_thread));
+  std::vector<int64_t> last_line(num_threads, -1);
+  for (absl::string_view line : lines) {
+    const std::vector<absl::string_view> parts = absl::StrSplit(line, ':');
+    ASSERT_EQ(2UL, parts.size());
+    uint64_t thread;
+    int64_t index;
+    ASSERT_TRUE(absl::SimpleAtoi(parts[0], &thread));
+    ASSERT_TRUE(absl::SimpleAtoi(parts[1], &index));
+    EXPECT_EQ(last_line[thread] + 1, index);
+    last_line[thread] = index;
+  }
+  ring.pop(num_threads * lines_per_thread);
+}
+
 } // namespace
 } // namespace AccessLog
 } // namespace Envoy
@@ -114,6 +114,18 @@ public:
     size_ -= size;
   }
 
+  Buffer::SliceDataPtr extractFrontSlice() override {
+    // The whole buffer is a single slice, which is handed out as a copy.
+    Buffer::SliceDataPtr slice = Buffer::OwnedSlice::create(start(), size_);
+    drain(size_);
+    return slice;
+  }
+
+  Buffer::RawSlice frontSlice() const override {
+    // Sketchy, but probably will work for test purposes.
+    return {const_cast<char*>(start()), size_};
+  }
+
   uint64_t getRawSlices(Buffer::RawSlice* out, uint64_t out_size) const override {
     if (out_size == 0) {
       return 1;
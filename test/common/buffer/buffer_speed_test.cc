@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <vector>
+
 #include "common/buffer/buffer_impl.h"
+#include "common/buffer/slice_pool.h"
 #include "common/common/assert.h"
 
 #include "absl/strings/string_view.h"
@@ -365,6 +369,82 @@ BENCHMARK(BufferStartsWithMatch)
     ->Args({16384, 256})
     ->Args({65536, 4096});
 
+// Configure the slice pool for a benchmark: range(0) == 0 disables pooling, anything else uses
+// the default per-thread limit.
+static void setSlicePoolEnabled(benchmark::State& state) {
+  Buffer::SlicePool::setMaxCachedBytesPerThread(
+      state.range(0) == 0 ? 0 : Buffer::SlicePool::DefaultMaxCachedBytesPerThread);
+  Buffer::SlicePool::releaseThreadCache();
+}
+
+static void reportSlicePoolStats(benchmark::State& state, const Buffer::SlicePoolStats& before) {
+  const Buffer::SlicePoolStats after = Buffer::SlicePool::stats();
+  state.counters["pool_hits"] = after.hits_ - before.hits_;
+  state.counters["heap_allocs"] = after.misses_ - before.misses_;
+}
+
+// Simulate the proxy data path: a 16KB socket read into a downstream read buffer, a move of the
+// data into the upstream write buffer, and a drain of the write buffer once it is flushed.
+// range(0) selects whether the slice pool is enabled, range(1) is the number of bytes each read
+// returns.
+static void BufferProxyReadMoveDrain(benchmark::State& state) {
+  setSlicePoolEnabled(state);
+  const Buffer::SlicePoolStats before = Buffer::SlicePool::stats();
+  constexpr uint64_t ReadSize = 16384;
+  const uint64_t bytes_read = state.range(1);
+  Buffer::OwnedImpl read_buffer;
+  Buffer::OwnedImpl write_buffer;
+  for (auto _ : state) {
+    constexpr uint64_t NumSlices = 2;
+    Buffer::RawSlice slices[NumSlices];
+    const uint64_t num_slices = read_buffer.reserve(ReadSize, slices, NumSlices);
+    uint64_t bytes_to_commit = bytes_read;
+    for (uint64_t i = 0; i < num_slices; i++) {
+      slices[i].len_ = std::min(slices[i].len_, static_cast<size_t>(bytes_to_commit));
+      memset(slices[i].mem_, 'a', slices[i].len_);
+      bytes_to_commit -= slices[i].len_;
+    }
+    read_buffer.commit(slices, num_slices);
+    write_buffer.move(read_buffer);
+    write_buffer.drain(write_buffer.length());
+  }
+  benchmark::DoNotOptimize(write_buffer.length());
+  reportSlicePoolStats(state, before);
+}
+BENCHMARK(BufferProxyReadMoveDrain)
+    ->Args({0, 128})
+    ->Args({1, 128})
+    ->Args({0, 16384})
+    ->Args({1, 16384});
+
+// Simulate many concurrent connections each holding a partially filled read buffer, so that
+// slices are freed in a different order than they were allocated.
+// range(0) selects whether the slice pool is enabled, range(1) is the number of connections.
+static void BufferProxyManyConnections(benchmark::State& state) {
+  setSlicePoolEnabled(state);
+  const Buffer::SlicePoolStats before = Buffer::SlicePool::stats();
+  const std::string data(4000, 'a');
+  std::vector<Buffer::OwnedImpl> read_buffers(state.range(1));
+  Buffer::OwnedImpl write_buffer;
+  size_t connection = 0;
+  for (auto _ : state) {
+    Buffer::OwnedImpl& read_buffer = read_buffers[connection];
+    read_buffer.add(data);
+    if (read_buffer.length() >= 4 * data.size()) {
+      write_buffer.move(read_buffer);
+      write_buffer.drain(write_buffer.length());
+    }
+    connection = (connection * 7 + 1) % read_buffers.size();
+  }
+  benchmark::DoNotOptimize(write_buffer.length());
+  reportSlicePoolStats(state, before);
+}
+BENCHMARK(BufferProxyManyConnections)
+    ->Args({0, 16})
+    ->Args({1, 16})
+    ->Args({0, 1024})
+    ->Args({1, 1024});
+
 } // namespace Envoy
 
 // Boilerplate main(), which discovers benchmarks in the same file and runs them.
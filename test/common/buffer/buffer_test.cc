@@ -60,7 +60,8 @@ bool sliceMatches(const SlicePtr& slice, const std::string& expected) {
 }
 
 TEST_F(OwnedSliceTest, Create) {
-  static constexpr uint64_t Sizes[] = {0, 1, 64, 4096 - sizeof(OwnedSlice), 65535};
+  static constexpr uint64_t Sizes[] = {0, 1, 64,
+                                       4096 - sizeof(OwnedSlice) - SlicePool::HeaderSize, 65535};
   for (const auto size : Sizes) {
     auto slice = OwnedSlice::create(size);
     EXPECT_NE(nullptr, slice->data());
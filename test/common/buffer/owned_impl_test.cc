@@ -303,6 +303,8 @@ TEST_F(OwnedImplTest, ReserveCommit) {
     Buffer::OwnedImpl buffer;
     // A zero-byte reservation should fail.
     static constexpr uint64_t NumIovecs = 16;
+    // Capacity of a slice that occupies exactly one pool page.
+    static constexpr uint64_t OnePageSliceSize = 4096 - sizeof(OwnedSlice) - SlicePool::HeaderSize;
     Buffer::RawSlice iovecs[NumIovecs];
     uint64_t num_reserved = buffer.reserve(0, iovecs, NumIovecs);
     EXPECT_EQ(0, num_reserved);
@@ -329,7 +331,7 @@ TEST_F(OwnedImplTest, ReserveCommit) {
     // Request a reservation that is too large to fit in the remaining space at the end of
     // the last slice, and allow the buffer to use only one slice. This should result in the
     // creation of a new slice within the buffer.
-    num_reserved = buffer.reserve(4096 - sizeof(OwnedSlice), iovecs, 1);
+    num_reserved = buffer.reserve(OnePageSliceSize, iovecs, 1);
     const void* slice2 = iovecs[0].mem_;
     EXPECT_EQ(1, num_reserved);
     EXPECT_NE(slice1, slice2);
@@ -337,7 +339,7 @@ TEST_F(OwnedImplTest, ReserveCommit) {
 
     // Request the same size reservation, but allow the buffer to use multiple slices. This
     // should result in the buffer splitting the reservation between its last two slices.
-    num_reserved = buffer.reserve(4096 - sizeof(OwnedSlice), iovecs, NumIovecs);
+    num_reserved = buffer.reserve(OnePageSliceSize, iovecs, NumIovecs);
     EXPECT_EQ(2, num_reserved);
     EXPECT_EQ(slice1, iovecs[0].mem_);
     EXPECT_EQ(slice2, iovecs[1].mem_);
@@ -513,6 +515,49 @@ TEST_F(OwnedImplTest, AppendSliceForTest) {
   expectSlice(slices[2], "four");
 }
 
+TEST_F(OwnedImplTest, FrontSlice) {
+  Buffer::OwnedImpl buffer;
+  EXPECT_EQ(RawSlice(), buffer.frontSlice());
+  buffer.appendSliceForTest("");
+  EXPECT_EQ(RawSlice(), buffer.frontSlice());
+  buffer.appendSliceForTest("one");
+  buffer.appendSliceForTest("two");
+  RawSlice slice = buffer.frontSlice();
+  EXPECT_EQ("one", absl::string_view(static_cast<const char*>(slice.mem_), slice.len_));
+  buffer.drain(3);
+  slice = buffer.frontSlice();
+  EXPECT_EQ("two", absl::string_view(static_cast<const char*>(slice.mem_), slice.len_));
+}
+
+TEST_F(OwnedImplTest, ExtractFrontSlice) {
+  Buffer::OwnedImpl buffer;
+  buffer.appendSliceForTest("");
+  buffer.appendSliceForTest("one");
+  char input[] = "two";
+  BufferFragmentImpl frag(input, 3, [this](const void*, size_t, const BufferFragmentImpl*) {
+    release_callback_called_ = true;
+  });
+  buffer.addBufferFragment(frag);
+  EXPECT_EQ(6, buffer.length());
+
+  // The empty slice at the front is skipped.
+  SliceDataPtr slice = buffer.extractFrontSlice();
+  EXPECT_EQ("one", absl::string_view(reinterpret_cast<const char*>(slice->getData().data()),
+                                     slice->getData().size()));
+  EXPECT_GE(slice->getCapacity(), 3);
+  EXPECT_EQ(3, buffer.length());
+  EXPECT_EQ("two", buffer.toString());
+
+  // The extracted fragment is only released when the extracted slice is destroyed.
+  slice = buffer.extractFrontSlice();
+  EXPECT_EQ(input, reinterpret_cast<const char*>(slice->getData().data()));
+  EXPECT_EQ(3, slice->getCapacity());
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_FALSE(release_callback_called_);
+  slice.reset();
+  EXPECT_TRUE(release_callback_called_);
+}
+
 // Regression test for oss-fuzz issue
 // https://bugs.chromium.org/p/oss-fuzz/issues/detail?id=13263, where prepending
 // an empty buffer resulted in a corrupted libevent internal state.
@@ -0,0 +1,113 @@
+#include "common/buffer/buffer_impl.h"
+#include "common/buffer/slice_pool.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SlicePoolTest : public testing::Test {
+protected:
+  SlicePoolTest() {
+    SlicePool::setMaxCachedBytesPerThread(SlicePool::DefaultMaxCachedBytesPerThread);
+    SlicePool::releaseThreadCache();
+  }
+
+  ~SlicePoolTest() override {
+    SlicePool::setMaxCachedBytesPerThread(SlicePool::DefaultMaxCachedBytesPerThread);
+    SlicePool::releaseThreadCache();
+  }
+
+  // Size of a pooled block that spans num_pages pages including the pool header.
+  static uint64_t blockSize(uint64_t num_pages) {
+    return num_pages * SlicePool::PageSize - SlicePool::HeaderSize;
+  }
+};
+
+TEST_F(SlicePoolTest, FreedBlockIsReused) {
+  const SlicePoolStats before = SlicePool::stats();
+  void* block = SlicePool::allocate(blockSize(4));
+  SlicePool::deallocate(block);
+  EXPECT_EQ(before.cached_bytes_ + 4 * SlicePool::PageSize, SlicePool::stats().cached_bytes_);
+
+  void* reused = SlicePool::allocate(blockSize(4));
+  EXPECT_EQ(block, reused);
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.misses_ + 1, after.misses_);
+  EXPECT_EQ(before.hits_ + 1, after.hits_);
+  EXPECT_EQ(before.cached_bytes_, after.cached_bytes_);
+  SlicePool::deallocate(reused);
+}
+
+TEST_F(SlicePoolTest, SizeClassesAreSeparate) {
+  void* small = SlicePool::allocate(blockSize(1));
+  SlicePool::deallocate(small);
+  const SlicePoolStats before = SlicePool::stats();
+  void* large = SlicePool::allocate(blockSize(2));
+  EXPECT_EQ(before.misses_ + 1, SlicePool::stats().misses_);
+  SlicePool::deallocate(large);
+}
+
+TEST_F(SlicePoolTest, UnpooledSizesBypassPool) {
+  const SlicePoolStats before = SlicePool::stats();
+  // Neither a partial page nor more than MaxPooledPages is pooled.
+  void* odd = SlicePool::allocate(100);
+  void* huge = SlicePool::allocate(blockSize(SlicePool::MaxPooledPages + 1));
+  SlicePool::deallocate(odd);
+  SlicePool::deallocate(huge);
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.hits_, after.hits_);
+  EXPECT_EQ(before.misses_, after.misses_);
+  EXPECT_EQ(before.cached_bytes_, after.cached_bytes_);
+}
+
+TEST_F(SlicePoolTest, CachedBytesAreCapped) {
+  SlicePool::setMaxCachedBytesPerThread(2 * SlicePool::PageSize);
+  const uint64_t baseline = SlicePool::stats().cached_bytes_;
+  void* a = SlicePool::allocate(blockSize(1));
+  void* b = SlicePool::allocate(blockSize(1));
+  void* c = SlicePool::allocate(blockSize(1));
+  SlicePool::deallocate(a);
+  SlicePool::deallocate(b);
+  SlicePool::deallocate(c);
+  EXPECT_EQ(baseline + 2 * SlicePool::PageSize, SlicePool::stats().cached_bytes_);
+
+  // Lowering the limit trims the freelists on the next deallocation.
+  SlicePool::setMaxCachedBytesPerThread(0);
+  SlicePool::deallocate(SlicePool::allocate(blockSize(1)));
+  EXPECT_EQ(baseline, SlicePool::stats().cached_bytes_);
+}
+
+TEST_F(SlicePoolTest, ExitedThreadReleasesCache) {
+  const SlicePoolStats before = SlicePool::stats();
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread([]() {
+    SlicePool::deallocate(SlicePool::allocate(blockSize(4)));
+    SlicePool::deallocate(SlicePool::allocate(blockSize(4)));
+  });
+  thread->join();
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.hits_ + 1, after.hits_);
+  EXPECT_EQ(before.misses_ + 1, after.misses_);
+  EXPECT_EQ(before.cached_bytes_, after.cached_bytes_);
+}
+
+TEST_F(SlicePoolTest, OwnedImplUsesPool) {
+  const std::string data(16384, 'a');
+  {
+    OwnedImpl buffer(data);
+    EXPECT_EQ(data, buffer.toString());
+  }
+  const SlicePoolStats before = SlicePool::stats();
+  {
+    OwnedImpl buffer(data);
+    EXPECT_EQ(data, buffer.toString());
+  }
+  EXPECT_EQ(before.hits_ + 1, SlicePool::stats().hits_);
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
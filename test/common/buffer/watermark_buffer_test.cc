@@ -124,6 +124,28 @@ TEST_F(WatermarkBufferTest, Commit) {
   EXPECT_EQ(20, buffer_.length());
 }
 
+TEST_F(WatermarkBufferTest, AddBufferFragment) {
+  BufferFragmentImpl fragment(TEN_BYTES, 10, nullptr);
+  buffer_.addBufferFragment(fragment);
+  EXPECT_EQ(0, times_high_watermark_called_);
+  BufferFragmentImpl another_fragment(TEN_BYTES, 1, nullptr);
+  buffer_.addBufferFragment(another_fragment);
+  EXPECT_EQ(1, times_high_watermark_called_);
+  EXPECT_EQ(11, buffer_.length());
+}
+
+TEST_F(WatermarkBufferTest, ExtractFrontSlice) {
+  buffer_.add(TEN_BYTES, 10);
+  BufferFragmentImpl fragment(TEN_BYTES, 1, nullptr);
+  buffer_.addBufferFragment(fragment);
+  EXPECT_EQ(1, times_high_watermark_called_);
+
+  SliceDataPtr slice = buffer_.extractFrontSlice();
+  EXPECT_EQ(10, slice->getData().size());
+  EXPECT_EQ(1, buffer_.length());
+  EXPECT_EQ(1, times_low_watermark_called_);
+}
+
 TEST_F(WatermarkBufferTest, Drain) {
   // Draining from above to below the low watermark does nothing if the high
   // watermark never got hit.
@@ -800,6 +800,28 @@ TEST(DateFormatter, FromTimeSameWildcard) {
             DateFormatter("%Y-%m-%dT%H:%M:%S.000Z%1f%2f").fromTime(time1));
 }
 
+TEST(DateFormatter, AppendTime) {
+  const SystemTime time1(std::chrono::seconds(1522796769) + std::chrono::milliseconds(142));
+  const DateFormatter formatter("%Y-%m-%dT%H:%M:%S.%3fZ %s");
+  std::string output = "prefix ";
+  formatter.appendTime(time1, output);
+  EXPECT_EQ("prefix 2018-04-03T23:06:09.142Z 1522796769", output);
+
+  // The second call in the same second comes from the cache, only the subseconds change.
+  const SystemTime time2(std::chrono::seconds(1522796769) + std::chrono::milliseconds(857));
+  formatter.appendTime(time2, output);
+  EXPECT_EQ("prefix 2018-04-03T23:06:09.142Z 15227967692018-04-03T23:06:09.857Z 1522796769",
+            output);
+  EXPECT_EQ(formatter.fromTime(time2), "2018-04-03T23:06:09.857Z 1522796769");
+}
+
+TEST(AccessLogDateTimeFormatter, AppendTime) {
+  const SystemTime time(std::chrono::seconds(1522796769) + std::chrono::milliseconds(142));
+  std::string output = "[";
+  AccessLogDateTimeFormatter::appendTime(time, output);
+  EXPECT_EQ("[2018-04-03T23:06:09.142Z", output);
+}
+
 TEST(TrieLookupTable, AddItems) {
   TrieLookupTable<const char*> trie;
   const char* cstr_a = "a";
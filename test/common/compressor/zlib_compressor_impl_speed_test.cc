@@ -0,0 +1,112 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "common/buffer/buffer_impl.h"
+#include "common/common/fmt.h"
+#include "common/compressor/zlib_compressor_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Compressor {
+
+namespace {
+
+// The response bodies the compressor is benchmarked over. The bodies are generated, so that the
+// results do not depend on files outside of the tree, but they are shaped like the typical
+// compressible responses: JSON API responses, HTML pages and access log like plain text.
+enum class Corpus { Json, Html, Text };
+
+std::string makeCorpus(Corpus corpus, size_t size) {
+  std::string body;
+  body.reserve(size + 256);
+  uint64_t i = 0;
+  while (body.size() < size) {
+    switch (corpus) {
+    case Corpus::Json:
+      body += fmt::format(R"({{"id":{},"name":"user-{}","email":"user{}@example.com",)"
+                          R"("active":{},"score":{},"tags":["alpha","beta","gamma"]}},)",
+                          i, i * 7919 % 1000, i, i % 3 == 0 ? "true" : "false", i * 31 % 997);
+      break;
+    case Corpus::Html:
+      body += fmt::format(R"(<div class="item" id="item-{}"><a href="/products/{}">Product {})"
+                          R"(</a><span class="price">{}.99</span></div>)",
+                          i, i * 13 % 5000, i, i % 100);
+      break;
+    case Corpus::Text:
+      body += fmt::format("[2019-10-{:02}T12:{:02}:{:02}.000Z] \"GET /api/v1/resource/{} "
+                          "HTTP/1.1\" 200 - 0 {} {} \"10.0.{}.{}\" \"curl/7.64.0\"\n",
+                          i % 28 + 1, i % 60, i * 7 % 60, i * 101 % 10000, i * 37 % 4096,
+                          i % 250, i % 256, i * 3 % 256);
+      break;
+    }
+    ++i;
+  }
+  body.resize(size);
+  return body;
+}
+
+ZlibCompressorImpl::CompressionLevel compressionLevel(int64_t level) {
+  switch (level) {
+  case 1:
+    return ZlibCompressorImpl::CompressionLevel::Speed;
+  case 9:
+    return ZlibCompressorImpl::CompressionLevel::Best;
+  default:
+    return ZlibCompressorImpl::CompressionLevel::Standard;
+  }
+}
+
+} // namespace
+
+// Compresses a whole response body, fed to the compressor in slices of the given size as the
+// gzip filter does with the data frames of a response, with the default gzip filter settings.
+// state.range(0) is the corpus, state.range(1) the compression level (1, -1 or 9), state.range(2)
+// the body size and state.range(3) the slice size.
+static void compressCorpus(benchmark::State& state) {
+  const std::string body = makeCorpus(static_cast<Corpus>(state.range(0)), state.range(2));
+  const size_t slice_size = state.range(3);
+  uint64_t compressed_bytes = 0;
+  for (auto _ : state) {
+    ZlibCompressorImpl compressor;
+    compressor.init(compressionLevel(state.range(1)),
+                    ZlibCompressorImpl::CompressionStrategy::Standard, 28, 5);
+    for (size_t offset = 0; offset < body.size(); offset += slice_size) {
+      const size_t length = std::min(slice_size, body.size() - offset);
+      Buffer::OwnedImpl buffer(body.data() + offset, length);
+      compressor.compress(buffer, offset + length == body.size() ? State::Finish : State::Flush);
+      compressed_bytes += buffer.length();
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+  state.counters["ratio"] =
+      static_cast<double>(compressed_bytes) / (state.iterations() * body.size());
+}
+
+static void compressCorpusArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t corpus : {static_cast<int64_t>(Corpus::Json), static_cast<int64_t>(Corpus::Html),
+                         static_cast<int64_t>(Corpus::Text)}) {
+    for (int64_t level : {1, -1, 9}) {
+      b->Args({corpus, level, 64 << 10, 16 << 10});
+    }
+    // Small bodies and small slices, where the per stream and per flush costs dominate.
+    b->Args({corpus, -1, 2 << 10, 2 << 10});
+    b->Args({corpus, -1, 64 << 10, 1 << 10});
+  }
+}
+BENCHMARK(compressCorpus)->Apply(compressCorpusArgs);
+
+} // namespace Compressor
+} // namespace Envoy
+
+// Boilerplate main(), which discovers benchmarks in the same file and runs them.
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -222,6 +222,23 @@ TEST_F(FileSystemImplTest, NonExistingFile) {
   EXPECT_EQ(" new data", contents);
 }
 
+TEST_F(FileSystemImplTest, Writev) {
+  const std::string new_file_path = TestEnvironment::temporaryPath("envoy_this_not_exist");
+  ::unlink(new_file_path.c_str());
+
+  {
+    FilePtr file = file_system_.createFile(new_file_path);
+    const Api::IoCallBoolResult open_result = file->open(DefaultFlags);
+    EXPECT_TRUE(open_result.rc_);
+    const absl::string_view buffers[] = {"first ", "", "second"};
+    const Api::IoCallSizeResult result = file->writev(buffers, 3);
+    EXPECT_EQ(12, result.rc_);
+  }
+
+  auto contents = TestEnvironment::readFileToStringForTest(new_file_path);
+  EXPECT_EQ("first second", contents);
+}
+
 TEST_F(FileSystemImplTest, Close) {
   const std::string new_file_path = TestEnvironment::temporaryPath("envoy_this_not_exist");
   ::unlink(new_file_path.c_str());
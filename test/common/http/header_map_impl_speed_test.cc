@@ -1,3 +1,6 @@
+#include <string>
+#include <vector>
+
 #include "common/http/header_map_impl.h"
 
 #include "benchmark/benchmark.h"
@@ -220,6 +223,99 @@ static void HeaderMapImplPopulate(benchmark::State& state) {
 }
 BENCHMARK(HeaderMapImplPopulate);
 
+/**
+ * A typical browser request as a codec would see it: a mix of inline headers and other headers,
+ * padded with dummy headers up to the requested count.
+ */
+static std::vector<std::pair<std::string, std::string>> requestHeaders(size_t num_headers) {
+  std::vector<std::pair<std::string, std::string>> headers = {
+      {":method", "GET"},
+      {":path", "/api/v1/users/12345/profile?fields=name,email"},
+      {":scheme", "https"},
+      {":authority", "api.example.com"},
+      {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)"},
+      {"accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8"},
+      {"accept-encoding", "gzip, deflate, br"},
+      {"accept-language", "en-US,en;q=0.9"},
+      {"cookie", "session=4f8c2a1b9d7e6f5a3c2b1a0e9d8c7b6a"},
+      {"x-request-id", "9b2f1c3e-4d5a-6b7c-8d9e-0f1a2b3c4d5e"},
+      {"x-forwarded-for", "10.0.0.1"},
+      {"x-forwarded-proto", "https"},
+      {"referer", "https://www.example.com/"},
+      {"cache-control", "no-cache"},
+      {"sec-fetch-mode", "navigate"},
+  };
+  for (size_t i = headers.size(); i < num_headers; i++) {
+    headers.emplace_back("x-custom-header-" + std::to_string(i), "abcd");
+  }
+  headers.resize(num_headers);
+  return headers;
+}
+
+/**
+ * Measure populating a HeaderMapImpl the way codecs do, via addViaMove(). Every insert does a
+ * static table lookup to decide whether the header is inline. The Arg is the number of headers.
+ */
+static void HeaderMapImplAddViaMove(benchmark::State& state) {
+  const auto request_headers = requestHeaders(state.range(0));
+  for (auto _ : state) {
+    HeaderMapImpl headers;
+    for (const auto& header : request_headers) {
+      HeaderString key;
+      key.setCopy(header.first);
+      HeaderString value;
+      value.setCopy(header.second);
+      headers.addViaMove(std::move(key), std::move(value));
+    }
+    benchmark::DoNotOptimize(headers.size());
+  }
+}
+BENCHMARK(HeaderMapImplAddViaMove)->Arg(10)->Arg(20)->Arg(40);
+
+/**
+ * Measure lookup() of every header of a request. Inline headers resolve through the static table,
+ * other headers return NotSupported after the table lookup.
+ */
+static void HeaderMapImplLookup(benchmark::State& state) {
+  const auto request_headers = requestHeaders(state.range(0));
+  std::vector<LowerCaseString> keys;
+  keys.reserve(request_headers.size());
+  HeaderMapImpl headers;
+  for (const auto& header : request_headers) {
+    keys.emplace_back(header.first);
+    headers.addCopy(keys.back(), header.second);
+  }
+  size_t found = 0;
+  for (auto _ : state) {
+    for (const LowerCaseString& key : keys) {
+      const HeaderEntry* entry;
+      found += headers.lookup(key, &entry) == HeaderMap::Lookup::Found;
+    }
+  }
+  benchmark::DoNotOptimize(found);
+}
+BENCHMARK(HeaderMapImplLookup)->Arg(10)->Arg(20)->Arg(40);
+
+/** Measure iterating over all headers of a request. */
+static void HeaderMapImplIterate(benchmark::State& state) {
+  const auto request_headers = requestHeaders(state.range(0));
+  HeaderMapImpl headers;
+  for (const auto& header : request_headers) {
+    headers.addCopy(LowerCaseString(header.first), header.second);
+  }
+  size_t num_bytes = 0;
+  for (auto _ : state) {
+    headers.iterate(
+        [](const HeaderEntry& header, void* context) -> HeaderMap::Iterate {
+          *static_cast<size_t*>(context) += header.key().size() + header.value().size();
+          return HeaderMap::Iterate::Continue;
+        },
+        &num_bytes);
+  }
+  benchmark::DoNotOptimize(num_bytes);
+}
+BENCHMARK(HeaderMapImplIterate)->Arg(10)->Arg(20)->Arg(40);
+
 } // namespace Http
 } // namespace Envoy
 
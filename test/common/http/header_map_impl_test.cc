@@ -1,5 +1,6 @@
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "common/http/header_map_impl.h"
 #include "common/http/header_utility.h"
@@ -881,6 +882,36 @@ TEST(HeaderMapImplTest, Lookup) {
   }
 }
 
+// Every inline header resolves through the static lookup table, and strings that differ from an
+// inline header name only slightly do not.
+TEST(HeaderMapImplTest, LookupAllInlineHeaders) {
+  VerifiedHeaderMapImpl headers;
+  std::vector<std::string> names;
+#define ADD_INLINE_HEADER_NAME(name) names.push_back(Headers::get().name.get());
+  ALL_INLINE_HEADERS(ADD_INLINE_HEADER_NAME)
+#undef ADD_INLINE_HEADER_NAME
+
+  for (const std::string& name : names) {
+    const HeaderEntry* entry;
+    EXPECT_EQ(HeaderMap::Lookup::NotFound, headers.lookup(LowerCaseString(name), &entry)) << name;
+
+    std::string last_char_changed = name;
+    last_char_changed.back() = last_char_changed.back() == 'z' ? 'y' : 'z';
+    EXPECT_EQ(HeaderMap::Lookup::NotSupported,
+              headers.lookup(LowerCaseString(last_char_changed), &entry))
+        << last_char_changed;
+    EXPECT_EQ(HeaderMap::Lookup::NotSupported, headers.lookup(LowerCaseString(name + "-"), &entry))
+        << name;
+    EXPECT_EQ(HeaderMap::Lookup::NotSupported,
+              headers.lookup(LowerCaseString(name.substr(0, name.size() - 1)), &entry))
+        << name;
+  }
+
+  // The legacy host header maps onto :authority.
+  headers.addCopy(LowerCaseString("host"), "example.com");
+  EXPECT_EQ("example.com", headers.Host()->value().getStringView());
+}
+
 TEST(HeaderMapImplTest, Get) {
   {
     const VerifiedHeaderMapImpl headers{{Headers::get().Path, "/"},
@@ -1080,6 +1080,50 @@ TEST_F(Http1ServerConnectionImplTest, DoubleRequest) {
   EXPECT_EQ(0U, buffer.length());
 }
 
+// Same as DoubleRequest, with the request body split across dispatches and parsed by
+// FastHttpParserImpl.
+TEST_F(Http1ServerConnectionImplTest, DoubleRequestFastParser) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.http1_fast_parser", "true"}});
+  initialize();
+
+  NiceMock<Http::MockStreamDecoder> decoder;
+  Http::StreamEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](Http::StreamEncoder& encoder, bool) -> Http::StreamDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  TestHeaderMapImpl expected_headers{
+      {":path", "/foo?bar=baz"}, {":method", "POST"}, {"content-length", "11"}};
+  EXPECT_CALL(decoder, decodeHeaders_(HeaderMapEqual(&expected_headers), false)).Times(2);
+  Buffer::OwnedImpl expected_data1("Hello");
+  EXPECT_CALL(decoder, decodeData(BufferEqual(&expected_data1), false));
+  Buffer::OwnedImpl expected_data2(" World");
+  EXPECT_CALL(decoder, decodeData(BufferEqual(&expected_data2), false));
+  Buffer::OwnedImpl expected_data3("Hello World");
+  EXPECT_CALL(decoder, decodeData(BufferEqual(&expected_data3), false));
+  EXPECT_CALL(decoder, decodeData(_, true)).Times(2);
+
+  const std::string request("POST /foo?bar=baz HTTP/1.1\r\ncontent-length: 11\r\n\r\nHello World");
+  Buffer::OwnedImpl buffer(request.substr(0, request.size() - 6));
+  codec_->dispatch(buffer);
+  EXPECT_EQ(0U, buffer.length());
+
+  buffer.add(request.substr(request.size() - 6));
+  buffer.add(request);
+  codec_->dispatch(buffer);
+  EXPECT_EQ(request.size(), buffer.length());
+
+  response_encoder->encodeHeaders(TestHeaderMapImpl{{":status", "200"}}, true);
+
+  codec_->dispatch(buffer);
+  EXPECT_EQ(0U, buffer.length());
+}
+
 TEST_F(Http1ServerConnectionImplTest, RequestWithTrailersDropped) { expectTrailersTest(false); }
 
 TEST_F(Http1ServerConnectionImplTest, RequestWithTrailersKept) { expectTrailersTest(true); }
@@ -1469,6 +1513,31 @@ TEST_F(Http1ClientConnectionImplTest, ResponseWithTrailers) {
   EXPECT_EQ(0UL, response.length());
 }
 
+TEST_F(Http1ClientConnectionImplTest, ChunkedResponseFastParser) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.http1_fast_parser", "true"}});
+  initialize();
+
+  InSequence sequence;
+
+  NiceMock<Http::MockStreamDecoder> response_decoder;
+  Http::StreamEncoder& request_encoder = codec_->newStream(response_decoder);
+  TestHeaderMapImpl headers{{":method", "GET"}, {":path", "/"}, {":authority", "host"}};
+  request_encoder.encodeHeaders(headers, true);
+
+  TestHeaderMapImpl expected_headers{{":status", "200"}, {"transfer-encoding", "chunked"}};
+  EXPECT_CALL(response_decoder, decodeHeaders_(HeaderMapEqual(&expected_headers), false));
+  Buffer::OwnedImpl expected_data("Hello World");
+  EXPECT_CALL(response_decoder, decodeData(BufferEqual(&expected_data), false));
+  EXPECT_CALL(response_decoder, decodeData(_, true));
+
+  Buffer::OwnedImpl response("HTTP/1.1 200 OK\r\ntransfer-encoding: chunked\r\n\r\nb;ext=1\r\n"
+                             "Hello World\r\n0\r\n\r\n");
+  codec_->dispatch(response);
+  EXPECT_EQ(0UL, response.length());
+}
+
 TEST_F(Http1ClientConnectionImplTest, GiantPath) {
   initialize();
 
@@ -0,0 +1,164 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/http/codec.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/http/http2/codec_impl.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+
+/**
+ * Drops the data of a stream. On the server side it also answers a complete request with a 200.
+ */
+class DrainingDecoder : public StreamDecoder {
+public:
+  // Http::StreamDecoder
+  void decode100ContinueHeaders(HeaderMapPtr&&) override {}
+  void decodeHeaders(HeaderMapPtr&&, bool) override {}
+  void decodeData(Buffer::Instance& data, bool end_stream) override {
+    data.drain(data.length());
+    if (end_stream && response_encoder_ != nullptr) {
+      TestHeaderMapImpl response_headers{{":status", "200"}};
+      response_encoder_->encodeHeaders(response_headers, true);
+    }
+  }
+  void decodeTrailers(HeaderMapPtr&&) override {}
+  void decodeMetadata(MetadataMapPtr&&) override {}
+
+  StreamEncoder* response_encoder_{};
+};
+
+class ServerCallbacks : public ServerConnectionCallbacks {
+public:
+  // Http::ConnectionCallbacks
+  void onGoAway() override {}
+
+  // Http::ServerConnectionCallbacks
+  StreamDecoder& newStream(StreamEncoder& response_encoder, bool) override {
+    decoders_.emplace_back();
+    decoders_.back().response_encoder_ = &response_encoder;
+    return decoders_.back();
+  }
+
+  std::list<DrainingDecoder> decoders_;
+};
+
+class ClientCallbacks : public ConnectionCallbacks {
+public:
+  // Http::ConnectionCallbacks
+  void onGoAway() override {}
+};
+
+/**
+ * Connects a client and a server codec in memory. The client output is cut into 16 KiB slices,
+ * the way the server connection would read it from a socket.
+ */
+class CodecSpeedTest {
+public:
+  CodecSpeedTest() {
+    ON_CALL(client_connection_, write(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) { client_output_.move(data); }));
+    ON_CALL(server_connection_, write(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) { client_->dispatch(data); }));
+    client_ = std::make_unique<ClientConnectionImpl>(
+        client_connection_, client_callbacks_, stats_store_, http2_settings_,
+        DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT);
+    server_ = std::make_unique<ServerConnectionImpl>(
+        server_connection_, server_callbacks_, stats_store_, http2_settings_,
+        DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT);
+  }
+
+  /**
+   * Sends requests with a 1 MiB body on the given number of concurrent streams and times the
+   * server decoding them.
+   */
+  void test(benchmark::State& state, uint64_t streams) {
+    const std::string body(BodySize, 'a');
+    for (auto _ : state) {
+      state.PauseTiming();
+      for (uint64_t i = 0; i < streams; ++i) {
+        StreamEncoder& request_encoder = client_->newStream(response_decoder_);
+        TestHeaderMapImpl request_headers{
+            {":method", "POST"}, {":path", "/"}, {":scheme", "http"}, {":authority", "host"}};
+        request_encoder.encodeHeaders(request_headers, false);
+        Buffer::OwnedImpl data(body);
+        request_encoder.encodeData(data, true);
+      }
+      readClientOutput();
+      state.ResumeTiming();
+
+      server_->dispatch(server_input_);
+
+      state.PauseTiming();
+      client_connection_.dispatcher_.to_delete_.clear();
+      server_connection_.dispatcher_.to_delete_.clear();
+      server_callbacks_.decoders_.clear();
+      state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * streams * BodySize);
+  }
+
+private:
+  static constexpr uint64_t BodySize = 1024 * 1024;
+  static constexpr uint64_t ReadSize = 16384;
+
+  void readClientOutput() {
+    while (client_output_.length() > 0) {
+      const uint64_t size = std::min(ReadSize, client_output_.length());
+      server_input_.appendSliceForTest(client_output_.linearize(size), size);
+      client_output_.drain(size);
+    }
+  }
+
+  Stats::IsolatedStoreImpl stats_store_;
+  Http2Settings http2_settings_;
+  NiceMock<Network::MockConnection> client_connection_;
+  NiceMock<Network::MockConnection> server_connection_;
+  ClientCallbacks client_callbacks_;
+  ServerCallbacks server_callbacks_;
+  DrainingDecoder response_decoder_;
+  Buffer::OwnedImpl client_output_;
+  Buffer::OwnedImpl server_input_;
+  std::unique_ptr<ClientConnectionImpl> client_;
+  std::unique_ptr<ServerConnectionImpl> server_;
+};
+
+// The argument is the number of concurrent streams.
+static void BM_DecodeLargeBodies(benchmark::State& state) {
+  CodecSpeedTest speed_test;
+  speed_test.test(state, state.range(0));
+}
+BENCHMARK(BM_DecodeLargeBodies)->Arg(1)->Arg(16)->Arg(100)->Unit(benchmark::kMillisecond);
+
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
+
+// Boilerplate main(), which discovers benchmarks in the same file and runs them.
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
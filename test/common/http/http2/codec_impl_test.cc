@@ -285,6 +285,8 @@ TEST_P(Http2CodecImplTest, InvalidContinueWithFin) {
   TestHeaderMapImpl continue_headers{{":status", "100"}};
   EXPECT_THROW(response_encoder_->encodeHeaders(continue_headers, true), CodecProtocolException);
   EXPECT_EQ(1, stats_store_.counter("http2.rx_messaging_error").value());
+  // dispatch() drains each slice before parsing it, so the slice with the invalid frame is gone.
+  EXPECT_EQ(0, client_wrapper_.buffer_.length());
 }
 
 TEST_P(Http2CodecImplTest, InvalidContinueWithFinAllowed) {
@@ -523,6 +525,88 @@ TEST_P(Http2CodecImplTest, TrailingHeaders) {
   response_encoder_->encodeTrailers(TestHeaderMapImpl{{"trailing", "header"}});
 }
 
+// DATA payloads large enough to be passed to the stream as references into the dispatched slices
+// arrive complete and in order.
+TEST_P(Http2CodecImplTest, LargeBody) {
+  initialize();
+
+  TestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  request_encoder_->encodeHeaders(request_headers, false);
+
+  std::string body;
+  for (uint64_t i = 0; body.size() < 256 * 1024; ++i) {
+    body += std::to_string(i);
+  }
+  std::string received;
+  EXPECT_CALL(request_decoder_, decodeData(_, _))
+      .WillRepeatedly(Invoke([&received](Buffer::Instance& data, bool) -> void {
+        received += data.toString();
+        data.drain(data.length());
+      }));
+  Buffer::OwnedImpl body_buffer(body);
+  request_encoder_->encodeData(body_buffer, true);
+  EXPECT_EQ(body, received);
+}
+
+// A DATA payload is only referenced if it makes up most of the read slice, so that it does not keep
+// a much larger slice alive. Otherwise it is copied.
+TEST_P(Http2CodecImplTest, LargeBodyReferencesOnlyMostlyFullSlices) {
+  initialize();
+
+  TestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  request_encoder_->encodeHeaders(request_headers, false);
+
+  // Capture the DATA frames of the body instead of dispatching them to the server.
+  std::string frames;
+  ON_CALL(client_connection_, write(_, _))
+      .WillByDefault(Invoke([&frames](Buffer::Instance& data, bool) -> void {
+        frames += data.toString();
+        data.drain(data.length());
+      }));
+  Buffer::OwnedImpl body(std::string(8192, 'a'));
+  request_encoder_->encodeData(body, false);
+
+  const uint8_t* input_begin = nullptr;
+  const uint8_t* input_end = nullptr;
+  bool referenced = false;
+  EXPECT_CALL(request_decoder_, decodeData(_, false))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data, bool) -> void {
+        EXPECT_EQ(std::string(8192, 'a'), data.toString());
+        Buffer::RawSlice slice;
+        data.getRawSlices(&slice, 1);
+        const uint8_t* mem = static_cast<const uint8_t*>(slice.mem_);
+        referenced = mem >= input_begin && mem < input_end;
+        data.drain(data.length());
+      }));
+
+  // The slice holds little more than the frame.
+  Buffer::BufferFragmentImpl fragment(frames.data(), frames.size(), nullptr);
+  Buffer::OwnedImpl exact;
+  exact.addBufferFragment(fragment);
+  input_begin = reinterpret_cast<const uint8_t*>(frames.data());
+  input_end = input_begin + frames.size();
+  server_->dispatch(exact);
+  EXPECT_TRUE(referenced);
+
+  // The slice has room for eight times the frame.
+  Buffer::OwnedImpl large;
+  Buffer::RawSlice reservation;
+  large.reserve(8 * frames.size(), &reservation, 1);
+  ASSERT_GE(reservation.len_, 8 * frames.size());
+  memcpy(reservation.mem_, frames.data(), frames.size());
+  reservation.len_ = frames.size();
+  large.commit(&reservation, 1);
+  input_begin = static_cast<const uint8_t*>(reservation.mem_);
+  input_end = input_begin + frames.size();
+  server_->dispatch(large);
+  EXPECT_FALSE(referenced);
+}
+
 TEST_P(Http2CodecImplTest, TrailingHeadersLargeBody) {
   initialize();
 
@@ -1,8 +1,17 @@
+#include "common/network/address_impl.h"
 #include "common/network/io_socket_error_impl.h"
 #include "common/network/io_socket_handle_impl.h"
 
+#include "test/mocks/api/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
 namespace Envoy {
 namespace Network {
 namespace {
@@ -36,6 +45,132 @@ TEST(IoSocketHandleImplTest, TestIoSocketError) {
   EXPECT_EQ(::strerror(123), error7.getErrorDetails());
 }
 
+class IoSocketHandleImplSendTest : public testing::Test {
+protected:
+  IoSocketHandleImplSendTest()
+      : os_calls_(&os_sys_calls_), peer_(new Address::Ipv4Instance("127.0.0.1", 1234)),
+        other_peer_(new Address::Ipv4Instance("127.0.0.1", 1235)) {}
+
+  ~IoSocketHandleImplSendTest() override {
+    // Don't close the fake fd.
+    EXPECT_CALL(os_sys_calls_, close(_)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  }
+
+  IoHandle::SendMsgEntry message(std::string& payload, const Address::Instance& peer) {
+    slices_.push_back(std::make_unique<Buffer::RawSlice>(
+        Buffer::RawSlice{const_cast<char*>(payload.data()), payload.size()}));
+    return {slices_.back().get(), 1, nullptr, &peer};
+  }
+
+  Api::MockOsSysCalls os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_;
+  Address::InstanceConstSharedPtr peer_;
+  Address::InstanceConstSharedPtr other_peer_;
+  std::vector<std::unique_ptr<Buffer::RawSlice>> slices_;
+  IoSocketHandleImpl io_handle_{42};
+};
+
+// Messages of one size to one peer are sent as a single GSO datagram.
+TEST_F(IoSocketHandleImplSendTest, SendmmsgUsesGso) {
+  std::string first(100, 'a');
+  std::string second(100, 'b');
+  std::string last(10, 'c');
+  std::vector<IoHandle::SendMsgEntry> messages{message(first, *peer_), message(second, *peer_),
+                                               message(last, *peer_)};
+
+  EXPECT_CALL(os_sys_calls_, supportsUdpGso()).WillOnce(Return(true));
+  EXPECT_CALL(os_sys_calls_, sendmsg(42, _, 0))
+      .WillOnce(Invoke([](int, const msghdr* message, int) {
+        EXPECT_EQ(3, message->msg_iovlen);
+        const cmsghdr* cmsg = CMSG_FIRSTHDR(message);
+        EXPECT_NE(nullptr, cmsg);
+        EXPECT_EQ(SOL_UDP, cmsg->cmsg_level);
+        EXPECT_EQ(UDP_SEGMENT, cmsg->cmsg_type);
+        EXPECT_EQ(100, *reinterpret_cast<const uint16_t*>(CMSG_DATA(cmsg)));
+        return Api::SysCallSizeResult{210, 0};
+      }));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(_, _, _, _)).Times(0);
+
+  Api::IoCallUint64Result result = io_handle_.sendmmsg(messages.data(), messages.size());
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(3, result.rc_);
+}
+
+// Messages to different peers can't be segmented and are batched with sendmmsg() instead.
+TEST_F(IoSocketHandleImplSendTest, SendmmsgWithoutGso) {
+  std::string first(100, 'a');
+  std::string second(100, 'b');
+  std::vector<IoHandle::SendMsgEntry> messages{message(first, *peer_),
+                                               message(second, *other_peer_)};
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _)).Times(0);
+  EXPECT_CALL(os_sys_calls_, supportsMmsg()).WillOnce(Return(true));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(42, _, 2, 0))
+      .WillOnce(Invoke([](int, struct mmsghdr* msgvec, unsigned int, int) {
+        EXPECT_EQ(1, msgvec[0].msg_hdr.msg_iovlen);
+        EXPECT_EQ(nullptr, msgvec[0].msg_hdr.msg_control);
+        EXPECT_EQ(1, msgvec[1].msg_hdr.msg_iovlen);
+        // The socket buffer filled up after the first message.
+        return Api::SysCallIntResult{1, 0};
+      }));
+
+  Api::IoCallUint64Result result = io_handle_.sendmmsg(messages.data(), messages.size());
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(1, result.rc_);
+}
+
+// Empty messages are skipped like sendmsg() does, but still count as sent.
+TEST_F(IoSocketHandleImplSendTest, SendmmsgSkipsEmptyMessages) {
+  std::string empty;
+  std::string first(100, 'a');
+  std::string second(100, 'b');
+  std::vector<IoHandle::SendMsgEntry> messages{message(first, *peer_), message(empty, *peer_),
+                                               message(second, *other_peer_),
+                                               message(empty, *other_peer_)};
+
+  EXPECT_CALL(os_sys_calls_, supportsMmsg()).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(42, _, 2, 0))
+      .WillOnce(Invoke([](int, struct mmsghdr* msgvec, unsigned int, int) {
+        EXPECT_EQ(100, msgvec[0].msg_hdr.msg_iov[0].iov_len);
+        EXPECT_EQ(100, msgvec[1].msg_hdr.msg_iov[0].iov_len);
+        return Api::SysCallIntResult{2, 0};
+      }))
+      .WillOnce(Return(Api::SysCallIntResult{1, 0}));
+
+  Api::IoCallUint64Result result = io_handle_.sendmmsg(messages.data(), messages.size());
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(4, result.rc_);
+
+  // Only the first message was sent, so the empty message before the unsent one counts as sent.
+  result = io_handle_.sendmmsg(messages.data(), messages.size());
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(2, result.rc_);
+
+  // Nothing to send at all.
+  std::vector<IoHandle::SendMsgEntry> empty_messages{message(empty, *peer_)};
+  EXPECT_CALL(os_sys_calls_, sendmmsg(_, _, _, _)).Times(0);
+  result = io_handle_.sendmmsg(empty_messages.data(), empty_messages.size());
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(1, result.rc_);
+}
+
+// Without sendmmsg() the messages are sent one by one until the first error.
+TEST_F(IoSocketHandleImplSendTest, SendmmsgFallsBackToSendmsg) {
+  std::string first(100, 'a');
+  std::string second(100, 'b');
+  std::vector<IoHandle::SendMsgEntry> messages{message(first, *peer_),
+                                               message(second, *other_peer_)};
+
+  EXPECT_CALL(os_sys_calls_, supportsMmsg()).WillOnce(Return(false));
+  EXPECT_CALL(os_sys_calls_, sendmsg(42, _, 0))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+
+  Api::IoCallUint64Result result = io_handle_.sendmmsg(messages.data(), messages.size());
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(1, result.rc_);
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
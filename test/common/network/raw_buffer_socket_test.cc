@@ -0,0 +1,155 @@
+#include <sys/ioctl.h>
+
+#include "common/buffer/buffer_impl.h"
+#include "common/network/io_socket_error_impl.h"
+#include "common/network/raw_buffer_socket.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::ByMove;
+using testing::Invoke;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+Api::IoCallUint64Result readResult(uint64_t rc) {
+  return Api::IoCallUint64Result(rc, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+}
+
+Api::IoCallUint64Result againResult() {
+  return Api::IoCallUint64Result(
+      0, Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(), IoSocketError::deleteIoError));
+}
+
+class ReadSizeControllerTest : public testing::Test {
+protected:
+  ReadSizeControllerTest() : config_(4096, 65536, false, store_) {}
+
+  Stats::IsolatedStoreImpl store_;
+  AdaptiveReadSizeConfig config_;
+};
+
+TEST_F(ReadSizeControllerTest, GrowsOnFullReads) {
+  ReadSizeController controller(config_);
+  EXPECT_EQ(16384, controller.readSize());
+  controller.onRead(16384);
+  EXPECT_EQ(32768, controller.readSize());
+  controller.onRead(32768);
+  EXPECT_EQ(65536, controller.readSize());
+  // Capped at the maximum.
+  controller.onRead(65536);
+  EXPECT_EQ(65536, controller.readSize());
+  EXPECT_EQ(2, store_.counter("raw_buffer.read_size_increased").value());
+}
+
+TEST_F(ReadSizeControllerTest, ShrinksOnSmallReads) {
+  ReadSizeController controller(config_);
+  // A read that returns more than a quarter of the read size leaves the size alone.
+  controller.onRead(8192);
+  EXPECT_EQ(16384, controller.readSize());
+  controller.onRead(100);
+  EXPECT_EQ(8192, controller.readSize());
+  controller.onRead(100);
+  EXPECT_EQ(4096, controller.readSize());
+  // Floored at the minimum.
+  controller.onRead(100);
+  EXPECT_EQ(4096, controller.readSize());
+  EXPECT_EQ(2, store_.counter("raw_buffer.read_size_decreased").value());
+}
+
+TEST_F(ReadSizeControllerTest, PendingBytes) {
+  ReadSizeController controller(config_);
+  // Pending bytes never shrink the read size; shrinking is left to onRead().
+  controller.onPendingBytes(10);
+  EXPECT_EQ(16384, controller.readSize());
+  controller.onPendingBytes(40000);
+  EXPECT_EQ(40000, controller.readSize());
+  controller.onPendingBytes(1000000);
+  EXPECT_EQ(65536, controller.readSize());
+  EXPECT_EQ(2, store_.counter("raw_buffer.read_size_from_pending_bytes").value());
+}
+
+TEST_F(ReadSizeControllerTest, InitialSizeClampedToBounds) {
+  AdaptiveReadSizeConfig small_config(1024, 8192, false, store_);
+  EXPECT_EQ(8192, ReadSizeController(small_config).readSize());
+  AdaptiveReadSizeConfig large_config(32768, 65536, false, store_);
+  EXPECT_EQ(32768, ReadSizeController(large_config).readSize());
+}
+
+class RawBufferSocketTest : public testing::Test {
+protected:
+  void initialize(bool use_pending_bytes) {
+    socket_ = std::make_unique<RawBufferSocket>(
+        std::make_shared<AdaptiveReadSizeConfig>(4096, 65536, use_pending_bytes, store_));
+    socket_->setTransportSocketCallbacks(callbacks_);
+    ON_CALL(callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle_));
+    ON_CALL(callbacks_, connection()).WillByDefault(ReturnRef(callbacks_.connection_));
+    ON_CALL(callbacks_, shouldDrainReadBuffer()).WillByDefault(Return(false));
+    ON_CALL(io_handle_, fd()).WillByDefault(Return(10));
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  testing::NiceMock<MockTransportSocketCallbacks> callbacks_;
+  testing::NiceMock<MockIoHandle> io_handle_;
+  std::unique_ptr<RawBufferSocket> socket_;
+};
+
+TEST_F(RawBufferSocketTest, ReadSizeAdapts) {
+  initialize(false);
+  Buffer::OwnedImpl buffer;
+  testing::InSequence s;
+  // A full read doubles the read size, and a small read halves it again.
+  EXPECT_CALL(io_handle_, readv(16384, _, _)).WillOnce(Return(ByMove(readResult(16384))));
+  EXPECT_CALL(io_handle_, readv(32768, _, _)).WillOnce(Return(ByMove(readResult(100))));
+  EXPECT_CALL(io_handle_, readv(16384, _, _)).WillOnce(Return(ByMove(againResult())));
+  IoResult result = socket_->doRead(buffer);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(16484, result.bytes_processed_);
+  EXPECT_EQ(16484, buffer.length());
+}
+
+TEST_F(RawBufferSocketTest, ReadSizedFromPendingBytes) {
+  initialize(true);
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  EXPECT_CALL(os_sys_calls, ioctl(10, FIONREAD, _))
+      .WillOnce(Invoke([](int, unsigned long int, void* argp) {
+        *static_cast<int*>(argp) = 50000;
+        return Api::SysCallIntResult{0, 0};
+      }));
+  Buffer::OwnedImpl buffer;
+  EXPECT_CALL(io_handle_, readv(50000, _, _)).WillOnce(Return(ByMove(readResult(50000))));
+  EXPECT_CALL(io_handle_, readv(65536, _, _)).WillOnce(Return(ByMove(readResult(0))));
+  IoResult result = socket_->doRead(buffer);
+  EXPECT_TRUE(result.end_stream_read_);
+  EXPECT_EQ(50000, result.bytes_processed_);
+  EXPECT_EQ(1, store_.counter("raw_buffer.read_size_from_pending_bytes").value());
+}
+
+TEST_F(RawBufferSocketTest, FixedReadSizeWithoutConfig) {
+  RawBufferSocket socket;
+  socket.setTransportSocketCallbacks(callbacks_);
+  ON_CALL(callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle_));
+  ON_CALL(callbacks_, connection()).WillByDefault(ReturnRef(callbacks_.connection_));
+  Buffer::OwnedImpl buffer;
+  EXPECT_CALL(io_handle_, readv(16384, _, _))
+      .WillOnce(Return(ByMove(readResult(16384))))
+      .WillOnce(Return(ByMove(againResult())));
+  IoResult result = socket.doRead(buffer);
+  EXPECT_EQ(16384, result.bytes_processed_);
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
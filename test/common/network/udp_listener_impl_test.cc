@@ -170,6 +170,42 @@ TEST_P(UdpListenerImplTest, UseActualDstUdp) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+/**
+ * Tests that a UDP listener with a packet budget of one still reads all packets, one per event
+ * loop iteration.
+ */
+TEST_P(UdpListenerImplTest, ReadPacketBudget) {
+  UdpReadOptions read_options;
+  read_options.max_packets_per_event_ = 1;
+  listener_ = std::make_unique<UdpListenerImpl>(dispatcherImpl(), server_socket_,
+                                                listener_callbacks_,
+                                                dispatcherImpl().timeSource(), read_options);
+  client_socket_ = createClientSocket(false);
+
+  const std::vector<std::string> payloads{"first", "second", "third"};
+  for (const std::string& payload : payloads) {
+    Buffer::RawSlice slice{const_cast<char*>(payload.data()), payload.length()};
+    auto send_rc = Network::Utility::writeToSocket(client_socket_->ioHandle(), &slice, 1,
+                                                   nullptr, *send_to_addr_);
+    ASSERT_EQ(send_rc.rc_, payload.length());
+  }
+
+  std::vector<std::string> received;
+  EXPECT_CALL(listener_callbacks_, onData(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](const UdpRecvData& data) -> void {
+        received.push_back(data.buffer_->toString());
+        if (received.size() == payloads.size()) {
+          dispatcher_->exit();
+        }
+      }));
+  EXPECT_CALL(listener_callbacks_, onWriteReady(_)).Times(testing::AnyNumber());
+  EXPECT_CALL(listener_callbacks_, onReceiveError(_)).Times(0);
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(payloads, received);
+}
+
 /**
  * Tests UDP listener for read and write callbacks with actual data.
  */
@@ -422,6 +458,41 @@ TEST_P(UdpListenerImplTest, SendData) {
   EXPECT_EQ(data.buffer_->toString(), payload);
 }
 
+/**
+ * Tests UDP listener for sending several datagrams with one call.
+ */
+TEST_P(UdpListenerImplTest, SendBatchData) {
+  client_socket_ = createClientSocket(true);
+  ASSERT_NE(client_socket_, nullptr);
+
+  Buffer::OwnedImpl first("first");
+  Buffer::OwnedImpl second("second");
+  const std::vector<UdpSendData> send_data{
+      {nullptr, *client_socket_->localAddress(), first},
+      {nullptr, *client_socket_->localAddress(), second}};
+
+  auto send_result = listener_->sendBatch(send_data.data(), send_data.size());
+  ASSERT_TRUE(send_result.ok()) << "sendBatch() failed : " << send_result.err_->getErrorDetails();
+  EXPECT_EQ(2, send_result.rc_);
+  EXPECT_EQ(0, first.length());
+  EXPECT_EQ(0, second.length());
+
+  std::vector<std::string> received;
+  for (int retry = 0; received.size() < 2 && retry < 10;) {
+    UdpRecvData data;
+    Api::IoCallUint64Result result = Network::Test::readFromSocket(
+        client_socket_->ioHandle(), *client_socket_->localAddress(), data);
+    if (result.ok()) {
+      received.push_back(data.buffer_->toString());
+    } else {
+      ASSERT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+      retry++;
+      ::usleep(10000);
+    }
+  }
+  EXPECT_EQ((std::vector<std::string>{"first", "second"}), received);
+}
+
 /**
  * The send fails because the server_socket is created with bind=false.
  */
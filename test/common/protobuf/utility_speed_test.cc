@@ -0,0 +1,121 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/api/v2/cds.pb.h"
+#include "envoy/api/v2/rds.pb.h"
+
+#include "common/common/hash.h"
+#include "common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+
+// The hash MessageUtil::hash() used to compute, printing the message as text, for comparison.
+static uint64_t textFormatHash(const Protobuf::Message& message) {
+  std::string text_format;
+  Protobuf::TextFormat::Printer printer;
+  printer.SetExpandAny(true);
+  printer.SetUseFieldNumber(true);
+  printer.SetSingleLineMode(true);
+  printer.PrintToString(message, &text_format);
+  return HashUtil::xxHash64(text_format);
+}
+
+// A cluster with the given number of endpoints, spread over 10 localities.
+static envoy::api::v2::Cluster makeCluster(int endpoints) {
+  envoy::api::v2::Cluster cluster;
+  cluster.set_name("cluster");
+  cluster.set_type(envoy::api::v2::Cluster::EDS);
+  cluster.mutable_connect_timeout()->set_seconds(1);
+  cluster.mutable_eds_cluster_config()->set_service_name("service");
+  auto& metadata = (*cluster.mutable_metadata()->mutable_filter_metadata())["envoy.lb"];
+  (*metadata.mutable_fields())["version"].set_string_value("1.0");
+  (*metadata.mutable_fields())["stage"].set_string_value("prod");
+
+  auto* load_assignment = cluster.mutable_load_assignment();
+  load_assignment->set_cluster_name("cluster");
+  for (int i = 0; i < 10; ++i) {
+    auto* locality = load_assignment->add_endpoints();
+    locality->mutable_locality()->set_zone(absl::StrCat("zone_", i));
+    for (int j = i; j < endpoints; j += 10) {
+      auto* address = locality->add_lb_endpoints()
+                          ->mutable_endpoint()
+                          ->mutable_address()
+                          ->mutable_socket_address();
+      address->set_address(absl::StrCat("10.0.", j / 256, ".", j % 256));
+      address->set_port_value(8080);
+    }
+  }
+  return cluster;
+}
+
+// A route configuration with the given number of virtual hosts of 10 routes each. Each route has
+// a per filter config packed in an Any.
+static envoy::api::v2::RouteConfiguration makeRouteConfiguration(int virtual_hosts) {
+  ProtobufWkt::Struct filter_config;
+  (*filter_config.mutable_fields())["enabled"].set_bool_value(true);
+  (*filter_config.mutable_fields())["limit"].set_number_value(100);
+
+  envoy::api::v2::RouteConfiguration route_configuration;
+  route_configuration.set_name("routes");
+  for (int i = 0; i < virtual_hosts; ++i) {
+    auto* virtual_host = route_configuration.add_virtual_hosts();
+    virtual_host->set_name(absl::StrCat("host_", i));
+    virtual_host->add_domains(absl::StrCat("host", i, ".example.com"));
+    for (int j = 0; j < 10; ++j) {
+      auto* route = virtual_host->add_routes();
+      route->mutable_match()->set_prefix(absl::StrCat("/path_", j));
+      route->mutable_route()->set_cluster(absl::StrCat("cluster_", i, "_", j));
+      (*route->mutable_typed_per_filter_config())["envoy.filter"].PackFrom(filter_config);
+    }
+  }
+  return route_configuration;
+}
+
+static void BM_HashCluster(benchmark::State& state) {
+  const envoy::api::v2::Cluster cluster = makeCluster(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MessageUtil::hash(cluster));
+  }
+}
+BENCHMARK(BM_HashCluster)->Arg(100)->Arg(10000);
+
+static void BM_TextFormatHashCluster(benchmark::State& state) {
+  const envoy::api::v2::Cluster cluster = makeCluster(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(textFormatHash(cluster));
+  }
+}
+BENCHMARK(BM_TextFormatHashCluster)->Arg(100)->Arg(10000);
+
+static void BM_HashRouteConfiguration(benchmark::State& state) {
+  const envoy::api::v2::RouteConfiguration route_configuration =
+      makeRouteConfiguration(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MessageUtil::hash(route_configuration));
+  }
+}
+BENCHMARK(BM_HashRouteConfiguration)->Arg(10)->Arg(1000);
+
+static void BM_TextFormatHashRouteConfiguration(benchmark::State& state) {
+  const envoy::api::v2::RouteConfiguration route_configuration =
+      makeRouteConfiguration(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(textFormatHash(route_configuration));
+  }
+}
+BENCHMARK(BM_TextFormatHashRouteConfiguration)->Arg(10)->Arg(1000);
+
+} // namespace Envoy
+
+// Boilerplate main(), which discovers benchmarks in the same file and runs them.
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -145,6 +145,52 @@ TEST_F(ProtobufUtilityTest, MessageUtilHash) {
   EXPECT_EQ(MessageUtil::hash(a2), MessageUtil::hash(a3));
   EXPECT_NE(0, MessageUtil::hash(a1));
   EXPECT_NE(MessageUtil::hash(s), MessageUtil::hash(a1));
+
+  // Any of an unknown type hashes the packed bytes.
+  ProtobufWkt::Any unknown1;
+  unknown1.set_type_url("type.googleapis.com/unknown.Type");
+  unknown1.set_value("foo");
+  ProtobufWkt::Any unknown2 = unknown1;
+  EXPECT_EQ(MessageUtil::hash(unknown1), MessageUtil::hash(unknown2));
+  unknown2.set_value("bar");
+  EXPECT_NE(MessageUtil::hash(unknown1), MessageUtil::hash(unknown2));
+}
+
+TEST_F(ProtobufUtilityTest, MessageUtilHashFields) {
+  ProtobufWkt::Struct s1;
+  (*s1.mutable_fields())["ab"].set_string_value("fgh");
+  ProtobufWkt::Struct s2 = s1;
+  EXPECT_EQ(MessageUtil::hash(s1), MessageUtil::hash(s2));
+
+  // The map values, the map keys and the nesting of the fields are all hashed.
+  (*s2.mutable_fields())["ab"].set_string_value("fgi");
+  EXPECT_NE(MessageUtil::hash(s1), MessageUtil::hash(s2));
+  s2.Clear();
+  (*s2.mutable_fields())["ac"].set_string_value("fgh");
+  EXPECT_NE(MessageUtil::hash(s1), MessageUtil::hash(s2));
+  s2.Clear();
+  (*(*s2.mutable_fields())["ab"].mutable_struct_value()->mutable_fields())["ab"].set_string_value(
+      "fgh");
+  EXPECT_NE(MessageUtil::hash(s1), MessageUtil::hash(s2));
+
+  // The order of repeated fields is hashed.
+  ProtobufWkt::ListValue l1;
+  l1.add_values()->set_number_value(1);
+  l1.add_values()->set_number_value(2);
+  ProtobufWkt::ListValue l2;
+  l2.add_values()->set_number_value(2);
+  l2.add_values()->set_number_value(1);
+  EXPECT_NE(MessageUtil::hash(l1), MessageUtil::hash(l2));
+
+  // A oneof field set to its default value is hashed, unlike other proto3 scalar fields.
+  ProtobufWkt::Value v1;
+  ProtobufWkt::Value v2;
+  v2.set_string_value("");
+  EXPECT_NE(MessageUtil::hash(v1), MessageUtil::hash(v2));
+  ProtobufWkt::UInt32Value u1;
+  ProtobufWkt::UInt32Value u2;
+  u2.set_value(0);
+  EXPECT_EQ(MessageUtil::hash(u1), MessageUtil::hash(u2));
 }
 
 TEST_F(ProtobufUtilityTest, RepeatedPtrUtilDebugString) {
@@ -0,0 +1,115 @@
+#include <string>
+#include <vector>
+
+#include "envoy/api/v2/rds.pb.h"
+#include "envoy/api/v2/route/route.pb.h"
+
+#include "common/http/header_map_impl.h"
+#include "common/router/config_impl.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Generates a virtual host shaped like one generated from an API catalog: for each service a
+ * header constrained canary prefix route, a few exact path routes and a catch-all prefix route.
+ */
+static envoy::api::v2::RouteConfiguration makeRouteConfig(int num_routes, bool build_route_index) {
+  envoy::api::v2::RouteConfiguration config;
+  config.set_build_route_index(build_route_index);
+  auto* virtual_host = config.add_virtual_hosts();
+  virtual_host->set_name("catalog");
+  virtual_host->add_domains("*");
+
+  const auto add_route = [&](const std::string& cluster) {
+    auto* route = virtual_host->add_routes();
+    route->mutable_route()->set_cluster(cluster);
+    return route->mutable_match();
+  };
+  for (int service = 0; virtual_host->routes_size() < num_routes; service++) {
+    const std::string prefix = absl::StrCat("/api/service", service);
+    auto* canary = add_route(absl::StrCat("service", service, "_canary"));
+    canary->set_prefix(prefix + "/");
+    auto* header = canary->add_headers();
+    header->set_name("x-canary");
+    header->set_exact_match("true");
+    for (const char* method : {"/get", "/list", "/create"}) {
+      add_route(absl::StrCat("service", service, "_exact"))->set_path(prefix + method);
+    }
+    add_route(absl::StrCat("service", service))->set_prefix(prefix + "/");
+  }
+  add_route("default")->set_prefix("/");
+  return config;
+}
+
+/**
+ * Route a request that matches the catch-all route of the last service. Without an index every
+ * route is evaluated first. Args are the number of routes and whether the index is built.
+ */
+static void RouteLookup(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+  const auto proto_config = makeRouteConfig(state.range(0), state.range(1) != 0);
+  ConfigImpl config(proto_config, factory_context, ProtobufMessage::getNullValidationVisitor(),
+                    false);
+
+  const int last_service = (proto_config.virtual_hosts(0).routes_size() - 1) / 5 - 1;
+  Http::TestHeaderMapImpl headers{{":authority", "www.example.com"},
+                                  {":path", absl::StrCat("/api/service", last_service, "/items/7")},
+                                  {":method", "GET"},
+                                  {"x-forwarded-proto", "http"}};
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  for (auto _ : state) {
+    RouteConstSharedPtr route = config.route(headers, stream_info, 0);
+    if (route == nullptr ||
+        route->routeEntry()->clusterName() != absl::StrCat("service", last_service)) {
+      state.SkipWithError("unexpected route");
+      break;
+    }
+  }
+}
+BENCHMARK(RouteLookup)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({10000, 0})
+    ->Args({10000, 1});
+
+/** Measure loading a route table, which includes building the index if enabled. */
+static void RouteConfigLoad(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+  const auto proto_config = makeRouteConfig(state.range(0), state.range(1) != 0);
+  for (auto _ : state) {
+    ConfigImpl config(proto_config, factory_context, ProtobufMessage::getNullValidationVisitor(),
+                      false);
+    benchmark::DoNotOptimize(config.name());
+  }
+}
+BENCHMARK(RouteConfigLoad)->Args({10000, 0})->Args({10000, 1})->Unit(benchmark::kMillisecond);
+
+} // namespace Router
+} // namespace Envoy
+
+// Boilerplate main(), which discovers benchmarks in the same file and runs them.
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
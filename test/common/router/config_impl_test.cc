@@ -28,6 +28,7 @@
 #include "test/test_common/registry.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/match.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -951,6 +952,77 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// With build_route_index the same route is selected as without it, including for overlapping
+// prefixes, header constrained routes, case insensitive routes and regex routes.
+TEST_F(RouteMatcherTest, RouteIndexPreservesFirstMatch) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: default
+    domains: ["*"]
+    routes:
+      - match:
+          prefix: "/api"
+          headers:
+            - name: x-canary
+              exact_match: "true"
+        route: { cluster: "canary" }
+      - match: { path: "/api/users", case_sensitive: false }
+        route: { cluster: "users_exact" }
+      - match: { safe_regex: { google_re2: {}, regex: "/api/v[0-9]+/orders.*" } }
+        route: { cluster: "orders_regex" }
+      - match: { prefix: "/api/v1" }
+        route: { cluster: "api_v1" }
+      - match: { prefix: "/api/v1/orders" }
+        route: { cluster: "shadowed" }
+      - match: { prefix: "/API/V2", case_sensitive: false }
+        route: { cluster: "api_v2" }
+      - match: { prefix: "/api" }
+        route: { cluster: "api" }
+      - match: { path: "/health" }
+        route: { cluster: "health" }
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+  )EOF";
+
+  auto proto_config = parseRouteConfigurationFromV2Yaml(yaml);
+  TestConfigImpl linear_config(proto_config, factory_context_, false);
+  proto_config.set_build_route_index(true);
+  TestConfigImpl indexed_config(proto_config, factory_context_, false);
+
+  const std::vector<std::pair<std::string, std::string>> expectations = {
+      {"/api/users", "users_exact"},
+      {"/API/Users?limit=10", "users_exact"},
+      {"/api/users/1", "api"},
+      {"/api/v1/orders/7", "orders_regex"},
+      {"/api/v1/users", "api_v1"},
+      {"/api/v2/users", "api_v2"},
+      {"/Api/V2", "api_v2"},
+      {"/api", "api"},
+      {"/health", "health"},
+      {"/health?verbose", "health"},
+      {"/healthz", "default"},
+      {"/", "default"},
+  };
+  for (const auto& expectation : expectations) {
+    Http::TestHeaderMapImpl headers = genHeaders("www.lyft.com", expectation.first, "GET");
+    EXPECT_EQ(expectation.second, linear_config.route(headers, 0)->routeEntry()->clusterName())
+        << expectation.first;
+    EXPECT_EQ(expectation.second, indexed_config.route(headers, 0)->routeEntry()->clusterName())
+        << expectation.first;
+
+    if (absl::StartsWith(expectation.first, "/api")) {
+      headers.addCopy("x-canary", "true");
+      EXPECT_EQ("canary", indexed_config.route(headers, 0)->routeEntry()->clusterName())
+          << expectation.first;
+    }
+  }
+
+  // Paths outside every prefix match nothing.
+  proto_config.mutable_virtual_hosts(0)->mutable_routes()->RemoveLast();
+  TestConfigImpl no_default_config(proto_config, factory_context_, false);
+  EXPECT_EQ(nullptr, no_default_config.route(genHeaders("www.lyft.com", "/other", "GET"), 0));
+}
+
 // When deprecating regex: this test can be removed.
 TEST_F(RouteMatcherTest, DEPRECATED_FEATURE_TEST(TestRoutesWithInvalidRegexLegacy)) {
   std::string invalid_route = R"EOF(
@@ -0,0 +1,81 @@
+#include "common/router/path_route_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+class PathRouteIndexTest : public testing::Test {
+protected:
+  std::vector<uint32_t> candidates(absl::string_view path) {
+    PathRouteIndex::Candidates candidates;
+    index_.candidates(path, candidates);
+    return {candidates.begin(), candidates.end()};
+  }
+
+  PathRouteIndex index_;
+};
+
+TEST_F(PathRouteIndexTest, Empty) { EXPECT_THAT(candidates("/foo"), IsEmpty()); }
+
+TEST_F(PathRouteIndexTest, Prefixes) {
+  index_.addPrefix("/foo/bar", true, 0);
+  index_.addPrefix("/foo", true, 1);
+  index_.addPrefix("/fob", true, 2);
+  index_.addPrefix("/", true, 3);
+  index_.addPrefix("", true, 4);
+  index_.addPrefix("/foo", true, 5);
+
+  EXPECT_THAT(candidates("/foo/bar/baz"), ElementsAre(0, 1, 3, 4, 5));
+  EXPECT_THAT(candidates("/foo/ba"), ElementsAre(1, 3, 4, 5));
+  EXPECT_THAT(candidates("/fob"), ElementsAre(2, 3, 4));
+  EXPECT_THAT(candidates("/fo"), ElementsAre(3, 4));
+  EXPECT_THAT(candidates("/FOO"), ElementsAre(3, 4));
+  EXPECT_THAT(candidates(""), ElementsAre(4));
+}
+
+TEST_F(PathRouteIndexTest, PrefixesIncludeQueryString) {
+  index_.addPrefix("/foo?a=b", true, 0);
+  EXPECT_THAT(candidates("/foo?a=b&c=d"), ElementsAre(0));
+  EXPECT_THAT(candidates("/foo?a=c"), IsEmpty());
+}
+
+TEST_F(PathRouteIndexTest, Paths) {
+  index_.addPath("/foo", true, 0);
+  index_.addPath("/foo/bar", true, 1);
+  index_.addPath("/foo", true, 2);
+
+  EXPECT_THAT(candidates("/foo"), ElementsAre(0, 2));
+  EXPECT_THAT(candidates("/foo?bar"), ElementsAre(0, 2));
+  EXPECT_THAT(candidates("/foo/bar"), ElementsAre(1));
+  EXPECT_THAT(candidates("/foo/"), IsEmpty());
+  EXPECT_THAT(candidates("/FOO"), IsEmpty());
+}
+
+TEST_F(PathRouteIndexTest, CaseInsensitive) {
+  index_.addPrefix("/Foo", false, 0);
+  index_.addPath("/Foo/Bar", false, 1);
+  index_.addPrefix("/foo", true, 2);
+
+  EXPECT_THAT(candidates("/fOO/bar"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates("/foo/BAR?x=Y"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(candidates("/fo"), IsEmpty());
+}
+
+TEST_F(PathRouteIndexTest, UnindexedRoutesAreAlwaysCandidates) {
+  index_.addUnindexed(0);
+  index_.addPrefix("/foo", true, 1);
+  index_.addUnindexed(2);
+
+  EXPECT_THAT(candidates("/foo"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(candidates("/bar"), ElementsAre(0, 2));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
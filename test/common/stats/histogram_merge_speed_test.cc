@@ -0,0 +1,110 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// NOLINT(namespace-envoy)
+//
+// Compares the main thread cost of merging the per-worker copies of a histogram, for the
+// log-linear histograms and for histograms with configured fixed buckets. The argument is the
+// number of per-worker histograms merged per iteration.
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/common/logger.h"
+#include "common/common/thread.h"
+#include "common/stats/histogram_impl.h"
+
+#include "benchmark/benchmark.h"
+#include "circllhist.h"
+
+namespace {
+
+// Spreads the recorded values over several orders of magnitude, like request latencies.
+uint64_t sampleValue(uint64_t i) { return (i * 7919) % (1 << ((i % 20) + 1)); }
+
+} // namespace
+
+static void BM_MergeLogLinear(benchmark::State& state) {
+  const int64_t workers = state.range(0);
+  std::vector<histogram_t*> tls_histograms;
+  for (int64_t i = 0; i < workers; ++i) {
+    histogram_t* histogram = hist_alloc();
+    for (uint64_t j = 0; j < 1000; ++j) {
+      hist_insert_intscale(histogram, sampleValue(i * 1000 + j), 0, 1);
+    }
+    tls_histograms.push_back(histogram);
+  }
+  histogram_t* interval = hist_alloc();
+
+  for (auto _ : state) {
+    hist_clear(interval);
+    hist_accumulate(interval, tls_histograms.data(), static_cast<int>(tls_histograms.size()));
+    Envoy::Stats::HistogramStatisticsImpl statistics(interval);
+    benchmark::DoNotOptimize(statistics.sampleCount());
+  }
+
+  hist_free(interval);
+  for (histogram_t* histogram : tls_histograms) {
+    hist_free(histogram);
+  }
+}
+BENCHMARK(BM_MergeLogLinear)->Arg(1)->Arg(8)->Arg(64);
+
+static void BM_MergeFixedBuckets(benchmark::State& state) {
+  const int64_t workers = state.range(0);
+  const Envoy::Stats::ConstSupportedBucketsSharedPtr& buckets =
+      Envoy::Stats::HistogramStatisticsImpl::defaultSupportedBuckets();
+  std::vector<std::unique_ptr<Envoy::Stats::FixedBucketHistogram>> tls_histograms;
+  for (int64_t i = 0; i < workers; ++i) {
+    auto histogram = std::make_unique<Envoy::Stats::FixedBucketHistogram>(buckets);
+    for (uint64_t j = 0; j < 1000; ++j) {
+      histogram->recordValue(sampleValue(i * 1000 + j));
+    }
+    tls_histograms.push_back(std::move(histogram));
+  }
+  Envoy::Stats::FixedBucketHistogram interval(buckets);
+
+  for (auto _ : state) {
+    interval.clear();
+    for (const auto& histogram : tls_histograms) {
+      interval.merge(*histogram);
+    }
+    Envoy::Stats::HistogramStatisticsImpl statistics(interval);
+    benchmark::DoNotOptimize(statistics.sampleCount());
+  }
+}
+BENCHMARK(BM_MergeFixedBuckets)->Arg(1)->Arg(8)->Arg(64);
+
+static void BM_RecordLogLinear(benchmark::State& state) {
+  histogram_t* histogram = hist_alloc();
+  uint64_t i = 0;
+  for (auto _ : state) {
+    hist_insert_intscale(histogram, sampleValue(++i), 0, 1);
+  }
+  hist_free(histogram);
+}
+BENCHMARK(BM_RecordLogLinear);
+
+static void BM_RecordFixedBuckets(benchmark::State& state) {
+  Envoy::Stats::FixedBucketHistogram histogram(
+      Envoy::Stats::HistogramStatisticsImpl::defaultSupportedBuckets());
+  uint64_t i = 0;
+  for (auto _ : state) {
+    histogram.recordValue(sampleValue(++i));
+  }
+  benchmark::DoNotOptimize(histogram.sampleCount());
+}
+BENCHMARK(BM_RecordFixedBuckets);
+
+int main(int argc, char** argv) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logger_context(spdlog::level::warn,
+                                        Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -63,6 +63,50 @@ TEST(TagExtractorTest, BadRegex) {
                           EnvoyException, "Invalid regex '\\+invalid':");
 }
 
+TEST(TagExtractorRe2Test, TwoSubexpressions) {
+  TagExtractorRe2Impl tag_extractor("cluster_name", "^cluster\\.((.+?)\\.)");
+  EXPECT_EQ("cluster_name", tag_extractor.name());
+  EXPECT_EQ("cluster", tag_extractor.prefixToken());
+  std::string name = "cluster.test_cluster.upstream_cx_total";
+  std::vector<Tag> tags;
+  IntervalSetImpl<size_t> remove_characters;
+  ASSERT_TRUE(tag_extractor.extractTag(name, tags, remove_characters));
+  std::string tag_extracted_name = StringUtil::removeCharacters(name, remove_characters);
+  EXPECT_EQ("cluster.upstream_cx_total", tag_extracted_name);
+  ASSERT_EQ(1, tags.size());
+  EXPECT_EQ("test_cluster", tags.at(0).value_);
+  EXPECT_EQ("cluster_name", tags.at(0).name_);
+}
+
+TEST(TagExtractorRe2Test, SingleSubexpression) {
+  TagExtractorRe2Impl tag_extractor("listner_port", "^listener\\.(\\d+?\\.)");
+  std::string name = "listener.80.downstream_cx_total";
+  std::vector<Tag> tags;
+  IntervalSetImpl<size_t> remove_characters;
+  ASSERT_TRUE(tag_extractor.extractTag(name, tags, remove_characters));
+  std::string tag_extracted_name = StringUtil::removeCharacters(name, remove_characters);
+  EXPECT_EQ("listener.downstream_cx_total", tag_extracted_name);
+  ASSERT_EQ(1, tags.size());
+  EXPECT_EQ("80.", tags.at(0).value_);
+}
+
+TEST(TagExtractorRe2Test, NoMatch) {
+  TagExtractorRe2Impl tag_extractor("listner_port", "^listener\\.(\\d+?\\.)\\.foo\\.",
+                                    ".foo.");
+  std::vector<Tag> tags;
+  IntervalSetImpl<size_t> remove_characters;
+  EXPECT_FALSE(
+      tag_extractor.extractTag("listener.80.downstream_cx_total", tags, remove_characters));
+  EXPECT_FALSE(tag_extractor.extractTag("cluster.80..foo.bar", tags, remove_characters));
+  EXPECT_TRUE(tags.empty());
+}
+
+TEST(TagExtractorRe2Test, Lookahead) {
+  // RE2 does not support lookarounds, which is why the default regexes avoid them.
+  EXPECT_THROW_WITH_REGEX(TagExtractorRe2Impl("cluster_name", "^cluster(?=\\.)((.+?)\\.)"),
+                          EnvoyException, "Invalid regex '\\^cluster");
+}
+
 class DefaultTagRegexTester {
 public:
   DefaultTagRegexTester() : tag_extractors_(envoy::config::metrics::v2::StatsConfig()) {}
@@ -115,8 +159,8 @@ public:
     // for this test, however.
     std::list<const TagExtractor*> extractors; // Note push-front is used to reverse order.
     tag_extractors_.forEachExtractorMatching(metric_name,
-                                             [&extractors](const TagExtractorPtr& tag_extractor) {
-                                               extractors.push_front(tag_extractor.get());
+                                             [&extractors](const TagExtractor& tag_extractor) {
+                                               extractors.push_front(&tag_extractor);
                                              });
 
     IntervalSetImpl<size_t> remove_characters;
@@ -1,3 +1,6 @@
+#include <map>
+#include <string>
+
 #include "envoy/config/metrics/v2/stats.pb.h"
 
 #include "common/config/well_known_names.h"
@@ -55,5 +58,41 @@ TEST(TagProducerTest, CheckConstructor) {
       "No regex specified for tag specifier and no default regex for name: 'test_extractor'");
 }
 
+// Regexes from the configuration are run with std::regex, so they may use lookaheads, and are
+// combined with the default extractors.
+TEST(TagProducerTest, CustomRegexWithDefaults) {
+  envoy::config::metrics::v2::StatsConfig stats_config;
+  auto& tag_specifier = *stats_config.mutable_stats_tags()->Add();
+  tag_specifier.set_tag_name("ua");
+  tag_specifier.set_regex(R"(^http(?=\.).*?\.user_agent\.((.+?)\.)\w+?$)");
+  TagProducerImpl producer{stats_config};
+
+  std::vector<Tag> tags;
+  EXPECT_EQ("http.user_agent.downstream_cx_total",
+            producer.produceTags("http.ingress.user_agent.ios.downstream_cx_total", tags));
+  std::map<std::string, std::string> tag_map;
+  for (const Tag& tag : tags) {
+    tag_map[tag.name_] = tag.value_;
+  }
+  EXPECT_EQ((std::map<std::string, std::string>{
+                {Config::TagNames::get().HTTP_CONN_MANAGER_PREFIX, "ingress"},
+                {Config::TagNames::get().HTTP_USER_AGENT, "ios"},
+                {"ua", "ios"},
+            }),
+            tag_map);
+}
+
+// Without default tags, only the configured extractors run.
+TEST(TagProducerTest, NoDefaultTags) {
+  envoy::config::metrics::v2::StatsConfig stats_config;
+  stats_config.mutable_use_all_default_tags()->set_value(false);
+  TagProducerImpl producer{stats_config};
+
+  std::vector<Tag> tags;
+  EXPECT_EQ("cluster.foo.upstream_rq_200",
+            producer.produceTags("cluster.foo.upstream_rq_200", tags));
+  EXPECT_TRUE(tags.empty());
+}
+
 } // namespace Stats
 } // namespace Envoy
@@ -1,4 +1,5 @@
 #include <chrono>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -8,6 +9,7 @@
 #include "common/common/c_smart_ptr.h"
 #include "common/event/dispatcher_impl.h"
 #include "common/memory/stats.h"
+#include "common/stats/histogram_impl.h"
 #include "common/stats/stats_matcher_impl.h"
 #include "common/stats/tag_producer_impl.h"
 #include "common/stats/thread_local_store.h"
@@ -1186,5 +1188,88 @@ TEST_F(HistogramTest, ParentHistogramBucketSummary) {
             parent_histogram->bucketSummary());
 }
 
+TEST_F(HistogramTest, FixedBucketHistogramSummary) {
+  envoy::config::metrics::v2::StatsConfig stats_config;
+  auto* setting = stats_config.add_histogram_bucket_settings();
+  setting->mutable_match()->set_prefix("fixed");
+  setting->add_buckets(100);
+  setting->add_buckets(10);
+  store_->setHistogramSettings(std::make_unique<HistogramSettingsImpl>(stats_config));
+
+  Histogram& fixed = store_->histogram("fixed", Stats::Histogram::Unit::Unspecified);
+  Histogram& other = store_->histogram("other", Stats::Histogram::Unit::Unspecified);
+  NameHistogramMap name_histogram_map = makeHistogramMap(store_->histograms());
+  const ParentHistogramSharedPtr& parent_fixed = name_histogram_map["fixed"];
+  const ParentHistogramSharedPtr& parent_other = name_histogram_map["other"];
+  EXPECT_EQ(std::vector<double>({10, 100}),
+            parent_fixed->intervalStatistics().supportedBuckets());
+  EXPECT_EQ(19, parent_other->intervalStatistics().supportedBuckets().size());
+
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(fixed), 10));
+  fixed.recordValue(10);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(other), 10));
+  other.recordValue(10);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ("B10(1,1) B100(1,1)", parent_fixed->bucketSummary());
+  EXPECT_EQ(1, parent_fixed->cumulativeStatistics().sampleCount());
+  EXPECT_EQ(10, parent_fixed->cumulativeStatistics().sampleSum());
+
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(fixed), 50));
+  fixed.recordValue(50);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(fixed), 500));
+  fixed.recordValue(500);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ("B10(0,1) B100(1,2)", parent_fixed->bucketSummary());
+  EXPECT_EQ(2, parent_fixed->intervalStatistics().sampleCount());
+  EXPECT_EQ(3, parent_fixed->cumulativeStatistics().sampleCount());
+  EXPECT_EQ(560, parent_fixed->cumulativeStatistics().sampleSum());
+}
+
+TEST(FixedBucketHistogramTest, RecordMergeAndQuantiles) {
+  auto buckets = std::make_shared<ConstSupportedBuckets>(std::vector<double>{1, 5, 10});
+  FixedBucketHistogram histogram(buckets);
+  EXPECT_TRUE(std::isnan(histogram.quantile(0.5)));
+
+  FixedBucketHistogram other(buckets);
+  for (uint64_t value : {1, 2, 3}) {
+    histogram.recordValue(value);
+  }
+  for (uint64_t value : {4, 20}) {
+    other.recordValue(value);
+  }
+  histogram.merge(other);
+
+  EXPECT_EQ(5, histogram.sampleCount());
+  EXPECT_EQ(30, histogram.sampleSum());
+  EXPECT_EQ(std::vector<uint64_t>({1, 4, 4}), histogram.cumulativeCounts());
+  EXPECT_DOUBLE_EQ(1, histogram.quantile(0));
+  EXPECT_DOUBLE_EQ(3, histogram.quantile(0.5));
+  EXPECT_DOUBLE_EQ(20, histogram.quantile(1));
+
+  HistogramStatisticsImpl statistics(histogram);
+  EXPECT_EQ(*buckets, statistics.supportedBuckets());
+  EXPECT_EQ(std::vector<uint64_t>({1, 4, 4}), statistics.computedBuckets());
+
+  histogram.clear();
+  EXPECT_EQ(0, histogram.sampleCount());
+  EXPECT_EQ(std::vector<uint64_t>({0, 0, 0}), histogram.cumulativeCounts());
+}
+
+TEST(HistogramSettingsImplTest, FirstMatchSelectsBuckets) {
+  envoy::config::metrics::v2::StatsConfig stats_config;
+  auto* setting = stats_config.add_histogram_bucket_settings();
+  setting->mutable_match()->set_prefix("cluster.a.");
+  setting->add_buckets(2);
+  setting->add_buckets(1);
+  setting = stats_config.add_histogram_bucket_settings();
+  setting->mutable_match()->set_prefix("cluster.");
+  setting->add_buckets(3);
+  HistogramSettingsImpl settings(stats_config);
+
+  EXPECT_EQ(std::vector<double>({1, 2}), *settings.buckets("cluster.a.upstream_rq_time"));
+  EXPECT_EQ(std::vector<double>({3}), *settings.buckets("cluster.b.upstream_rq_time"));
+  EXPECT_EQ(nullptr, settings.buckets("http.downstream_rq_time"));
+}
+
 } // namespace Stats
 } // namespace Envoy
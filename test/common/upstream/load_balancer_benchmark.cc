@@ -31,15 +31,46 @@ public:
                                    should_weight ? weight : 1));
     }
 
+    hosts_ = std::make_shared<HostVector>(hosts);
+    hosts_per_locality_ = makeHostsPerLocality({hosts});
+    priority_set_.updateHosts(0, HostSetImpl::partitionHosts(hosts_, hosts_per_locality_), {},
+                              hosts, {}, absl::nullopt);
+    local_priority_set_.updateHosts(0, HostSetImpl::partitionHosts(hosts_, hosts_per_locality_),
+                                    {}, hosts, {}, absl::nullopt);
+  }
+
+  // Adds a second priority, whose load balancing state is not affected by the updates of the
+  // first one.
+  void addPriority(uint64_t num_hosts) {
+    HostVector hosts;
+    ASSERT(num_hosts < 65536);
+    for (uint64_t i = 0; i < num_hosts; i++) {
+      hosts.push_back(makeTestHost(info_, fmt::format("tcp://10.1.{}.{}:6379", i / 256, i % 256)));
+    }
+
     HostVectorConstSharedPtr updated_hosts = std::make_shared<HostVector>(hosts);
     HostsPerLocalityConstSharedPtr hosts_per_locality = makeHostsPerLocality({hosts});
-    priority_set_.updateHosts(0, HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {},
+    priority_set_.updateHosts(1, HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {},
                               hosts, {}, absl::nullopt);
-    local_priority_set_.updateHosts(0,
-                                    HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality),
-                                    {}, hosts, {}, absl::nullopt);
   }
 
+  // Flips the health of a host of the first priority and updates the priority set, as a health
+  // checker would. The host list itself doesn't change.
+  void flipHostHealth(uint64_t index) {
+    Host& host = *(*hosts_)[index];
+    if (host.healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
+      host.healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+    } else {
+      host.healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+    }
+    priority_set_.updateHosts(0,
+                              HostSetImpl::partitionHosts(hosts_, hosts_per_locality_,
+                                                          *priority_set_.hostSetsPerPriority()[0]),
+                              {}, {}, {}, absl::nullopt);
+  }
+
+  HostVectorConstSharedPtr hosts_;
+  HostsPerLocalityConstSharedPtr hosts_per_locality_;
   PrioritySetImpl priority_set_;
   PrioritySetImpl local_priority_set_;
   Stats::IsolatedStoreImpl stats_store_;
@@ -118,6 +149,45 @@ BENCHMARK(BM_RoundRobinLoadBalancerBuild)
     ->Args({50000, 100, 50})
     ->Unit(benchmark::kMillisecond);
 
+// Each iteration is a host failing a health check and then recovering, which updates the load
+// balancer twice.
+void BM_RoundRobinLoadBalancerHostHealthChurn(benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t weighted_subset_percent = state.range(1);
+  const uint64_t weight = state.range(2);
+  RoundRobinTester tester(num_hosts, weighted_subset_percent, weight);
+  tester.initialize();
+
+  uint64_t i = 0;
+  for (auto _ : state) {
+    tester.flipHostHealth(i % num_hosts);
+    tester.flipHostHealth(i % num_hosts);
+    i++;
+  }
+}
+BENCHMARK(BM_RoundRobinLoadBalancerHostHealthChurn)
+    ->Args({500, 0, 1})
+    ->Args({500, 50, 50})
+    ->Args({10000, 0, 1})
+    ->Args({10000, 50, 50})
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_LeastRequestLoadBalancerHostHealthChurn(benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  LeastRequestTester tester(num_hosts, 2);
+
+  uint64_t i = 0;
+  for (auto _ : state) {
+    tester.flipHostHealth(i % num_hosts);
+    tester.flipHostHealth(i % num_hosts);
+    i++;
+  }
+}
+BENCHMARK(BM_LeastRequestLoadBalancerHostHealthChurn)
+    ->Arg(500)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
 class RingHashTester : public BaseTester {
 public:
   RingHashTester(uint64_t num_hosts, uint64_t min_ring_size) : BaseTester(num_hosts) {
@@ -199,6 +269,54 @@ BENCHMARK(BM_MaglevLoadBalancerBuildTable)
     ->Arg(500)
     ->Unit(benchmark::kMillisecond);
 
+// The second argument is the number of hosts of a second priority, whose ring is not rebuilt when
+// the first priority is updated.
+void BM_RingHashLoadBalancerHostHealthChurn(benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t other_priority_hosts = state.range(1);
+  RingHashTester tester(num_hosts, 65536);
+  if (other_priority_hosts > 0) {
+    tester.addPriority(other_priority_hosts);
+  }
+  tester.ring_hash_lb_->initialize();
+
+  uint64_t i = 0;
+  for (auto _ : state) {
+    tester.flipHostHealth(i % num_hosts);
+    tester.flipHostHealth(i % num_hosts);
+    i++;
+  }
+}
+BENCHMARK(BM_RingHashLoadBalancerHostHealthChurn)
+    ->Args({100, 0})
+    ->Args({100, 500})
+    ->Args({500, 0})
+    ->Args({500, 500})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_MaglevLoadBalancerHostHealthChurn(benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t other_priority_hosts = state.range(1);
+  MaglevTester tester(num_hosts);
+  if (other_priority_hosts > 0) {
+    tester.addPriority(other_priority_hosts);
+  }
+  tester.maglev_lb_->initialize();
+
+  uint64_t i = 0;
+  for (auto _ : state) {
+    tester.flipHostHealth(i % num_hosts);
+    tester.flipHostHealth(i % num_hosts);
+    i++;
+  }
+}
+BENCHMARK(BM_MaglevLoadBalancerHostHealthChurn)
+    ->Args({100, 0})
+    ->Args({100, 500})
+    ->Args({500, 0})
+    ->Args({500, 500})
+    ->Unit(benchmark::kMillisecond);
+
 class TestLoadBalancerContext : public LoadBalancerContextBase {
 public:
   // Upstream::LoadBalancerContext
@@ -823,6 +823,43 @@ TEST_P(RoundRobinLoadBalancerTest, Weighted) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
 }
 
+// A host set update that keeps the host lists keeps their weighted schedules, instead of restarting
+// them.
+TEST(RoundRobinLoadBalancerScheduleTest, UnchangedHostListKeepsSchedule) {
+  Stats::IsolatedStoreImpl stats_store;
+  ClusterStats stats{ClusterInfoImpl::generateStats(stats_store)};
+  NiceMock<Runtime::MockLoader> runtime;
+  NiceMock<Runtime::MockRandomGenerator> random;
+  std::shared_ptr<MockClusterInfo> info{new NiceMock<MockClusterInfo>()};
+  envoy::api::v2::Cluster::CommonLbConfig common_config;
+  PrioritySetImpl priority_set;
+
+  HostVectorSharedPtr hosts(new HostVector({makeTestHost(info, "tcp://127.0.0.1:80", 1),
+                                            makeTestHost(info, "tcp://127.0.0.1:81", 2)}));
+  HostsPerLocalityConstSharedPtr hosts_per_locality = makeHostsPerLocality({*hosts});
+  priority_set.updateHosts(0, HostSetImpl::partitionHosts(hosts, hosts_per_locality), {}, *hosts,
+                           {}, absl::nullopt);
+  RoundRobinLoadBalancer lb(priority_set, nullptr, stats, runtime, random, common_config);
+  EXPECT_EQ((*hosts)[1], lb.chooseHost(nullptr));
+  EXPECT_EQ((*hosts)[0], lb.chooseHost(nullptr));
+
+  // The host lists are shared with the previous host set, the schedule goes on.
+  priority_set.updateHosts(0,
+                           HostSetImpl::partitionHosts(hosts, hosts_per_locality,
+                                                       *priority_set.hostSetsPerPriority()[0]),
+                           {}, {}, {}, absl::nullopt);
+  EXPECT_EQ((*hosts)[1], lb.chooseHost(nullptr));
+  EXPECT_EQ((*hosts)[1], lb.chooseHost(nullptr));
+  EXPECT_EQ((*hosts)[0], lb.chooseHost(nullptr));
+
+  // New host lists, even with the same hosts, restart the schedule.
+  priority_set.updateHosts(
+      0, HostSetImpl::partitionHosts(std::make_shared<HostVector>(*hosts), hosts_per_locality), {},
+      {}, {}, absl::nullopt);
+  EXPECT_EQ((*hosts)[1], lb.chooseHost(nullptr));
+  EXPECT_EQ((*hosts)[0], lb.chooseHost(nullptr));
+}
+
 // Validate that the RNG seed influences pick order when weighted RR.
 TEST_P(RoundRobinLoadBalancerTest, WeightedSeed) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
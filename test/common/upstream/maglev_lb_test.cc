@@ -81,6 +81,39 @@ TEST_F(MaglevLoadBalancerTest, Basic) {
   }
 }
 
+// Only the table of the updated priority is rebuilt. The stats are set by the last table built.
+TEST_F(MaglevLoadBalancerTest, UpdateRebuildsOnlyUpdatedPriority) {
+  MockHostSet& failover_host_set = *priority_set_.getMockHostSet(1);
+  host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90")};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  failover_host_set.hosts_ = {
+      makeTestHost(info_, "tcp://127.0.0.1:91"), makeTestHost(info_, "tcp://127.0.0.1:92"),
+      makeTestHost(info_, "tcp://127.0.0.1:93"), makeTestHost(info_, "tcp://127.0.0.1:94"),
+      makeTestHost(info_, "tcp://127.0.0.1:95"), makeTestHost(info_, "tcp://127.0.0.1:96")};
+  failover_host_set.healthy_hosts_ = failover_host_set.hosts_;
+  init(7);
+  // The stats describe the table of the last priority.
+  EXPECT_EQ(1, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(2, lb_->stats().max_entries_per_host_.value());
+
+  // The failover hosts change without their update callbacks running, so the failover table
+  // only changes if it is rebuilt. It is reused, and its stats are applied again after those of
+  // the rebuilt table.
+  failover_host_set.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:91")};
+  failover_host_set.healthy_hosts_ = failover_host_set.hosts_;
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(1, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(2, lb_->stats().max_entries_per_host_.value());
+
+  failover_host_set.runCallbacks({}, {});
+  EXPECT_EQ(7, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(7, lb_->stats().max_entries_per_host_.value());
+
+  LoadBalancerPtr lb = lb_->factory()->create();
+  TestLoadBalancerContext context(0);
+  EXPECT_EQ(host_set_.hosts_[0], lb->chooseHost(&context));
+}
+
 // Weighted sanity test.
 TEST_F(MaglevLoadBalancerTest, Weighted) {
   host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", 1),
@@ -1384,6 +1384,61 @@ TEST_F(StaticClusterImplTest, OutlierDetector) {
   EXPECT_EQ(2UL, cluster.info()->stats().membership_healthy_.value());
 }
 
+// A health change only updates the host set of the host.
+TEST_F(StaticClusterImplTest, HealthChangeUpdatesHostPriorityOnly) {
+  const std::string yaml = R"EOF(
+    name: staticcluster
+    connect_timeout: 0.25s
+    type: static
+    lb_policy: random
+    load_assignment:
+      cluster_name: foo
+      endpoints:
+      - priority: 0
+        lb_endpoints:
+        - endpoint:
+            address:
+              socket_address: { address: 10.0.0.1, port_value: 11001 }
+      - priority: 1
+        lb_endpoints:
+        - endpoint:
+            address:
+              socket_address: { address: 10.0.0.1, port_value: 11002 }
+  )EOF";
+
+  envoy::api::v2::Cluster cluster_config = parseClusterFromV2Yaml(yaml);
+  Envoy::Stats::ScopePtr scope =
+      stats_.createScope(fmt::format("cluster.{}.", cluster_config.name()));
+  Envoy::Server::Configuration::TransportSocketFactoryContextImpl factory_context(
+      admin_, ssl_context_manager_, *scope, cm_, local_info_, dispatcher_, random_, stats_,
+      singleton_manager_, tls_, validation_visitor_, *api_);
+  StaticClusterImpl cluster(cluster_config, runtime_, factory_context, std::move(scope), false);
+
+  Outlier::MockDetector* detector = new NiceMock<Outlier::MockDetector>();
+  cluster.setOutlierDetector(Outlier::DetectorSharedPtr{detector});
+  cluster.initialize([] {});
+
+  std::vector<uint32_t> updated_priorities;
+  cluster.prioritySet().addPriorityUpdateCb(
+      [&](uint32_t priority, const HostVector&, const HostVector&) -> void {
+        updated_priorities.push_back(priority);
+      });
+
+  const auto& host_set = *cluster.prioritySet().hostSetsPerPriority()[1];
+  const HostSharedPtr host = host_set.hosts()[0];
+  const auto degraded_hosts = host_set.degradedHostsPtr();
+  host->healthFlagSet(Host::HealthFlag::FAILED_OUTLIER_CHECK);
+  detector->runCallbacks(host);
+  EXPECT_EQ(std::vector<uint32_t>{1}, updated_priorities);
+  EXPECT_EQ(0UL, host_set.healthyHosts().size());
+  // The lists the host didn't move in or out of are shared with the previous host set.
+  EXPECT_EQ(degraded_hosts, host_set.degradedHostsPtr());
+
+  // Nothing changed, so there is no update.
+  detector->runCallbacks(host);
+  EXPECT_EQ(std::vector<uint32_t>{1}, updated_priorities);
+}
+
 TEST_F(StaticClusterImplTest, HealthyStat) {
   const std::string yaml = R"EOF(
     name: addressportconfig
@@ -2699,6 +2754,44 @@ TEST(HostPartitionTest, PartitionHosts) {
   EXPECT_EQ(1, update_hosts_params.excluded_hosts_per_locality->get()[1].size());
   EXPECT_EQ(hosts[2], update_hosts_params.excluded_hosts_per_locality->get()[1][0]);
 }
+
+// Verifies that partitionHosts reuses the host lists of the previous host set that are unchanged.
+TEST(HostPartitionTest, PartitionHostsReusesUnchangedLists) {
+  std::shared_ptr<MockClusterInfo> info{new NiceMock<MockClusterInfo>()};
+  HostVector hosts{makeTestHost(info, "tcp://127.0.0.1:80"),
+                   makeTestHost(info, "tcp://127.0.0.1:81")};
+  hosts[1]->healthFlagSet(Host::HealthFlag::DEGRADED_ACTIVE_HC);
+
+  auto hosts_ptr = std::make_shared<const HostVector>(hosts);
+  auto hosts_per_locality = makeHostsPerLocality({{hosts[0]}, {hosts[1]}});
+  HostSetImpl host_set(0, absl::nullopt);
+  host_set.updateHosts(HostSetImpl::partitionHosts(hosts_ptr, hosts_per_locality), nullptr, {},
+                       {});
+
+  EXPECT_TRUE(HostSetImpl::unchanged(
+      HostSetImpl::partitionHosts(hosts_ptr, hosts_per_locality, host_set), host_set));
+
+  hosts[0]->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+  auto update_hosts_params = HostSetImpl::partitionHosts(hosts_ptr, hosts_per_locality, host_set);
+  EXPECT_FALSE(HostSetImpl::unchanged(update_hosts_params, host_set));
+  EXPECT_EQ(0, update_hosts_params.healthy_hosts->get().size());
+  EXPECT_EQ(0, update_hosts_params.healthy_hosts_per_locality->get()[0].size());
+  EXPECT_EQ(host_set.degradedHostsPtr(), update_hosts_params.degraded_hosts);
+  EXPECT_EQ(host_set.degradedHostsPerLocalityPtr(),
+            update_hosts_params.degraded_hosts_per_locality);
+  EXPECT_EQ(host_set.excludedHostsPtr(), update_hosts_params.excluded_hosts);
+  EXPECT_EQ(host_set.excludedHostsPerLocalityPtr(),
+            update_hosts_params.excluded_hosts_per_locality);
+
+  // The lists are rebuilt when the hosts they hold change.
+  update_hosts_params = HostSetImpl::partitionHosts(
+      std::make_shared<const HostVector>(HostVector{hosts[1]}), makeHostsPerLocality({{hosts[1]}}),
+      host_set);
+  EXPECT_EQ(host_set.degradedHostsPtr(), update_hosts_params.degraded_hosts);
+  EXPECT_NE(host_set.degradedHostsPerLocalityPtr(),
+            update_hosts_params.degraded_hosts_per_locality);
+  EXPECT_EQ(1, update_hosts_params.degraded_hosts_per_locality->get()[0].size());
+}
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
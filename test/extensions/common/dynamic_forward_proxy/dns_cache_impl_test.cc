@@ -371,6 +371,80 @@ TEST_F(DnsCacheImplTest, ResolveFailure) {
   result = dns_cache_->loadDnsCacheEntry("foo.com", 80, callbacks);
   EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::InCache, result.status_);
   EXPECT_EQ(result.handle_, nullptr);
+  EXPECT_EQ(1, TestUtility::findCounter(store_, "dns_cache.foo.cache_hit")->value());
+  EXPECT_EQ(1, TestUtility::findCounter(store_, "dns_cache.foo.cache_miss")->value());
+}
+
+// The refresh interval follows the DNS TTL, capped at the refresh rate.
+TEST_F(DnsCacheImplTest, RespectDnsTtl) {
+  config_.set_respect_dns_ttl(true);
+  initialize();
+  InSequence s;
+
+  MockLoadDnsCacheEntryCallbacks callbacks;
+  Network::DnsResolver::ResolveCb resolve_cb;
+  Event::MockTimer* resolve_timer = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*resolver_, resolve("foo.com", _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  auto result = dns_cache_->loadDnsCacheEntry("foo.com", 80, callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::Loading, result.status_);
+
+  EXPECT_CALL(update_callbacks_,
+              onDnsHostAddOrUpdate("foo.com", DnsHostInfoEquals("10.0.0.1:80", "foo.com", false)));
+  EXPECT_CALL(callbacks, onLoadDnsCacheComplete());
+  EXPECT_CALL(*resolve_timer, enableTimer(std::chrono::milliseconds(6000), _));
+  resolve_cb(TestUtility::makeDnsResponse({"10.0.0.1"}, std::chrono::seconds(6)));
+
+  // A TTL above the refresh rate is capped.
+  EXPECT_CALL(*resolver_, resolve("foo.com", _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  resolve_timer->invokeCallback();
+  EXPECT_CALL(*resolve_timer, enableTimer(std::chrono::milliseconds(60000), _));
+  resolve_cb(TestUtility::makeDnsResponse({"10.0.0.1"}, std::chrono::seconds(3600)));
+
+  // A zero TTL and a failed resolution use the refresh rate.
+  EXPECT_CALL(*resolver_, resolve("foo.com", _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  resolve_timer->invokeCallback();
+  EXPECT_CALL(*resolve_timer, enableTimer(std::chrono::milliseconds(60000), _));
+  resolve_cb(TestUtility::makeDnsResponse({"10.0.0.1"}, std::chrono::seconds(0)));
+
+  EXPECT_CALL(*resolver_, resolve("foo.com", _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  resolve_timer->invokeCallback();
+  EXPECT_CALL(*resolve_timer, enableTimer(std::chrono::milliseconds(60000), _));
+  resolve_cb(TestUtility::makeDnsResponse({}));
+
+  // The host keeps its address while it is re-resolved.
+  result = dns_cache_->loadDnsCacheEntry("foo.com", 80, callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::InCache, result.status_);
+}
+
+// Configured hosts are resolved when the cache is created.
+TEST_F(DnsCacheImplTest, PreresolveHostnames) {
+  auto* preresolve_host = config_.add_preresolve_hostnames();
+  preresolve_host->set_host("bar.com");
+  preresolve_host->set_default_port(443);
+
+  Network::DnsResolver::ResolveCb resolve_cb;
+  Event::MockTimer* resolve_timer = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*resolver_, resolve("bar.com", _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  initialize();
+  checkStats(1 /* attempt */, 0 /* success */, 0 /* failure */, 0 /* address changed */,
+             1 /* added */, 0 /* removed */, 1 /* num hosts */);
+
+  EXPECT_CALL(update_callbacks_, onDnsHostAddOrUpdate(
+                                     "bar.com", DnsHostInfoEquals("10.0.0.1:443", "bar.com", false)));
+  EXPECT_CALL(*resolve_timer, enableTimer(std::chrono::milliseconds(60000), _));
+  resolve_cb(TestUtility::makeDnsResponse({"10.0.0.1"}));
+
+  MockLoadDnsCacheEntryCallbacks callbacks;
+  auto result = dns_cache_->loadDnsCacheEntry("bar.com", 443, callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::InCache, result.status_);
+  EXPECT_EQ(result.handle_, nullptr);
+  EXPECT_EQ(1, TestUtility::findCounter(store_, "dns_cache.foo.cache_hit")->value());
+  EXPECT_EQ(0, TestUtility::findCounter(store_, "dns_cache.foo.cache_miss")->value());
 }
 
 // Cancel a cache load before the resolve completes.
@@ -0,0 +1,86 @@
+#include "envoy/compressor/config.h"
+#include "envoy/config/compressor/zlib/v2alpha/zlib.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/decompressor/zlib_decompressor_impl.h"
+
+#include "extensions/compression/well_known_names.h"
+#include "extensions/compression/zlib/config.h"
+#include "extensions/compression/zlib/zlib_compressor_factory.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zlib {
+namespace {
+
+Compressor::CompressorFactorySharedPtr createFactory(const std::string& yaml) {
+  auto* factory =
+      Registry::FactoryRegistry<Compressor::NamedCompressorLibraryConfigFactory>::getFactory(
+          CompressorNames::get().Zlib);
+  EXPECT_NE(nullptr, factory);
+  envoy::config::compressor::zlib::v2alpha::Zlib config;
+  TestUtility::loadFromYaml(yaml, config);
+  // Use createEmptyConfigProto to exercise that code path. This ensures the proto returned by that
+  // method is compatible with the downcast in createCompressorFactoryFromProto.
+  auto empty = factory->createEmptyConfigProto();
+  empty->MergeFrom(config);
+  return factory->createCompressorFactoryFromProto(*empty,
+                                                   ProtobufMessage::getStrictValidationVisitor());
+}
+
+TEST(ZlibCompressorLibraryFactoryTest, Defaults) {
+  auto factory = createFactory("{}");
+  const auto& zlib = dynamic_cast<const ZlibCompressorFactory&>(*factory);
+  EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionLevel::Standard, zlib.compressionLevel());
+  EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+            zlib.compressionStrategy());
+  EXPECT_EQ(5, zlib.memoryLevel());
+  EXPECT_EQ(28, zlib.windowBits());
+}
+
+TEST(ZlibCompressorLibraryFactoryTest, Config) {
+  auto factory = createFactory(R"EOF(
+memory_level: 9
+compression_level: SPEED
+compression_strategy: HUFFMAN
+window_bits: 9
+)EOF");
+  const auto& zlib = dynamic_cast<const ZlibCompressorFactory&>(*factory);
+  EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionLevel::Speed, zlib.compressionLevel());
+  EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionStrategy::Huffman,
+            zlib.compressionStrategy());
+  EXPECT_EQ(9, zlib.memoryLevel());
+  EXPECT_EQ(25, zlib.windowBits());
+}
+
+TEST(ZlibCompressorLibraryFactoryTest, InvalidConfig) {
+  EXPECT_THROW(createFactory("window_bits: 16"), EnvoyException);
+}
+
+// Each compressor writes a whole gzip stream.
+TEST(ZlibCompressorLibraryFactoryTest, CreateCompressor) {
+  auto factory = createFactory("{}");
+  for (int i = 0; i < 2; i++) {
+    Compressor::CompressorPtr compressor = factory->createCompressor();
+    Buffer::OwnedImpl buffer("hello world, hello world");
+    compressor->compress(buffer, Compressor::State::Finish);
+
+    Decompressor::ZlibDecompressorImpl decompressor;
+    decompressor.init(31);
+    Buffer::OwnedImpl decompressed;
+    decompressor.decompress(buffer, decompressed);
+    EXPECT_EQ("hello world, hello world", decompressed.toString());
+  }
+}
+
+} // namespace
+} // namespace Zlib
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -157,6 +157,33 @@ TEST_F(LuaTest, MarkDead) {
   lua_gc(cr1->luaState(), LUA_GCCOLLECT, 0);
 }
 
+// The bytecode of a script is cached for as long as a state that loaded it exists, and a state
+// loaded from the cache has the globals of the script.
+TEST_F(LuaTest, BytecodeCache) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+    end
+  )EOF"};
+
+  BytecodeCache cache;
+  EXPECT_THROW(ThreadLocalState("bad code", tls_, &cache), LuaException);
+  EXPECT_EQ(nullptr, cache.find("bad code"));
+
+  auto state1 = std::make_unique<ThreadLocalState>(SCRIPT, tls_, &cache);
+  BytecodeCache::BytecodeSharedPtr bytecode = cache.find(SCRIPT);
+  EXPECT_NE(nullptr, bytecode);
+
+  auto state2 = std::make_unique<ThreadLocalState>(SCRIPT, tls_, &cache);
+  EXPECT_EQ(bytecode, cache.find(SCRIPT));
+  EXPECT_NE(LUA_REFNIL, state2->getGlobalRef(state2->registerGlobal("callMe")));
+
+  bytecode.reset();
+  state1.reset();
+  EXPECT_NE(nullptr, cache.find(SCRIPT));
+  state2.reset();
+  EXPECT_EQ(nullptr, cache.find(SCRIPT));
+}
+
 } // namespace
 } // namespace Lua
 } // namespace Common
@@ -0,0 +1,293 @@
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/config/filter/http/ext_authz/v2/ext_authz.pb.h"
+#include "envoy/service/auth/v2/external_auth.pb.h"
+
+#include "common/stats/isolated_store_impl.h"
+
+#include "extensions/filters/http/ext_authz/check_cache.h"
+
+#include "test/extensions/filters/common/ext_authz/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/tracing/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::WithArgs;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+using Filters::Common::ExtAuthz::CheckStatus;
+using Filters::Common::ExtAuthz::MockClient;
+using Filters::Common::ExtAuthz::MockRequestCallbacks;
+using Filters::Common::ExtAuthz::RequestCallbacks;
+using Filters::Common::ExtAuthz::Response;
+using Filters::Common::ExtAuthz::ResponsePtr;
+
+envoy::service::auth::v2::CheckRequest checkRequest(const std::string& method,
+                                                    const std::string& path,
+                                                    const std::string& authorization) {
+  envoy::service::auth::v2::CheckRequest request;
+  auto& http = *request.mutable_attributes()->mutable_request()->mutable_http();
+  http.set_method(method);
+  http.set_path(path);
+  if (!authorization.empty()) {
+    (*http.mutable_headers())["authorization"] = authorization;
+  }
+  return request;
+}
+
+CheckCacheSettings settings(const std::string& yaml) {
+  envoy::config::filter::http::ext_authz::v2::CacheSettings config;
+  TestUtility::loadFromYaml(yaml, config);
+  return CheckCacheSettings(config);
+}
+
+TEST(CheckCacheSettingsTest, KeyHeaders) {
+  const auto cache_settings = settings(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  )EOF");
+  const std::string key = cache_settings.key(checkRequest("GET", "/a", "Bearer x"));
+  EXPECT_EQ(32U, key.size());
+  // Only the configured components are part of the key.
+  EXPECT_EQ(key, cache_settings.key(checkRequest("POST", "/b", "Bearer x")));
+  EXPECT_NE(key, cache_settings.key(checkRequest("GET", "/a", "Bearer y")));
+  EXPECT_NE(key, cache_settings.key(checkRequest("GET", "/a", "")));
+}
+
+TEST(CheckCacheSettingsTest, KeyMethodAndPath) {
+  const auto cache_settings = settings(R"EOF(
+  key_method: true
+  key_path: true
+  ttl: 10s
+  )EOF");
+  const std::string key = cache_settings.key(checkRequest("GET", "/a/b", ""));
+  EXPECT_EQ(key, cache_settings.key(checkRequest("GET", "/a/b?c=d", "Bearer x")));
+  EXPECT_NE(key, cache_settings.key(checkRequest("POST", "/a/b", "")));
+  EXPECT_NE(key, cache_settings.key(checkRequest("GET", "/a/c", "")));
+}
+
+TEST(CheckCacheSettingsTest, KeyPathSegments) {
+  const auto cache_settings = settings(R"EOF(
+  key_path: true
+  key_path_segments: 2
+  ttl: 10s
+  )EOF");
+  const std::string key = cache_settings.key(checkRequest("GET", "/api/v1", ""));
+  EXPECT_EQ(key, cache_settings.key(checkRequest("GET", "/api/v1/users/42", "")));
+  EXPECT_EQ(key, cache_settings.key(checkRequest("GET", "/api/v1?users", "")));
+  EXPECT_NE(key, cache_settings.key(checkRequest("GET", "/api/v2/users/42", "")));
+  EXPECT_NE(key, cache_settings.key(checkRequest("GET", "/api", "")));
+}
+
+TEST(CheckCacheSettingsTest, KeyPeerIdentityAndContextExtensions) {
+  const auto cache_settings = settings(R"EOF(
+  key_peer_identity: true
+  ttl: 10s
+  )EOF");
+  auto request = checkRequest("GET", "/", "");
+  request.mutable_attributes()->mutable_source()->set_principal("spiffe://cluster.local/a");
+  const std::string key = cache_settings.key(request);
+
+  auto other_peer = request;
+  other_peer.mutable_attributes()->mutable_source()->set_principal("spiffe://cluster.local/b");
+  EXPECT_NE(key, cache_settings.key(other_peer));
+
+  auto other_extensions = request;
+  (*other_extensions.mutable_attributes()->mutable_context_extensions())["route"] = "a";
+  EXPECT_NE(key, cache_settings.key(other_extensions));
+}
+
+class CheckCacheTest : public testing::Test {
+public:
+  void initialize(const std::string& yaml) {
+    cache_ = std::make_unique<CheckCache>(
+        std::make_shared<const CheckCacheSettings>(settings(yaml)), dispatcher_, stats_);
+  }
+
+  // Starts a check with a new client, returning the callbacks of the client.
+  RequestCallbacks* startCheck(const std::string& key, RequestCallbacks& callbacks) {
+    auto client = std::make_unique<NiceMock<MockClient>>();
+    RequestCallbacks* client_callbacks{};
+    EXPECT_CALL(*client, check(_, _, _))
+        .WillOnce(WithArgs<0>(Invoke([&](RequestCallbacks& cb) { client_callbacks = &cb; })));
+    EXPECT_FALSE(
+        cache_->check(key, callbacks, std::move(client), checkRequest("GET", "/", ""), span_));
+    return client_callbacks;
+  }
+
+  static ResponsePtr response(CheckStatus status) {
+    auto response = std::make_unique<Response>();
+    response->status = status;
+    response->headers_to_add.emplace_back(Http::LowerCaseString{"x-user"}, "alice");
+    return response;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Stats::IsolatedStoreImpl store_;
+  CheckCacheStats stats_{ALL_EXT_AUTHZ_CACHE_STATS(POOL_COUNTER_PREFIX(store_, "ext_authz."))};
+  NiceMock<Tracing::MockSpan> span_;
+  std::unique_ptr<CheckCache> cache_;
+};
+
+TEST_F(CheckCacheTest, CacheOkResponse) {
+  initialize("ttl: 10s");
+  EXPECT_EQ(nullptr, cache_->lookup("key"));
+  EXPECT_EQ(1U, stats_.cache_miss_.value());
+
+  MockRequestCallbacks callbacks;
+  RequestCallbacks* client_callbacks = startCheck("key", callbacks);
+  ASSERT_NE(nullptr, client_callbacks);
+  EXPECT_CALL(callbacks, onComplete_(_)).WillOnce(Invoke([](ResponsePtr& response) {
+    EXPECT_EQ(CheckStatus::OK, response->status);
+  }));
+  client_callbacks->onComplete(response(CheckStatus::OK));
+
+  ResponsePtr cached = cache_->lookup("key");
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(1U, stats_.cache_hit_.value());
+  EXPECT_EQ(CheckStatus::OK, cached->status);
+  ASSERT_EQ(1U, cached->headers_to_add.size());
+  EXPECT_EQ("alice", cached->headers_to_add[0].second);
+
+  time_system_.sleep(std::chrono::seconds(11));
+  EXPECT_EQ(nullptr, cache_->lookup("key"));
+  EXPECT_EQ(0U, cache_->size());
+}
+
+TEST_F(CheckCacheTest, CoalesceChecks) {
+  initialize("ttl: 10s");
+  MockRequestCallbacks callbacks1;
+  MockRequestCallbacks callbacks2;
+  MockRequestCallbacks callbacks3;
+  RequestCallbacks* client_callbacks = startCheck("key", callbacks1);
+
+  // The later checks with the same key wait for the first one, and don't use their clients.
+  auto client = std::make_unique<MockClient>();
+  EXPECT_CALL(*client, check(_, _, _)).Times(0);
+  EXPECT_TRUE(
+      cache_->check("key", callbacks2, std::move(client), checkRequest("GET", "/", ""), span_));
+  EXPECT_TRUE(cache_->check("key", callbacks3, std::make_unique<MockClient>(),
+                            checkRequest("GET", "/", ""), span_));
+  EXPECT_EQ(2U, stats_.cache_coalesced_.value());
+
+  // A cancelled request isn't called back.
+  cache_->cancel("key", callbacks2);
+  EXPECT_CALL(callbacks1, onComplete_(_));
+  EXPECT_CALL(callbacks2, onComplete_(_)).Times(0);
+  EXPECT_CALL(callbacks3, onComplete_(_));
+  EXPECT_CALL(dispatcher_, deferredDelete_(_));
+  client_callbacks->onComplete(response(CheckStatus::OK));
+}
+
+TEST_F(CheckCacheTest, CheckOutlivesCancelledRequests) {
+  initialize("ttl: 10s");
+  MockRequestCallbacks callbacks;
+  RequestCallbacks* client_callbacks = startCheck("key", callbacks);
+  cache_->cancel("key", callbacks);
+
+  EXPECT_CALL(callbacks, onComplete_(_)).Times(0);
+  client_callbacks->onComplete(response(CheckStatus::OK));
+  EXPECT_NE(nullptr, cache_->lookup("key"));
+}
+
+TEST_F(CheckCacheTest, CallbackCancelsOtherRequest) {
+  initialize("ttl: 10s");
+  MockRequestCallbacks callbacks1;
+  MockRequestCallbacks callbacks2;
+  RequestCallbacks* client_callbacks = startCheck("key", callbacks1);
+  cache_->check("key", callbacks2, std::make_unique<MockClient>(), checkRequest("GET", "/", ""),
+                span_);
+
+  EXPECT_CALL(callbacks1, onComplete_(_)).WillOnce(Invoke([&](ResponsePtr&) {
+    cache_->cancel("key", callbacks2);
+  }));
+  EXPECT_CALL(callbacks2, onComplete_(_)).Times(0);
+  client_callbacks->onComplete(response(CheckStatus::OK));
+}
+
+TEST_F(CheckCacheTest, ImmediateResponse) {
+  initialize("ttl: 10s");
+  MockRequestCallbacks callbacks;
+  auto client = std::make_unique<MockClient>();
+  EXPECT_CALL(*client, check(_, _, _))
+      .WillOnce(WithArgs<0>(Invoke(
+          [](RequestCallbacks& cb) { cb.onComplete(response(CheckStatus::OK)); })));
+  EXPECT_CALL(callbacks, onComplete_(_));
+  cache_->check("key", callbacks, std::move(client), checkRequest("GET", "/", ""), span_);
+  EXPECT_NE(nullptr, cache_->lookup("key"));
+}
+
+TEST_F(CheckCacheTest, DeniedAndErrorResponses) {
+  initialize("ttl: 10s");
+  NiceMock<MockRequestCallbacks> callbacks;
+  startCheck("denied", callbacks)->onComplete(response(CheckStatus::Denied));
+  startCheck("error", callbacks)->onComplete(response(CheckStatus::Error));
+  EXPECT_EQ(nullptr, cache_->lookup("denied"));
+  EXPECT_EQ(nullptr, cache_->lookup("error"));
+}
+
+TEST_F(CheckCacheTest, NegativeCaching) {
+  initialize(R"EOF(
+  ttl: 10s
+  negative_ttl: 1s
+  )EOF");
+  NiceMock<MockRequestCallbacks> callbacks;
+  startCheck("denied", callbacks)->onComplete(response(CheckStatus::Denied));
+  startCheck("error", callbacks)->onComplete(response(CheckStatus::Error));
+  ResponsePtr cached = cache_->lookup("denied");
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(CheckStatus::Denied, cached->status);
+  EXPECT_EQ(nullptr, cache_->lookup("error"));
+
+  time_system_.sleep(std::chrono::seconds(2));
+  EXPECT_EQ(nullptr, cache_->lookup("denied"));
+}
+
+TEST_F(CheckCacheTest, EvictLeastRecentlyUsed) {
+  initialize(R"EOF(
+  ttl: 10s
+  max_entries: 2
+  )EOF");
+  NiceMock<MockRequestCallbacks> callbacks;
+  startCheck("a", callbacks)->onComplete(response(CheckStatus::OK));
+  startCheck("b", callbacks)->onComplete(response(CheckStatus::OK));
+  EXPECT_NE(nullptr, cache_->lookup("a"));
+
+  startCheck("c", callbacks)->onComplete(response(CheckStatus::OK));
+  EXPECT_EQ(1U, stats_.cache_evicted_.value());
+  EXPECT_EQ(2U, cache_->size());
+  EXPECT_NE(nullptr, cache_->lookup("a"));
+  EXPECT_EQ(nullptr, cache_->lookup("b"));
+  EXPECT_NE(nullptr, cache_->lookup("c"));
+}
+
+TEST_F(CheckCacheTest, DestroyWithPendingCheck) {
+  initialize("ttl: 10s");
+  MockRequestCallbacks callbacks;
+  auto client = std::make_unique<MockClient>();
+  EXPECT_CALL(*client, check(_, _, _));
+  EXPECT_CALL(*client, cancel());
+  cache_->check("key", callbacks, std::move(client), checkRequest("GET", "/", ""), span_);
+  cache_.reset();
+}
+
+} // namespace
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -26,6 +26,7 @@
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/router/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/tracing/mocks.h"
 #include "test/mocks/upstream/mocks.h"
 #include "test/test_common/printers.h"
@@ -60,7 +61,7 @@ public:
       TestUtility::loadFromYaml(yaml, proto_config);
     }
     config_.reset(new FilterConfig(proto_config, local_info_, stats_store_, runtime_, http_context_,
-                                   "ext_authz_prefix"));
+                                   tls_, "ext_authz_prefix"));
     client_ = new Filters::Common::ExtAuthz::MockClient();
     filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_});
     filter_->setDecoderFilterCallbacks(filter_callbacks_);
@@ -78,6 +79,7 @@ public:
   NiceMock<Runtime::MockLoader> runtime_;
   NiceMock<Upstream::MockClusterManager> cm_;
   NiceMock<LocalInfo::MockLocalInfo> local_info_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
   Network::Address::InstanceConstSharedPtr addr_;
   NiceMock<Envoy::Network::MockConnection> connection_;
   Http::ContextImpl http_context_;
@@ -900,6 +902,172 @@ TEST_F(HttpFilterTest, FilterEnabled) {
 // Parameterized Tests
 // -------------------
 
+// Test that a cached response is applied to a later request with the same key without calling the
+// authorization service, including the headers to add.
+TEST_F(HttpFilterTest, CachedOkResponse) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  cache_settings:
+    key_headers: ["authorization"]
+    ttl: 10s
+  )EOF");
+
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  response.headers_to_add = Http::HeaderVector{{Http::LowerCaseString{"x-user"}, "alice"}};
+
+  request_headers_.addCopy(Http::Headers::get().Authorization, "Bearer token");
+  prepareCheck();
+  EXPECT_CALL(*client_, check(_, _, _))
+      .WillOnce(
+          WithArgs<0>(Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks) -> void {
+            callbacks.onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+          })));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  EXPECT_EQ("alice", request_headers_.get_("x-user"));
+
+  auto* client = new Filters::Common::ExtAuthz::MockClient();
+  EXPECT_CALL(*client, check(_, _, _)).Times(0);
+  Filter filter(config_, Filters::Common::ExtAuthz::ClientPtr{client});
+  filter.setDecoderFilterCallbacks(filter_callbacks_);
+  Http::TestHeaderMapImpl headers{{"authorization", "Bearer token"}};
+  prepareCheck();
+  EXPECT_CALL(filter_callbacks_, continueDecoding()).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter.decodeHeaders(headers, false));
+  EXPECT_EQ("alice", headers.get_("x-user"));
+  // The cache hit is only counted in the cache stats.
+  EXPECT_EQ(1U, config_->stats().ok_.value());
+  EXPECT_EQ(1U, filter_callbacks_.clusterInfo()->statsScope().counter("ext_authz.ok").value());
+  EXPECT_EQ(1U, stats_store_.counter("ext_authz_prefix.ext_authz.cache_hit").value());
+  EXPECT_EQ(1U, stats_store_.counter("ext_authz_prefix.ext_authz.cache_miss").value());
+}
+
+// Test that a cached denied response rejects a later request with the same key, and that the cache
+// hit is not counted as a denied response of the authorization service.
+TEST_F(HttpFilterTest, CachedDeniedResponse) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  cache_settings:
+    key_headers: ["authorization"]
+    ttl: 10s
+    negative_ttl: 10s
+  )EOF");
+
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::Denied;
+  response.status_code = Http::Code::Forbidden;
+
+  request_headers_.addCopy(Http::Headers::get().Authorization, "Bearer token");
+  prepareCheck();
+  EXPECT_CALL(*client_, check(_, _, _))
+      .WillOnce(
+          WithArgs<0>(Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks) -> void {
+            callbacks.onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+          })));
+  EXPECT_CALL(filter_callbacks_, encodeHeaders_(_, true)).Times(2);
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers_, false));
+
+  auto* client = new Filters::Common::ExtAuthz::MockClient();
+  EXPECT_CALL(*client, check(_, _, _)).Times(0);
+  Filter filter(config_, Filters::Common::ExtAuthz::ClientPtr{client});
+  filter.setDecoderFilterCallbacks(filter_callbacks_);
+  Http::TestHeaderMapImpl headers{{"authorization", "Bearer token"}};
+  prepareCheck();
+  EXPECT_CALL(filter_callbacks_, continueDecoding()).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter.decodeHeaders(headers, false));
+  EXPECT_EQ(1U, config_->stats().denied_.value());
+  EXPECT_EQ(1U, filter_callbacks_.clusterInfo()->statsScope().counter("ext_authz.denied").value());
+  EXPECT_EQ(1U, stats_store_.counter("ext_authz_prefix.ext_authz.cache_hit").value());
+}
+
+// Test that concurrent requests with the same key share a check, which isn't cancelled when the
+// request starting it is reset.
+TEST_F(HttpFilterTest, CoalescedCheck) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  cache_settings:
+    key_headers: ["authorization"]
+    ttl: 10s
+  )EOF");
+
+  request_headers_.addCopy(Http::Headers::get().Authorization, "Bearer token");
+  prepareCheck();
+  EXPECT_CALL(*client_, check(_, _, _))
+      .WillOnce(
+          WithArgs<0>(Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks) -> void {
+            request_callbacks_ = &callbacks;
+          })));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers_, false));
+
+  auto* client = new Filters::Common::ExtAuthz::MockClient();
+  EXPECT_CALL(*client, check(_, _, _)).Times(0);
+  Filter filter(config_, Filters::Common::ExtAuthz::ClientPtr{client});
+  filter.setDecoderFilterCallbacks(filter_callbacks_);
+  Http::TestHeaderMapImpl headers{{"authorization", "Bearer token"}};
+  prepareCheck();
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter.decodeHeaders(headers, false));
+  EXPECT_EQ(1U, stats_store_.counter("ext_authz_prefix.ext_authz.cache_coalesced").value());
+
+  EXPECT_CALL(*client_, cancel()).Times(0);
+  filter_->onDestroy();
+
+  EXPECT_CALL(filter_callbacks_, continueDecoding());
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  request_callbacks_->onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+  // The waiting request didn't call the authorization service, and the request that did was reset.
+  EXPECT_EQ(0U, config_->stats().ok_.value());
+}
+
+// Test that a check shared by coalesced requests is counted once in the filter and cluster stats.
+TEST_F(HttpFilterTest, CoalescedCheckCountedOnce) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  cache_settings:
+    key_headers: ["authorization"]
+    ttl: 10s
+  )EOF");
+
+  request_headers_.addCopy(Http::Headers::get().Authorization, "Bearer token");
+  prepareCheck();
+  EXPECT_CALL(*client_, check(_, _, _))
+      .WillOnce(
+          WithArgs<0>(Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks) -> void {
+            request_callbacks_ = &callbacks;
+          })));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers_, false));
+
+  auto* client = new Filters::Common::ExtAuthz::MockClient();
+  EXPECT_CALL(*client, check(_, _, _)).Times(0);
+  Filter filter(config_, Filters::Common::ExtAuthz::ClientPtr{client});
+  filter.setDecoderFilterCallbacks(filter_callbacks_);
+  Http::TestHeaderMapImpl headers{{"authorization", "Bearer token"}};
+  prepareCheck();
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter.decodeHeaders(headers, false));
+
+  EXPECT_CALL(filter_callbacks_, continueDecoding()).Times(2);
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  request_callbacks_->onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+  EXPECT_EQ(1U, config_->stats().ok_.value());
+  EXPECT_EQ(1U, filter_callbacks_.clusterInfo()->statsScope().counter("ext_authz.ok").value());
+  EXPECT_EQ(1U, stats_store_.counter("ext_authz_prefix.ext_authz.cache_coalesced").value());
+}
+
 // Test that context extensions make it into the check request.
 TEST_F(HttpFilterTestParam, ContextExtensions) {
   // Place something in the context extensions on the virtualhost.
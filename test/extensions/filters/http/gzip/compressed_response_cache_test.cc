@@ -0,0 +1,59 @@
+#include "extensions/filters/http/gzip/compressed_response_cache.h"
+
+#include "test/mocks/stats/mocks.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Gzip {
+namespace {
+
+CompressedBodyConstSharedPtr body(const std::string& value) {
+  return std::make_shared<const std::string>(value);
+}
+
+TEST(CompressedResponseCacheTest, Key) {
+  EXPECT_EQ(CompressedResponseCache::key("a", "/b", "\"c\""),
+            CompressedResponseCache::key("a", "/b", "\"c\""));
+  EXPECT_NE(CompressedResponseCache::key("a", "/b", "\"c\""),
+            CompressedResponseCache::key("a/", "b", "\"c\""));
+  EXPECT_NE(CompressedResponseCache::key("a", "/b", "\"c\""),
+            CompressedResponseCache::key("a", "/b", "\"d\""));
+}
+
+TEST(CompressedResponseCacheTest, LookupAndInsert) {
+  Stats::MockCounter evicted;
+  CompressedResponseCache cache(2, evicted);
+  EXPECT_EQ(nullptr, cache.lookup("a"));
+
+  cache.insert("a", body("1"));
+  EXPECT_EQ("1", *cache.lookup("a"));
+
+  cache.insert("a", body("2"));
+  EXPECT_EQ("2", *cache.lookup("a"));
+  EXPECT_EQ(1, cache.size());
+}
+
+TEST(CompressedResponseCacheTest, EvictLeastRecentlyUsed) {
+  Stats::MockCounter evicted;
+  CompressedResponseCache cache(2, evicted);
+  cache.insert("a", body("1"));
+  cache.insert("b", body("2"));
+  // "a" becomes the most recently used entry.
+  EXPECT_NE(nullptr, cache.lookup("a"));
+
+  EXPECT_CALL(evicted, inc());
+  cache.insert("c", body("3"));
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(nullptr, cache.lookup("b"));
+  EXPECT_EQ("1", *cache.lookup("a"));
+  EXPECT_EQ("3", *cache.lookup("c"));
+}
+
+} // namespace
+} // namespace Gzip
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -8,11 +8,13 @@
 #include "common/decompressor/zlib_decompressor_impl.h"
 #include "common/protobuf/utility.h"
 
+#include "extensions/compression/zlib/zlib_compressor_factory.h"
 #include "extensions/filters/http/gzip/gzip_filter.h"
 
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -68,11 +70,44 @@ protected:
     Json::ObjectSharedPtr config = Json::Factory::loadFromString(json);
     envoy::config::filter::http::gzip::v2::Gzip gzip;
     TestUtility::loadFromJson(json, gzip);
-    config_.reset(new GzipFilterConfig(gzip, "test.", stats_, runtime_));
+    config_.reset(new GzipFilterConfig(gzip, "test.", stats_, runtime_, tls_,
+                                       ProtobufMessage::getStrictValidationVisitor()));
+    newFilter();
+  }
+
+  const Compression::Zlib::ZlibCompressorFactory& zlibFactory() {
+    return dynamic_cast<const Compression::Zlib::ZlibCompressorFactory&>(
+        config_->compressorFactory());
+  }
+
+  void newFilter() {
     filter_ = std::make_unique<GzipFilter>(config_);
     filter_->setEncoderFilterCallbacks(encoder_callbacks_);
   }
 
+  // Sends a request and a 200 response with the given etag through the filter, and returns the
+  // response body sent downstream.
+  std::string doCacheableResponse(const std::string& etag, uint64_t content_length) {
+    doRequest({{":method", "get"},
+               {":authority", "example.com"},
+               {":path", "/static/app.js"},
+               {"accept-encoding", "gzip"}},
+              true);
+    Http::TestHeaderMapImpl headers{{":status", "200"},
+                                    {"content-length", std::to_string(content_length)},
+                                    {"etag", etag}};
+    Buffer::OwnedImpl data;
+    TestUtility::feedBufferWithRandomCharacters(data, content_length);
+    const std::string body = data.toString();
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+    EXPECT_EQ("gzip", headers.get_("content-encoding"));
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data, true));
+    if (expected_str_.empty()) {
+      expected_str_ = body;
+    }
+    return data.toString();
+  }
+
   void verifyCompressedData(const uint32_t content_length) {
     // This makes sure we have a finished buffer before sending it to the client.
     expectValidFinishedBuffer(content_length);
@@ -150,11 +185,11 @@ protected:
       Compressor::ZlibCompressorImpl::CompressionLevel level, absl::string_view level_name) {
     setUpFilter(fmt::format(R"EOF({{"compression_strategy": "{}", "compression_level": "{}"}})EOF",
                             strategy_name, level_name));
-    EXPECT_EQ(strategy, config_->compressionStrategy());
-    EXPECT_EQ(level, config_->compressionLevel());
-    EXPECT_EQ(5, config_->memoryLevel());
+    EXPECT_EQ(strategy, zlibFactory().compressionStrategy());
+    EXPECT_EQ(level, zlibFactory().compressionLevel());
+    EXPECT_EQ(5, zlibFactory().memoryLevel());
     EXPECT_EQ(30, config_->minimumLength());
-    EXPECT_EQ(28, config_->windowBits());
+    EXPECT_EQ(28, zlibFactory().windowBits());
     EXPECT_EQ(false, config_->disableOnEtagHeader());
     EXPECT_EQ(false, config_->removeAcceptEncodingHeader());
     EXPECT_EQ(8, config_->contentTypeValues().size());
@@ -185,6 +220,7 @@ protected:
   std::string expected_str_;
   Stats::IsolatedStoreImpl stats_;
   NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
   NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
 };
 
@@ -198,15 +234,15 @@ TEST_F(GzipFilterTest, RuntimeDisabled) {
 
 // Default config values.
 TEST_F(GzipFilterTest, DefaultConfigValues) {
-  EXPECT_EQ(5, config_->memoryLevel());
+  EXPECT_EQ(5, zlibFactory().memoryLevel());
   EXPECT_EQ(30, config_->minimumLength());
-  EXPECT_EQ(28, config_->windowBits());
+  EXPECT_EQ(28, zlibFactory().windowBits());
   EXPECT_EQ(false, config_->disableOnEtagHeader());
   EXPECT_EQ(false, config_->removeAcceptEncodingHeader());
   EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
-            config_->compressionStrategy());
+            zlibFactory().compressionStrategy());
   EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
-            config_->compressionLevel());
+            zlibFactory().compressionLevel());
   EXPECT_EQ(8, config_->contentTypeValues().size());
 }
 
@@ -246,6 +282,52 @@ TEST_F(GzipFilterTest, AcceptanceGzipEncodingWithTrailers) {
   doResponseCompression({{":method", "get"}, {"content-length", "256"}}, true);
 }
 
+// The compressor library replaces the zlib fields of the filter.
+TEST_F(GzipFilterTest, CompressorLibrary) {
+  setUpFilter(R"EOF(
+{
+  "compression_level": "SPEED",
+  "memory_level": 2,
+  "compressor_library": {
+    "name": "envoy.compressors.zlib",
+    "typed_config": {
+      "@type": "type.googleapis.com/envoy.config.compressor.zlib.v2alpha.Zlib",
+      "compression_level": "BEST",
+      "compression_strategy": "RLE",
+      "window_bits": 15
+    }
+  }
+}
+)EOF");
+  EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionLevel::Best,
+            zlibFactory().compressionLevel());
+  EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionStrategy::Rle,
+            zlibFactory().compressionStrategy());
+  EXPECT_EQ(5, zlibFactory().memoryLevel());
+  EXPECT_EQ(31, zlibFactory().windowBits());
+
+  doRequest({{":method", "get"}, {"accept-encoding", "gzip"}}, true);
+  doResponseCompression({{":method", "get"}, {"content-length", "256"}}, false);
+}
+
+// Without a typed config, the compressor library uses its defaults.
+TEST_F(GzipFilterTest, CompressorLibraryDefaults) {
+  setUpFilter(R"EOF({"compressor_library": {"name": "envoy.compressors.zlib"}})EOF");
+  EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+            zlibFactory().compressionLevel());
+  EXPECT_EQ(Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+            zlibFactory().compressionStrategy());
+  EXPECT_EQ(5, zlibFactory().memoryLevel());
+  EXPECT_EQ(28, zlibFactory().windowBits());
+}
+
+TEST_F(GzipFilterTest, UnknownCompressorLibrary) {
+  EXPECT_THROW_WITH_MESSAGE(
+      setUpFilter(R"EOF({"compressor_library": {"name": "envoy.compressors.unknown"}})EOF"),
+      EnvoyException,
+      "Didn't find a registered implementation for name: 'envoy.compressors.unknown'");
+}
+
 // Verifies isAcceptEncodingAllowed function.
 TEST_F(GzipFilterTest, hasCacheControlNoTransform) {
   {
@@ -792,6 +874,86 @@ TEST_F(GzipFilterTest, RemoveAcceptEncodingHeader) {
   }
 }
 
+// Verifies that a response with the same strong etag reuses the cached compressed body, even if
+// the upstream body differs.
+TEST_F(GzipFilterTest, CompressedResponseCacheHit) {
+  setUpFilter(R"EOF({"compressed_response_cache": {}})EOF");
+  const std::string compressed = doCacheableResponse("\"v1\"", 256);
+  EXPECT_EQ(1, stats_.counter("test.gzip.cache_miss").value());
+
+  newFilter();
+  EXPECT_EQ(compressed, doCacheableResponse("\"v1\"", 256));
+  EXPECT_EQ(1, stats_.counter("test.gzip.cache_hit").value());
+  EXPECT_EQ(2, stats_.counter("test.gzip.compressed").value());
+
+  data_.add(compressed);
+  decompressor_.decompress(data_, decompressed_data_);
+  EXPECT_EQ(expected_str_, decompressed_data_.toString());
+
+  // Another etag is a miss.
+  newFilter();
+  EXPECT_NE(compressed, doCacheableResponse("\"v2\"", 256));
+  EXPECT_EQ(2, stats_.counter("test.gzip.cache_miss").value());
+}
+
+// Verifies that a cache hit discards the upstream data until the end of the stream, and that the
+// cached body is sent with the trailers.
+TEST_F(GzipFilterTest, CompressedResponseCacheHitWithTrailers) {
+  setUpFilter(R"EOF({"compressed_response_cache": {}})EOF");
+  const std::string compressed = doCacheableResponse("\"v1\"", 256);
+
+  newFilter();
+  doRequest({{":method", "get"},
+             {":authority", "example.com"},
+             {":path", "/static/app.js"},
+             {"accept-encoding", "gzip"}},
+            true);
+  Http::TestHeaderMapImpl headers{
+      {":status", "200"}, {"content-length", "256"}, {"etag", "\"v1\""}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+  feedBuffer(256);
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data_, false));
+  EXPECT_EQ(0, data_.length());
+  EXPECT_CALL(encoder_callbacks_, addEncodedData(_, true))
+      .WillOnce(Invoke(
+          [&](Buffer::Instance& data, bool) { EXPECT_EQ(compressed, data.toString()); }));
+  Http::TestHeaderMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->encodeTrailers(trailers));
+  EXPECT_EQ(1, stats_.counter("test.gzip.cache_hit").value());
+}
+
+// Verifies that only 200 responses with a strong etag are cached.
+TEST_F(GzipFilterTest, CompressedResponseCacheNotCacheable) {
+  setUpFilter(R"EOF({"compressed_response_cache": {}})EOF");
+  doCacheableResponse("W/\"v1\"", 256);
+  newFilter();
+  doCacheableResponse("W/\"v1\"", 256);
+
+  newFilter();
+  doRequest({{":method", "get"},
+             {":authority", "example.com"},
+             {":path", "/static/app.js"},
+             {"accept-encoding", "gzip"}},
+            true);
+  Http::TestHeaderMapImpl headers{
+      {":status", "206"}, {"content-length", "256"}, {"etag", "\"v1\""}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+
+  EXPECT_EQ(0, stats_.counter("test.gzip.cache_hit").value());
+  EXPECT_EQ(0, stats_.counter("test.gzip.cache_miss").value());
+  EXPECT_EQ(3, stats_.counter("test.gzip.compressed").value());
+}
+
+// Verifies that compressed bodies larger than max_body_bytes are not cached.
+TEST_F(GzipFilterTest, CompressedResponseCacheBodyTooLarge) {
+  setUpFilter(R"EOF({"compressed_response_cache": {"max_body_bytes": 64}})EOF");
+  doCacheableResponse("\"v1\"", 1024);
+  newFilter();
+  doCacheableResponse("\"v1\"", 1024);
+  EXPECT_EQ(0, stats_.counter("test.gzip.cache_hit").value());
+  EXPECT_EQ(2, stats_.counter("test.gzip.cache_miss").value());
+}
+
 } // namespace Gzip
 } // namespace HttpFilters
 } // namespace Extensions
@@ -109,6 +109,39 @@ TEST_F(AuthenticatorTest, TestOkJWTandCache) {
   }
 }
 
+// This test verifies the verified JWTs are cached: only the first of 10 JWT authentications
+// verifies the token, and the others still forward the payload and remove the token.
+TEST_F(AuthenticatorTest, TestJwtCache) {
+  (*proto_config_.mutable_providers())[std::string(ProviderName)].mutable_jwt_cache_config();
+  CreateAuthenticator();
+  EXPECT_CALL(*raw_fetcher_, fetch(_, _, _))
+      .WillOnce(Invoke([this](const ::envoy::api::v2::core::HttpUri&, Tracing::Span&,
+                              JwksFetcher::JwksReceiver& receiver) {
+        receiver.onJwksSuccess(std::move(jwks_));
+      }));
+
+  for (int i = 0; i < 10; i++) {
+    auto headers = Http::TestHeaderMapImpl{{"Authorization", "Bearer " + std::string(GoodToken)}};
+
+    expectVerifyStatus(Status::Ok, headers);
+
+    EXPECT_EQ(headers.get_("sec-istio-auth-userinfo"), ExpectedPayloadValue);
+    EXPECT_FALSE(headers.Authorization());
+  }
+  EXPECT_EQ(filter_config_->stats().jwt_cache_miss_.value(), 1);
+  EXPECT_EQ(filter_config_->stats().jwt_cache_hit_.value(), 9);
+
+  // The claims of a cached JWT are still checked.
+  auto headers = Http::TestHeaderMapImpl{{"Authorization", "Bearer " + std::string(GoodToken)}};
+  ::google::jwt_verify::CheckAudience check_audience({"other_service"});
+  auth_ = Authenticator::create(
+      &check_audience, absl::make_optional<std::string>(ProviderName), false, false,
+      filter_config_->getCache().getJwksCache(), filter_config_->cm(),
+      [](Upstream::ClusterManager&) { return nullptr; }, filter_config_->timeSource());
+  expectVerifyStatus(Status::JwtAudienceNotAllowed, headers);
+  EXPECT_EQ(filter_config_->stats().jwt_cache_hit_.value(), 10);
+}
+
 // This test verifies the Jwt is forwarded if "forward" flag is set.
 TEST_F(AuthenticatorTest, TestForwardJwt) {
   // Config forward_jwt flag
@@ -23,10 +23,12 @@ namespace {
 
 class JwksCacheTest : public testing::Test {
 protected:
-  JwksCacheTest() : api_(Api::createApiForTest()) {}
+  JwksCacheTest()
+      : api_(Api::createApiForTest()),
+        stats_{ALL_JWT_AUTHN_FILTER_STATS(POOL_COUNTER_PREFIX(store_, "jwt_authn."))} {}
   void SetUp() override {
     TestUtility::loadFromYaml(ExampleConfig, config_);
-    cache_ = JwksCache::create(config_, time_system_, *api_);
+    cache_ = JwksCache::create(config_, time_system_, *api_, stats_);
     jwks_ = google::jwt_verify::Jwks::createFrom(PublicKey, google::jwt_verify::Jwks::JWKS);
   }
 
@@ -35,6 +37,8 @@ protected:
   JwksCachePtr cache_;
   google::jwt_verify::JwksPtr jwks_;
   Api::ApiPtr api_;
+  Stats::IsolatedStoreImpl store_;
+  JwtAuthnFilterStats stats_;
 };
 
 // Test findByIssuer
@@ -48,7 +52,7 @@ TEST_F(JwksCacheTest, TestSetRemoteJwks) {
   auto& provider0 = (*config_.mutable_providers())[std::string(ProviderName)];
   // Set cache_duration to 1 second to test expiration
   provider0.mutable_remote_jwks()->mutable_cache_duration()->set_seconds(1);
-  cache_ = JwksCache::create(config_, time_system_, *api_);
+  cache_ = JwksCache::create(config_, time_system_, *api_, stats_);
 
   auto jwks = cache_->findByIssuer("https://example.com");
   EXPECT_TRUE(jwks->getJwksObj() == nullptr);
@@ -62,12 +66,31 @@ TEST_F(JwksCacheTest, TestSetRemoteJwks) {
   EXPECT_TRUE(jwks->isExpired());
 }
 
+// Test setRemoteJwks removes the JWTs verified with the previous Jwks from the Jwt cache.
+TEST_F(JwksCacheTest, TestSetRemoteJwksClearsJwtCache) {
+  auto& provider0 = (*config_.mutable_providers())[std::string(ProviderName)];
+  provider0.mutable_jwt_cache_config();
+  cache_ = JwksCache::create(config_, time_system_, *api_, stats_);
+
+  auto jwks = cache_->findByIssuer("https://example.com");
+  EXPECT_EQ(jwks->setRemoteJwks(std::move(jwks_))->getStatus(), Status::Ok);
+
+  auto jwt = std::make_shared<::google::jwt_verify::Jwt>();
+  EXPECT_EQ(jwt->parseFromString(GoodToken), Status::Ok);
+  jwks->getJwtCache().insert(GoodToken, jwt);
+  EXPECT_EQ(jwks->getJwtCache().lookup(GoodToken), jwt);
+
+  jwks->setRemoteJwks(
+      google::jwt_verify::Jwks::createFrom(PublicKey, google::jwt_verify::Jwks::JWKS));
+  EXPECT_EQ(jwks->getJwtCache().lookup(GoodToken), nullptr);
+}
+
 // Test setRemoteJwks and use default cache duration.
 TEST_F(JwksCacheTest, TestSetRemoteJwksWithDefaultCacheDuration) {
   auto& provider0 = (*config_.mutable_providers())[std::string(ProviderName)];
   // Clear cache_duration to use default one.
   provider0.mutable_remote_jwks()->clear_cache_duration();
-  cache_ = JwksCache::create(config_, time_system_, *api_);
+  cache_ = JwksCache::create(config_, time_system_, *api_, stats_);
 
   auto jwks = cache_->findByIssuer("https://example.com");
   EXPECT_TRUE(jwks->getJwksObj() == nullptr);
@@ -84,7 +107,7 @@ TEST_F(JwksCacheTest, TestGoodInlineJwks) {
   auto local_jwks = provider0.mutable_local_jwks();
   local_jwks->set_inline_string(PublicKey);
 
-  cache_ = JwksCache::create(config_, time_system_, *api_);
+  cache_ = JwksCache::create(config_, time_system_, *api_, stats_);
 
   auto jwks = cache_->findByIssuer("https://example.com");
   EXPECT_FALSE(jwks->getJwksObj() == nullptr);
@@ -98,7 +121,7 @@ TEST_F(JwksCacheTest, TestBadInlineJwks) {
   auto local_jwks = provider0.mutable_local_jwks();
   local_jwks->set_inline_string("BAD-JWKS");
 
-  cache_ = JwksCache::create(config_, time_system_, *api_);
+  cache_ = JwksCache::create(config_, time_system_, *api_, stats_);
 
   auto jwks = cache_->findByIssuer("https://example.com");
   EXPECT_TRUE(jwks->getJwksObj() == nullptr);
@@ -0,0 +1,107 @@
+#include "envoy/config/filter/http/jwt_authn/v2alpha/config.pb.h"
+
+#include "common/stats/isolated_store_impl.h"
+
+#include "extensions/filters/http/jwt_authn/jwt_cache.h"
+
+#include "test/extensions/filters/http/jwt_authn/test_common.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+using ::envoy::config::filter::http::jwt_authn::v2alpha::JwtProvider;
+using ::google::jwt_verify::Jwt;
+using ::google::jwt_verify::Status;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace JwtAuthn {
+namespace {
+
+class JwtCacheTest : public testing::Test {
+protected:
+  JwtCacheTest() : stats_{ALL_JWT_AUTHN_FILTER_STATS(POOL_COUNTER_PREFIX(store_, "jwt_authn."))} {
+    // The good tokens expire at 2001001001.
+    time_system_.setSystemTime(std::chrono::system_clock::from_time_t(2001000000));
+  }
+
+  void createCache(uint32_t size) {
+    config_.mutable_jwt_cache_config()->set_jwt_cache_size(size);
+    cache_ = JwtCache::create(config_, time_system_, stats_);
+  }
+
+  JwtConstSharedPtr parse(const std::string& token) {
+    auto jwt = std::make_shared<Jwt>();
+    EXPECT_EQ(jwt->parseFromString(token), Status::Ok);
+    return jwt;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl store_;
+  JwtAuthnFilterStats stats_;
+  JwtProvider config_;
+  JwtCachePtr cache_;
+};
+
+TEST_F(JwtCacheTest, LookupAndInsert) {
+  createCache(10);
+  EXPECT_EQ(cache_->lookup(GoodToken), nullptr);
+  EXPECT_EQ(stats_.jwt_cache_miss_.value(), 1);
+
+  const auto jwt = parse(GoodToken);
+  cache_->insert(GoodToken, jwt);
+  EXPECT_EQ(cache_->lookup(GoodToken), jwt);
+  EXPECT_EQ(stats_.jwt_cache_hit_.value(), 1);
+  EXPECT_EQ(cache_->lookup(OtherGoodToken), nullptr);
+  EXPECT_EQ(stats_.jwt_cache_miss_.value(), 2);
+
+  cache_->clear();
+  EXPECT_EQ(cache_->lookup(GoodToken), nullptr);
+}
+
+TEST_F(JwtCacheTest, EvictLeastRecentlyUsed) {
+  createCache(2);
+  cache_->insert(GoodToken, parse(GoodToken));
+  cache_->insert(OtherGoodToken, parse(OtherGoodToken));
+  // Use GoodToken, so that OtherGoodToken is the least recently used one.
+  EXPECT_NE(cache_->lookup(GoodToken), nullptr);
+
+  cache_->insert(NonExpiringToken, parse(NonExpiringToken));
+  EXPECT_EQ(stats_.jwt_cache_evict_.value(), 1);
+  EXPECT_NE(cache_->lookup(GoodToken), nullptr);
+  EXPECT_NE(cache_->lookup(NonExpiringToken), nullptr);
+  EXPECT_EQ(cache_->lookup(OtherGoodToken), nullptr);
+}
+
+TEST_F(JwtCacheTest, ExpiredTokenIsRemoved) {
+  createCache(10);
+  cache_->insert(GoodToken, parse(GoodToken));
+  cache_->insert(NonExpiringToken, parse(NonExpiringToken));
+  EXPECT_NE(cache_->lookup(GoodToken), nullptr);
+
+  time_system_.setSystemTime(std::chrono::system_clock::from_time_t(2001001002));
+  EXPECT_EQ(cache_->lookup(GoodToken), nullptr);
+  EXPECT_EQ(stats_.jwt_cache_miss_.value(), 1);
+  // Tokens without "exp" claim don't expire.
+  EXPECT_NE(cache_->lookup(NonExpiringToken), nullptr);
+}
+
+TEST_F(JwtCacheTest, DefaultSize) {
+  createCache(0);
+  cache_->insert(GoodToken, parse(GoodToken));
+  EXPECT_NE(cache_->lookup(GoodToken), nullptr);
+}
+
+TEST_F(JwtCacheTest, NotConfigured) {
+  cache_ = JwtCache::create(config_, time_system_, stats_);
+  cache_->insert(GoodToken, parse(GoodToken));
+  EXPECT_EQ(cache_->lookup(GoodToken), nullptr);
+  EXPECT_EQ(stats_.jwt_cache_miss_.value(), 0);
+}
+
+} // namespace
+} // namespace JwtAuthn
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -11,9 +11,11 @@
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/ssl/mocks.h"
+#include "test/mocks/stats/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/upstream/mocks.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -23,6 +25,7 @@ using testing::AtLeast;
 using testing::Eq;
 using testing::InSequence;
 using testing::Invoke;
+using testing::Property;
 using testing::Return;
 using testing::ReturnRef;
 using testing::StrEq;
@@ -70,7 +73,8 @@ public:
   ~LuaHttpFilterTest() override { filter_->onDestroy(); }
 
   void setup(const std::string& lua_code) {
-    config_.reset(new FilterConfig(lua_code, tls_, cluster_manager_));
+    config_.reset(new FilterConfig(lua_code, tls_, cluster_manager_, "test.", stats_store_,
+                                   time_system_, bytecode_cache_));
     setupFilter();
   }
 
@@ -94,6 +98,10 @@ public:
 
   NiceMock<ThreadLocal::MockInstance> tls_;
   Upstream::MockClusterManager cluster_manager_;
+  NiceMock<Stats::MockIsolatedStatsStore> stats_store_;
+  Event::SimulatedTimeSystem time_system_;
+  Filters::Common::Lua::BytecodeCacheSharedPtr bytecode_cache_{
+      std::make_shared<Filters::Common::Lua::BytecodeCache>()};
   std::shared_ptr<FilterConfig> config_;
   std::unique_ptr<TestFilter> filter_;
   Http::MockStreamDecoderFilterCallbacks decoder_callbacks_;
@@ -189,7 +197,10 @@ TEST(LuaHttpFilterConfigTest, BadCode) {
 
   NiceMock<ThreadLocal::MockInstance> tls;
   NiceMock<Upstream::MockClusterManager> cluster_manager;
-  EXPECT_THROW_WITH_MESSAGE(FilterConfig(SCRIPT, tls, cluster_manager),
+  Stats::IsolatedStoreImpl stats_store;
+  Event::SimulatedTimeSystem time_system;
+  EXPECT_THROW_WITH_MESSAGE(FilterConfig(SCRIPT, tls, cluster_manager, "test.", stats_store,
+                                         time_system, nullptr),
                             Filters::Common::Lua::LuaException,
                             "script load error: [string \"...\"]:3: '=' expected near '<eof>'");
 }
@@ -556,6 +567,64 @@ TEST_F(LuaHttpFilterTest, ScriptErrorHeadersRequestBodyTrailers) {
 
   Http::TestHeaderMapImpl request_trailers{{"foo", "bar"}};
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
+  EXPECT_EQ(1UL, stats_store_.counter("test.lua.errors").value());
+}
+
+// The time spent running the script is recorded once per stream, and not at all for the streams
+// without any script function to run.
+TEST_F(LuaHttpFilterTest, ScriptTimeStats) {
+  const std::string SCRIPT{R"EOF(
+    function envoy_on_response(response_handle)
+      response_handle:logTrace("response")
+    end
+  )EOF"};
+
+  InSequence s;
+  setup(SCRIPT);
+
+  Http::TestHeaderMapImpl request_headers{{":path", "/"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+  EXPECT_CALL(stats_store_, deliverHistogramToSinks(_, _)).Times(0);
+  filter_->onDestroy();
+
+  setupFilter();
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+  Http::TestHeaderMapImpl response_headers{{":status", "200"}};
+  EXPECT_CALL(*filter_, scriptLog(spdlog::level::trace, StrEq("response")));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers, true));
+  EXPECT_EQ(0UL, stats_store_.counter("test.lua.errors").value());
+
+  // The fixture destroys the second filter.
+  EXPECT_CALL(stats_store_, deliverHistogramToSinks(
+                                Property(&Stats::Metric::name, "test.lua.script_time_us"), _));
+}
+
+// A local reply destroys the filter while the script runs. The time spent running the script up to
+// then is recorded, once.
+TEST_F(LuaHttpFilterTest, ScriptTimeStatsLocalReply) {
+  const std::string SCRIPT{R"EOF(
+    function envoy_on_request(request_handle)
+      request_handle:respond({[":status"] = "503"})
+    end
+  )EOF"};
+
+  InSequence s;
+  setup(SCRIPT);
+
+  Http::TestHeaderMapImpl request_headers{{":path", "/"}};
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_(_, true))
+      .WillOnce(Invoke([this](Http::HeaderMap&, bool) {
+        time_system_.sleep(std::chrono::milliseconds(5));
+        filter_->onDestroy();
+        time_system_.sleep(std::chrono::milliseconds(5));
+      }));
+  EXPECT_CALL(stats_store_, deliverHistogramToSinks(
+                                Property(&Stats::Metric::name, "test.lua.script_time_us"), 5000));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers, false));
+
+  // The fixture destroys the filter again, which records nothing.
+  EXPECT_CALL(stats_store_, deliverHistogramToSinks(_, _)).Times(0);
 }
 
 // Script that tries to store a local variable to a global and then use it.
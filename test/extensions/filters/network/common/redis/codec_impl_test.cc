@@ -179,6 +179,35 @@ TEST_F(RedisRespValueTest, SwapTest) {
   EXPECT_TRUE(value1 == value3);
 }
 
+TEST_F(RedisRespValueTest, RawTest) {
+  RespValue value;
+  value.type(RespType::BulkString);
+  value.asString() = "foo";
+  EXPECT_EQ(nullptr, value.raw());
+  value.raw(std::make_unique<Buffer::OwnedImpl>("$3\r\nfoo\r\n"));
+
+  // Moves carry the raw bytes along.
+  RespValue moved(std::move(value));
+  ASSERT_NE(nullptr, moved.raw());
+  EXPECT_EQ("$3\r\nfoo\r\n", moved.raw()->toString());
+  RespValue move_assigned;
+  move_assigned = std::move(moved);
+  ASSERT_NE(nullptr, move_assigned.raw());
+  EXPECT_EQ("$3\r\nfoo\r\n", move_assigned.raw()->toString());
+
+  // Copies do not, and the raw bytes do not take part in equality.
+  RespValue copied(move_assigned);
+  EXPECT_EQ(nullptr, copied.raw());
+  RespValue copy_assigned;
+  copy_assigned = move_assigned;
+  EXPECT_EQ(nullptr, copy_assigned.raw());
+  EXPECT_TRUE(copied == move_assigned);
+
+  // Changing the type drops them.
+  move_assigned.type(RespType::BulkString);
+  EXPECT_EQ(nullptr, move_assigned.raw());
+}
+
 TEST_F(RedisRespValueTest, CompositeArrayTest) {
   InSequence s;
 
@@ -397,6 +426,101 @@ TEST_F(RedisEncoderDecoderImplTest, NestedArray) {
   EXPECT_EQ(value, *decoded_values_[0]);
 }
 
+TEST_F(RedisEncoderDecoderImplTest, MultipleValuesPartialDecode) {
+  std::vector<RespValue> values(3);
+  values[0].type(RespType::SimpleString);
+  values[0].asString() = "OK";
+  values[1].type(RespType::Error);
+  values[1].asString() = "ERR unknown command";
+  values[2].type(RespType::Array);
+  values[2].asArray().resize(2);
+  values[2].asArray()[0].type(RespType::Integer);
+  values[2].asArray()[0].asInteger() = -12345;
+  values[2].asArray()[1].type(RespType::SimpleString);
+  values[2].asArray()[1].asString() = "PONG";
+
+  for (const RespValue& value : values) {
+    encoder_.encode(value, buffer_);
+  }
+  EXPECT_EQ("+OK\r\n-ERR unknown command\r\n*2\r\n:-12345\r\n+PONG\r\n", buffer_.toString());
+
+  // Split the values across slices at every position.
+  const std::string encoded = buffer_.toString();
+  for (size_t split = 1; split < encoded.size(); split++) {
+    decoded_values_.clear();
+    Buffer::OwnedImpl first(encoded.substr(0, split));
+    decoder_.decode(first);
+    Buffer::OwnedImpl second(encoded.substr(split));
+    decoder_.decode(second);
+
+    ASSERT_EQ(3UL, decoded_values_.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      EXPECT_EQ(values[i], *decoded_values_[i]);
+    }
+  }
+}
+
+TEST_F(RedisEncoderDecoderImplTest, RawValues) {
+  DecoderImpl decoder(*this, true);
+
+  std::vector<RespValue> values(3);
+  values[0].type(RespType::BulkString);
+  values[0].asString() = std::string(DecoderImpl::MinRawValueBytes, 'a');
+  values[1].type(RespType::SimpleString);
+  values[1].asString() = "OK";
+  values[2].type(RespType::Array);
+  values[2].asArray().resize(2);
+  values[2].asArray()[0].type(RespType::Integer);
+  values[2].asArray()[0].asInteger() = 1;
+  values[2].asArray()[1].type(RespType::BulkString);
+  values[2].asArray()[1].asString() = std::string(DecoderImpl::MinRawValueBytes, 'b');
+
+  std::vector<std::string> encoded;
+  for (const RespValue& value : values) {
+    Buffer::OwnedImpl buffer;
+    encoder_.encode(value, buffer);
+    encoded.push_back(buffer.toString());
+  }
+  const std::string all = encoded[0] + encoded[1] + encoded[2];
+
+  // Split the values across decode calls at a few positions, in and between values.
+  const std::vector<size_t> splits{1, encoded[0].size() / 2, encoded[0].size() + 1,
+                                   encoded[0].size() + encoded[1].size() + 3, all.size() - 1};
+  for (const size_t split : splits) {
+    decoded_values_.clear();
+    Buffer::OwnedImpl first(all.substr(0, split));
+    decoder.decode(first);
+    EXPECT_EQ(0UL, first.length());
+    Buffer::OwnedImpl second(all.substr(split));
+    decoder.decode(second);
+    EXPECT_EQ(0UL, second.length());
+
+    ASSERT_EQ(3UL, decoded_values_.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      EXPECT_EQ(values[i], *decoded_values_[i]);
+    }
+    ASSERT_NE(nullptr, decoded_values_[0]->raw());
+    EXPECT_EQ(encoded[0], decoded_values_[0]->raw()->toString());
+    // Small values are not kept.
+    EXPECT_EQ(nullptr, decoded_values_[1]->raw());
+    ASSERT_NE(nullptr, decoded_values_[2]->raw());
+    EXPECT_EQ(encoded[2], decoded_values_[2]->raw()->toString());
+    // Only top level values are.
+    EXPECT_EQ(nullptr, decoded_values_[2]->asArray()[1].raw());
+  }
+}
+
+TEST_F(RedisEncoderDecoderImplTest, NoRawValues) {
+  RespValue value;
+  value.type(RespType::BulkString);
+  value.asString() = std::string(DecoderImpl::MinRawValueBytes, 'a');
+  encoder_.encode(value, buffer_);
+  decoder_.decode(buffer_);
+  EXPECT_EQ(value, *decoded_values_[0]);
+  EXPECT_EQ(nullptr, decoded_values_[0]->raw());
+  EXPECT_EQ(0UL, buffer_.length());
+}
+
 TEST_F(RedisEncoderDecoderImplTest, NullArray) {
   buffer_.add("*-1\r\n");
   decoder_.decode(buffer_);
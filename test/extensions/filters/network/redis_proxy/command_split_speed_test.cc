@@ -5,10 +5,12 @@
 #include <string>
 #include <vector>
 
+#include "common/buffer/buffer_impl.h"
 #include "common/common/fmt.h"
 #include "common/stats/isolated_store_impl.h"
 
 #include "extensions/filters/network/common/redis/client_impl.h"
+#include "extensions/filters/network/common/redis/codec_impl.h"
 #include "extensions/filters/network/common/redis/supported_commands.h"
 #include "extensions/filters/network/redis_proxy/command_splitter_impl.h"
 #include "extensions/filters/network/redis_proxy/router_impl.h"
@@ -23,6 +25,12 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace RedisProxy {
 
+class NullDecoderCallbacks : public Common::Redis::DecoderCallbacks {
+public:
+  // Common::Redis::DecoderCallbacks
+  void onRespValue(Common::Redis::RespValuePtr&&) override {}
+};
+
 class CommandSplitSpeedTest {
 public:
   Common::Redis::RespValueSharedPtr
@@ -89,6 +97,63 @@ public:
 } // namespace Extensions
 } // namespace Envoy
 
+// Decodes an mset request, as read from a downstream connection. The time includes the copy of the
+// request into the read buffer.
+static void BM_Decode_BulkStringArray(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::CommandSplitSpeedTest context;
+  Envoy::Extensions::NetworkFilters::Common::Redis::RespValueSharedPtr request =
+      context.makeSharedBulkStringArray(state.range(0), 36, state.range(1));
+  Envoy::Buffer::OwnedImpl encoded;
+  Envoy::Extensions::NetworkFilters::Common::Redis::EncoderImpl encoder;
+  encoder.encode(*request, encoded);
+
+  Envoy::Extensions::NetworkFilters::RedisProxy::NullDecoderCallbacks callbacks;
+  Envoy::Extensions::NetworkFilters::Common::Redis::DecoderImpl decoder(callbacks);
+  for (auto _ : state) {
+    Envoy::Buffer::OwnedImpl data;
+    data.add(encoded);
+    decoder.decode(data);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.length());
+}
+BENCHMARK(BM_Decode_BulkStringArray)->Ranges({{1, 100}, {64, 8 << 14}});
+
+// Encodes an mset request and decodes it back, which is what the proxy does for each request and
+// reply that goes through it.
+static void BM_EncodeDecode_BulkStringArray(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::CommandSplitSpeedTest context;
+  Envoy::Extensions::NetworkFilters::Common::Redis::RespValueSharedPtr request =
+      context.makeSharedBulkStringArray(state.range(0), 36, state.range(1));
+
+  Envoy::Extensions::NetworkFilters::Common::Redis::EncoderImpl encoder;
+  Envoy::Extensions::NetworkFilters::RedisProxy::NullDecoderCallbacks callbacks;
+  Envoy::Extensions::NetworkFilters::Common::Redis::DecoderImpl decoder(callbacks);
+  for (auto _ : state) {
+    Envoy::Buffer::OwnedImpl data;
+    encoder.encode(*request, data);
+    decoder.decode(data);
+  }
+}
+BENCHMARK(BM_EncodeDecode_BulkStringArray)->Ranges({{1, 100}, {64, 8 << 14}});
+
+// Decodes a batch of small replies, as a pipelined connection to an upstream would receive them.
+static void BM_Decode_SimpleReplies(benchmark::State& state) {
+  Envoy::Buffer::OwnedImpl encoded;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    encoded.add("+OK\r\n:1\r\n$5\r\nvalue\r\n$-1\r\n");
+  }
+
+  Envoy::Extensions::NetworkFilters::RedisProxy::NullDecoderCallbacks callbacks;
+  Envoy::Extensions::NetworkFilters::Common::Redis::DecoderImpl decoder(callbacks);
+  for (auto _ : state) {
+    Envoy::Buffer::OwnedImpl data;
+    data.add(encoded);
+    decoder.decode(data);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 4);
+}
+BENCHMARK(BM_Decode_SimpleReplies)->Range(1, 1024);
+
 static void BM_Split_CompositeArray(benchmark::State& state) {
   Envoy::Extensions::NetworkFilters::RedisProxy::CommandSplitSpeedTest context;
   Envoy::Extensions::NetworkFilters::Common::Redis::RespValueSharedPtr request =
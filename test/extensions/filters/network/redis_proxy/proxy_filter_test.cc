@@ -8,6 +8,7 @@
 #include "test/extensions/filters/network/common/redis/mocks.h"
 #include "test/extensions/filters/network/redis_proxy/mocks.h"
 #include "test/mocks/api/mocks.h"
+#include "test/mocks/buffer/mocks.h"
 #include "test/mocks/common.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/upstream/mocks.h"
@@ -188,6 +189,31 @@ TEST_F(RedisProxyFilterTest, OutOfOrderResponseWithDrainClose) {
   EXPECT_EQ(1UL, config_->stats_.downstream_cx_drain_close_.value());
 }
 
+TEST_F(RedisProxyFilterTest, RawResponse) {
+  InSequence s;
+
+  Buffer::OwnedImpl fake_data;
+  CommandSplitter::MockSplitRequest* request_handle1 = new CommandSplitter::MockSplitRequest();
+  CommandSplitter::SplitCallbacks* request_callbacks1;
+  EXPECT_CALL(*decoder_, decode(Ref(fake_data))).WillOnce(Invoke([&](Buffer::Instance&) -> void {
+    Common::Redis::RespValuePtr request1(new Common::Redis::RespValue());
+    EXPECT_CALL(splitter_, makeRequest_(Ref(*request1), _))
+        .WillOnce(DoAll(WithArg<1>(SaveArgAddress(&request_callbacks1)), Return(request_handle1)));
+    decoder_callbacks_->onRespValue(std::move(request1));
+  }));
+  EXPECT_EQ(Network::FilterStatus::Continue, filter_->onData(fake_data, false));
+
+  // A response that comes with the bytes it was decoded from is written as those bytes.
+  Common::Redis::RespValuePtr response1(new Common::Redis::RespValue());
+  response1->type(Common::Redis::RespType::SimpleString);
+  response1->asString() = "OK";
+  response1->raw(std::make_unique<Buffer::OwnedImpl>("+OK\r\n"));
+  EXPECT_CALL(*encoder_, encode(_, _)).Times(0);
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferStringEqual("+OK\r\n"), false))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) -> void { data.drain(data.length()); }));
+  request_callbacks1->onResponse(std::move(response1));
+}
+
 TEST_F(RedisProxyFilterTest, OutOfOrderResponseDownstreamDisconnectBeforeFlush) {
   InSequence s;
 
@@ -717,6 +717,88 @@ TEST_F(ThriftConnectionManagerTest, RequestAndResponseSequenceIdHandling) {
   EXPECT_EQ(0U, store_.counter("test.response_error").value());
 }
 
+// Tests that message bodies are passed through when enabled and supported by the filters.
+TEST_F(ThriftConnectionManagerTest, PayloadPassthroughRequestAndResponse) {
+  const std::string yaml = R"EOF(
+transport: FRAMED
+protocol: BINARY
+stat_prefix: test
+payload_passthrough: true
+)EOF";
+
+  initializeFilter(yaml);
+  writeComplexFramedBinaryMessage(buffer_, MessageType::Call, 0x0F);
+
+  // The body follows the 4 byte frame size and the 16 byte binary message begin.
+  Buffer::OwnedImpl request_body;
+  {
+    Buffer::OwnedImpl request;
+    writeComplexFramedBinaryMessage(request, MessageType::Call, 0x0F);
+    request.drain(20);
+    request_body.move(request);
+  }
+
+  ThriftFilters::DecoderFilterCallbacks* callbacks{};
+  EXPECT_CALL(*decoder_filter_, setDecoderFilterCallbacks(_))
+      .WillOnce(
+          Invoke([&](ThriftFilters::DecoderFilterCallbacks& cb) -> void { callbacks = &cb; }));
+  ON_CALL(*decoder_filter_, passthroughSupported()).WillByDefault(Return(true));
+  EXPECT_CALL(*decoder_filter_, structBegin(_)).Times(0);
+  EXPECT_CALL(*decoder_filter_, passthroughData(_))
+      .WillOnce(Invoke([&](Buffer::Instance& data) -> FilterStatus {
+        EXPECT_EQ(request_body.toString(), data.toString());
+        return FilterStatus::Continue;
+      }));
+
+  EXPECT_EQ(filter_->onData(buffer_, false), Network::FilterStatus::StopIteration);
+  EXPECT_EQ(1U, store_.counter("test.request_call").value());
+
+  writeComplexFramedBinaryMessage(write_buffer_, MessageType::Reply, 0xFF);
+
+  FramedTransportImpl transport;
+  BinaryProtocolImpl proto;
+  callbacks->startUpstreamResponse(transport, proto);
+
+  Buffer::OwnedImpl response_buffer;
+  writeComplexFramedBinaryMessage(response_buffer, MessageType::Reply, 0x0F);
+
+  EXPECT_CALL(filter_callbacks_.connection_, write(_, false))
+      .WillOnce(Invoke([&](Buffer::Instance& buffer, bool) -> void {
+        EXPECT_EQ(response_buffer.toString(), buffer.toString());
+      }));
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, deferredDelete_(_)).Times(1);
+  EXPECT_EQ(ThriftFilters::ResponseStatus::Complete, callbacks->upstreamData(write_buffer_));
+
+  filter_callbacks_.connection_.dispatcher_.clearDeferredDeleteList();
+
+  EXPECT_EQ(1U, store_.counter("test.request").value());
+  EXPECT_EQ(0U, stats_.request_active_.value());
+  EXPECT_EQ(1U, store_.counter("test.response").value());
+  EXPECT_EQ(1U, store_.counter("test.response_reply").value());
+  EXPECT_EQ(1U, store_.counter("test.response_success").value());
+  EXPECT_EQ(0U, store_.counter("test.response_error").value());
+}
+
+// Tests that message bodies are decoded when a filter does not support passthrough.
+TEST_F(ThriftConnectionManagerTest, PayloadPassthroughUnsupportedByFilter) {
+  const std::string yaml = R"EOF(
+transport: FRAMED
+protocol: BINARY
+stat_prefix: test
+payload_passthrough: true
+)EOF";
+
+  initializeFilter(yaml);
+  writeFramedBinaryMessage(buffer_, MessageType::Call, 0x0F);
+
+  EXPECT_CALL(*decoder_filter_, passthroughSupported()).WillOnce(Return(false));
+  EXPECT_CALL(*decoder_filter_, passthroughData(_)).Times(0);
+  EXPECT_CALL(*decoder_filter_, structBegin(_));
+
+  EXPECT_EQ(filter_->onData(buffer_, false), Network::FilterStatus::StopIteration);
+  EXPECT_EQ(1U, store_.counter("test.request_call").value());
+}
+
 TEST_F(ThriftConnectionManagerTest, RequestAndExceptionResponse) {
   initializeFilter();
   writeFramedBinaryMessage(buffer_, MessageType::Call, 0x0F);
@@ -35,6 +35,7 @@ public:
   MOCK_METHOD0(stats, ThriftFilterStats&());
   MOCK_METHOD1(createDecoder, DecoderPtr(DecoderCallbacks&));
   MOCK_METHOD0(routerConfig, Router::Config&());
+  MOCK_CONST_METHOD0(payloadPassthrough, bool());
 };
 
 class MockTransport : public Transport {
@@ -125,6 +126,7 @@ public:
 
   // ThriftProxy::DecoderCallbacks
   MOCK_METHOD0(newDecoderEventHandler, DecoderEventHandler&());
+  MOCK_CONST_METHOD0(passthroughEnabled, bool());
 };
 
 class MockDecoderEventHandler : public DecoderEventHandler {
@@ -155,6 +157,7 @@ public:
   MOCK_METHOD0(listEnd, FilterStatus());
   MOCK_METHOD2(setBegin, FilterStatus(FieldType& elem_type, uint32_t& size));
   MOCK_METHOD0(setEnd, FilterStatus());
+  MOCK_METHOD1(passthroughData, FilterStatus(Buffer::Instance& data));
 };
 
 class MockDirectResponse : public DirectResponse {
@@ -199,6 +202,7 @@ public:
   MOCK_METHOD0(onDestroy, void());
   MOCK_METHOD1(setDecoderFilterCallbacks, void(DecoderFilterCallbacks& callbacks));
   MOCK_METHOD0(resetUpstreamConnection, void());
+  MOCK_CONST_METHOD0(passthroughSupported, bool());
 
   // ThriftProxy::DecoderEventHandler
   MOCK_METHOD1(transportBegin, FilterStatus(MessageMetadataSharedPtr metadata));
@@ -223,6 +227,7 @@ public:
   MOCK_METHOD0(listEnd, FilterStatus());
   MOCK_METHOD2(setBegin, FilterStatus(FieldType& elem_type, uint32_t& size));
   MOCK_METHOD0(setEnd, FilterStatus());
+  MOCK_METHOD1(passthroughData, FilterStatus(Buffer::Instance& data));
 };
 
 class MockDecoderFilterCallbacks : public DecoderFilterCallbacks {
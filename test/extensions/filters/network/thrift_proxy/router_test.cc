@@ -794,6 +794,43 @@ TEST_P(ThriftRouterFieldTypeTest, StripServiceNameDisabled) {
   destroyRouter();
 }
 
+TEST_F(ThriftRouterTest, PayloadPassthrough) {
+  initializeRouter();
+  startRequest(MessageType::Call);
+  EXPECT_TRUE(router_->passthroughSupported());
+  connectUpstream();
+
+  EXPECT_CALL(*protocol_, writeStructBegin(_, _)).Times(0);
+  Buffer::OwnedImpl body("body");
+  EXPECT_EQ(FilterStatus::Continue, router_->passthroughData(body));
+  EXPECT_EQ(0, body.length());
+
+  EXPECT_CALL(*protocol_, writeMessageEnd(_));
+  EXPECT_CALL(*transport_, encodeFrame(_, _, _))
+      .WillOnce(Invoke([&](Buffer::Instance& buffer, const MessageMetadata&,
+                           Buffer::Instance& message) -> void {
+        EXPECT_EQ("body", message.toString());
+        buffer.move(message);
+      }));
+  EXPECT_CALL(upstream_connection_, write(_, false));
+  EXPECT_EQ(FilterStatus::Continue, router_->messageEnd());
+  EXPECT_EQ(FilterStatus::Continue, router_->transportEnd());
+
+  returnResponse();
+  destroyRouter();
+}
+
+TEST_F(ThriftRouterTest, PayloadPassthroughUnsupportedWithProtocolUpgrade) {
+  mock_protocol_cb_ = [&](MockProtocol* protocol) -> void {
+    ON_CALL(*protocol, supportsUpgrade()).WillByDefault(Return(true));
+  };
+
+  initializeRouter();
+  startRequest(MessageType::Call);
+  EXPECT_FALSE(router_->passthroughSupported());
+  destroyRouter();
+}
+
 TEST_F(ThriftRouterTest, CallWithExistingConnection) {
   initializeRouter();
 
@@ -83,24 +83,24 @@ public:
               }));
 
       if (recv_sys_errno == 0) {
-        // Send the datagram downstream.
-        EXPECT_CALL(parent_.callbacks_.udp_listener_, send(_))
-            .WillOnce(Invoke([data, send_sys_errno](
-                                 const Network::UdpSendData& send_data) -> Api::IoCallUint64Result {
+        // Return an EAGAIN result.
+        EXPECT_CALL(*io_handle_, recvmsg(_, 1, _, _))
+            .WillOnce(Return(ByMove(Api::IoCallUint64Result(
+                0, Api::IoErrorPtr(Network::IoSocketError::getIoSocketEagainInstance(),
+                                   Network::IoSocketError::deleteIoError)))));
+        // Send the datagram downstream once the socket is drained.
+        EXPECT_CALL(parent_.callbacks_.udp_listener_, sendBatch(_, 1))
+            .WillOnce(Invoke([data, send_sys_errno](const Network::UdpSendData* send_data,
+                                                    uint64_t) -> Api::IoCallUint64Result {
               // TODO(mattklein123): Verify peer/local address.
-              EXPECT_EQ(send_data.buffer_.toString(), data);
+              EXPECT_EQ(send_data[0].buffer_.toString(), data);
               if (send_sys_errno == 0) {
-                send_data.buffer_.drain(send_data.buffer_.length());
-                return makeNoError(data.size());
+                send_data[0].buffer_.drain(send_data[0].buffer_.length());
+                return makeNoError(1);
               } else {
                 return makeError(send_sys_errno);
               }
             }));
-        // Return an EAGAIN result.
-        EXPECT_CALL(*io_handle_, recvmsg(_, 1, _, _))
-            .WillOnce(Return(ByMove(Api::IoCallUint64Result(
-                0, Api::IoErrorPtr(Network::IoSocketError::getIoSocketEagainInstance(),
-                                   Network::IoSocketError::deleteIoError)))));
       }
 
       // Kick off the receive.
@@ -285,6 +285,60 @@ cluster: fake_cluster
                    ->value());
 }
 
+// Verify that the datagrams read from the upstream host in one event are sent downstream in
+// batches, going on after partial sends and errors.
+TEST_F(UdpProxyFilterTest, BatchedDownstreamSends) {
+  InSequence s;
+
+  setup(R"EOF(
+stat_prefix: foo
+cluster: fake_cluster
+  )EOF");
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  session.expectUpstreamWrite("hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+
+  const auto recv_datagram = [&session](Buffer::RawSlice* slices, const uint64_t, uint32_t,
+                                        Network::IoHandle::RecvMsgOutput& output) {
+    memcpy(slices[0].mem_, "world", 5);
+    output.peer_address_ = session.upstream_address_;
+    return makeNoError(5);
+  };
+  const auto send_datagrams = [](uint64_t rc) {
+    return [rc](const Network::UdpSendData* send_data, uint64_t) -> Api::IoCallUint64Result {
+      for (uint64_t i = 0; i < rc; i++) {
+        EXPECT_EQ("world", send_data[i].buffer_.toString());
+        send_data[i].buffer_.drain(send_data[i].buffer_.length());
+      }
+      return makeNoError(rc);
+    };
+  };
+
+  // 17 datagrams: a full batch is sent as soon as it is read, the last datagram once the socket is
+  // drained. The first batch is sent in part, and the first datagram of the rest fails.
+  EXPECT_CALL(*session.idle_timer_, enableTimer(config_->sessionTimeout(), nullptr));
+  EXPECT_CALL(*session.io_handle_, recvmsg(_, 1, _, _))
+      .Times(16)
+      .WillRepeatedly(Invoke(recv_datagram));
+  EXPECT_CALL(callbacks_.udp_listener_, sendBatch(_, 16)).WillOnce(Invoke(send_datagrams(10)));
+  EXPECT_CALL(callbacks_.udp_listener_, sendBatch(_, 6)).WillOnce(Return(ByMove(makeError(EPERM))));
+  EXPECT_CALL(callbacks_.udp_listener_, sendBatch(_, 5)).WillOnce(Invoke(send_datagrams(5)));
+  EXPECT_CALL(*session.io_handle_, recvmsg(_, 1, _, _)).WillOnce(Invoke(recv_datagram));
+  EXPECT_CALL(*session.io_handle_, recvmsg(_, 1, _, _))
+      .WillOnce(Return(ByMove(Api::IoCallUint64Result(
+          0, Api::IoErrorPtr(Network::IoSocketError::getIoSocketEagainInstance(),
+                             Network::IoSocketError::deleteIoError)))));
+  EXPECT_CALL(callbacks_.udp_listener_, sendBatch(_, 1)).WillOnce(Invoke(send_datagrams(1)));
+  session.file_event_cb_(Event::FileReadyType::Read);
+
+  checkTransferStats(5 /*rx_bytes*/, 1 /*rx_datagrams*/, 80 /*tx_bytes*/, 16 /*tx_datagrams*/);
+  EXPECT_EQ(1, config_->stats().downstream_sess_tx_errors_.value());
+  EXPECT_EQ(85, cluster_manager_.thread_local_cluster_.cluster_.info_->stats_
+                    .upstream_cx_rx_bytes_total_.value());
+}
+
 // No upstream host handling.
 TEST_F(UdpProxyFilterTest, NoUpstreamHost) {
   InSequence s;
@@ -0,0 +1,214 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/private_key_provider/thread_pool/v2alpha/thread_pool.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "common/stats/isolated_store_impl.h"
+
+#include "extensions/private_key_providers/thread_pool/config.h"
+#include "extensions/private_key_providers/thread_pool/thread_pool_provider.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+using testing::Invoke;
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyProviders {
+namespace ThreadPool {
+namespace {
+
+class ThreadPoolPrivateKeyMethodProviderTest : public testing::Test {
+public:
+  ThreadPoolPrivateKeyMethodProviderTest()
+      : api_(Api::createApiForTest(store_)), dispatcher_(api_->allocateDispatcher()),
+        ssl_ctx_(SSL_CTX_new(TLS_method())), ssl_(SSL_new(ssl_ctx_.get())) {
+    ON_CALL(factory_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_, statsScope()).WillByDefault(ReturnRef(store_));
+  }
+
+  void createProvider(const std::string& key_file) {
+    config_.mutable_private_key()->set_filename(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/" + key_file));
+    provider_ = std::make_unique<ThreadPoolPrivateKeyMethodProvider>(config_, factory_context_);
+  }
+
+  // Runs the dispatcher until the private key operation of the callbacks has been handed back.
+  void waitForCompletion(Ssl::MockPrivateKeyConnectionCallbacks& callbacks) {
+    EXPECT_CALL(callbacks, onPrivateKeyMethodComplete()).WillOnce(Invoke([this]() {
+      dispatcher_->exit();
+    }));
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+
+  bool verify(uint16_t signature_algorithm, const std::vector<uint8_t>& in,
+              const std::vector<uint8_t>& signature) {
+    const std::string key = api_->fileSystem().fileReadToEnd(config_.private_key().filename());
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(key.data(), key.size()));
+    bssl::UniquePtr<EVP_PKEY> pkey(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pkey_ctx;
+    if (!EVP_DigestVerifyInit(ctx.get(), &pkey_ctx,
+                              SSL_get_signature_algorithm_digest(signature_algorithm), nullptr,
+                              pkey.get())) {
+      return false;
+    }
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+        (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+         !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+      return false;
+    }
+    return EVP_DigestVerify(ctx.get(), signature.data(), signature.size(), in.data(), in.size());
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  envoy::config::private_key_provider::thread_pool::v2alpha::ThreadPoolPrivateKeyProviderConfig
+      config_;
+  std::unique_ptr<ThreadPoolPrivateKeyMethodProvider> provider_;
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  bssl::UniquePtr<SSL> ssl_;
+  NiceMock<Ssl::MockPrivateKeyConnectionCallbacks> callbacks_;
+  const std::vector<uint8_t> in_{'h', 'a', 'n', 'd', 's', 'h', 'a', 'k', 'e'};
+};
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, RsaSign) {
+  createProvider("selfsigned_key.pem");
+  provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider_->getBoringSslPrivateKeyMethod();
+
+  for (const uint16_t signature_algorithm : {SSL_SIGN_RSA_PKCS1_SHA256, SSL_SIGN_RSA_PSS_SHA256}) {
+    std::vector<uint8_t> out(1024);
+    size_t out_len;
+    EXPECT_EQ(ssl_private_key_retry,
+              method->sign(ssl_.get(), out.data(), &out_len, out.size(), signature_algorithm,
+                           in_.data(), in_.size()));
+    waitForCompletion(callbacks_);
+    ASSERT_EQ(ssl_private_key_success,
+              method->complete(ssl_.get(), out.data(), &out_len, out.size()));
+    out.resize(out_len);
+    EXPECT_TRUE(verify(signature_algorithm, in_, out));
+  }
+
+  EXPECT_EQ(2U, store_.counter("private_key_provider.thread_pool.offloaded").value());
+  EXPECT_EQ(0U, store_.counter("private_key_provider.thread_pool.failed").value());
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, EcdsaSign) {
+  createProvider("selfsigned_ecdsa_p256_key.pem");
+  provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider_->getBoringSslPrivateKeyMethod();
+
+  std::vector<uint8_t> out(1024);
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_retry,
+            method->sign(ssl_.get(), out.data(), &out_len, out.size(),
+                         SSL_SIGN_ECDSA_SECP256R1_SHA256, in_.data(), in_.size()));
+  // The operation is only done once it has been handed back to the worker.
+  EXPECT_EQ(ssl_private_key_retry, method->complete(ssl_.get(), out.data(), &out_len, out.size()));
+  waitForCompletion(callbacks_);
+  ASSERT_EQ(ssl_private_key_success,
+            method->complete(ssl_.get(), out.data(), &out_len, out.size()));
+  out.resize(out_len);
+  EXPECT_TRUE(verify(SSL_SIGN_ECDSA_SECP256R1_SHA256, in_, out));
+
+  // ECDSA keys can't decrypt.
+  EXPECT_EQ(ssl_private_key_failure, method->decrypt(ssl_.get(), out.data(), &out_len, out.size(),
+                                                     in_.data(), in_.size()));
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, FailedOperation) {
+  createProvider("selfsigned_key.pem");
+  provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider_->getBoringSslPrivateKeyMethod();
+
+  // The input of a raw RSA decryption must be as long as the modulus.
+  std::vector<uint8_t> out(1024);
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_retry, method->decrypt(ssl_.get(), out.data(), &out_len, out.size(),
+                                                   in_.data(), in_.size()));
+  waitForCompletion(callbacks_);
+  EXPECT_EQ(ssl_private_key_failure,
+            method->complete(ssl_.get(), out.data(), &out_len, out.size()));
+  EXPECT_EQ(1U, store_.counter("private_key_provider.thread_pool.failed").value());
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+// Operations of connections that went away are not handed back.
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, UnregisterWithPendingOperation) {
+  createProvider("selfsigned_key.pem");
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider_->getBoringSslPrivateKeyMethod();
+  bssl::UniquePtr<SSL> other_ssl(SSL_new(ssl_ctx_.get()));
+  NiceMock<Ssl::MockPrivateKeyConnectionCallbacks> other_callbacks;
+  provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  provider_->registerPrivateKeyMethod(other_ssl.get(), other_callbacks, *dispatcher_);
+
+  std::vector<uint8_t> out(1024);
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_retry,
+            method->sign(ssl_.get(), out.data(), &out_len, out.size(), SSL_SIGN_RSA_PKCS1_SHA256,
+                         in_.data(), in_.size()));
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+  EXPECT_CALL(callbacks_, onPrivateKeyMethodComplete()).Times(0);
+
+  // With a single thread, the operations run in order.
+  EXPECT_EQ(ssl_private_key_retry,
+            method->sign(other_ssl.get(), out.data(), &out_len, out.size(),
+                         SSL_SIGN_RSA_PKCS1_SHA256, in_.data(), in_.size()));
+  waitForCompletion(other_callbacks);
+  EXPECT_EQ(ssl_private_key_success,
+            method->complete(other_ssl.get(), out.data(), &out_len, out.size()));
+  provider_->unregisterPrivateKeyMethod(other_ssl.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, RegisterTwice) {
+  createProvider("selfsigned_key.pem");
+  provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  EXPECT_THROW_WITH_MESSAGE(
+      provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_), EnvoyException,
+      "Can't distinguish between two registered providers for the same SSL object.");
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, BadKey) {
+  EXPECT_THROW_WITH_MESSAGE(
+      createProvider("selfsigned_cert.pem"), EnvoyException,
+      "Failed to load private key for the thread pool private key provider.");
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, Factory) {
+  auto* factory =
+      Registry::FactoryRegistry<Ssl::PrivateKeyMethodProviderInstanceFactory>::getFactory(
+          PrivateKeyProviderNames::get().ThreadPool);
+  ASSERT_NE(nullptr, factory);
+
+  config_.mutable_private_key()->set_filename(TestEnvironment::substitute(
+      "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/selfsigned_key.pem"));
+  config_.mutable_thread_count()->set_value(2);
+  envoy::api::v2::auth::PrivateKeyProvider provider_config;
+  provider_config.set_provider_name(PrivateKeyProviderNames::get().ThreadPool);
+  provider_config.mutable_typed_config()->PackFrom(config_);
+  EXPECT_NE(nullptr,
+            factory->createPrivateKeyMethodProviderInstance(provider_config, factory_context_));
+}
+
+} // namespace
+} // namespace ThreadPool
+} // namespace PrivateKeyProviders
+} // namespace Extensions
+} // namespace Envoy
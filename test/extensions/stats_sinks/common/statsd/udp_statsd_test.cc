@@ -1,21 +1,29 @@
 #include <chrono>
 
+#include "common/api/os_sys_calls_impl.h"
 #include "common/network/address_impl.h"
 #include "common/network/utility.h"
 
 #include "extensions/stat_sinks/common/statsd/statsd.h"
 
+#include "test/mocks/api/mocks.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "spdlog/spdlog.h"
 
+using testing::_;
+using testing::InSequence;
+using testing::Invoke;
 using testing::NiceMock;
+using testing::Return;
 
 namespace Envoy {
 namespace Extensions {
@@ -27,6 +35,13 @@ namespace {
 class MockWriter : public Writer {
 public:
   MOCK_METHOD1(write, void(const std::string& message));
+
+  // Surfaces every datagram of a batch through write(), so tests can match them one by one.
+  void writeBatch(const std::vector<absl::string_view>& datagrams) override {
+    for (const absl::string_view datagram : datagrams) {
+      write(std::string(datagram));
+    }
+  }
 };
 
 class UdpStatsdSinkTest : public testing::TestWithParam<Network::Address::IpVersion> {};
@@ -219,6 +234,88 @@ TEST(UdpStatsdSinkTest, SiSuffix) {
   tls_.shutdownThread();
 }
 
+TEST(UdpStatsdSinkTest, PacksMetricsIntoDatagrams) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  // "envoy.counter_a:1|c\nenvoy.counter_b:2|c" is 39 bytes.
+  UdpStatsdSink sink(tls_, writer_ptr, false, "", 40);
+
+  std::vector<std::shared_ptr<NiceMock<Stats::MockCounter>>> counters;
+  for (const std::string name : {"counter_a", "counter_b", "counter_c"}) {
+    auto counter = std::make_shared<NiceMock<Stats::MockCounter>>();
+    counter->name_ = name;
+    counter->used_ = true;
+    snapshot.counters_.push_back({counters.size() + 1, *counter});
+    counters.push_back(counter);
+  }
+
+  auto gauge = std::make_shared<NiceMock<Stats::MockGauge>>();
+  gauge->name_ = "a_gauge_with_a_name_longer_than_the_datagram_limit";
+  gauge->value_ = 4;
+  gauge->used_ = true;
+  snapshot.gauges_.push_back(*gauge);
+
+  testing::InSequence s;
+  EXPECT_CALL(*writer_ptr, write("envoy.counter_a:1|c\nenvoy.counter_b:2|c"));
+  EXPECT_CALL(*writer_ptr, write("envoy.counter_c:3|c"));
+  EXPECT_CALL(*writer_ptr,
+              write("envoy.a_gauge_with_a_name_longer_than_the_datagram_limit:4|g"));
+  sink.flush(snapshot);
+
+  // The buffer is reused by the next flush.
+  EXPECT_CALL(*writer_ptr, write("envoy.counter_a:1|c\nenvoy.counter_b:2|c"));
+  EXPECT_CALL(*writer_ptr, write("envoy.counter_c:3|c"));
+  EXPECT_CALL(*writer_ptr,
+              write("envoy.a_gauge_with_a_name_longer_than_the_datagram_limit:4|g"));
+  sink.flush(snapshot);
+
+  tls_.shutdownThread();
+}
+
+TEST(UdpStatsdSinkTest, NothingToFlush) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  UdpStatsdSink sink(tls_, writer_ptr, false, "", 1432);
+
+  auto counter = std::make_shared<NiceMock<Stats::MockCounter>>();
+  counter->name_ = "test_counter";
+  counter->used_ = false;
+  snapshot.counters_.push_back({1, *counter});
+
+  EXPECT_CALL(*writer_ptr, write(_)).Times(0);
+  sink.flush(snapshot);
+
+  tls_.shutdownThread();
+}
+
+TEST(UdpStatsdSinkWithTagsTest, PacksMetricsIntoDatagrams) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  UdpStatsdSink sink(tls_, writer_ptr, true, "", 1432);
+
+  std::vector<Stats::Tag> tags = {Stats::Tag{"key1", "value1"}, Stats::Tag{"key2", "value2"}};
+  auto counter = std::make_shared<NiceMock<Stats::MockCounter>>();
+  counter->name_ = "test_counter";
+  counter->used_ = true;
+  counter->setTags(tags);
+  snapshot.counters_.push_back({1, *counter});
+
+  auto gauge = std::make_shared<NiceMock<Stats::MockGauge>>();
+  gauge->name_ = "test_gauge";
+  gauge->value_ = 1;
+  gauge->used_ = true;
+  snapshot.gauges_.push_back(*gauge);
+
+  EXPECT_CALL(*writer_ptr, write("envoy.test_counter:1|c|#key1:value1,key2:value2\n"
+                                 "envoy.test_gauge:1|g"));
+  sink.flush(snapshot);
+
+  tls_.shutdownThread();
+}
+
 TEST(UdpStatsdSinkWithTagsTest, CheckActualStats) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
@@ -306,6 +403,76 @@ TEST(UdpStatsdSinkWithTagsTest, SiSuffix) {
   tls_.shutdownThread();
 }
 
+class WriterTest : public testing::TestWithParam<Network::Address::IpVersion> {};
+INSTANTIATE_TEST_SUITE_P(IpVersions, WriterTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+TEST_P(WriterTest, WriteBatch) {
+  auto server =
+      Network::Test::bindFreeLoopbackPort(GetParam(), Network::Address::SocketType::Datagram);
+  Writer writer(server.first);
+
+  // More datagrams than a single sendmmsg() call takes.
+  std::vector<std::string> datagrams;
+  for (int i = 0; i < 70; i++) {
+    datagrams.push_back(absl::StrCat("envoy.counter_", i, ":1|c"));
+  }
+  writer.writeBatch(std::vector<absl::string_view>(datagrams.begin(), datagrams.end()));
+
+  for (const std::string& expected : datagrams) {
+    char buffer[64];
+    const ssize_t received = ::recv(server.second->fd(), buffer, sizeof(buffer), 0);
+    ASSERT_EQ(static_cast<ssize_t>(expected.size()), received);
+    EXPECT_EQ(expected, absl::string_view(buffer, received));
+  }
+}
+
+std::string datagramString(const mmsghdr& header) {
+  std::string datagram;
+  for (size_t i = 0; i < header.msg_hdr.msg_iovlen; i++) {
+    const iovec& iov = header.msg_hdr.msg_iov[i];
+    datagram.append(static_cast<const char*>(iov.iov_base), iov.iov_len);
+  }
+  return datagram;
+}
+
+TEST_P(WriterTest, WriteBatchPartialSendsAndErrors) {
+  Writer writer(Network::Utility::parseInternetAddressAndPort(
+      fmt::format("{}:8125", Network::Test::getLoopbackAddressUrlString(GetParam()))));
+  const std::vector<absl::string_view> datagrams{"a", "bb", "ccc"};
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  ON_CALL(os_sys_calls, supportsMmsg()).WillByDefault(Return(true));
+  InSequence s;
+
+  // The datagrams left over by a partial send are sent by the next call.
+  EXPECT_CALL(os_sys_calls, sendmmsg(writer.getFdForTests(), _, 3, 0))
+      .WillOnce(Invoke([](int, mmsghdr* headers, unsigned int, int) -> Api::SysCallIntResult {
+        EXPECT_EQ("a", datagramString(headers[0]));
+        EXPECT_EQ("bb", datagramString(headers[1]));
+        EXPECT_EQ("ccc", datagramString(headers[2]));
+        return {2, 0};
+      }));
+  EXPECT_CALL(os_sys_calls, sendmmsg(writer.getFdForTests(), _, 1, 0))
+      .WillOnce(Invoke([](int, mmsghdr* headers, unsigned int, int) -> Api::SysCallIntResult {
+        EXPECT_EQ("ccc", datagramString(headers[0]));
+        return {1, 0};
+      }));
+  writer.writeBatch(datagrams);
+
+  // An error, such as a full send buffer, drops the rest of the batch.
+  EXPECT_CALL(os_sys_calls, sendmmsg(writer.getFdForTests(), _, 3, 0))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EAGAIN}));
+  writer.writeBatch(datagrams);
+
+  // So does a send that makes no progress.
+  EXPECT_CALL(os_sys_calls, sendmmsg(writer.getFdForTests(), _, 3, 0))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  writer.writeBatch(datagrams);
+}
+
 } // namespace
 } // namespace Statsd
 } // namespace Common
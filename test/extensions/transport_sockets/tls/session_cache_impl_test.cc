@@ -0,0 +1,87 @@
+#include <string>
+
+#include "extensions/transport_sockets/tls/session_cache_impl.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class SessionCacheImplTest : public testing::Test {
+protected:
+  bssl::UniquePtr<SSL_SESSION> newSession(uint16_t version = TLS1_2_VERSION) {
+    bssl::UniquePtr<SSL_SESSION> session(SSL_SESSION_new(ssl_ctx_.get()));
+    EXPECT_EQ(1, SSL_SESSION_set_protocol_version(session.get(), version));
+    return session;
+  }
+
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_{SSL_CTX_new(TLS_method())};
+};
+
+TEST_F(SessionCacheImplTest, InsertLookupRemove) {
+  SessionCacheImpl cache;
+  EXPECT_EQ(nullptr, cache.lookup("a"));
+
+  bssl::UniquePtr<SSL_SESSION> session = newSession();
+  SSL_SESSION* raw_session = session.get();
+  cache.insert("a", std::move(session));
+  EXPECT_EQ(1, cache.size());
+  // Sessions that can be resumed several times stay in the cache.
+  EXPECT_EQ(raw_session, cache.lookup("a").get());
+  EXPECT_EQ(raw_session, cache.lookup("a").get());
+  EXPECT_EQ(nullptr, cache.lookup("b"));
+
+  bssl::UniquePtr<SSL_SESSION> replacement = newSession();
+  SSL_SESSION* raw_replacement = replacement.get();
+  cache.insert("a", std::move(replacement));
+  EXPECT_EQ(1, cache.size());
+  EXPECT_EQ(raw_replacement, cache.lookup("a").get());
+
+  cache.remove("b");
+  EXPECT_EQ(1, cache.size());
+  cache.remove("a");
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(nullptr, cache.lookup("a"));
+}
+
+TEST_F(SessionCacheImplTest, SingleUseSession) {
+  SessionCacheImpl cache;
+  cache.insert("a", newSession(TLS1_3_VERSION));
+  EXPECT_NE(nullptr, cache.lookup("a"));
+  EXPECT_EQ(nullptr, cache.lookup("a"));
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(SessionCacheImplTest, EvictLeastRecentlyUsed) {
+  // A single shard, so that the eviction order doesn't depend on the hash of the keys.
+  SessionCacheImpl cache(2, 1);
+  cache.insert("a", newSession());
+  cache.insert("b", newSession());
+  EXPECT_NE(nullptr, cache.lookup("a"));
+
+  cache.insert("c", newSession());
+  EXPECT_EQ(2, cache.size());
+  EXPECT_NE(nullptr, cache.lookup("a"));
+  EXPECT_EQ(nullptr, cache.lookup("b"));
+  EXPECT_NE(nullptr, cache.lookup("c"));
+}
+
+TEST_F(SessionCacheImplTest, SessionsSplitBetweenShards) {
+  SessionCacheImpl cache(16, 4);
+  for (int i = 0; i < 100; ++i) {
+    cache.insert(std::to_string(i), newSession());
+  }
+  // Every shard holds at most 4 sessions.
+  EXPECT_LE(cache.size(), 16U);
+  EXPECT_NE(nullptr, cache.lookup("99"));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -3164,6 +3164,252 @@ TEST_P(SslSocketTest, ClientSessionResumptionEnabledTls13) {
   testClientSessionResumption(server_ctx_yaml, client_ctx_yaml, true, GetParam());
 }
 
+namespace {
+
+// Test connecting with a client context to a server context, then resuming the session with a new
+// client context to a new server context, both created by the same context manager.
+void testSharedSessionCacheResumption(const std::string& server_ctx_yaml,
+                                      const std::string& client_ctx_yaml,
+                                      const Network::Address::IpVersion ip_version) {
+  Event::SimulatedTimeSystem time_system;
+  ContextManagerImpl manager(*time_system);
+
+  Stats::IsolatedStoreImpl server_stats_store;
+  Api::ApiPtr server_api = Api::createApiForTest(server_stats_store, time_system);
+  testing::NiceMock<Server::Configuration::MockTransportSocketFactoryContext>
+      server_factory_context;
+  ON_CALL(server_factory_context, api()).WillByDefault(ReturnRef(*server_api));
+
+  envoy::api::v2::auth::DownstreamTlsContext server_tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(server_ctx_yaml), server_tls_context);
+  ServerSslSocketFactory server_ssl_socket_factory1(
+      std::make_unique<ServerContextConfigImpl>(server_tls_context, server_factory_context),
+      manager, server_stats_store, std::vector<std::string>{});
+  ServerSslSocketFactory server_ssl_socket_factory2(
+      std::make_unique<ServerContextConfigImpl>(server_tls_context, server_factory_context),
+      manager, server_stats_store, std::vector<std::string>{});
+
+  Stats::IsolatedStoreImpl client_stats_store;
+  Api::ApiPtr client_api = Api::createApiForTest(client_stats_store, time_system);
+  testing::NiceMock<Server::Configuration::MockTransportSocketFactoryContext>
+      client_factory_context;
+  ON_CALL(client_factory_context, api()).WillByDefault(ReturnRef(*client_api));
+
+  envoy::api::v2::auth::UpstreamTlsContext client_tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(client_ctx_yaml), client_tls_context);
+  ClientSslSocketFactory client_ssl_socket_factory1(
+      std::make_unique<ClientContextConfigImpl>(client_tls_context, client_factory_context),
+      manager, client_stats_store);
+  ClientSslSocketFactory client_ssl_socket_factory2(
+      std::make_unique<ClientContextConfigImpl>(client_tls_context, client_factory_context),
+      manager, client_stats_store);
+
+  auto socket = std::make_shared<Network::TcpListenSocket>(
+      Network::Test::getCanonicalLoopbackAddress(ip_version), nullptr, true);
+  NiceMock<Network::MockListenerCallbacks> callbacks;
+  Event::DispatcherPtr dispatcher(server_api->allocateDispatcher());
+  Network::ListenerPtr listener = dispatcher->createListener(socket, callbacks, true);
+
+  Network::TransportSocketFactory* server_ssl_socket_factory = &server_ssl_socket_factory1;
+  Network::ConnectionPtr server_connection;
+  Network::MockConnectionCallbacks server_connection_callbacks;
+  EXPECT_CALL(callbacks, onAccept_(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](Network::ConnectionSocketPtr& socket) -> void {
+        server_connection = dispatcher->createServerConnection(
+            std::move(socket), server_ssl_socket_factory->createTransportSocket(nullptr));
+        server_connection->addConnectionCallbacks(server_connection_callbacks);
+      }));
+
+  Network::ClientConnectionPtr client_connection;
+  Network::MockConnectionCallbacks client_connection_callbacks;
+  size_t connect_count = 0;
+  auto connect = [&](Network::TransportSocketFactory& client_ssl_socket_factory) {
+    connect_count = 0;
+    client_connection = dispatcher->createClientConnection(
+        socket->localAddress(), Network::Address::InstanceConstSharedPtr(),
+        client_ssl_socket_factory.createTransportSocket(nullptr), nullptr);
+    client_connection->addConnectionCallbacks(client_connection_callbacks);
+    // Without tickets, TLSv1.2 servers can only resume the session through its session ID.
+    const SslSocketInfo* ssl_socket =
+        dynamic_cast<const SslSocketInfo*>(client_connection->ssl().get());
+    SSL_set_options(ssl_socket->rawSslForTest(), SSL_OP_NO_TICKET);
+    client_connection->connect();
+    dispatcher->run(Event::Dispatcher::RunType::Block);
+  };
+  auto connected = [&](Network::ConnectionEvent) -> void {
+    if (++connect_count == 2) {
+      client_connection->close(Network::ConnectionCloseType::NoFlush);
+      server_connection->close(Network::ConnectionCloseType::NoFlush);
+      dispatcher->exit();
+    }
+  };
+  EXPECT_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::Connected))
+      .Times(2)
+      .WillRepeatedly(Invoke(connected));
+  EXPECT_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::Connected))
+      .Times(2)
+      .WillRepeatedly(Invoke(connected));
+  EXPECT_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::LocalClose))
+      .Times(2);
+  EXPECT_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::LocalClose))
+      .Times(2);
+
+  connect(client_ssl_socket_factory1);
+  EXPECT_EQ(0UL, server_stats_store.counter("ssl.session_reused").value());
+  EXPECT_EQ(0UL, client_stats_store.counter("ssl.session_reused").value());
+  EXPECT_EQ(2UL, manager.sessionCache().size());
+
+  server_ssl_socket_factory = &server_ssl_socket_factory2;
+  connect(client_ssl_socket_factory2);
+  EXPECT_EQ(1UL, server_stats_store.counter("ssl.session_reused").value());
+  EXPECT_EQ(1UL, server_stats_store.counter("ssl.session_cache_hit").value());
+  EXPECT_EQ(1UL, client_stats_store.counter("ssl.session_reused").value());
+  EXPECT_EQ(1UL, client_stats_store.counter("ssl.session_cache_hit").value());
+}
+
+} // namespace
+
+// Test that sessions survive the replacement of both the client and the server contexts when the
+// server shares its session cache.
+TEST_P(SslSocketTest, SharedSessionCacheResumption) {
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_maximum_protocol_version: TLSv1_2
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_tmpdir }}/unittestcert.pem"
+      private_key:
+        filename: "{{ test_tmpdir }}/unittestkey.pem"
+  share_session_cache: true
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_maximum_protocol_version: TLSv1_2
+)EOF";
+
+  testSharedSessionCacheResumption(server_ctx_yaml, client_ctx_yaml, GetParam());
+}
+
+// Test that a TLSv1.3 session key, which must only be used once, is handed out to a single new
+// connection, whether the connection is created by the context that received the key or by a
+// context replacing it.
+TEST_P(SslSocketTest, SharedSessionCacheSingleUseSessionKey) {
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_minimum_protocol_version: TLSv1_3
+      tls_maximum_protocol_version: TLSv1_3
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_tmpdir }}/unittestcert.pem"
+      private_key:
+        filename: "{{ test_tmpdir }}/unittestkey.pem"
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_minimum_protocol_version: TLSv1_3
+      tls_maximum_protocol_version: TLSv1_3
+  max_session_keys: 2
+)EOF";
+
+  ContextManagerImpl manager(time_system_);
+
+  Stats::IsolatedStoreImpl server_stats_store;
+  Api::ApiPtr server_api = Api::createApiForTest(server_stats_store, time_system_);
+  testing::NiceMock<Server::Configuration::MockTransportSocketFactoryContext>
+      server_factory_context;
+  ON_CALL(server_factory_context, api()).WillByDefault(ReturnRef(*server_api));
+
+  envoy::api::v2::auth::DownstreamTlsContext server_tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(server_ctx_yaml), server_tls_context);
+  ServerSslSocketFactory server_ssl_socket_factory(
+      std::make_unique<ServerContextConfigImpl>(server_tls_context, server_factory_context),
+      manager, server_stats_store, std::vector<std::string>{});
+
+  Stats::IsolatedStoreImpl client_stats_store;
+  Api::ApiPtr client_api = Api::createApiForTest(client_stats_store, time_system_);
+  testing::NiceMock<Server::Configuration::MockTransportSocketFactoryContext>
+      client_factory_context;
+  ON_CALL(client_factory_context, api()).WillByDefault(ReturnRef(*client_api));
+
+  envoy::api::v2::auth::UpstreamTlsContext client_tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(client_ctx_yaml), client_tls_context);
+  ClientSslSocketFactory client_ssl_socket_factory1(
+      std::make_unique<ClientContextConfigImpl>(client_tls_context, client_factory_context),
+      manager, client_stats_store);
+  ClientSslSocketFactory client_ssl_socket_factory2(
+      std::make_unique<ClientContextConfigImpl>(client_tls_context, client_factory_context),
+      manager, client_stats_store);
+
+  auto socket = std::make_shared<Network::TcpListenSocket>(
+      Network::Test::getCanonicalLoopbackAddress(GetParam()), nullptr, true);
+  NiceMock<Network::MockListenerCallbacks> callbacks;
+  Event::DispatcherPtr dispatcher(server_api->allocateDispatcher());
+  Network::ListenerPtr listener = dispatcher->createListener(socket, callbacks, true);
+
+  Network::ConnectionPtr server_connection;
+  NiceMock<Network::MockConnectionCallbacks> server_connection_callbacks;
+  EXPECT_CALL(callbacks, onAccept_(_))
+      .WillRepeatedly(Invoke([&](Network::ConnectionSocketPtr& socket) -> void {
+        server_connection = dispatcher->createServerConnection(
+            std::move(socket), server_ssl_socket_factory.createTransportSocket(nullptr));
+        server_connection->addConnectionCallbacks(server_connection_callbacks);
+      }));
+
+  // The server sends its session keys once the handshake is done, so the client has received
+  // them by the time it sees the server closing the connection.
+  Network::ClientConnectionPtr client_connection;
+  NiceMock<Network::MockConnectionCallbacks> client_connection_callbacks;
+  ON_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::Connected))
+      .WillByDefault(Invoke([&](Network::ConnectionEvent) -> void {
+        server_connection->close(Network::ConnectionCloseType::FlushWrite);
+      }));
+  ON_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::RemoteClose))
+      .WillByDefault(Invoke([&](Network::ConnectionEvent) -> void { dispatcher->exit(); }));
+  auto connect = [&](Network::TransportSocketFactory& client_ssl_socket_factory) {
+    client_connection = dispatcher->createClientConnection(
+        socket->localAddress(), Network::Address::InstanceConstSharedPtr(),
+        client_ssl_socket_factory.createTransportSocket(nullptr), nullptr);
+    client_connection->addConnectionCallbacks(client_connection_callbacks);
+    client_connection->connect();
+    dispatcher->run(Event::Dispatcher::RunType::Block);
+  };
+
+  connect(client_ssl_socket_factory1);
+  EXPECT_EQ(0UL, client_stats_store.counter("ssl.session_cache_hit").value());
+  EXPECT_EQ(1UL, client_stats_store.counter("ssl.session_cache_miss").value());
+  EXPECT_EQ(1UL, manager.sessionCache().size());
+
+  // The context that received the session key hands it out once.
+  Network::TransportSocketPtr transport_socket =
+      client_ssl_socket_factory1.createTransportSocket(nullptr);
+  EXPECT_EQ(1UL, client_stats_store.counter("ssl.session_cache_hit").value());
+  EXPECT_EQ(0UL, manager.sessionCache().size());
+  transport_socket = client_ssl_socket_factory1.createTransportSocket(nullptr);
+  transport_socket = client_ssl_socket_factory2.createTransportSocket(nullptr);
+  EXPECT_EQ(1UL, client_stats_store.counter("ssl.session_cache_hit").value());
+  EXPECT_EQ(3UL, client_stats_store.counter("ssl.session_cache_miss").value());
+
+  // So does the context replacing it, after which the context that received the key can't use it
+  // anymore.
+  connect(client_ssl_socket_factory1);
+  EXPECT_EQ(4UL, client_stats_store.counter("ssl.session_cache_miss").value());
+  EXPECT_EQ(1UL, manager.sessionCache().size());
+  transport_socket = client_ssl_socket_factory2.createTransportSocket(nullptr);
+  EXPECT_EQ(2UL, client_stats_store.counter("ssl.session_cache_hit").value());
+  transport_socket = client_ssl_socket_factory1.createTransportSocket(nullptr);
+  transport_socket = client_ssl_socket_factory2.createTransportSocket(nullptr);
+  EXPECT_EQ(2UL, client_stats_store.counter("ssl.session_cache_hit").value());
+  EXPECT_EQ(6UL, client_stats_store.counter("ssl.session_cache_miss").value());
+  EXPECT_EQ(0UL, client_stats_store.counter("ssl.session_reused").value());
+}
+
 TEST_P(SslSocketTest, SslError) {
   const std::string server_ctx_yaml = R"EOF(
   common_tls_context:
@@ -3949,8 +4195,9 @@ protected:
     EXPECT_EQ(0UL, client_stats_store_.counter("ssl.connection_error").value());
   }
 
-  void singleWriteTest(uint32_t read_buffer_limit, uint32_t bytes_to_write) {
-    MockWatermarkBuffer* client_write_buffer = nullptr;
+  // Connects a client whose write buffer is a MockWatermarkBuffer, saved in client_write_buffer_.
+  // SslSocket drains each record from it as soon as SSL_write() takes the record.
+  void connectWithMockClientWriteBuffer(uint32_t read_buffer_limit) {
     MockBufferFactory* factory = new StrictMock<MockBufferFactory>;
     dispatcher_ = api_->allocateDispatcher(Buffer::WatermarkFactoryPtr{factory});
 
@@ -3959,8 +4206,8 @@ protected:
         .Times(2)
         .WillOnce(Invoke([&](std::function<void()> below_low,
                              std::function<void()> above_high) -> Buffer::Instance* {
-          client_write_buffer = new MockWatermarkBuffer(below_low, above_high);
-          return client_write_buffer;
+          client_write_buffer_ = new MockWatermarkBuffer(below_low, above_high);
+          return client_write_buffer_;
         }))
         .WillRepeatedly(Invoke([](std::function<void()> below_low,
                                   std::function<void()> above_high) -> Buffer::Instance* {
@@ -3984,6 +4231,10 @@ protected:
         }));
 
     dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+
+  void singleWriteTest(uint32_t read_buffer_limit, uint32_t bytes_to_write) {
+    connectWithMockClientWriteBuffer(read_buffer_limit);
 
     EXPECT_CALL(*read_filter_, onNewConnection());
     EXPECT_CALL(*read_filter_, onData(_, _)).Times(testing::AnyNumber());
@@ -3991,12 +4242,15 @@ protected:
     std::string data_to_write(bytes_to_write, 'a');
     Buffer::OwnedImpl buffer_to_write(data_to_write);
     std::string data_written;
-    EXPECT_CALL(*client_write_buffer, move(_))
+    EXPECT_CALL(*client_write_buffer_, move(_))
         .WillRepeatedly(DoAll(AddBufferToStringWithoutDraining(&data_written),
-                              Invoke(client_write_buffer, &MockWatermarkBuffer::baseMove)));
-    EXPECT_CALL(*client_write_buffer, drain(_)).WillOnce(Invoke([&](uint64_t n) -> void {
-      client_write_buffer->baseDrain(n);
-      dispatcher_->exit();
+                              Invoke(client_write_buffer_, &MockWatermarkBuffer::baseMove)));
+    // The data may be written in several TLS records, each drained separately.
+    EXPECT_CALL(*client_write_buffer_, drain(_)).WillRepeatedly(Invoke([&](uint64_t n) -> void {
+      client_write_buffer_->baseDrain(n);
+      if (client_write_buffer_->length() == 0) {
+        dispatcher_->exit();
+      }
     }));
     client_connection_->write(buffer_to_write, false);
     dispatcher_->run(Event::Dispatcher::RunType::Block);
@@ -4049,6 +4303,7 @@ protected:
   Network::TransportSocketFactoryPtr client_ssl_socket_factory_;
   Network::ClientConnectionPtr client_connection_;
   Network::TransportSocket* client_transport_socket_{};
+  MockWatermarkBuffer* client_write_buffer_{};
   Network::ConnectionPtr server_connection_;
   NiceMock<Network::MockConnectionCallbacks> server_callbacks_;
   std::shared_ptr<Network::MockReadFilter> read_filter_;
@@ -4070,6 +4325,16 @@ TEST_P(SslReadBufferLimitTest, NoLimitSmallWrites) {
   readBufferLimitTest(0, 256 * 1024, 1, 256 * 1024, false);
 }
 
+// Records are cut at slice boundaries or assembled from several slices, depending on the slice
+// sizes.
+TEST_P(SslReadBufferLimitTest, NoLimitSmallSlices) {
+  readBufferLimitTest(0, 256 * 1024, 3000, 100, false);
+}
+
+TEST_P(SslReadBufferLimitTest, NoLimitLargeSlices) {
+  readBufferLimitTest(0, 256 * 1024, 5000, 100, false);
+}
+
 TEST_P(SslReadBufferLimitTest, SomeLimit) {
   readBufferLimitTest(32 * 1024, 32 * 1024, 256 * 1024, 1, false);
 }
@@ -4078,6 +4343,103 @@ TEST_P(SslReadBufferLimitTest, WritesSmallerThanBufferLimit) { singleWriteTest(5
 
 TEST_P(SslReadBufferLimitTest, WritesLargerThanBufferLimit) { singleWriteTest(1024, 5 * 1024); }
 
+// After the connection has been idle, the first 64 KiB are written in 1400 byte records and the
+// rest in 16 KiB records.
+TEST_P(SslReadBufferLimitTest, DynamicRecordSizes) {
+  connectWithMockClientWriteBuffer(0);
+
+  EXPECT_CALL(*read_filter_, onNewConnection());
+  EXPECT_CALL(*read_filter_, onData(_, _)).Times(testing::AnyNumber());
+
+  std::vector<uint64_t> record_sizes;
+  EXPECT_CALL(*client_write_buffer_, move(_))
+      .WillRepeatedly(Invoke(client_write_buffer_, &MockWatermarkBuffer::baseMove));
+  EXPECT_CALL(*client_write_buffer_, drain(_)).WillRepeatedly(Invoke([&](uint64_t n) -> void {
+    record_sizes.push_back(n);
+    client_write_buffer_->baseDrain(n);
+    if (client_write_buffer_->length() == 0) {
+      dispatcher_->exit();
+    }
+  }));
+  const auto write = [&](uint64_t size) -> std::vector<uint64_t> {
+    record_sizes.clear();
+    Buffer::OwnedImpl data(std::string(size, 'a'));
+    client_connection_->write(data, false);
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+    return record_sizes;
+  };
+
+  // 47 small records make up the first 64 KiB.
+  std::vector<uint64_t> expected_record_sizes(47, 1400);
+  expected_record_sizes.insert(expected_record_sizes.end(), {16384, 16384, 3832});
+  EXPECT_EQ(expected_record_sizes, write(100 * 1024));
+
+  // Without idle time in between, the next write goes on with large records.
+  EXPECT_EQ(std::vector<uint64_t>({16384, 16384, 1000}), write(32 * 1024 + 1000));
+
+  // Idle time shorter than a second doesn't matter either.
+  time_system_.sleep(std::chrono::milliseconds(900));
+  EXPECT_EQ(std::vector<uint64_t>({16384, 1000}), write(16 * 1024 + 1000));
+
+  // Once the connection has been idle for a second, records are small again.
+  time_system_.sleep(std::chrono::milliseconds(1100));
+  EXPECT_EQ(std::vector<uint64_t>({1400, 1400, 1200}), write(4000));
+
+  disconnect();
+}
+
+// An SSL_write() that fails with SSL_ERROR_WANT_WRITE is retried with the same record once the
+// socket is writable, even if the write buffer has been rearranged so that the record is no
+// longer at the address of the failed attempt.
+TEST_P(SslReadBufferLimitTest, WriteResumesAfterWantWrite) {
+  connectWithMockClientWriteBuffer(0);
+
+  std::string data_written;
+  std::string data_read;
+  EXPECT_CALL(*read_filter_, onNewConnection());
+  EXPECT_CALL(*read_filter_, onData(_, _))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data, bool) -> Network::FilterStatus {
+        data_read.append(data.toString());
+        data.drain(data.length());
+        if (data_read.size() == data_written.size()) {
+          dispatcher_->exit();
+        }
+        return Network::FilterStatus::StopIteration;
+      }));
+  EXPECT_CALL(*client_write_buffer_, move(_))
+      .WillRepeatedly(Invoke(client_write_buffer_, &MockWatermarkBuffer::baseMove));
+  EXPECT_CALL(*client_write_buffer_, drain(_))
+      .WillRepeatedly(Invoke(client_write_buffer_, &MockWatermarkBuffer::baseDrain));
+
+  // With the server not reading, write until the socket buffers are full and SSL_write() can't
+  // take a record. The data is in 100 byte slices, so records are copied into the scratch buffer.
+  server_connection_->readDisable(true);
+  for (uint32_t i = 0; i < 64 && client_write_buffer_->length() == 0; i++) {
+    Buffer::OwnedImpl data;
+    for (uint32_t j = 0; j < 10 * 1024; j++) {
+      Buffer::OwnedImpl slice(std::string(100, static_cast<char>('a' + (i + j) % 26)));
+      data.move(slice);
+    }
+    data_written.append(data.toString());
+    client_connection_->write(data, false);
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  ASSERT_NE(0, client_write_buffer_->length());
+  EXPECT_EQ(Network::Connection::State::Open, client_connection_->state());
+
+  // The record to retry is now at the front of a single slice instead of in the scratch buffer.
+  client_write_buffer_->linearize(client_write_buffer_->length());
+
+  server_connection_->readDisable(false);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(data_written, data_read);
+  EXPECT_EQ(0UL, client_write_buffer_->length());
+  EXPECT_EQ(0UL, server_stats_store_.counter("ssl.connection_error").value());
+  EXPECT_EQ(0UL, client_stats_store_.counter("ssl.connection_error").value());
+
+  disconnect();
+}
+
 TEST_P(SslReadBufferLimitTest, TestBind) {
   std::string address_string = TestUtility::getIpv4Loopback();
   if (GetParam() == Network::Address::IpVersion::v4) {
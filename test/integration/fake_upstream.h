@@ -654,7 +654,8 @@ private:
   public:
     FakeListener(FakeUpstream& parent)
         : parent_(parent), name_("fake_upstream"),
-          udp_listener_factory_(std::make_unique<Server::ActiveRawUdpListenerFactory>()) {}
+          udp_listener_factory_(std::make_unique<Server::ActiveRawUdpListenerFactory>(
+              envoy::api::v2::listener::RawUdpListenerConfig())) {}
 
   private:
     // Network::ListenerConfig
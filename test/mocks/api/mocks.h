@@ -66,6 +66,13 @@ public:
   MOCK_METHOD3(readv, SysCallSizeResult(int, const iovec*, int));
   MOCK_METHOD4(recv, SysCallSizeResult(int socket, void* buffer, size_t length, int flags));
   MOCK_METHOD3(recvmsg, SysCallSizeResult(int socket, struct msghdr* msg, int flags));
+  MOCK_METHOD5(recvmmsg, SysCallIntResult(int socket, struct mmsghdr* msgvec, unsigned int vlen,
+                                          int flags, struct timespec* timeout));
+  MOCK_METHOD4(sendmmsg, SysCallIntResult(int socket, struct mmsghdr* msgvec, unsigned int vlen,
+                                          int flags));
+  MOCK_CONST_METHOD0(supportsMmsg, bool());
+  MOCK_CONST_METHOD0(supportsUdpGro, bool());
+  MOCK_CONST_METHOD0(supportsUdpGso, bool());
   MOCK_METHOD2(ftruncate, SysCallIntResult(int fd, off_t length));
   MOCK_METHOD6(mmap, SysCallPtrResult(void* addr, size_t length, int prot, int flags, int fd,
                                       off_t offset));
@@ -67,7 +67,8 @@ public:
   }
 
   Network::UdpListenerPtr createUdpListener(Network::SocketSharedPtr&& socket,
-                                            Network::UdpListenerCallbacks& cb) override {
+                                            Network::UdpListenerCallbacks& cb,
+                                            const Network::UdpReadOptions&) override {
     return Network::UdpListenerPtr{createUdpListener_(std::move(socket), cb)};
   }
 
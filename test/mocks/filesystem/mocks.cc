@@ -33,6 +33,15 @@ Api::IoCallSizeResult MockFile::write(absl::string_view buffer) {
   return result;
 }
 
+Api::IoCallSizeResult MockFile::writev(const absl::string_view* buffers, uint64_t num_buffers) {
+  // Gathered writes are surfaced as a single write_() of the concatenated buffers.
+  std::string data;
+  for (uint64_t i = 0; i < num_buffers; i++) {
+    data.append(buffers[i].data(), buffers[i].size());
+  }
+  return write(data);
+}
+
 Api::IoCallBoolResult MockFile::close() {
   Api::IoCallBoolResult result = close_();
   is_open_ = !result.rc_;
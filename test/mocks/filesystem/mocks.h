@@ -21,6 +21,7 @@ public:
   // Filesystem::File
   Api::IoCallBoolResult open(FlagSet flag) override;
   Api::IoCallSizeResult write(absl::string_view buffer) override;
+  Api::IoCallSizeResult writev(const absl::string_view* buffers, uint64_t num_buffers) override;
   Api::IoCallBoolResult close() override;
   bool isOpen() const override { return is_open_; };
   MOCK_CONST_METHOD0(path, std::string());
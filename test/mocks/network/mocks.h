@@ -419,6 +419,7 @@ public:
   MOCK_METHOD0(dispatcher, Event::Dispatcher&());
   MOCK_CONST_METHOD0(localAddress, Address::InstanceConstSharedPtr&());
   MOCK_METHOD1(send, Api::IoCallUint64Result(const UdpSendData&));
+  MOCK_METHOD2(sendBatch, Api::IoCallUint64Result(const UdpSendData* data, uint64_t num_packets));
 
   Event::MockDispatcher dispatcher_;
 };
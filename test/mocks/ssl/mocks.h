@@ -108,6 +108,7 @@ public:
 
   MOCK_CONST_METHOD0(requireClientCertificate, bool());
   MOCK_CONST_METHOD0(sessionTicketKeys, const std::vector<SessionTicketKey>&());
+  MOCK_CONST_METHOD0(shareSessionCache, bool());
 };
 
 class MockPrivateKeyMethodManager : public PrivateKeyMethodManager {
@@ -136,5 +137,13 @@ public:
 #endif
 };
 
+class MockPrivateKeyConnectionCallbacks : public PrivateKeyConnectionCallbacks {
+public:
+  MockPrivateKeyConnectionCallbacks();
+  ~MockPrivateKeyConnectionCallbacks() override;
+
+  MOCK_METHOD0(onPrivateKeyMethodComplete, void());
+};
+
 } // namespace Ssl
 } // namespace Envoy
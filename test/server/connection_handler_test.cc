@@ -9,6 +9,7 @@
 #include "common/network/io_socket_handle_impl.h"
 #include "common/network/raw_buffer_socket.h"
 #include "common/network/utility.h"
+#include "common/protobuf/utility.h"
 
 #include "server/connection_handler_impl.h"
 
@@ -57,12 +58,11 @@ public:
           name_(name), listener_filters_timeout_(listener_filters_timeout),
           continue_on_listener_filters_timeout_(continue_on_listener_filters_timeout),
           connection_balancer_(std::make_unique<Network::NopConnectionBalancerImpl>()) {
-      envoy::api::v2::listener::UdpListenerConfig dummy;
       std::string listener_name("raw_udp_listener");
-      dummy.set_udp_listener_name(listener_name);
+      auto& config_factory =
+          Config::Utility::getAndCheckFactory<ActiveUdpListenerConfigFactory>(listener_name);
       udp_listener_factory_ =
-          Config::Utility::getAndCheckFactory<ActiveUdpListenerConfigFactory>(listener_name)
-              .createActiveUdpListenerFactory(dummy);
+          config_factory.createActiveUdpListenerFactory(*config_factory.createEmptyConfigProto());
       ON_CALL(*socket_, socketType()).WillByDefault(Return(socket_type));
     }
 
@@ -796,6 +796,18 @@ TEST_F(ConnectionHandlerTest, UdpListenerNoFilterThrowsException) {
   }
 }
 
+// A raw UDP listener must read at least one datagram per event.
+TEST_F(ConnectionHandlerTest, RawUdpListenerRejectsZeroPacketsPerEvent) {
+  auto& config_factory =
+      Config::Utility::getAndCheckFactory<ActiveUdpListenerConfigFactory>("raw_udp_listener");
+  envoy::api::v2::listener::RawUdpListenerConfig config;
+  config.mutable_max_read_packets_per_event()->set_value(0);
+  EXPECT_THROW(config_factory.createActiveUdpListenerFactory(config), ProtoValidationException);
+
+  config.mutable_max_read_packets_per_event()->set_value(1);
+  EXPECT_NE(nullptr, config_factory.createActiveUdpListenerFactory(config));
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy